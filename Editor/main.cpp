@@ -1,14 +1,85 @@
 #include "DeepEngine/engine.hpp"
+#include "DeepEngine/frame_limiter.hpp"
 
-int main(int /*argv*/, const char * /*argc*/[])
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, const char *argv[])
 {
-    deep::ref<deep::engine> eng = deep::engine::create();
+    deep::uint64 max_frames          = 0;
+    deep::uint32 recording_threads   = 0;
+    double target_fps                = 0.0;
+    deep::uint64 frame_budget_micros = 0;
+    deep::int32 sync_interval        = -1;
+    bool quantize_vertices           = false;
+    int index;
+
+    // Les outils hors ligne et les exécutions sans fenêtre sont fournis par DeepEngineTools.
+    // --frames N          : quitte après N images.
+    // --threads N         : nombre de threads qui enregistrent les commandes de dessin, 0 pour tous les cœurs.
+    // --quantize-vertices : compresse les sommets des formes de base.
+    // --fps N             : limite le nombre d'images par seconde, en dormant entre deux images.
+    // --frame-time N      : limite la durée d'une image à N microsecondes au lieu d'un nombre d'images par seconde.
+    // --vsync N           : nombre de synchronisations verticales attendues par image, 0 pour laisser le limiteur rythmer.
+    for (index = 1; index < argc; ++index)
+    {
+        if (std::strcmp(argv[index], "--quantize-vertices") == 0)
+        {
+            quantize_vertices = true;
+        }
+        else if (std::strcmp(argv[index], "--frames") == 0 && index + 1 < argc)
+        {
+            max_frames = static_cast<deep::uint64>(std::strtoull(argv[++index], nullptr, 10));
+        }
+        else if (std::strcmp(argv[index], "--threads") == 0 && index + 1 < argc)
+        {
+            recording_threads = static_cast<deep::uint32>(std::strtoul(argv[++index], nullptr, 10));
+        }
+        else if (std::strcmp(argv[index], "--fps") == 0 && index + 1 < argc)
+        {
+            target_fps = std::strtod(argv[++index], nullptr);
+        }
+        else if (std::strcmp(argv[index], "--frame-time") == 0 && index + 1 < argc)
+        {
+            frame_budget_micros = static_cast<deep::uint64>(std::strtoull(argv[++index], nullptr, 10));
+        }
+        else if (std::strcmp(argv[index], "--vsync") == 0 && index + 1 < argc)
+        {
+            sync_interval = static_cast<deep::int32>(std::strtol(argv[++index], nullptr, 10));
+        }
+    }
+
+    const deep::D3D::vertex_compression vertex_compression = quantize_vertices ? deep::D3D::vertex_compression::Quantized
+                                                                               : deep::D3D::vertex_compression::None;
+
+    deep::ref<deep::engine> eng = deep::engine::create(deep::D3D::renderer_backend::Direct3D11, vertex_compression);
 
     if (!eng.is_valid())
     {
         return 1;
     }
 
+    if (recording_threads != 0 && eng->get_renderer().is_valid())
+    {
+        eng->get_renderer()->set_recording_thread_count(recording_threads);
+    }
+
+    if (sync_interval >= 0 && eng->get_renderer().is_valid())
+    {
+        eng->get_renderer()->set_sync_interval(static_cast<deep::uint32>(sync_interval));
+    }
+
+    if (frame_budget_micros != 0)
+    {
+        eng->get_frame_limiter().set_frame_budget_micros(frame_budget_micros);
+    }
+    else if (target_fps > 0.0)
+    {
+        eng->get_frame_limiter().set_target_fps(target_fps);
+    }
+
+    eng->set_max_frames(max_frames);
+
     eng->run();
 
     eng->get_context()->out() << "~Goodbye~\r\n";
@@ -0,0 +1,811 @@
+#include "asset_database.hpp"
+#include "mapped_file.hpp"
+#include "D3D/cooked_texture.hpp"
+#include "D3D/thread_pool.hpp"
+#include "Assimp/loader.hpp"
+#include "Cooked/cooked_mesh.hpp"
+
+#include <DeepLib/context.hpp>
+#include <DeepLib/stream/file_stream.hpp>
+#include <DeepLib/image/png.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <unordered_set>
+
+namespace deep
+{
+    namespace
+    {
+        // Incrémenté quand le format de la base change : une base plus ancienne est ignorée.
+        constexpr uint32 database_version = 1;
+
+        const char *DATABASE_FILE = "asset_database.json";
+
+        constexpr uint64 prime_1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64 prime_2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64 prime_3 = 0x165667B19E3779F9ull;
+        constexpr uint64 prime_4 = 0x85EBCA77C2B2AE63ull;
+        constexpr uint64 prime_5 = 0x27D4EB2F165667C5ull;
+
+        uint64 rotate_left(uint64 value, int bits) noexcept
+        {
+            return (value << bits) | (value >> (64 - bits));
+        }
+
+        uint64 read_64(const uint8 *data) noexcept
+        {
+            uint64 value;
+            std::memcpy(&value, data, sizeof(value));
+
+            return value;
+        }
+
+        uint32 read_32(const uint8 *data) noexcept
+        {
+            uint32 value;
+            std::memcpy(&value, data, sizeof(value));
+
+            return value;
+        }
+
+        uint64 hash_round(uint64 accumulator, uint64 input) noexcept
+        {
+            accumulator += input * prime_2;
+            accumulator = rotate_left(accumulator, 31);
+
+            return accumulator * prime_1;
+        }
+
+        uint64 merge_round(uint64 accumulator, uint64 value) noexcept
+        {
+            accumulator ^= hash_round(0, value);
+
+            return accumulator * prime_1 + prime_4;
+        }
+
+        const char *get_type_name(asset_database::asset_type type) noexcept
+        {
+            return type == asset_database::asset_type::Texture ? "texture" : "model";
+        }
+
+        std::filesystem::path to_path(const std::string &relative) noexcept
+        {
+            return std::filesystem::u8path(relative);
+        }
+    } // namespace
+
+    bool asset_database::file_stamp::operator==(const file_stamp &other) const noexcept
+    {
+        return size == other.size && write_time == other.write_time;
+    }
+
+    asset_database::asset_database(const ref<ctx> &context, const std::filesystem::path &project_folder)
+            : m_context(context),
+              m_resources_folder(project_folder / "resources"),
+              m_imported_folder(project_folder / "imported")
+    {
+    }
+
+    void asset_database::load() noexcept
+    {
+        m_records.clear();
+
+        file_stream fs = file_stream(m_context, (m_imported_folder / DATABASE_FILE).c_str(), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
+
+        if (!fs.open())
+        {
+            return;
+        }
+
+        std::vector<char> content(fs.get_length());
+        usize bytes_read;
+
+        const bool read = fs.read(content.data(), content.size(), &bytes_read);
+        fs.close();
+
+        if (!read)
+        {
+            return;
+        }
+
+        content.resize(bytes_read);
+
+        const nlohmann::json database = nlohmann::json::parse(content, nullptr, false);
+
+        if (database.is_discarded() || !database.is_object() || database.value("version", 0u) != database_version || !database.contains("assets"))
+        {
+            return;
+        }
+
+        // Une entrée incomplète provoque simplement un nouvel import de sa source.
+        for (const auto &[source, entry] : database["assets"].items())
+        {
+            if (!entry.is_object())
+            {
+                continue;
+            }
+
+            record state           = {};
+            state.type             = entry.value("type", std::string()) == get_type_name(asset_type::Texture) ? asset_type::Texture : asset_type::Model;
+            state.stamp.size       = entry.value("size", uint64(0));
+            state.stamp.write_time = entry.value("write_time", int64(0));
+            state.hash             = entry.value("hash", uint64(0));
+            state.settings         = entry.value("settings", get_default_settings(state.type));
+            state.settings_hash    = entry.value("settings_hash", uint64(0));
+            state.importer_version = entry.value("importer_version", 0u);
+            state.imported         = entry.value("imported", false);
+
+            if (entry.contains("artifacts") && entry["artifacts"].is_array())
+            {
+                for (const nlohmann::json &artifact : entry["artifacts"])
+                {
+                    if (artifact.is_string())
+                    {
+                        state.artifacts.push_back(artifact.get<std::string>());
+                    }
+                }
+            }
+
+            if (entry.contains("dependencies") && entry["dependencies"].is_array())
+            {
+                for (const nlohmann::json &item : entry["dependencies"])
+                {
+                    if (!item.is_object())
+                    {
+                        continue;
+                    }
+
+                    dependency dep       = {};
+                    dep.path             = item.value("path", std::string());
+                    dep.stamp.size       = item.value("size", uint64(0));
+                    dep.stamp.write_time = item.value("write_time", int64(0));
+                    dep.hash             = item.value("hash", uint64(0));
+
+                    state.dependencies.push_back(std::move(dep));
+                }
+            }
+
+            m_records.emplace(source, std::move(state));
+        }
+    }
+
+    bool asset_database::save() const noexcept
+    {
+        nlohmann::json database;
+        database["version"] = database_version;
+        database["assets"]  = nlohmann::json::object();
+
+        for (const auto &[source, state] : m_records)
+        {
+            nlohmann::json entry;
+            entry["type"]             = get_type_name(state.type);
+            entry["size"]             = state.stamp.size;
+            entry["write_time"]       = state.stamp.write_time;
+            entry["hash"]             = state.hash;
+            entry["settings"]         = state.settings;
+            entry["settings_hash"]    = state.settings_hash;
+            entry["importer_version"] = state.importer_version;
+            entry["imported"]         = state.imported;
+            entry["artifacts"]        = state.artifacts;
+            entry["dependencies"]     = nlohmann::json::array();
+
+            for (const dependency &dep : state.dependencies)
+            {
+                entry["dependencies"].push_back({
+                    { "path", dep.path },
+                    { "size", dep.stamp.size },
+                    { "write_time", dep.stamp.write_time },
+                    { "hash", dep.hash }
+                });
+            }
+
+            database["assets"][source] = std::move(entry);
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(m_imported_folder, error);
+
+        file_stream fs = file_stream(m_context, (m_imported_folder / DATABASE_FILE).c_str(), core_fs::file_mode::Create, core_fs::file_access::Write, core_fs::file_share::Read);
+
+        if (!fs.open())
+        {
+            return false;
+        }
+
+        usize bytes_written;
+        const std::string database_dump = database.dump(4);
+
+        const bool written = fs.write(database_dump.c_str(), database_dump.size(), &bytes_written);
+        fs.close();
+
+        return written;
+    }
+
+    asset_database::refresh_statistics asset_database::refresh(uint32 thread_count) noexcept
+    {
+        refresh_statistics statistics = {};
+
+        std::vector<job> jobs;
+        std::unordered_set<std::string> seen;
+        std::error_code error;
+
+        // Première passe, sur le thread appelant : seules la taille et la date des fichiers sont consultées.
+        for (std::filesystem::recursive_directory_iterator it(m_resources_folder, std::filesystem::directory_options::skip_permission_denied, error), end;
+             !error && it != end;
+             it.increment(error))
+        {
+            asset_type type;
+
+            if (!it->is_regular_file(error) || !get_type(it->path(), type))
+            {
+                continue;
+            }
+
+            file_stamp stamp;
+
+            if (!get_stamp(it->path(), stamp))
+            {
+                continue;
+            }
+
+            std::string source = it->path().lexically_relative(m_resources_folder).generic_u8string();
+
+            statistics.scanned++;
+            seen.insert(source);
+
+            auto found = m_records.find(source);
+
+            if (found != m_records.end() && found->second.type == type && found->second.stamp == stamp && is_up_to_date(found->second))
+            {
+                continue;
+            }
+
+            job target = {};
+            target.source = std::move(source);
+
+            if (found != m_records.end() && found->second.type == type)
+            {
+                target.state = found->second;
+                target.force = !target.state.imported ||
+                               target.state.importer_version != get_importer_version(type) ||
+                               target.state.settings_hash != hash_settings(target.state.settings) ||
+                               !artifacts_exist(target.state);
+            }
+            else
+            {
+                target.state.type     = type;
+                target.state.settings = get_default_settings(type);
+                target.force          = true;
+            }
+
+            target.state.stamp = stamp;
+
+            jobs.push_back(std::move(target));
+        }
+
+        // Les sources supprimées emportent leurs fichiers préparés.
+        for (auto it = m_records.begin(); it != m_records.end();)
+        {
+            if (seen.count(it->first) != 0)
+            {
+                ++it;
+
+                continue;
+            }
+
+            for (const std::string &artifact : it->second.artifacts)
+            {
+                std::filesystem::remove(m_imported_folder / to_path(artifact), error);
+            }
+
+            statistics.removed++;
+            it = m_records.erase(it);
+        }
+
+        std::vector<model::cook_statistics> mesh_statistics(jobs.size());
+
+        if (!jobs.empty())
+        {
+            if (thread_count == 0)
+            {
+                thread_count = std::max(1u, static_cast<uint32>(std::thread::hardware_concurrency()));
+            }
+
+            D3D::thread_pool pool(std::min(thread_count, static_cast<uint32>(jobs.size())));
+
+            // Chaque thread prend la source suivante : un gros modèle n'immobilise qu'un seul cœur.
+            pool.parallel_for(static_cast<uint32>(jobs.size()), [this, &jobs, &mesh_statistics](uint32 index, uint32 /*worker*/) {
+                process(jobs[index], mesh_statistics[index]);
+            });
+        }
+
+        usize index;
+
+        for (index = 0; index < jobs.size(); ++index)
+        {
+            job &target = jobs[index];
+
+            if (target.hashed)
+            {
+                statistics.hashed++;
+            }
+
+            if (target.imported)
+            {
+                statistics.imported++;
+
+                m_context->out() << "Imported '" << target.source.c_str() << "'.\r\n";
+
+                if (target.state.type == asset_type::Model)
+                {
+                    model::loader::print_statistics(m_context, target.source.c_str(), mesh_statistics[index]);
+                }
+            }
+
+            if (target.failed)
+            {
+                statistics.failed++;
+
+                m_context->err() << "[ERROR] Cannot import '" << target.source.c_str() << "'.\r\n";
+            }
+
+            m_records[target.source] = std::move(target.state);
+        }
+
+        return statistics;
+    }
+
+    std::filesystem::path asset_database::get_artifact(const std::string &source) const noexcept
+    {
+        auto found = m_records.find(source);
+
+        if (found == m_records.end() || !found->second.imported || found->second.artifacts.empty())
+        {
+            return std::filesystem::path();
+        }
+
+        return m_imported_folder / to_path(found->second.artifacts.front());
+    }
+
+    uint64 asset_database::hash(const void *data, usize size, uint64 seed) noexcept
+    {
+        // XXH64 : quatre accumulateurs indépendants traitent 32 octets par tour, bien plus vite qu'un hash octet par octet.
+        const uint8 *input = static_cast<const uint8 *>(data);
+        const uint8 *end   = input + size;
+        uint64 result;
+
+        if (size >= 32)
+        {
+            uint64 v1 = seed + prime_1 + prime_2;
+            uint64 v2 = seed + prime_2;
+            uint64 v3 = seed;
+            uint64 v4 = seed - prime_1;
+
+            const uint8 *limit = end - 32;
+
+            do
+            {
+                v1 = hash_round(v1, read_64(input));
+                v2 = hash_round(v2, read_64(input + 8));
+                v3 = hash_round(v3, read_64(input + 16));
+                v4 = hash_round(v4, read_64(input + 24));
+
+                input += 32;
+            } while (input <= limit);
+
+            result = rotate_left(v1, 1) + rotate_left(v2, 7) + rotate_left(v3, 12) + rotate_left(v4, 18);
+            result = merge_round(result, v1);
+            result = merge_round(result, v2);
+            result = merge_round(result, v3);
+            result = merge_round(result, v4);
+        }
+        else
+        {
+            result = seed + prime_5;
+        }
+
+        result += static_cast<uint64>(size);
+
+        while (input + 8 <= end)
+        {
+            result ^= hash_round(0, read_64(input));
+            result = rotate_left(result, 27) * prime_1 + prime_4;
+
+            input += 8;
+        }
+
+        if (input + 4 <= end)
+        {
+            result ^= static_cast<uint64>(read_32(input)) * prime_1;
+            result = rotate_left(result, 23) * prime_2 + prime_3;
+
+            input += 4;
+        }
+
+        while (input < end)
+        {
+            result ^= static_cast<uint64>(*input) * prime_5;
+            result = rotate_left(result, 11) * prime_1;
+
+            input++;
+        }
+
+        result ^= result >> 33;
+        result *= prime_2;
+        result ^= result >> 29;
+        result *= prime_3;
+        result ^= result >> 32;
+
+        return result;
+    }
+
+    uint64 asset_database::hash_settings(const nlohmann::json &settings) noexcept
+    {
+        const std::string settings_dump = settings.dump();
+
+        return hash(settings_dump.data(), settings_dump.size());
+    }
+
+    bool asset_database::get_type(const std::filesystem::path &path, asset_type &type) noexcept
+    {
+        std::string extension = path.extension().u8string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+
+        if (extension == ".png")
+        {
+            type = asset_type::Texture;
+
+            return true;
+        }
+
+        const char *model_extensions[] = { ".obj", ".fbx", ".gltf", ".glb", ".dae", ".3ds", ".ply", ".stl" };
+
+        for (const char *model_extension : model_extensions)
+        {
+            if (extension == model_extension)
+            {
+                type = asset_type::Model;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    nlohmann::json asset_database::get_default_settings(asset_type type) noexcept
+    {
+        switch (type)
+        {
+            case asset_type::Texture:
+            {
+                return { { "format", "bc7" } };
+            }
+            case asset_type::Model:
+            {
+                return { { "vertex_compression", "none" } };
+            }
+        }
+
+        return nlohmann::json::object();
+    }
+
+    uint32 asset_database::get_importer_version(asset_type type) noexcept
+    {
+        // Un changement de format des fichiers préparés invalide les imports précédents.
+        return type == asset_type::Texture ? D3D::texture_cooker::version : model::cooked_mesh_version;
+    }
+
+    bool asset_database::get_stamp(const std::filesystem::path &path, file_stamp &stamp) noexcept
+    {
+        std::error_code error;
+
+        const uintmax_t size                          = std::filesystem::file_size(path, error);
+        const std::filesystem::file_time_type written = error ? std::filesystem::file_time_type() : std::filesystem::last_write_time(path, error);
+
+        if (error)
+        {
+            return false;
+        }
+
+        stamp.size       = static_cast<uint64>(size);
+        stamp.write_time = static_cast<int64>(written.time_since_epoch().count());
+
+        return true;
+    }
+
+    bool asset_database::hash_file(const std::filesystem::path &path, uint64 &hash_value) noexcept
+    {
+        std::error_code error;
+
+        if (std::filesystem::file_size(path, error) == 0)
+        {
+            hash_value = hash(nullptr, 0);
+
+            return !error;
+        }
+
+        // La projection évite de copier le fichier : seules ses pages sont lues, une fois.
+        mapped_file file;
+
+        if (!file.open(path))
+        {
+            return false;
+        }
+
+        hash_value = hash(file.get_data(), file.get_size());
+
+        return true;
+    }
+
+    bool asset_database::is_up_to_date(const record &state) const noexcept
+    {
+        if (!state.imported || state.importer_version != get_importer_version(state.type) || state.settings_hash != hash_settings(state.settings) || !artifacts_exist(state))
+        {
+            return false;
+        }
+
+        for (const dependency &dep : state.dependencies)
+        {
+            file_stamp stamp;
+
+            if (!get_stamp(m_resources_folder / to_path(dep.path), stamp) || !(stamp == dep.stamp))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool asset_database::artifacts_exist(const record &state) const noexcept
+    {
+        std::error_code error;
+
+        for (const std::string &artifact : state.artifacts)
+        {
+            if (!std::filesystem::exists(m_imported_folder / to_path(artifact), error))
+            {
+                return false;
+            }
+        }
+
+        return !state.artifacts.empty();
+    }
+
+    void asset_database::process(job &target, model::cook_statistics &statistics) const noexcept
+    {
+        uint64 content_hash;
+
+        if (!hash_file(m_resources_folder / to_path(target.source), content_hash))
+        {
+            target.state.imported = false;
+            target.failed         = true;
+
+            return;
+        }
+
+        target.hashed = true;
+
+        bool changed = target.force || content_hash != target.state.hash;
+
+        // Une dépendance dont seule la date a changé est relue : son contenu peut être identique.
+        for (dependency &dep : target.state.dependencies)
+        {
+            if (changed)
+            {
+                break;
+            }
+
+            const std::filesystem::path path = m_resources_folder / to_path(dep.path);
+            file_stamp stamp;
+            uint64 dependency_hash;
+
+            if (get_stamp(path, stamp) && stamp == dep.stamp)
+            {
+                continue;
+            }
+
+            if (!get_stamp(path, stamp) || !hash_file(path, dependency_hash) || dependency_hash != dep.hash)
+            {
+                changed = true;
+
+                break;
+            }
+
+            dep.stamp = stamp;
+        }
+
+        target.state.hash = content_hash;
+
+        if (!changed)
+        {
+            return;
+        }
+
+        target.imported = import(target.source, target.state, statistics);
+        target.failed   = !target.imported;
+    }
+
+    bool asset_database::import(const std::string &source, record &state, model::cook_statistics &statistics) const noexcept
+    {
+        const std::string artifact              = source + (state.type == asset_type::Texture ? ".dtex" : ".dmsh");
+        const std::filesystem::path source_path = m_resources_folder / to_path(source);
+        std::filesystem::path artifact_path     = m_imported_folder / to_path(artifact);
+        std::filesystem::path temporary_path    = artifact_path;
+        std::error_code error;
+
+        temporary_path += ".tmp";
+
+        std::filesystem::create_directories(artifact_path.parent_path(), error);
+
+        // Le fichier est écrit à côté puis renommé : un import interrompu ne laisse pas de fichier préparé tronqué.
+        bool imported = state.type == asset_type::Texture ? import_texture(source_path, temporary_path, state.settings)
+                                                          : import_model(source_path, temporary_path, state.settings, statistics);
+
+        if (imported)
+        {
+            std::filesystem::rename(temporary_path, artifact_path, error);
+            imported = !error;
+        }
+
+        if (!imported)
+        {
+            std::filesystem::remove(temporary_path, error);
+            state.imported = false;
+
+            return false;
+        }
+
+        for (const std::string &previous : state.artifacts)
+        {
+            if (previous != artifact)
+            {
+                std::filesystem::remove(m_imported_folder / to_path(previous), error);
+            }
+        }
+
+        state.artifacts        = { artifact };
+        state.settings_hash    = hash_settings(state.settings);
+        state.importer_version = get_importer_version(state.type);
+        state.imported         = true;
+
+        find_dependencies(source, state);
+
+        return true;
+    }
+
+    bool asset_database::import_texture(const std::filesystem::path &source, const std::filesystem::path &artifact, const nlohmann::json &settings) const noexcept
+    {
+        D3D::texture_format format = D3D::texture_format::BC7;
+
+        if (settings.contains("format") && settings["format"].is_string() &&
+            !D3D::texture_cooker::parse_format(settings["format"].get<std::string>().c_str(), format))
+        {
+            return false;
+        }
+
+        file_stream input = file_stream(m_context, source.c_str(), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
+
+        if (!input.open())
+        {
+            return false;
+        }
+
+        png png_source = png::load(m_context, &input);
+
+        if (!png_source.is_valid() || !png_source.check() || !png_source.read_info())
+        {
+            input.close();
+
+            return false;
+        }
+
+        image img = png_source.read_image(image::color_space::RGBA);
+
+        input.close();
+
+        if (!img.is_valid())
+        {
+            return false;
+        }
+
+        file_stream output = file_stream(m_context, artifact.c_str(), core_fs::file_mode::Create, core_fs::file_access::Write, core_fs::file_share::Read);
+
+        const bool written = output.open() && D3D::texture_cooker::cook(img, format, &output);
+
+        output.close();
+
+        return written;
+    }
+
+    bool asset_database::import_model(const std::filesystem::path &source, const std::filesystem::path &artifact, const nlohmann::json &settings, model::cook_statistics &statistics) const noexcept
+    {
+        D3D::vertex_compression compression = D3D::vertex_compression::None;
+
+        if (settings.value("vertex_compression", std::string("none")) == "quantized")
+        {
+            compression = D3D::vertex_compression::Quantized;
+        }
+
+        file_stream output = file_stream(m_context, artifact.c_str(), core_fs::file_mode::Create, core_fs::file_access::Write, core_fs::file_share::Read);
+
+        // Assimp attend des chemins en UTF-8.
+        const bool written = output.open() && model::loader::cook(m_context, source.u8string().c_str(), &output, compression, &statistics);
+
+        output.close();
+
+        return written;
+    }
+
+    void asset_database::find_dependencies(const std::string &source, record &state) const noexcept
+    {
+        state.dependencies.clear();
+
+        const std::filesystem::path source_path = to_path(source);
+        std::string extension                   = source_path.extension().u8string();
+
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+
+        // Seuls les buffers externes d'un fichier glTF contiennent des sommets : les matériaux ne sont pas importés.
+        if (extension != ".gltf")
+        {
+            return;
+        }
+
+        file_stream fs = file_stream(m_context, (m_resources_folder / source_path).c_str(), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
+
+        if (!fs.open())
+        {
+            return;
+        }
+
+        std::vector<char> content(fs.get_length());
+        usize bytes_read;
+
+        const bool read = fs.read(content.data(), content.size(), &bytes_read);
+        fs.close();
+
+        if (!read)
+        {
+            return;
+        }
+
+        content.resize(bytes_read);
+
+        const nlohmann::json document = nlohmann::json::parse(content, nullptr, false);
+
+        if (document.is_discarded() || !document.contains("buffers") || !document["buffers"].is_array())
+        {
+            return;
+        }
+
+        for (const nlohmann::json &buffer : document["buffers"])
+        {
+            if (!buffer.is_object() || !buffer.contains("uri") || !buffer["uri"].is_string())
+            {
+                continue;
+            }
+
+            const std::string uri = buffer["uri"].get<std::string>();
+
+            // Les données intégrées au fichier sont déjà couvertes par son hash.
+            if (uri.compare(0, 5, "data:") == 0)
+            {
+                continue;
+            }
+
+            dependency dep = {};
+            dep.path       = (source_path.parent_path() / to_path(uri)).lexically_normal().generic_u8string();
+
+            const std::filesystem::path path = m_resources_folder / to_path(dep.path);
+
+            if (get_stamp(path, dep.stamp) && hash_file(path, dep.hash))
+            {
+                state.dependencies.push_back(std::move(dep));
+            }
+        }
+    }
+} // namespace deep
@@ -0,0 +1,170 @@
+#ifndef DEEP_ENGINE_ASSET_DATABASE_HPP
+#define DEEP_ENGINE_ASSET_DATABASE_HPP
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/memory/ref_counted.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace deep
+{
+    namespace model
+    {
+        struct cook_statistics;
+    } // namespace model
+
+    /**
+     * @brief Suit les fichiers sources du dossier 'resources' d'un projet et les fichiers préparés qui en sont issus.
+     *
+     * Pour chaque source, la base enregistre son empreinte (taille, date de modification et hash du contenu), ses
+     * paramètres d'import, les fichiers produits dans le dossier 'imported' et les fichiers dont elle dépend.
+     * refresh ne prépare de nouveau que les sources modifiées, en répartissant les imports sur tous les cœurs :
+     * seules les sources dont la taille ou la date a changé sont relues, et seules celles dont le contenu, les
+     * paramètres ou les dépendances ont changé sont importées.
+     *
+     * La base est enregistrée dans 'imported/asset_database.json', que l'on peut modifier pour changer les
+     * paramètres d'import d'une source.
+     *
+     * La classe n'est pas exportée et n'est utilisée que de manière interne, à travers un pointeur.
+     */
+    class asset_database
+    {
+      public:
+        enum class asset_type
+        {
+            Texture,
+            Model
+        };
+
+        struct refresh_statistics
+        {
+            // Sources trouvées dans le dossier des ressources.
+            uint32 scanned;
+
+            // Sources relues pour calculer le hash de leur contenu.
+            uint32 hashed;
+
+            uint32 imported;
+            uint32 failed;
+
+            // Sources supprimées, dont les fichiers préparés ont été retirés.
+            uint32 removed;
+        };
+
+      public:
+        /**
+         * @param project_folder Le dossier du projet, qui contient le dossier 'resources'.
+         */
+        asset_database(const ref<ctx> &context, const std::filesystem::path &project_folder);
+
+        asset_database(const asset_database &)            = delete;
+        asset_database &operator=(const asset_database &) = delete;
+
+        /**
+         * @brief Lit la base enregistrée. Une base absente ou illisible est considérée comme vide.
+         */
+        void load() noexcept;
+        bool save() const noexcept;
+
+        /**
+         * @brief Compare le dossier des ressources à la base et importe ce qui a changé.
+         * @param thread_count Le nombre de threads d'import. 0 pour tous les cœurs.
+         */
+        refresh_statistics refresh(uint32 thread_count = 0) noexcept;
+
+        /**
+         * @return Le premier fichier préparé d'une source, chemin relatif au dossier des ressources, ou un chemin vide.
+         */
+        std::filesystem::path get_artifact(const std::string &source) const noexcept;
+
+        static uint64 hash(const void *data, usize size, uint64 seed = 0) noexcept;
+        static uint64 hash_settings(const nlohmann::json &settings) noexcept;
+
+      private:
+        /**
+         * @brief Taille et date de modification d'un fichier, comparées avant de relire son contenu.
+         */
+        struct file_stamp
+        {
+            uint64 size;
+            int64 write_time;
+
+            bool operator==(const file_stamp &other) const noexcept;
+        };
+
+        struct dependency
+        {
+            std::string path;
+            file_stamp stamp;
+            uint64 hash;
+        };
+
+        struct record
+        {
+            asset_type type;
+            file_stamp stamp;
+            uint64 hash;
+
+            // Paramètres d'import, et hash de ceux utilisés lors du dernier import réussi.
+            nlohmann::json settings;
+            uint64 settings_hash;
+            uint32 importer_version;
+
+            // Chemins relatifs au dossier 'imported'.
+            std::vector<std::string> artifacts;
+            std::vector<dependency> dependencies;
+
+            bool imported;
+        };
+
+        /**
+         * @brief Source à relire ou à importer, traitée par un thread d'import.
+         */
+        struct job
+        {
+            std::string source;
+            record state;
+
+            // La source n'a pas été vue depuis le dernier import ou ses fichiers produits manquent.
+            bool force;
+
+            bool hashed;
+            bool imported;
+            bool failed;
+        };
+
+      private:
+        static bool get_type(const std::filesystem::path &path, asset_type &type) noexcept;
+        static nlohmann::json get_default_settings(asset_type type) noexcept;
+        static uint32 get_importer_version(asset_type type) noexcept;
+
+        static bool get_stamp(const std::filesystem::path &path, file_stamp &stamp) noexcept;
+        static bool hash_file(const std::filesystem::path &path, uint64 &hash) noexcept;
+
+        bool is_up_to_date(const record &state) const noexcept;
+        bool artifacts_exist(const record &state) const noexcept;
+
+        // Appelées depuis un thread d'import. Les statistiques d'un modèle sont affichées une fois tous les imports terminés.
+        void process(job &target, model::cook_statistics &statistics) const noexcept;
+        bool import(const std::string &source, record &state, model::cook_statistics &statistics) const noexcept;
+        bool import_texture(const std::filesystem::path &source, const std::filesystem::path &artifact, const nlohmann::json &settings) const noexcept;
+        bool import_model(const std::filesystem::path &source, const std::filesystem::path &artifact, const nlohmann::json &settings, model::cook_statistics &statistics) const noexcept;
+        void find_dependencies(const std::string &source, record &state) const noexcept;
+
+      private:
+        ref<ctx> m_context;
+
+        std::filesystem::path m_resources_folder;
+        std::filesystem::path m_imported_folder;
+
+        // Indexé par le chemin de la source relatif au dossier des ressources, avec des '/'.
+        std::unordered_map<std::string, record> m_records;
+    };
+} // namespace deep
+
+#endif
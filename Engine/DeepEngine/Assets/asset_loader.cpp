@@ -0,0 +1,387 @@
+#include "asset_loader.hpp"
+#include "D3D/resource_factory.hpp"
+#include "D3D/shader/shader_factory.hpp"
+#include "D3D/shader/shader_cache.hpp"
+
+#include <DeepLib/context.hpp>
+#include <DeepLib/stream/file_stream.hpp>
+#include <DeepLib/image/png.hpp>
+
+#include <algorithm>
+#include <filesystem>
+
+namespace deep
+{
+    asset_loader::asset_kind asset_loader::asset::get_kind() const noexcept
+    {
+        return m_kind;
+    }
+
+    asset_loader::asset_state asset_loader::asset::get_state() const noexcept
+    {
+        return m_state.load(std::memory_order_acquire);
+    }
+
+    const std::basic_string<native_char> &asset_loader::asset::get_path() const noexcept
+    {
+        return m_path;
+    }
+
+    bool asset_loader::asset::is_done() const noexcept
+    {
+        const asset_state state = get_state();
+
+        return state == asset_state::Ready || state == asset_state::Failed;
+    }
+
+    const ref<D3D::vertex_shader> &asset_loader::asset::get_vertex_shader() const noexcept
+    {
+        return m_vertex_shader;
+    }
+
+    const ref<D3D::pixel_shader> &asset_loader::asset::get_pixel_shader() const noexcept
+    {
+        return m_pixel_shader;
+    }
+
+    const ref<D3D::texture> &asset_loader::asset::get_texture() const noexcept
+    {
+        return m_texture;
+    }
+
+    asset_loader::asset_loader(const ref<ctx> &context, uint32 thread_count)
+            : m_context(context),
+              m_pending(0),
+              m_stopping(false)
+    {
+        if (thread_count == 0)
+        {
+            // Le thread de rendu garde un cœur pour lui.
+            thread_count = std::max(1u, static_cast<uint32>(std::thread::hardware_concurrency()) - 1);
+        }
+
+        uint32 index;
+
+        for (index = 0; index < thread_count; ++index)
+        {
+            m_workers.emplace_back(&asset_loader::worker_main, this);
+        }
+    }
+
+    asset_loader::~asset_loader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_stopping = true;
+        }
+
+        m_queue_condition.notify_all();
+
+        for (std::thread &worker : m_workers)
+        {
+            worker.join();
+        }
+
+        // Les images chargées que le thread de rendu n'a pas reprises gardent encore leurs mipmaps.
+        for (const handle &target : m_loaded)
+        {
+            D3D::resource_factory::release_mips(m_context, target->m_mips);
+        }
+    }
+
+    bool asset_loader::mount(const std::filesystem::path &pack_path)
+    {
+        return m_pack.open(pack_path);
+    }
+
+    asset_loader::handle asset_loader::load_vertex_shader(const native_char *path, const D3D::input_element_desc *ied, uint32 ied_count, callback on_ready)
+    {
+        auto found = m_assets.find(path);
+
+        if (found == m_assets.end())
+        {
+            handle target = std::make_shared<asset>();
+            target->m_ied.assign(ied, ied + ied_count);
+
+            for (const D3D::input_element_desc &element : target->m_ied)
+            {
+                target->m_semantic_names.emplace_back(element.semantic_name);
+            }
+
+            // Les noms pointent vers les copies, conservées aussi longtemps que la ressource.
+            uint32 index;
+
+            for (index = 0; index < ied_count; ++index)
+            {
+                target->m_ied[index].semantic_name = target->m_semantic_names[index].c_str();
+            }
+
+            m_assets.emplace(path, target);
+        }
+
+        return request(asset_kind::VertexShader, path, std::move(on_ready));
+    }
+
+    asset_loader::handle asset_loader::load_pixel_shader(const native_char *path, callback on_ready)
+    {
+        return request(asset_kind::PixelShader, path, std::move(on_ready));
+    }
+
+    asset_loader::handle asset_loader::load_texture(const native_char *path, callback on_ready)
+    {
+        return request(asset_kind::Texture, path, std::move(on_ready));
+    }
+
+    uint32 asset_loader::process(D3D::renderer &renderer, uint32 max_count)
+    {
+        std::vector<handle> loaded;
+
+        {
+            std::lock_guard<std::mutex> lock(m_loaded_mutex);
+
+            if (max_count == 0 || m_loaded.size() <= max_count)
+            {
+                loaded.swap(m_loaded);
+            }
+            else
+            {
+                loaded.assign(m_loaded.begin(), m_loaded.begin() + max_count);
+                m_loaded.erase(m_loaded.begin(), m_loaded.begin() + max_count);
+            }
+        }
+
+        for (const handle &target : loaded)
+        {
+            create(*target, renderer);
+
+            m_pending--;
+
+            // Les callbacks peuvent demander d'autres ressources : la liste est vidée avant de les appeler.
+            std::vector<callback> callbacks;
+            callbacks.swap(target->m_callbacks);
+
+            for (const callback &on_ready : callbacks)
+            {
+                on_ready(*target);
+            }
+        }
+
+        return static_cast<uint32>(loaded.size());
+    }
+
+    bool asset_loader::wait(const handle &target, D3D::renderer &renderer)
+    {
+        while (!target->is_done())
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_loaded_mutex);
+                m_loaded_condition.wait(lock, [this] { return !m_loaded.empty(); });
+            }
+
+            process(renderer);
+        }
+
+        return target->get_state() == asset_state::Ready;
+    }
+
+    uint32 asset_loader::get_pending_count() const noexcept
+    {
+        return m_pending;
+    }
+
+    uint32 asset_loader::get_thread_count() const noexcept
+    {
+        return static_cast<uint32>(m_workers.size());
+    }
+
+    asset_loader::handle asset_loader::request(asset_kind kind, const native_char *path, callback on_ready)
+    {
+        auto found = m_assets.find(path);
+        handle target;
+
+        if (found != m_assets.end())
+        {
+            target = found->second;
+        }
+        else
+        {
+            target = std::make_shared<asset>();
+            m_assets.emplace(path, target);
+        }
+
+        // Une ressource déjà terminée appelle immédiatement son callback.
+        if (target->is_done())
+        {
+            if (on_ready)
+            {
+                on_ready(*target);
+            }
+
+            return target;
+        }
+
+        if (on_ready)
+        {
+            target->m_callbacks.push_back(std::move(on_ready));
+        }
+
+        if (!target->m_path.empty())
+        {
+            return target;
+        }
+
+        target->m_kind   = kind;
+        target->m_path   = path;
+        target->m_cooked = kind == asset_kind::Texture && std::filesystem::path(path).extension() == ".dtex";
+
+        m_pending++;
+
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_queue.push_back(target);
+        }
+
+        m_queue_condition.notify_one();
+
+        return target;
+    }
+
+    void asset_loader::worker_main()
+    {
+        for (;;)
+        {
+            handle target;
+
+            {
+                std::unique_lock<std::mutex> lock(m_queue_mutex);
+                m_queue_condition.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+
+                if (m_stopping)
+                {
+                    return;
+                }
+
+                target = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            target->m_state.store(asset_state::Loading, std::memory_order_release);
+
+            load(*target);
+
+            {
+                std::lock_guard<std::mutex> lock(m_loaded_mutex);
+                m_loaded.push_back(std::move(target));
+            }
+
+            m_loaded_condition.notify_one();
+        }
+    }
+
+    void asset_loader::load(asset &target)
+    {
+        file_stream fs = file_stream(m_context, target.m_path.c_str(), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
+        pack_stream packed = pack_stream(m_context);
+
+        bool loaded   = false;
+        stream *input = nullptr;
+
+        // L'archive montée est consultée avant le disque : ses entrées ne coûtent aucune ouverture de fichier.
+        if (m_pack.is_open() && m_pack.open_stream(std::filesystem::path(target.m_path).lexically_normal().generic_u8string(), packed))
+        {
+            input = &packed;
+        }
+        else if (fs.open())
+        {
+            input = &fs;
+        }
+
+        if (input != nullptr)
+        {
+            // Les shaders et les textures préparées sont envoyés tels quels : seules les images PNG sont décodées.
+            if (target.m_kind == asset_kind::Texture && !target.m_cooked)
+            {
+                png source = png::load(m_context, input);
+
+                if (source.is_valid() && source.check() && source.read_info())
+                {
+                    target.m_image.emplace(source.read_image(image::color_space::RGBA));
+
+                    // Les threads de chargement travaillent déjà en parallèle : chacun calcule ses mipmaps seul.
+                    if (target.m_image->is_valid())
+                    {
+                        target.m_mips = D3D::resource_factory::build_mips(m_context, *target.m_image);
+                        loaded        = target.m_mips != nullptr;
+                    }
+                }
+            }
+            else
+            {
+                usize bytes_read;
+
+                target.m_bytes.resize(input->get_length());
+                loaded = input->read(target.m_bytes.data(), target.m_bytes.size(), &bytes_read);
+                target.m_bytes.resize(bytes_read);
+            }
+
+            input->close();
+        }
+
+        // L'échec n'est signalé que par le thread de rendu, avec les autres ressources terminées.
+        target.m_read = loaded;
+        target.m_state.store(asset_state::Loaded, std::memory_order_release);
+    }
+
+    void asset_loader::create(asset &target, D3D::renderer &renderer)
+    {
+        target.m_state.store(asset_state::Failed, std::memory_order_release);
+
+        if (target.m_read)
+        {
+            D3D::device_handle device = renderer.get_device();
+            D3D::shader_cache *cache  = renderer.get_shader_cache();
+
+            switch (target.m_kind)
+            {
+                case asset_kind::VertexShader:
+                {
+                    target.m_vertex_shader = cache->get_vertex_shader(m_context, target.m_bytes.data(), target.m_bytes.size(), target.m_ied.data(), static_cast<uint32>(target.m_ied.size()), device);
+                }
+                break;
+                case asset_kind::PixelShader:
+                {
+                    target.m_pixel_shader = cache->get_pixel_shader(m_context, target.m_bytes.data(), target.m_bytes.size(), device);
+                }
+                break;
+                case asset_kind::Texture:
+                {
+                    if (target.m_cooked)
+                    {
+                        target.m_texture = D3D::resource_factory::create_texture(m_context, target.m_bytes.data(), target.m_bytes.size(), device);
+                    }
+                    else
+                    {
+                        target.m_texture = D3D::resource_factory::create_texture(m_context, *target.m_image, target.m_mips, device);
+                    }
+                }
+                break;
+            }
+
+            const bool created = target.m_vertex_shader.is_valid() || target.m_pixel_shader.is_valid() || target.m_texture.is_valid();
+
+            target.m_state.store(created ? asset_state::Ready : asset_state::Failed, std::memory_order_release);
+        }
+
+        if (target.get_state() == asset_state::Failed)
+        {
+            m_context->err() << DEEP_TEXT_UTF8("[ERROR] Cannot load '") << std::filesystem::path(target.m_path).u8string().c_str() << DEEP_TEXT_UTF8("'.\r\n");
+        }
+
+        target.m_bytes.clear();
+        target.m_bytes.shrink_to_fit();
+        target.m_image.reset();
+
+        D3D::resource_factory::release_mips(m_context, target.m_mips);
+        target.m_mips = nullptr;
+    }
+} // namespace deep
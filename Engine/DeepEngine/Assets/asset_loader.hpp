@@ -0,0 +1,213 @@
+#ifndef DEEP_ENGINE_ASSET_LOADER_HPP
+#define DEEP_ENGINE_ASSET_LOADER_HPP
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/memory/ref_counted.hpp>
+#include <DeepLib/image/image.hpp>
+
+#include "D3D/renderer.hpp"
+#include "D3D/shader/vertex_shader.hpp"
+#include "D3D/shader/pixel_shader.hpp"
+#include "D3D/texture.hpp"
+#include "D3D/shader/input_layout.hpp"
+#include "DeepEngine/Assets/pack_file.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        class mip_chain;
+    } // namespace D3D
+
+    /**
+     * @brief Charge les shaders et les textures en arrière-plan.
+     *
+     * Les fichiers sont lus et les images décodées par des threads de chargement. Les données prêtes côté CPU sont
+     * ensuite remises au thread de rendu, qui crée les objets Direct3D dans process, appelée une fois par image.
+     * Les chargements du démarrage se recouvrent ainsi entre eux et avec la création de la fenêtre, et ceux
+     * demandés en cours de jeu ne bloquent pas la boucle.
+     *
+     * Chaque fichier n'est chargé qu'une fois : une nouvelle demande pour le même chemin renvoie la même ressource.
+     * Les méthodes publiques doivent être appelées depuis le thread de rendu.
+     *
+     * La classe n'est pas exportée et n'est utilisée que de manière interne, à travers un pointeur.
+     */
+    class asset_loader
+    {
+      public:
+        enum class asset_kind
+        {
+            VertexShader,
+            PixelShader,
+            Texture
+        };
+
+        enum class asset_state
+        {
+            // En attente d'un thread de chargement.
+            Queued,
+
+            // Lecture et décodage en cours.
+            Loading,
+
+            // Données prêtes côté CPU, en attente du thread de rendu.
+            Loaded,
+
+            Ready,
+            Failed
+        };
+
+        class asset;
+
+        using handle   = std::shared_ptr<asset>;
+        using callback = std::function<void(const asset &)>;
+
+        /**
+         * @brief Ressource demandée au chargeur, consultable pendant et après son chargement.
+         */
+        class asset
+        {
+          public:
+            asset_kind get_kind() const noexcept;
+            asset_state get_state() const noexcept;
+            const std::basic_string<native_char> &get_path() const noexcept;
+
+            /**
+             * @return true si la ressource est prête ou si son chargement a échoué.
+             */
+            bool is_done() const noexcept;
+
+            /**
+             * @brief Ressources créées, valides une fois l'état Ready atteint.
+             */
+            const ref<D3D::vertex_shader> &get_vertex_shader() const noexcept;
+            const ref<D3D::pixel_shader> &get_pixel_shader() const noexcept;
+            const ref<D3D::texture> &get_texture() const noexcept;
+
+          private:
+            asset_kind m_kind;
+            std::basic_string<native_char> m_path;
+            std::atomic<asset_state> m_state { asset_state::Queued };
+
+            // Copie de l'input layout d'un vertex shader, noms de sémantique compris.
+            std::vector<D3D::input_element_desc> m_ied;
+            std::vector<std::string> m_semantic_names;
+
+            // Données lues par le thread de chargement, libérées une fois les objets Direct3D créés.
+            std::vector<uint8> m_bytes;
+            std::optional<image> m_image;
+
+            // Mipmaps de l'image, calculés par le thread de chargement pour ne laisser que l'envoi au thread de rendu.
+            D3D::mip_chain *m_mips = nullptr;
+            bool m_cooked = false;
+            bool m_read   = false;
+
+            ref<D3D::vertex_shader> m_vertex_shader;
+            ref<D3D::pixel_shader> m_pixel_shader;
+            ref<D3D::texture> m_texture;
+
+            // Appelés par le thread de rendu à la fin du chargement.
+            std::vector<callback> m_callbacks;
+
+          public:
+            friend class asset_loader;
+        };
+
+      public:
+        /**
+         * @param thread_count Le nombre de threads de chargement. 0 pour tous les cœurs sauf celui du thread de rendu.
+         */
+        explicit asset_loader(const ref<ctx> &context, uint32 thread_count = 0);
+        ~asset_loader();
+
+        asset_loader(const asset_loader &)            = delete;
+        asset_loader &operator=(const asset_loader &) = delete;
+
+        /**
+         * @brief Monte une archive écrite par pack_builder::build, dont les entrées remplacent les fichiers de même chemin.
+         *
+         * Les chemins demandés sont cherchés dans l'archive tels quels, avec des '/' : 'cube_vs.cso' ou
+         * 'Resources/Textures/icon.png'. Ceux qu'elle ne contient pas sont lus sur le disque. L'archive doit être
+         * montée avant les premières demandes.
+         * @return false si l'archive n'existe pas ou n'est pas valide.
+         */
+        bool mount(const std::filesystem::path &pack_path);
+
+        /**
+         * @brief Demande le chargement d'un fichier '.cso'.
+         * @param on_ready Appelée par process une fois le chargement terminé, réussi ou non.
+         */
+        handle load_vertex_shader(const native_char *path, const D3D::input_element_desc *ied, uint32 ied_count, callback on_ready = nullptr);
+        handle load_pixel_shader(const native_char *path, callback on_ready = nullptr);
+
+        /**
+         * @brief Demande le chargement d'une image PNG, ou d'une texture préparée si son extension est '.dtex'.
+         */
+        handle load_texture(const native_char *path, callback on_ready = nullptr);
+
+        /**
+         * @brief Crée les objets Direct3D des ressources chargées depuis le dernier appel puis appelle leurs callbacks.
+         * @param max_count Le nombre maximal de ressources à terminer, 0 pour toutes.
+         * @return Le nombre de ressources terminées.
+         */
+        uint32 process(D3D::renderer &renderer, uint32 max_count = 0);
+
+        /**
+         * @brief Attend la fin du chargement d'une ressource, en terminant au passage les autres.
+         * @return true si la ressource est prête.
+         */
+        bool wait(const handle &target, D3D::renderer &renderer);
+
+        /**
+         * @return Le nombre de ressources demandées qui ne sont pas encore terminées.
+         */
+        uint32 get_pending_count() const noexcept;
+        uint32 get_thread_count() const noexcept;
+
+      private:
+        handle request(asset_kind kind, const native_char *path, callback on_ready);
+
+        void worker_main();
+
+        // Appelée depuis un thread de chargement.
+        void load(asset &target);
+
+        // Appelée depuis le thread de rendu.
+        void create(asset &target, D3D::renderer &renderer);
+
+      private:
+        ref<ctx> m_context;
+
+        // Lue par les threads de chargement, qui ne la modifient pas.
+        pack_file m_pack;
+
+        std::unordered_map<std::basic_string<native_char>, handle> m_assets;
+        uint32 m_pending;
+
+        std::mutex m_queue_mutex;
+        std::condition_variable m_queue_condition;
+        std::deque<handle> m_queue;
+        bool m_stopping;
+
+        std::mutex m_loaded_mutex;
+        std::condition_variable m_loaded_condition;
+        std::vector<handle> m_loaded;
+
+        std::vector<std::thread> m_workers;
+    };
+} // namespace deep
+
+#endif
@@ -0,0 +1,166 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace deep
+{
+#ifdef _WIN32
+    mapped_file::mapped_file() noexcept
+            : m_file(INVALID_HANDLE_VALUE),
+              m_mapping(nullptr),
+              m_data(nullptr),
+              m_size(0)
+    {
+    }
+#else
+    mapped_file::mapped_file() noexcept
+            : m_file(-1),
+              m_data(nullptr),
+              m_size(0)
+    {
+    }
+#endif
+
+    mapped_file::~mapped_file()
+    {
+        close();
+    }
+
+    bool mapped_file::open(const std::filesystem::path &path) noexcept
+    {
+        close();
+
+#ifdef _WIN32
+        // Le fichier est lu du début à la fin : le cache du système peut anticiper les lectures.
+        m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+        if (m_file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+
+        // Un fichier vide ne peut pas être projeté.
+        if (!GetFileSizeEx(m_file, &size) || size.QuadPart <= 0)
+        {
+            close();
+
+            return false;
+        }
+
+        m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (m_mapping == nullptr)
+        {
+            close();
+
+            return false;
+        }
+
+        m_data = static_cast<const uint8 *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        m_size = static_cast<usize>(size.QuadPart);
+#else
+        m_file = ::open(path.c_str(), O_RDONLY);
+
+        if (m_file < 0)
+        {
+            return false;
+        }
+
+        struct stat info;
+
+        // Un fichier vide ne peut pas être projeté.
+        if (fstat(m_file, &info) != 0 || info.st_size <= 0)
+        {
+            close();
+
+            return false;
+        }
+
+        void *data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, m_file, 0);
+
+        if (data != MAP_FAILED)
+        {
+            madvise(data, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+
+            m_data = static_cast<const uint8 *>(data);
+            m_size = static_cast<usize>(info.st_size);
+        }
+#endif
+
+        if (m_data == nullptr)
+        {
+            close();
+
+            return false;
+        }
+
+        return true;
+    }
+
+    void mapped_file::close() noexcept
+    {
+#ifdef _WIN32
+        if (m_data != nullptr)
+        {
+            UnmapViewOfFile(m_data);
+        }
+
+        if (m_mapping != nullptr)
+        {
+            CloseHandle(m_mapping);
+        }
+
+        if (m_file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_file);
+        }
+
+        m_file    = INVALID_HANDLE_VALUE;
+        m_mapping = nullptr;
+#else
+        if (m_data != nullptr)
+        {
+            munmap(const_cast<uint8 *>(m_data), m_size);
+        }
+
+        if (m_file >= 0)
+        {
+            ::close(m_file);
+        }
+
+        m_file = -1;
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    bool mapped_file::is_open() const noexcept
+    {
+        return m_data != nullptr;
+    }
+
+    const uint8 *mapped_file::get_data() const noexcept
+    {
+        return m_data;
+    }
+
+    usize mapped_file::get_size() const noexcept
+    {
+        return m_size;
+    }
+} // namespace deep
@@ -0,0 +1,54 @@
+#ifndef DEEP_ENGINE_MAPPED_FILE_HPP
+#define DEEP_ENGINE_MAPPED_FILE_HPP
+
+#include <DeepCore/types.hpp>
+
+#include <filesystem>
+
+namespace deep
+{
+    /**
+     * @brief Projette un fichier en lecture seule dans l'espace d'adressage du processus.
+     *
+     * Les pages ne sont lues depuis le disque qu'au premier accès et restent dans le cache du système : aucune
+     * copie intermédiaire n'est faite, les données peuvent être passées telles quelles aux API qui les consomment.
+     *
+     * La classe n'est pas exportée et n'est utilisée que de manière interne.
+     */
+    class mapped_file
+    {
+      public:
+        mapped_file() noexcept;
+        ~mapped_file();
+
+        mapped_file(const mapped_file &)            = delete;
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        /**
+         * @brief Projette le fichier, en fermant celui déjà ouvert.
+         * @return false si le fichier n'existe pas, est vide ou ne peut pas être projeté.
+         */
+        bool open(const std::filesystem::path &path) noexcept;
+        void close() noexcept;
+
+        bool is_open() const noexcept;
+
+        /**
+         * @return Le début du fichier, aligné sur une page mémoire.
+         */
+        const uint8 *get_data() const noexcept;
+        usize get_size() const noexcept;
+
+      private:
+#ifdef _WIN32
+        void *m_file;
+        void *m_mapping;
+#else
+        int m_file;
+#endif
+        const uint8 *m_data;
+        usize m_size;
+    };
+} // namespace deep
+
+#endif
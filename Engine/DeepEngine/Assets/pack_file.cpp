@@ -0,0 +1,737 @@
+#include "pack_file.hpp"
+#include "asset_database.hpp"
+
+#include <DeepLib/context.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace deep
+{
+    namespace
+    {
+        // Une séquence LZ4 code au moins 4 octets répétés.
+        constexpr usize min_match = 4;
+
+        // Les 5 derniers octets d'un bloc sont des littéraux, et la dernière répétition commence au moins
+        // 12 octets avant la fin.
+        constexpr usize last_literals = 5;
+        constexpr usize match_limit   = 12;
+
+        constexpr uint32 hash_bits  = 12;
+        constexpr usize max_offset  = 65535;
+        constexpr usize max_entries = 1u << 20;
+
+        /**
+         * @brief Fichier lu et éventuellement compressé, en attente d'écriture dans l'archive.
+         */
+        struct pack_source
+        {
+            std::filesystem::path path;
+            std::string name;
+            std::vector<uint8> data;
+            pack_entry entry;
+            bool read;
+        };
+
+        uint32 read_32(const uint8 *data) noexcept
+        {
+            uint32 value;
+            std::memcpy(&value, data, sizeof(value));
+
+            return value;
+        }
+
+        uint32 hash_sequence(uint32 sequence) noexcept
+        {
+            return (sequence * 2654435761u) >> (32 - hash_bits);
+        }
+
+        /**
+         * @brief Écrit une longueur sous la forme LZ4 : 255 tant qu'elle dépasse, puis le reste.
+         */
+        bool write_length(usize length, uint8 *&output, const uint8 *end) noexcept
+        {
+            while (length >= 255)
+            {
+                if (output >= end)
+                {
+                    return false;
+                }
+
+                *output++ = 255;
+                length -= 255;
+            }
+
+            if (output >= end)
+            {
+                return false;
+            }
+
+            *output++ = static_cast<uint8>(length);
+
+            return true;
+        }
+
+        bool read_length(const uint8 *&input, const uint8 *end, usize &length) noexcept
+        {
+            uint8 value;
+
+            do
+            {
+                if (input >= end)
+                {
+                    return false;
+                }
+
+                value = *input++;
+                length += value;
+            } while (value == 255);
+
+            return true;
+        }
+
+        /**
+         * @brief Écrit les littéraux depuis anchor puis, si match_length n'est pas nul, la répétition qui les suit.
+         */
+        bool write_sequence(const uint8 *anchor, usize literal_count, usize offset, usize match_length, uint8 *&output, const uint8 *end) noexcept
+        {
+            const usize match_code = match_length != 0 ? match_length - min_match : 0;
+
+            if (output >= end)
+            {
+                return false;
+            }
+
+            uint8 *token = output++;
+            *token       = static_cast<uint8>((std::min<usize>(literal_count, 15) << 4) | std::min<usize>(match_code, 15));
+
+            if (literal_count >= 15 && !write_length(literal_count - 15, output, end))
+            {
+                return false;
+            }
+
+            if (static_cast<usize>(end - output) < literal_count)
+            {
+                return false;
+            }
+
+            if (literal_count != 0)
+            {
+                std::memcpy(output, anchor, literal_count);
+                output += literal_count;
+            }
+
+            if (match_length == 0)
+            {
+                return true;
+            }
+
+            if (end - output < 2)
+            {
+                return false;
+            }
+
+            *output++ = static_cast<uint8>(offset & 0xFF);
+            *output++ = static_cast<uint8>(offset >> 8);
+
+            return match_code < 15 || write_length(match_code - 15, output, end);
+        }
+    } // namespace
+
+    pack_stream::pack_stream(const ref<ctx> &context) noexcept
+            : stream(context),
+              m_data(nullptr),
+              m_size(0),
+              m_position(0)
+    {
+    }
+
+    bool pack_stream::open() noexcept
+    {
+        // Le flux est ouvert par pack_file::open_stream.
+        return m_data != nullptr || m_size == 0;
+    }
+
+    bool pack_stream::close() noexcept
+    {
+        m_data     = nullptr;
+        m_size     = 0;
+        m_position = 0;
+
+        m_buffer.clear();
+        m_buffer.shrink_to_fit();
+
+        return true;
+    }
+
+    bool pack_stream::can_read() const noexcept
+    {
+        return true;
+    }
+
+    bool pack_stream::can_write() const noexcept
+    {
+        return false;
+    }
+
+    bool pack_stream::can_seek() const noexcept
+    {
+        return true;
+    }
+
+    usize pack_stream::get_position() const noexcept
+    {
+        return m_position;
+    }
+
+    usize pack_stream::get_length() const noexcept
+    {
+        return m_size;
+    }
+
+    bool pack_stream::read(void *buffer, usize count, usize *bytes_read) noexcept
+    {
+        const usize available = std::min(count, m_size - m_position);
+
+        if (available != 0)
+        {
+            std::memcpy(buffer, m_data + m_position, available);
+        }
+
+        m_position += available;
+
+        if (bytes_read != nullptr)
+        {
+            *bytes_read = available;
+        }
+
+        return true;
+    }
+
+    bool pack_stream::write(const void *, usize, usize *bytes_written) noexcept
+    {
+        if (bytes_written != nullptr)
+        {
+            *bytes_written = 0;
+        }
+
+        return false;
+    }
+
+    bool pack_stream::seek(isize offset, seek_origin origin, usize *new_position) noexcept
+    {
+        isize base = 0;
+
+        switch (origin)
+        {
+            case seek_origin::Begin:
+            {
+                base = 0;
+            }
+            break;
+            case seek_origin::Current:
+            {
+                base = static_cast<isize>(m_position);
+            }
+            break;
+            case seek_origin::End:
+            {
+                base = static_cast<isize>(m_size);
+            }
+            break;
+        }
+
+        const isize position = base + offset;
+
+        if (position < 0 || static_cast<usize>(position) > m_size)
+        {
+            return false;
+        }
+
+        m_position = static_cast<usize>(position);
+
+        if (new_position != nullptr)
+        {
+            *new_position = m_position;
+        }
+
+        return true;
+    }
+
+    bool pack_stream::set_length(usize) noexcept
+    {
+        return false;
+    }
+
+    const uint8 *pack_stream::get_data() const noexcept
+    {
+        return m_data;
+    }
+
+    bool pack_file::open(const std::filesystem::path &path) noexcept
+    {
+        close();
+
+        if (!m_file.open(path) || m_file.get_size() < sizeof(pack_header))
+        {
+            close();
+
+            return false;
+        }
+
+        const uint8 *data = m_file.get_data();
+        const usize size  = m_file.get_size();
+
+        pack_header header;
+        std::memcpy(&header, data, sizeof(header));
+
+        if (header.magic != pack_magic || header.version != pack_version || header.entry_count > max_entries ||
+            header.entries_offset % alignof(pack_entry) != 0 ||
+            header.entries_offset + static_cast<uint64>(header.entry_count) * sizeof(pack_entry) > size ||
+            header.names_offset + header.names_size > size)
+        {
+            close();
+
+            return false;
+        }
+
+        m_entries     = reinterpret_cast<const pack_entry *>(data + header.entries_offset);
+        m_names       = reinterpret_cast<const char *>(data + header.names_offset);
+        m_entry_count = header.entry_count;
+
+        // Les entrées sont vérifiées une fois pour toutes : les lectures n'ont plus à le faire.
+        uint32 index;
+
+        for (index = 0; index < m_entry_count; ++index)
+        {
+            const pack_entry &entry = m_entries[index];
+
+            if (entry.offset + entry.stored_size > size ||
+                static_cast<uint64>(entry.name_offset) + entry.name_size > header.names_size ||
+                (index > 0 && m_entries[index - 1].path_hash > entry.path_hash) ||
+                (entry.compression == static_cast<uint16>(pack_compression::None) && entry.stored_size != entry.size) ||
+                entry.compression > static_cast<uint16>(pack_compression::LZ4))
+            {
+                close();
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void pack_file::close() noexcept
+    {
+        m_file.close();
+
+        m_entries     = nullptr;
+        m_names       = nullptr;
+        m_entry_count = 0;
+    }
+
+    bool pack_file::is_open() const noexcept
+    {
+        return m_file.is_open();
+    }
+
+    uint32 pack_file::get_entry_count() const noexcept
+    {
+        return m_entry_count;
+    }
+
+    const pack_entry *pack_file::find(const std::string &name) const noexcept
+    {
+        if (m_entry_count == 0)
+        {
+            return nullptr;
+        }
+
+        const uint64 path_hash = asset_database::hash(name.data(), name.size());
+
+        const pack_entry *end   = m_entries + m_entry_count;
+        const pack_entry *found = std::lower_bound(m_entries, end, path_hash, [](const pack_entry &entry, uint64 value) {
+            return entry.path_hash < value;
+        });
+
+        // Deux chemins peuvent avoir le même hash : le nom départage les entrées.
+        for (; found != end && found->path_hash == path_hash; ++found)
+        {
+            if (found->name_size == name.size() && std::memcmp(m_names + found->name_offset, name.data(), name.size()) == 0)
+            {
+                return found;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool pack_file::open_stream(const std::string &name, pack_stream &target) const noexcept
+    {
+        const pack_entry *entry = find(name);
+
+        target.close();
+
+        if (entry == nullptr)
+        {
+            return false;
+        }
+
+        const uint8 *stored = m_file.get_data() + entry->offset;
+
+        if (entry->compression == static_cast<uint16>(pack_compression::None))
+        {
+            target.m_data = stored;
+            target.m_size = entry->size;
+
+            return true;
+        }
+
+        target.m_buffer.resize(entry->size);
+
+        if (!decompress(stored, entry->stored_size, target.m_buffer.data(), entry->size))
+        {
+            target.close();
+
+            return false;
+        }
+
+        target.m_data = target.m_buffer.data();
+        target.m_size = entry->size;
+
+        return true;
+    }
+
+    bool pack_builder::build(const ref<ctx> &context, const std::filesystem::path &folder, stream *output) noexcept
+    {
+        if (output == nullptr)
+        {
+            return false;
+        }
+
+        std::vector<pack_source> sources;
+        std::error_code error;
+
+        for (std::filesystem::recursive_directory_iterator it(folder, error), end; !error && it != end; it.increment(error))
+        {
+            if (!it->is_regular_file(error))
+            {
+                continue;
+            }
+
+            pack_source source = {};
+            source.path        = it->path();
+            source.name        = it->path().lexically_relative(folder).generic_u8string();
+
+            sources.push_back(std::move(source));
+        }
+
+        if (error)
+        {
+            context->err() << "[ERROR] Cannot list '" << folder.u8string().c_str() << "'.\r\n";
+
+            return false;
+        }
+
+        // Chaque thread prend le fichier suivant, le lit et le compresse.
+        std::atomic<usize> next { 0 };
+
+        const auto worker = [&sources, &next]() {
+            usize index;
+
+            while ((index = next.fetch_add(1, std::memory_order_relaxed)) < sources.size())
+            {
+                pack_source &source = sources[index];
+                std::error_code size_error;
+
+                const uintmax_t size = std::filesystem::file_size(source.path, size_error);
+
+                if (size_error || size > UINT32_MAX)
+                {
+                    continue;
+                }
+
+                source.entry.size        = static_cast<uint32>(size);
+                source.entry.stored_size = source.entry.size;
+                source.entry.compression = static_cast<uint16>(pack_compression::None);
+
+                if (size == 0)
+                {
+                    source.read = true;
+
+                    continue;
+                }
+
+                mapped_file file;
+
+                if (!file.open(source.path))
+                {
+                    continue;
+                }
+
+                // Les données déjà compressées (PNG, blocs BC) ne sont gardées compressées que si le gain
+                // dépasse un huitième : sinon, la décompression coûterait plus que la lecture.
+                source.data.resize(pack_file::compress_bound(file.get_size()));
+
+                const usize compressed_size = pack_file::compress(file.get_data(), file.get_size(), source.data.data(), file.get_size() - file.get_size() / 8);
+
+                if (compressed_size != 0)
+                {
+                    source.data.resize(compressed_size);
+                    source.entry.stored_size = static_cast<uint32>(compressed_size);
+                    source.entry.compression = static_cast<uint16>(pack_compression::LZ4);
+                }
+                else
+                {
+                    source.data.assign(file.get_data(), file.get_data() + file.get_size());
+                }
+
+                source.read = true;
+            }
+        };
+
+        const uint32 thread_count = std::min(std::max(1u, static_cast<uint32>(std::thread::hardware_concurrency())), static_cast<uint32>(sources.size()));
+
+        std::vector<std::thread> workers;
+        uint32 thread;
+
+        for (thread = 1; thread < thread_count; ++thread)
+        {
+            workers.emplace_back(worker);
+        }
+
+        worker();
+
+        for (std::thread &worker_thread : workers)
+        {
+            worker_thread.join();
+        }
+
+        std::string names;
+
+        for (pack_source &source : sources)
+        {
+            if (!source.read || source.name.size() > UINT16_MAX)
+            {
+                context->err() << "[ERROR] Cannot pack '" << source.path.u8string().c_str() << "'.\r\n";
+
+                return false;
+            }
+
+            source.entry.path_hash   = asset_database::hash(source.name.data(), source.name.size());
+            source.entry.name_offset = static_cast<uint32>(names.size());
+            source.entry.name_size   = static_cast<uint16>(source.name.size());
+
+            names += source.name;
+        }
+
+        std::sort(sources.begin(), sources.end(), [](const pack_source &left, const pack_source &right) {
+            return left.entry.path_hash < right.entry.path_hash;
+        });
+
+        pack_header header    = {};
+        header.magic          = pack_magic;
+        header.version        = pack_version;
+        header.entry_count    = static_cast<uint32>(sources.size());
+        header.names_size     = static_cast<uint32>(names.size());
+        header.entries_offset = sizeof(pack_header);
+        header.names_offset   = header.entries_offset + sizeof(pack_entry) * sources.size();
+
+        const auto align = [](uint64 offset) {
+            return (offset + pack_alignment - 1) / pack_alignment * pack_alignment;
+        };
+
+        uint64 offset = align(header.names_offset + names.size());
+
+        for (pack_source &source : sources)
+        {
+            source.entry.offset = offset;
+            offset              = align(offset + source.entry.stored_size);
+        }
+
+        // Octets de remplissage écrits entre les données des entrées.
+        const uint8 padding[pack_alignment] = {};
+        usize bytes_written;
+        uint64 position;
+
+        bool written = output->write(&header, sizeof(header), &bytes_written);
+
+        for (const pack_source &source : sources)
+        {
+            written = written && output->write(&source.entry, sizeof(pack_entry), &bytes_written);
+        }
+
+        written  = written && output->write(names.data(), names.size(), &bytes_written);
+        position = header.names_offset + names.size();
+
+        for (const pack_source &source : sources)
+        {
+            written  = written && output->write(padding, static_cast<usize>(source.entry.offset - position), &bytes_written);
+            written  = written && output->write(source.data.data(), source.data.size(), &bytes_written);
+            position = source.entry.offset + source.entry.stored_size;
+        }
+
+        if (written)
+        {
+            context->out() << "Packed " << header.entry_count << " files.\r\n";
+        }
+
+        return written;
+    }
+
+    usize pack_file::compress_bound(usize size) noexcept
+    {
+        return size + size / 255 + 16;
+    }
+
+    usize pack_file::compress(const uint8 *input, usize size, uint8 *output, usize capacity) noexcept
+    {
+        const uint8 *anchor     = input;
+        const uint8 *const end  = input + size;
+        uint8 *out              = output;
+        const uint8 *const last = output + capacity;
+
+        // Dernière position sur laquelle une répétition peut commencer et dernière qu'elle peut atteindre.
+        const uint8 *const match_start_limit = size > match_limit ? end - match_limit : input;
+        const uint8 *const match_end_limit   = end - std::min(size, last_literals);
+
+        std::vector<uint32> table(static_cast<usize>(1) << hash_bits, 0);
+        const uint8 *current = input;
+
+        while (current < match_start_limit)
+        {
+            const uint32 sequence = read_32(current);
+            const uint32 slot     = hash_sequence(sequence);
+            const uint8 *match    = input + table[slot];
+
+            table[slot] = static_cast<uint32>(current - input);
+
+            if (match >= current || static_cast<usize>(current - match) > max_offset || read_32(match) != sequence)
+            {
+                // Les zones sans répétition sont parcourues de plus en plus vite.
+                current += 1 + (static_cast<usize>(current - anchor) >> 6);
+
+                continue;
+            }
+
+            // Les octets précédents identiques sont ajoutés à la répétition.
+            while (current > anchor && match > input && current[-1] == match[-1])
+            {
+                current--;
+                match--;
+            }
+
+            usize match_length = min_match;
+
+            while (current + match_length < match_end_limit && current[match_length] == match[match_length])
+            {
+                match_length++;
+            }
+
+            if (!write_sequence(anchor, static_cast<usize>(current - anchor), static_cast<usize>(current - match), match_length, out, last))
+            {
+                return 0;
+            }
+
+            current += match_length;
+            anchor = current;
+
+            if (current < match_start_limit)
+            {
+                table[hash_sequence(read_32(current - 2))] = static_cast<uint32>(current - 2 - input);
+            }
+        }
+
+        if (!write_sequence(anchor, static_cast<usize>(end - anchor), 0, 0, out, last))
+        {
+            return 0;
+        }
+
+        return static_cast<usize>(out - output);
+    }
+
+    bool pack_file::decompress(const uint8 *input, usize stored_size, uint8 *output, usize size) noexcept
+    {
+        const uint8 *in            = input;
+        const uint8 *const in_end  = input + stored_size;
+        uint8 *out                 = output;
+        const uint8 *const out_end = output + size;
+
+        while (in < in_end)
+        {
+            const uint8 token   = *in++;
+            usize literal_count = token >> 4;
+
+            if (literal_count == 15 && !read_length(in, in_end, literal_count))
+            {
+                return false;
+            }
+
+            if (static_cast<usize>(in_end - in) < literal_count || static_cast<usize>(out_end - out) < literal_count)
+            {
+                return false;
+            }
+
+            if (literal_count != 0)
+            {
+                std::memcpy(out, in, literal_count);
+                in += literal_count;
+                out += literal_count;
+            }
+
+            // La dernière séquence n'a que des littéraux.
+            if (in == in_end)
+            {
+                break;
+            }
+
+            if (in_end - in < 2)
+            {
+                return false;
+            }
+
+            const usize offset = static_cast<usize>(in[0]) | (static_cast<usize>(in[1]) << 8);
+            in += 2;
+
+            if (offset == 0 || offset > static_cast<usize>(out - output))
+            {
+                return false;
+            }
+
+            usize match_length = token & 15;
+
+            if (match_length == 15 && !read_length(in, in_end, match_length))
+            {
+                return false;
+            }
+
+            match_length += min_match;
+
+            if (static_cast<usize>(out_end - out) < match_length)
+            {
+                return false;
+            }
+
+            const uint8 *match = out - offset;
+
+            // Une répétition peut recouvrir les octets qu'elle écrit : la copie se fait alors octet par octet.
+            if (offset >= match_length)
+            {
+                std::memcpy(out, match, match_length);
+                out += match_length;
+            }
+            else
+            {
+                while (match_length-- != 0)
+                {
+                    *out++ = *match++;
+                }
+            }
+        }
+
+        return out == out_end;
+    }
+} // namespace deep
@@ -0,0 +1,184 @@
+#ifndef DEEP_ENGINE_PACK_FILE_HPP
+#define DEEP_ENGINE_PACK_FILE_HPP
+
+#include "DeepEngine/deep_engine_export.h"
+#include "DeepEngine/Assets/mapped_file.hpp"
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/memory/ref_counted.hpp>
+#include <DeepLib/stream/stream.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace deep
+{
+    // 'DPAK'
+    constexpr uint32 pack_magic   = 0x4B415044;
+    constexpr uint16 pack_version = 1;
+
+    // Alignement des données de chaque entrée depuis le début de l'archive.
+    constexpr uint32 pack_alignment = 64;
+
+    enum class pack_compression : uint16
+    {
+        None = 0,
+
+        // Format de bloc LZ4, sans en-tête de trame.
+        LZ4 = 1
+    };
+
+    /**
+     * @brief En-tête d'une archive écrite par pack_builder::build.
+     *
+     * L'en-tête est suivi de la table des entrées, triée par hash du chemin, puis des chemins et enfin des données
+     * de chaque entrée, alignées sur pack_alignment. Toutes les valeurs sont en little-endian.
+     */
+    struct pack_header
+    {
+        uint32 magic;
+        uint16 version;
+        uint16 reserved;
+        uint32 entry_count;
+        uint32 names_size;
+        uint64 entries_offset;
+        uint64 names_offset;
+    };
+
+    struct pack_entry
+    {
+        // Hash du chemin relatif à la racine de l'archive, avec des '/'.
+        uint64 path_hash;
+        uint64 offset;
+
+        // Taille dans l'archive et taille une fois décompressée.
+        uint32 stored_size;
+        uint32 size;
+
+        uint32 name_offset;
+        uint16 name_size;
+        uint16 compression;
+    };
+
+    /**
+     * @brief Flux en lecture seule sur une entrée d'une archive.
+     *
+     * Une entrée non compressée est lue directement dans la projection de l'archive, sans copie intermédiaire ;
+     * une entrée compressée est décompressée en une fois à l'ouverture.
+     */
+    class pack_stream : public stream
+    {
+      public:
+        explicit pack_stream(const ref<ctx> &context) noexcept;
+
+        virtual bool open() noexcept override;
+        virtual bool close() noexcept override;
+
+        virtual bool can_read() const noexcept override;
+        virtual bool can_write() const noexcept override;
+        virtual bool can_seek() const noexcept override;
+
+        virtual usize get_position() const noexcept override;
+        virtual usize get_length() const noexcept override;
+
+        virtual bool read(void *buffer, usize count, usize *bytes_read) noexcept override;
+        virtual bool write(const void *buffer, usize count, usize *bytes_written) noexcept override;
+        virtual bool seek(isize offset, seek_origin origin, usize *new_position = nullptr) noexcept override;
+        virtual bool set_length(usize length) noexcept override;
+
+        /**
+         * @return Les données de l'entrée, valides tant que le flux et l'archive sont ouverts.
+         */
+        const uint8 *get_data() const noexcept;
+
+      private:
+        const uint8 *m_data;
+        usize m_size;
+        usize m_position;
+
+        // Données décompressées, vide pour une entrée stockée telle quelle.
+        std::vector<uint8> m_buffer;
+
+      public:
+        friend class pack_file;
+    };
+
+    /**
+     * @brief Archive qui regroupe les ressources d'un projet dans un seul fichier projeté en mémoire.
+     *
+     * Les ressources livrées sont lues depuis l'archive au lieu d'ouvrir chaque fichier : la table des entrées est
+     * triée par hash du chemin et une recherche ne touche que ses pages. Les entrées que la compression réduit
+     * suffisamment sont compressées en LZ4, dont la décompression est plus rapide que la lecture du disque.
+     *
+     * Une archive ouverte peut être lue depuis plusieurs threads à la fois.
+     *
+     * La classe n'est pas exportée et n'est utilisée que de manière interne.
+     */
+    class pack_file
+    {
+      public:
+        pack_file() noexcept = default;
+
+        pack_file(const pack_file &)            = delete;
+        pack_file &operator=(const pack_file &) = delete;
+
+        /**
+         * @return false si l'archive n'existe pas ou si sa table des entrées n'est pas valide.
+         */
+        bool open(const std::filesystem::path &path) noexcept;
+        void close() noexcept;
+
+        bool is_open() const noexcept;
+        uint32 get_entry_count() const noexcept;
+
+        /**
+         * @param name Le chemin de l'entrée, relatif à la racine de l'archive et avec des '/'.
+         * @return L'entrée, ou nullptr si l'archive ne la contient pas.
+         */
+        const pack_entry *find(const std::string &name) const noexcept;
+
+        /**
+         * @brief Attache une entrée à un flux, qui peut ensuite être passé à toute fonction qui lit un 'stream'.
+         * @return false si l'entrée n'existe pas ou ne peut pas être décompressée.
+         */
+        bool open_stream(const std::string &name, pack_stream &target) const noexcept;
+
+        /**
+         * @return La taille maximale d'un bloc LZ4 compressé.
+         */
+        static usize compress_bound(usize size) noexcept;
+
+        /**
+         * @return La taille compressée, ou 0 si elle dépasse capacity.
+         */
+        static usize compress(const uint8 *input, usize size, uint8 *output, usize capacity) noexcept;
+
+        /**
+         * @brief Décompresse un bloc LZ4 en vérifiant chaque longueur et chaque distance.
+         * @return false si le bloc n'est pas valide ou ne donne pas exactement size octets.
+         */
+        static bool decompress(const uint8 *input, usize stored_size, uint8 *output, usize size) noexcept;
+
+      private:
+        mapped_file m_file;
+
+        const pack_entry *m_entries = nullptr;
+        const char *m_names         = nullptr;
+        uint32 m_entry_count        = 0;
+    };
+
+    class DEEP_ENGINE_API pack_builder
+    {
+      public:
+        /**
+         * @brief Écrit l'archive de tous les fichiers d'un dossier et de ses sous-dossiers.
+         *
+         * Les chemins des entrées sont relatifs au dossier. Les fichiers sont lus et compressés sur tous les cœurs.
+         * @return false si un fichier ne peut pas être lu ou si l'écriture échoue.
+         */
+        static bool build(const ref<ctx> &context, const std::filesystem::path &folder, stream *output) noexcept;
+    };
+} // namespace deep
+
+#endif
@@ -2,6 +2,7 @@
 #include "DeepEngine/engine.hpp"
 #include "DeepEngine/GUI/imgui_helper.hpp"
 #include "DeepEngine/project.hpp"
+#include "DeepEngine/Scene/scene.hpp"
 #include "D3D/drawable/drawable_factory.hpp"
 
 #include <DeepLib/context.hpp>
@@ -111,9 +112,57 @@ namespace deep
                 {
                     if (ImGui::BeginMenu("Project"))
                     {
-                        if (ImGui::MenuItem("Import resource..."))
+                        if (ImGui::MenuItem("Import resources..."))
                         {
-                            // TODO: ouvrir un sélecteur de fichier puis copier le fichier dans le dossier des ressources.
+                            // DeepLib ne propose qu'un sélecteur de dossier : le dossier choisi est copié avec son contenu.
+                            string_native source_folder = fs::select_folder(m_context, DEEP_TEXT_NATIVE("Select a folder to import"));
+
+                            if (source_folder.is_valid())
+                            {
+                                m_context->out() << "Importing resources from '" << *source_folder << "'...\r\n";
+
+                                if (!proj->import_resources(*source_folder))
+                                {
+                                    m_context->err() << "[ERROR] Cannot import resources.\r\n";
+                                }
+                            }
+                        }
+
+                        if (ImGui::MenuItem("Refresh resources"))
+                        {
+                            if (!proj->refresh_resources())
+                            {
+                                m_context->err() << "[ERROR] Cannot save the resource database.\r\n";
+                            }
+                        }
+
+                        // L'enregistrement se fait en arrière-plan : son état est affiché à côté de l'entrée.
+                        const char *save_state = nullptr;
+
+                        switch (eng->get_scene()->get_save_state())
+                        {
+                            default:
+                                break;
+                            case scene::save_state::Saving:
+                            {
+                                save_state = "Saving...";
+                            }
+                            break;
+                            case scene::save_state::Saved:
+                            {
+                                save_state = "Saved";
+                            }
+                            break;
+                            case scene::save_state::Failed:
+                            {
+                                save_state = "Failed";
+                            }
+                            break;
+                        }
+
+                        if (ImGui::MenuItem("Save scene", save_state))
+                        {
+                            proj->save_scene(eng);
                         }
 
                         ImGui::EndMenu();
@@ -169,23 +218,8 @@ namespace deep
                             ref<camera> cam = eng->get_camera();
                             if (cam.is_valid())
                             {
-                                fvec3 location            = cam->get_location();
-                                ref<D3D::cube> basic_cube = eng->get_basic_shapes().cube;
-
-                                ref<D3D::cube> add_cube = D3D::drawable_factory::from(m_context,
-                                                                                      basic_cube,
-                                                                                      basic_cube->get_vertex_shader(),
-                                                                                      basic_cube->get_pixel_shader(),
-                                                                                      location,
-                                                                                      fvec3(),
-                                                                                      fvec3(1.0f, 1.0f, 1.0f),
-                                                                                      graph->get_device());
-
-                                if (add_cube.is_valid())
-                                {
-                                    graph->add_drawable(ref_cast<D3D::drawable>(add_cube));
-                                }
-                                else
+                                // Les cubes ajoutés partagent un seul appel de dessin.
+                                if (!eng->add_basic_shape(basic_shape_kind::Cube, cam->get_location(), fvec3(), fvec3(1.0f, 1.0f, 1.0f)))
                                 {
                                     m_context->err() << "[ERROR] Cannot add 'basic_cube'\r\n";
                                 }
@@ -197,23 +231,7 @@ namespace deep
                             ref<camera> cam = eng->get_camera();
                             if (cam.is_valid())
                             {
-                                fvec3 location              = cam->get_location();
-                                ref<D3D::plane> basic_plane = eng->get_basic_shapes().plane;
-
-                                ref<D3D::plane> add_plane = D3D::drawable_factory::from(m_context,
-                                                                                        basic_plane,
-                                                                                        basic_plane->get_vertex_shader(),
-                                                                                        basic_plane->get_pixel_shader(),
-                                                                                        location,
-                                                                                        fvec3(),
-                                                                                        fvec3(1.0f, 1.0f, 1.0f),
-                                                                                        graph->get_device());
-
-                                if (add_plane.is_valid())
-                                {
-                                    graph->add_drawable(ref_cast<D3D::drawable>(add_plane));
-                                }
-                                else
+                                if (!eng->add_basic_shape(basic_shape_kind::Plane, cam->get_location(), fvec3(), fvec3(1.0f, 1.0f, 1.0f)))
                                 {
                                     m_context->err() << "[ERROR] Cannot add 'basic_plane'\r\n";
                                 }
@@ -297,9 +315,35 @@ namespace deep
                 break;
                 case view::Stats:
                 {
-                    uint32 FPS = eng->get_FPS();
+                    uint32 FPS                          = eng->get_FPS();
+                    const D3D::frame_stats &frame_stats = graph->get_last_frame_stats();
 
                     imgui_helper::print("FPS: %u", FPS);
+                    imgui_helper::print("Draw calls: %u", frame_stats.draw_calls);
+                    imgui_helper::print("Vertices: %u", frame_stats.vertices);
+                    imgui_helper::print("Shader binds: %u", frame_stats.shader_binds);
+                    imgui_helper::print("Buffer binds: %u", frame_stats.buffer_binds);
+                    imgui_helper::print("Texture binds: %u", frame_stats.texture_binds);
+                    imgui_helper::print("State changes: %u", frame_stats.state_changes);
+                    imgui_helper::print("Buffer uploads: %u (%llu bytes)", frame_stats.buffer_uploads, static_cast<unsigned long long>(frame_stats.buffer_upload_bytes));
+                    imgui_helper::print("Ring constants: %u bytes (%u maps)", frame_stats.ring_constant_bytes, frame_stats.ring_maps);
+                    imgui_helper::print("Culled drawables: %u", frame_stats.culled_drawables);
+                    imgui_helper::print("Occluded drawables: %u", frame_stats.occluded_drawables);
+                    imgui_helper::print("Dropped drawables: %u", frame_stats.dropped_drawables);
+                    imgui_helper::print("Command lists: %u", frame_stats.command_lists);
+                    imgui_helper::print("Pipeline cache: %u/%u hits (%u states)", frame_stats.pipeline_cache_hits, frame_stats.pipeline_lookups, graph->get_pipeline_state_count());
+                    imgui_helper::print("Redundant state sets: %u", frame_stats.redundant_state_sets);
+
+                    frame_limiter &limiter = eng->get_frame_limiter();
+
+                    if (limiter.is_enabled())
+                    {
+                        const frame_pacing_stats &pacing = limiter.get_stats();
+
+                        imgui_helper::print("Frame budget: %.3f ms (sync interval %u)", limiter.get_frame_budget_micros() / 1000.0, graph->get_sync_interval());
+                        imgui_helper::print("Frame time: %.3f ms, jitter %.3f ms", pacing.mean_millis, pacing.jitter_millis);
+                        imgui_helper::print("Max deviation: %.3f ms, late frames: %u", pacing.max_deviation_millis, pacing.late_frames);
+                    }
                 }
                 break;
                 case view::About:
@@ -0,0 +1,461 @@
+#include "file_watcher.hpp"
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#elif defined(__linux__)
+#    include <poll.h>
+#    include <sys/eventfd.h>
+#    include <sys/inotify.h>
+#    include <unistd.h>
+#endif
+
+#include <algorithm>
+
+namespace deep
+{
+#ifdef _WIN32
+    /**
+     * @brief Lecture asynchrone des changements d'un dossier, réarmée après chaque notification.
+     */
+    struct file_watcher::directory
+    {
+        HANDLE handle;
+        OVERLAPPED overlapped;
+
+        // Le détail des changements n'est pas lu : toute notification provoque une relecture des fichiers.
+        alignas(DWORD) uint8 buffer[4096];
+
+        bool arm() noexcept
+        {
+            ResetEvent(overlapped.hEvent);
+
+            return ReadDirectoryChangesW(handle, buffer, sizeof(buffer), FALSE,
+                                         FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE,
+                                         nullptr, &overlapped, nullptr) != FALSE;
+        }
+    };
+#endif
+
+    namespace
+    {
+        /**
+         * @brief Liste sans doublon des dossiers contenant les fichiers surveillés.
+         */
+        template<typename Entries>
+        std::vector<std::filesystem::path> get_directories(const Entries &entries)
+        {
+            std::vector<std::filesystem::path> directories;
+
+            for (const auto &e : entries)
+            {
+                std::filesystem::path directory = e.path.parent_path();
+
+                if (directory.empty())
+                {
+                    directory = ".";
+                }
+
+                if (std::find(directories.begin(), directories.end(), directory) == directories.end())
+                {
+                    directories.push_back(directory);
+                }
+            }
+
+            return directories;
+        }
+    } // namespace
+
+    file_watcher::file_watcher(change_callback callback, uint32 poll_interval_millis)
+            : m_callback(std::move(callback)),
+              m_poll_interval_millis(poll_interval_millis),
+              m_stopping(false),
+              m_notified(false)
+#ifdef _WIN32
+              ,
+              m_stop_event(nullptr)
+#elif defined(__linux__)
+              ,
+              m_inotify(-1),
+              m_stop_event(-1)
+#endif
+    {
+    }
+
+    file_watcher::~file_watcher()
+    {
+        stop();
+    }
+
+    usize file_watcher::watch(const std::filesystem::path &path)
+    {
+        entry e   = {};
+        e.path    = path;
+        e.pending = false;
+
+        get_stamp(path, e.write_time, e.size);
+
+        m_entries.push_back(e);
+
+        return m_entries.size() - 1;
+    }
+
+    void file_watcher::start()
+    {
+        if (m_thread.joinable())
+        {
+            return;
+        }
+
+        m_stopping = false;
+        m_notified = open_notifications();
+        m_thread   = std::thread(&file_watcher::run, this);
+    }
+
+    void file_watcher::stop()
+    {
+        if (!m_thread.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+
+        m_wake.notify_all();
+
+#ifdef _WIN32
+        if (m_stop_event != nullptr)
+        {
+            SetEvent(m_stop_event);
+        }
+#elif defined(__linux__)
+        if (m_stop_event != -1)
+        {
+            const uint64_t value = 1;
+
+            [[maybe_unused]] const ssize_t written = ::write(m_stop_event, &value, sizeof(value));
+        }
+#endif
+
+        m_thread.join();
+
+        close_notifications();
+        m_notified = false;
+    }
+
+    bool file_watcher::is_running() const noexcept
+    {
+        return m_thread.joinable();
+    }
+
+    bool file_watcher::is_notified() const noexcept
+    {
+        return m_notified;
+    }
+
+    void file_watcher::run()
+    {
+        bool pending = false;
+
+        for (;;)
+        {
+            if (m_notified)
+            {
+                // Sans fichier en attente, rien ne peut changer avant la prochaine notification.
+                if (!wait_notification(pending ? static_cast<int64>(m_poll_interval_millis) : -1))
+                {
+                    return;
+                }
+            }
+            else
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                if (m_wake.wait_for(lock, std::chrono::milliseconds(m_poll_interval_millis), [this] { return m_stopping; }))
+                {
+                    return;
+                }
+            }
+
+            pending = check();
+        }
+    }
+
+    bool file_watcher::check()
+    {
+        const auto now      = std::chrono::steady_clock::now();
+        const auto interval = std::chrono::milliseconds(m_poll_interval_millis);
+
+        bool pending = false;
+        usize index;
+
+        for (index = 0; index < m_entries.size(); ++index)
+        {
+            entry &e = m_entries[index];
+
+            std::filesystem::file_time_type write_time;
+            uintmax_t size;
+
+            // Fichier absent, par exemple supprimé puis recréé par le compilateur : on attend le passage suivant.
+            if (!get_stamp(e.path, write_time, size))
+            {
+                pending = pending || e.pending;
+
+                continue;
+            }
+
+            if (write_time != e.write_time || size != e.size)
+            {
+                e.write_time = write_time;
+                e.size       = size;
+                e.pending    = true;
+                e.changed_at = now;
+            }
+            else if (e.pending && now - e.changed_at >= interval)
+            {
+                e.pending = false;
+
+                m_callback(index, e.path);
+            }
+
+            pending = pending || e.pending;
+        }
+
+        return pending;
+    }
+
+#ifdef _WIN32
+    bool file_watcher::open_notifications()
+    {
+        const std::vector<std::filesystem::path> directories = get_directories(m_entries);
+
+        // Un dossier et l'évènement d'arrêt par objet attendu.
+        if (directories.empty() || directories.size() + 1 > MAXIMUM_WAIT_OBJECTS)
+        {
+            return false;
+        }
+
+        m_stop_event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+        if (m_stop_event == nullptr)
+        {
+            return false;
+        }
+
+        for (const std::filesystem::path &path : directories)
+        {
+            std::unique_ptr<directory> watched = std::make_unique<directory>();
+
+            watched->handle = CreateFileW(path.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                          nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+
+            if (watched->handle == INVALID_HANDLE_VALUE)
+            {
+                close_notifications();
+
+                return false;
+            }
+
+            watched->overlapped        = {};
+            watched->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+            const bool armed = watched->overlapped.hEvent != nullptr && watched->arm();
+
+            m_directories.push_back(std::move(watched));
+
+            if (!armed)
+            {
+                close_notifications();
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void file_watcher::close_notifications() noexcept
+    {
+        for (const std::unique_ptr<directory> &watched : m_directories)
+        {
+            if (watched->handle != INVALID_HANDLE_VALUE)
+            {
+                // La lecture en cours doit être terminée avant de libérer son tampon.
+                CancelIoEx(watched->handle, &watched->overlapped);
+
+                DWORD bytes;
+                GetOverlappedResult(watched->handle, &watched->overlapped, &bytes, TRUE);
+
+                CloseHandle(watched->handle);
+            }
+
+            if (watched->overlapped.hEvent != nullptr)
+            {
+                CloseHandle(watched->overlapped.hEvent);
+            }
+        }
+
+        m_directories.clear();
+
+        if (m_stop_event != nullptr)
+        {
+            CloseHandle(m_stop_event);
+            m_stop_event = nullptr;
+        }
+    }
+
+    bool file_watcher::wait_notification(int64 timeout_millis)
+    {
+        HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+        DWORD count = 0;
+
+        handles[count++] = m_stop_event;
+
+        for (const std::unique_ptr<directory> &watched : m_directories)
+        {
+            handles[count++] = watched->overlapped.hEvent;
+        }
+
+        const DWORD result = WaitForMultipleObjects(count, handles, FALSE, timeout_millis < 0 ? INFINITE : static_cast<DWORD>(timeout_millis));
+
+        if (result == WAIT_OBJECT_0 || result == WAIT_FAILED)
+        {
+            return false;
+        }
+
+        // Plusieurs dossiers peuvent avoir changé : chaque lecture terminée est réarmée.
+        for (const std::unique_ptr<directory> &watched : m_directories)
+        {
+            DWORD bytes;
+
+            // Un dossier disparu ne peut plus être suivi : les fichiers sont alors interrogés à chaque intervalle.
+            if (GetOverlappedResult(watched->handle, &watched->overlapped, &bytes, FALSE))
+            {
+                if (!watched->arm())
+                {
+                    m_notified = false;
+                }
+            }
+            else if (GetLastError() != ERROR_IO_INCOMPLETE)
+            {
+                m_notified = false;
+            }
+        }
+
+        return true;
+    }
+#elif defined(__linux__)
+    bool file_watcher::open_notifications()
+    {
+        const std::vector<std::filesystem::path> directories = get_directories(m_entries);
+
+        if (directories.empty())
+        {
+            return false;
+        }
+
+        m_inotify    = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        m_stop_event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (m_inotify == -1 || m_stop_event == -1)
+        {
+            close_notifications();
+
+            return false;
+        }
+
+        for (const std::filesystem::path &path : directories)
+        {
+            if (inotify_add_watch(m_inotify, path.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_TO) == -1)
+            {
+                close_notifications();
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void file_watcher::close_notifications() noexcept
+    {
+        if (m_inotify != -1)
+        {
+            ::close(m_inotify);
+            m_inotify = -1;
+        }
+
+        if (m_stop_event != -1)
+        {
+            ::close(m_stop_event);
+            m_stop_event = -1;
+        }
+    }
+
+    bool file_watcher::wait_notification(int64 timeout_millis)
+    {
+        pollfd fds[2] = {};
+        fds[0].fd     = m_stop_event;
+        fds[0].events = POLLIN;
+        fds[1].fd     = m_inotify;
+        fds[1].events = POLLIN;
+
+        const int result = ::poll(fds, 2, timeout_millis < 0 ? -1 : static_cast<int>(timeout_millis));
+
+        if (result > 0 && (fds[0].revents & POLLIN) != 0)
+        {
+            return false;
+        }
+
+        // Le détail des évènements n'est pas lu : toute notification provoque une relecture des fichiers.
+        if (result > 0 && (fds[1].revents & POLLIN) != 0)
+        {
+            alignas(inotify_event) char buffer[4096];
+
+            while (::read(m_inotify, buffer, sizeof(buffer)) > 0)
+            {
+            }
+        }
+
+        return true;
+    }
+#else
+    bool file_watcher::open_notifications()
+    {
+        return false;
+    }
+
+    void file_watcher::close_notifications() noexcept
+    {
+    }
+
+    bool file_watcher::wait_notification(int64)
+    {
+        return false;
+    }
+#endif
+
+    bool file_watcher::get_stamp(const std::filesystem::path &path, std::filesystem::file_time_type &write_time, uintmax_t &size) noexcept
+    {
+        std::error_code error;
+
+        write_time = std::filesystem::last_write_time(path, error);
+
+        if (error)
+        {
+            return false;
+        }
+
+        size = std::filesystem::file_size(path, error);
+
+        return !error;
+    }
+} // namespace deep
@@ -0,0 +1,121 @@
+#ifndef DEEP_ENGINE_FILE_WATCHER_HPP
+#define DEEP_ENGINE_FILE_WATCHER_HPP
+
+#include <DeepCore/types.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace deep
+{
+    /**
+     * @brief Surveille la date de modification et la taille d'une liste de fichiers depuis un thread dédié.
+     *
+     * Le thread dort jusqu'à ce que le système signale un changement dans le dossier d'un des fichiers :
+     * ReadDirectoryChangesW sous Windows, inotify sous Linux. Si ces notifications ne peuvent pas être
+     * mises en place, les fichiers sont interrogés à chaque intervalle.
+     *
+     * Un fichier modifié n'est signalé qu'une fois stable, c'est-à-dire inchangé pendant un intervalle complet :
+     * un compilateur de shaders écrit sa sortie en plusieurs fois. La fonction de rappel est appelée depuis
+     * le thread de surveillance.
+     *
+     * La classe n'est pas exportée et n'est utilisée que de manière interne, à travers un pointeur.
+     */
+    class file_watcher
+    {
+      public:
+        using change_callback = std::function<void(usize index, const std::filesystem::path &path)>;
+
+        static constexpr uint32 default_poll_interval_millis = 250;
+
+      public:
+        explicit file_watcher(change_callback callback, uint32 poll_interval_millis = default_poll_interval_millis);
+        ~file_watcher();
+
+        file_watcher(const file_watcher &)            = delete;
+        file_watcher &operator=(const file_watcher &) = delete;
+
+        /**
+         * @brief Ajoute un fichier à surveiller. Doit être appelée avant start.
+         * @return L'indice passé à la fonction de rappel pour ce fichier.
+         */
+        usize watch(const std::filesystem::path &path);
+
+        void start();
+        void stop();
+
+        bool is_running() const noexcept;
+
+        /**
+         * @return true si le thread attend les notifications du système, false s'il interroge les fichiers.
+         */
+        bool is_notified() const noexcept;
+
+      private:
+        struct entry
+        {
+            std::filesystem::path path;
+            std::filesystem::file_time_type write_time;
+            uintmax_t size;
+
+            // Modifié depuis changed_at, en attente d'un intervalle sans changement.
+            bool pending;
+            std::chrono::steady_clock::time_point changed_at;
+        };
+
+#ifdef _WIN32
+        struct directory;
+#endif
+
+      private:
+        void run();
+
+        /**
+         * @brief Relit la date et la taille de chaque fichier et signale ceux restés inchangés pendant un intervalle.
+         * @return true si un fichier attend encore d'être stable.
+         */
+        bool check();
+
+        // Met en place les notifications du système, false si elles ne sont pas disponibles.
+        bool open_notifications();
+        void close_notifications() noexcept;
+
+        /**
+         * @brief Attend une notification du système, l'arrêt ou la fin du délai, puis réarme les notifications.
+         * @param timeout_millis Le délai d'attente, négatif pour attendre sans limite.
+         * @return false si l'arrêt a été demandé.
+         */
+        bool wait_notification(int64 timeout_millis);
+
+        static bool get_stamp(const std::filesystem::path &path, std::filesystem::file_time_type &write_time, uintmax_t &size) noexcept;
+
+      private:
+        change_callback m_callback;
+        uint32 m_poll_interval_millis;
+
+        std::vector<entry> m_entries;
+
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        bool m_stopping;
+
+        std::atomic<bool> m_notified;
+#ifdef _WIN32
+        std::vector<std::unique_ptr<directory>> m_directories;
+        void *m_stop_event;
+#elif defined(__linux__)
+        int m_inotify;
+        int m_stop_event;
+#endif
+    };
+} // namespace deep
+
+#endif
@@ -0,0 +1,248 @@
+#include "hot_reloader.hpp"
+#include "D3D/resource_factory.hpp"
+#include "D3D/shader/shader_factory.hpp"
+
+#include <DeepLib/context.hpp>
+#include <DeepLib/stream/file_stream.hpp>
+#include <DeepLib/image/png.hpp>
+
+namespace deep
+{
+    hot_reloader::hot_reloader(const ref<ctx> &context, const ref<D3D::renderer> &renderer)
+            : m_context(context),
+              m_renderer(renderer),
+              m_device(renderer->get_device()),
+              m_watcher([this](usize index, const std::filesystem::path &) { reload(index); })
+    {
+    }
+
+    void hot_reloader::watch_vertex_shader(const native_char *path, const D3D::input_element_desc *ied, uint32 ied_count, const ref<D3D::vertex_shader> &shader)
+    {
+        if (!shader.is_valid())
+        {
+            return;
+        }
+
+        resource res      = {};
+        res.kind          = resource_kind::VertexShader;
+        res.path          = path;
+        res.vertex_shader = shader;
+        res.ied.assign(ied, ied + ied_count);
+
+        for (const D3D::input_element_desc &element : res.ied)
+        {
+            res.semantic_names.emplace_back(element.semantic_name);
+        }
+
+        m_resources.push_back(std::move(res));
+        m_watcher.watch(path);
+    }
+
+    void hot_reloader::watch_pixel_shader(const native_char *path, const ref<D3D::pixel_shader> &shader)
+    {
+        if (!shader.is_valid())
+        {
+            return;
+        }
+
+        resource res     = {};
+        res.kind         = resource_kind::PixelShader;
+        res.path         = path;
+        res.pixel_shader = shader;
+
+        m_resources.push_back(std::move(res));
+        m_watcher.watch(path);
+    }
+
+    void hot_reloader::watch_texture(const native_char *path, const ref<D3D::texture> &tex)
+    {
+        if (!tex.is_valid())
+        {
+            return;
+        }
+
+        resource res = {};
+        res.kind     = resource_kind::Texture;
+        res.path     = path;
+        res.cooked   = std::filesystem::path(path).extension() == ".dtex";
+        res.texture  = tex;
+
+        m_resources.push_back(std::move(res));
+        m_watcher.watch(path);
+    }
+
+    void hot_reloader::start()
+    {
+        m_watcher.start();
+    }
+
+    void hot_reloader::stop()
+    {
+        m_watcher.stop();
+    }
+
+    void hot_reloader::reload(usize index)
+    {
+        const resource &res = m_resources[index];
+
+        reloaded next = {};
+        next.index    = index;
+
+        file_stream fs = file_stream(m_context, res.path.c_str(), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
+
+        if (fs.open())
+        {
+            switch (res.kind)
+            {
+                case resource_kind::VertexShader:
+                {
+                    // Les noms de sémantique sont repointés ici : les chaînes courtes sont déplacées avec leur ressource.
+                    std::vector<D3D::input_element_desc> ied = res.ied;
+                    usize element;
+
+                    for (element = 0; element < ied.size(); ++element)
+                    {
+                        ied[element].semantic_name = res.semantic_names[element].c_str();
+                    }
+
+                    // Le cache de shaders n'est pas utilisé : ses références sont partagées avec le thread de rendu.
+                    ref<D3D::vertex_shader> vs = D3D::shader_factory::create_vertex_shader(m_context, &fs, ied.data(), static_cast<uint32>(ied.size()), m_device);
+
+                    if (vs.is_valid() && (!m_device || (vs->get() != nullptr && vs->get_input_layout() != nullptr)))
+                    {
+                        next.vertex_shader = vs;
+                    }
+                }
+                break;
+                case resource_kind::PixelShader:
+                {
+                    ref<D3D::pixel_shader> ps = D3D::shader_factory::create_pixel_shader(m_context, &fs, m_device);
+
+                    if (ps.is_valid() && (!m_device || ps->get() != nullptr))
+                    {
+                        next.pixel_shader = ps;
+                    }
+                }
+                break;
+                case resource_kind::Texture:
+                {
+                    if (res.cooked)
+                    {
+                        next.texture = D3D::resource_factory::create_texture(m_context, &fs, m_device);
+
+                        break;
+                    }
+
+                    png source = png::load(m_context, &fs);
+
+                    if (source.is_valid() && source.check() && source.read_info())
+                    {
+                        image img = source.read_image(image::color_space::RGBA);
+
+                        if (img.is_valid())
+                        {
+                            next.texture = D3D::resource_factory::create_texture(m_context, img, m_device);
+                        }
+                    }
+                }
+                break;
+            }
+
+            fs.close();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_reloaded.push_back(next);
+    }
+
+    uint32 hot_reloader::apply(basic_shapes &shapes) noexcept
+    {
+        std::vector<reloaded> pending;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            pending.swap(m_reloaded);
+        }
+
+        uint32 replaced = 0;
+
+        for (const reloaded &next : pending)
+        {
+            resource &res = m_resources[next.index];
+
+            if (!next.vertex_shader.is_valid() && !next.pixel_shader.is_valid() && !next.texture.is_valid())
+            {
+                m_context->err() << DEEP_TEXT_UTF8("[ERROR] Cannot reload '") << std::filesystem::path(res.path).u8string().c_str() << DEEP_TEXT_UTF8("'.\r\n");
+
+                continue;
+            }
+
+            const usize count = m_renderer->get_drawable_count();
+            usize index;
+
+            for (index = 0; index < count; ++index)
+            {
+                ref<D3D::drawable> dr = m_renderer->get_drawable(index);
+
+                replace(res, next, *dr);
+            }
+
+            // Les formes de base servent de modèles aux objets créés par la suite.
+            const ref<D3D::drawable> templates[] = {
+                ref_cast<D3D::drawable>(shapes.cube),
+                ref_cast<D3D::drawable>(shapes.textured_cube),
+                ref_cast<D3D::drawable>(shapes.plane)
+            };
+
+            for (const ref<D3D::drawable> &dr : templates)
+            {
+                if (dr.is_valid())
+                {
+                    replace(res, next, *dr);
+                }
+            }
+
+            res.vertex_shader = next.vertex_shader;
+            res.pixel_shader  = next.pixel_shader;
+            res.texture       = next.texture;
+
+            m_context->out() << DEEP_TEXT_UTF8("Reloaded '") << std::filesystem::path(res.path).u8string().c_str() << DEEP_TEXT_UTF8("'.\r\n");
+
+            replaced++;
+        }
+
+        return replaced;
+    }
+
+    void hot_reloader::replace(const resource &res, const reloaded &next, D3D::drawable &dr) noexcept
+    {
+        switch (res.kind)
+        {
+            case resource_kind::VertexShader:
+            {
+                if (dr.get_vertex_shader() == res.vertex_shader)
+                {
+                    dr.set_vertex_shader(next.vertex_shader);
+                }
+            }
+            break;
+            case resource_kind::PixelShader:
+            {
+                if (dr.get_pixel_shader() == res.pixel_shader)
+                {
+                    dr.set_pixel_shader(next.pixel_shader);
+                }
+            }
+            break;
+            case resource_kind::Texture:
+            {
+                if (dr.get_texture() == res.texture)
+                {
+                    dr.set_texture(next.texture);
+                }
+            }
+            break;
+        }
+    }
+} // namespace deep
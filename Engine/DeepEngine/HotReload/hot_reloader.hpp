@@ -0,0 +1,124 @@
+#ifndef DEEP_ENGINE_HOT_RELOADER_HPP
+#define DEEP_ENGINE_HOT_RELOADER_HPP
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/memory/ref_counted.hpp>
+
+#include "DeepEngine/HotReload/file_watcher.hpp"
+#include "DeepEngine/basic_shapes.hpp"
+#include "D3D/renderer.hpp"
+#include "D3D/shader/vertex_shader.hpp"
+#include "D3D/shader/pixel_shader.hpp"
+#include "D3D/texture.hpp"
+#include "D3D/shader/input_layout.hpp"
+#include "D3D/device_handle.hpp"
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace deep
+{
+    /**
+     * @brief Recharge les shaders compilés et les textures lorsque leur fichier change sur le disque.
+     *
+     * Les fichiers sont relus et les nouveaux objets Direct3D créés sur le thread de surveillance, le périphérique
+     * pouvant être utilisé depuis plusieurs threads. Les ressources rechargées ne sont ensuite échangées que par
+     * apply, appelée par la boucle de jeu entre deux images : une image n'utilise jamais un mélange d'anciennes
+     * et de nouvelles ressources.
+     *
+     * Une ressource dont le fichier est invalide conserve sa version actuelle.
+     *
+     * La classe n'est pas exportée et n'est utilisée que de manière interne, à travers un pointeur.
+     */
+    class hot_reloader
+    {
+      public:
+        hot_reloader(const ref<ctx> &context, const ref<D3D::renderer> &renderer);
+
+        hot_reloader(const hot_reloader &)            = delete;
+        hot_reloader &operator=(const hot_reloader &) = delete;
+
+        /**
+         * @brief Surveille le fichier '.cso' d'un vertex shader. L'input layout est recréé à l'identique.
+         */
+        void watch_vertex_shader(const native_char *path, const D3D::input_element_desc *ied, uint32 ied_count, const ref<D3D::vertex_shader> &shader);
+        void watch_pixel_shader(const native_char *path, const ref<D3D::pixel_shader> &shader);
+
+        /**
+         * @brief Surveille une image PNG, ou une texture préparée si son extension est '.dtex'.
+         */
+        void watch_texture(const native_char *path, const ref<D3D::texture> &tex);
+
+        /**
+         * @brief Démarre la surveillance, une fois toutes les ressources ajoutées.
+         */
+        void start();
+        void stop();
+
+        /**
+         * @brief Remplace, dans tous les objets de la scène et dans les formes de base, les ressources rechargées
+         * depuis le dernier appel.
+         *
+         * Doit être appelée depuis le thread de rendu, entre deux images.
+         * @return Le nombre de ressources remplacées.
+         */
+        uint32 apply(basic_shapes &shapes) noexcept;
+
+      private:
+        enum class resource_kind
+        {
+            VertexShader,
+            PixelShader,
+            Texture
+        };
+
+        struct resource
+        {
+            resource_kind kind;
+            std::basic_string<native_char> path;
+
+            // Texture préparée par texture_cooker plutôt qu'image PNG.
+            bool cooked;
+
+            // Copie de l'input layout, noms de sémantique compris.
+            std::vector<D3D::input_element_desc> ied;
+            std::vector<std::string> semantic_names;
+
+            // Version actuellement utilisée par la scène, lue et modifiée uniquement par apply.
+            ref<D3D::vertex_shader> vertex_shader;
+            ref<D3D::pixel_shader> pixel_shader;
+            ref<D3D::texture> texture;
+        };
+
+        struct reloaded
+        {
+            usize index;
+
+            ref<D3D::vertex_shader> vertex_shader;
+            ref<D3D::pixel_shader> pixel_shader;
+            ref<D3D::texture> texture;
+        };
+
+      private:
+        // Appelée depuis le thread de surveillance.
+        void reload(usize index);
+
+        void replace(const resource &res, const reloaded &next, D3D::drawable &dr) noexcept;
+
+      private:
+        ref<ctx> m_context;
+        ref<D3D::renderer> m_renderer;
+        D3D::device_handle m_device;
+
+        std::vector<resource> m_resources;
+
+        std::mutex m_mutex;
+        std::vector<reloaded> m_reloaded;
+
+        file_watcher m_watcher;
+    };
+} // namespace deep
+
+#endif
@@ -0,0 +1,445 @@
+#include "scene.hpp"
+#include "DeepEngine/Assets/asset_database.hpp"
+#include "DeepEngine/Assets/mapped_file.hpp"
+
+#include <DeepLib/context.hpp>
+#include <DeepLib/stream/file_stream.hpp>
+
+#include <cstring>
+
+namespace deep
+{
+    namespace
+    {
+        /**
+         * @brief Ajoute une ressource référencée par un objet à la table du fichier.
+         * @return L'indice de la ressource dans la table, scene_no_asset pour l'identifiant 0.
+         */
+        uint32 get_asset_index(uint64 id,
+                               std::unordered_map<uint64, uint32> &indices,
+                               std::vector<uint64> &ids)
+        {
+            if (id == 0)
+            {
+                return scene_no_asset;
+            }
+
+            auto found = indices.find(id);
+
+            if (found != indices.end())
+            {
+                return found->second;
+            }
+
+            const uint32 index = static_cast<uint32>(ids.size());
+
+            indices.emplace(id, index);
+            ids.push_back(id);
+
+            return index;
+        }
+    } // namespace
+
+    scene::scene(const ref<ctx> &context)
+            : m_context(context),
+              m_object_count(0),
+              m_capture_generation(0),
+              m_released_generation(0),
+              m_saving(false),
+              m_has_pending(false),
+              m_save_state(save_state::Idle)
+    {
+    }
+
+    scene::~scene()
+    {
+        wait();
+    }
+
+    uint64 scene::make_asset_id(const char *name) noexcept
+    {
+        return asset_database::hash(name, std::strlen(name));
+    }
+
+    uint64 scene::register_asset(scene_asset_kind kind, const char *name)
+    {
+        const uint64 id = make_asset_id(name);
+
+        m_assets[id] = { kind, name };
+
+        return id;
+    }
+
+    const char *scene::get_asset_name(uint64 id) const noexcept
+    {
+        auto found = m_assets.find(id);
+
+        return found != m_assets.end() ? found->second.name.c_str() : nullptr;
+    }
+
+    uint32 scene::add_object(const scene_object &object)
+    {
+        if (m_object_count % chunk_size == 0)
+        {
+            m_chunks.push_back(std::make_shared<chunk>());
+            m_chunks.back()->reserve(chunk_size);
+            m_chunk_generations.push_back(0);
+        }
+
+        get_chunk_for_write(m_object_count / chunk_size).push_back(object);
+
+        return m_object_count++;
+    }
+
+    void scene::set_transform(uint32 index, const float *location, const float *rotation, const float *scale)
+    {
+        if (index >= m_object_count)
+        {
+            return;
+        }
+
+        scene_object &object = get_chunk_for_write(index / chunk_size)[index % chunk_size];
+
+        std::memcpy(object.location, location, sizeof(object.location));
+        std::memcpy(object.rotation, rotation, sizeof(object.rotation));
+        std::memcpy(object.scale, scale, sizeof(object.scale));
+    }
+
+    const scene_object &scene::get_object(uint32 index) const noexcept
+    {
+        return (*m_chunks[index / chunk_size])[index % chunk_size];
+    }
+
+    uint32 scene::get_object_count() const noexcept
+    {
+        return m_object_count;
+    }
+
+    void scene::clear()
+    {
+        // Les captures en cours d'écriture gardent leurs blocs.
+        m_chunks.clear();
+        m_chunk_generations.clear();
+        m_object_count = 0;
+    }
+
+    void scene::save_async(const std::filesystem::path &path)
+    {
+        m_capture_generation++;
+
+        snapshot captured;
+        captured.chunks.assign(m_chunks.begin(), m_chunks.end());
+        captured.assets       = m_assets;
+        captured.object_count = m_object_count;
+        captured.generation   = m_capture_generation;
+
+        for (uint64 &generation : m_chunk_generations)
+        {
+            generation = m_capture_generation;
+        }
+
+        std::lock_guard<std::mutex> lock(m_save_mutex);
+
+        // Une capture qui n'a pas encore été écrite est remplacée par la plus récente.
+        m_pending      = std::move(captured);
+        m_pending_path = path;
+        m_has_pending  = true;
+
+        m_save_state.store(save_state::Saving, std::memory_order_release);
+
+        if (m_saving)
+        {
+            return;
+        }
+
+        // Le thread précédent a fini son travail et ne fait plus que se terminer.
+        if (m_save_thread.joinable())
+        {
+            m_save_thread.join();
+        }
+
+        m_saving      = true;
+        m_save_thread = std::thread(&scene::save_main, this);
+    }
+
+    void scene::wait()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_save_mutex);
+            m_save_condition.wait(lock, [this] { return !m_saving; });
+        }
+
+        if (m_save_thread.joinable())
+        {
+            m_save_thread.join();
+        }
+    }
+
+    scene::save_state scene::get_save_state() const noexcept
+    {
+        return m_save_state.load(std::memory_order_acquire);
+    }
+
+    bool scene::load(const std::filesystem::path &path)
+    {
+        mapped_file file;
+
+        if (!file.open(path) || file.get_size() < sizeof(scene_header))
+        {
+            return false;
+        }
+
+        const uint8 *data = file.get_data();
+        const usize size  = file.get_size();
+
+        scene_header header;
+        std::memcpy(&header, data, sizeof(header));
+
+        const usize names_offset = sizeof(scene_header) + sizeof(scene_asset_record) * static_cast<usize>(header.asset_count);
+
+        if (header.magic != scene_magic || header.version != scene_version ||
+            names_offset + header.names_size > size || header.objects_offset < names_offset + header.names_size ||
+            header.objects_offset + sizeof(scene_object_record) * static_cast<usize>(header.object_count) > size)
+        {
+            return false;
+        }
+
+        std::vector<uint64> ids(header.asset_count);
+        std::unordered_map<uint64, asset_info> assets;
+        uint32 index;
+
+        for (index = 0; index < header.asset_count; ++index)
+        {
+            scene_asset_record record;
+            std::memcpy(&record, data + sizeof(scene_header) + sizeof(scene_asset_record) * index, sizeof(record));
+
+            if (static_cast<usize>(record.name_offset) + record.name_size > header.names_size)
+            {
+                return false;
+            }
+
+            ids[index] = record.id;
+
+            const char *name = reinterpret_cast<const char *>(data + names_offset + record.name_offset);
+
+            if (record.name_size != 0)
+            {
+                assets[record.id] = { static_cast<scene_asset_kind>(record.kind), std::string(name, record.name_size) };
+            }
+        }
+
+        const auto resolve = [&ids](uint32 asset, uint64 &id) {
+            if (asset == scene_no_asset)
+            {
+                id = 0;
+
+                return true;
+            }
+
+            if (asset >= ids.size())
+            {
+                return false;
+            }
+
+            id = ids[asset];
+
+            return true;
+        };
+
+        std::vector<scene_object> objects(header.object_count);
+
+        for (index = 0; index < header.object_count; ++index)
+        {
+            scene_object_record record;
+            std::memcpy(&record, data + header.objects_offset + sizeof(scene_object_record) * index, sizeof(record));
+
+            scene_object &object = objects[index];
+
+            if (!resolve(record.mesh, object.mesh) || !resolve(record.vertex_shader, object.vertex_shader) ||
+                !resolve(record.pixel_shader, object.pixel_shader) || !resolve(record.texture, object.texture))
+            {
+                return false;
+            }
+
+            std::memcpy(object.location, record.location, sizeof(object.location));
+            std::memcpy(object.rotation, record.rotation, sizeof(object.rotation));
+            std::memcpy(object.scale, record.scale, sizeof(object.scale));
+        }
+
+        clear();
+
+        // Les noms déjà enregistrés par le moteur restent valables, ceux du fichier complètent la table.
+        for (auto &[id, info] : assets)
+        {
+            m_assets.emplace(id, std::move(info));
+        }
+
+        for (const scene_object &object : objects)
+        {
+            add_object(object);
+        }
+
+        return true;
+    }
+
+    scene::chunk &scene::get_chunk_for_write(uint32 index)
+    {
+        std::shared_ptr<chunk> &target = m_chunks[index];
+
+        // L'acquisition garantit que le thread d'enregistrement a fini de lire les blocs des captures libérées.
+        if (m_chunk_generations[index] > m_released_generation.load(std::memory_order_acquire))
+        {
+            std::shared_ptr<chunk> copy = std::make_shared<chunk>();
+            copy->reserve(chunk_size);
+            copy->assign(target->begin(), target->end());
+
+            target = std::move(copy);
+        }
+
+        // Seul le thread de rendu crée des captures : le bloc n'est plus partagé jusqu'à la prochaine.
+        m_chunk_generations[index] = 0;
+
+        return *target;
+    }
+
+    void scene::save_main()
+    {
+        for (;;)
+        {
+            snapshot captured;
+            std::filesystem::path path;
+
+            {
+                std::lock_guard<std::mutex> lock(m_save_mutex);
+
+                if (!m_has_pending)
+                {
+                    m_saving = false;
+                    m_save_condition.notify_all();
+
+                    return;
+                }
+
+                captured      = std::move(m_pending);
+                path          = std::move(m_pending_path);
+                m_has_pending = false;
+            }
+
+            const bool written    = write(captured, path, m_context);
+            const uint64 released = captured.generation;
+
+            // Les captures plus anciennes ont déjà été écrites ou remplacées : tous leurs blocs sont libérés.
+            captured.chunks.clear();
+            m_released_generation.store(released, std::memory_order_release);
+
+            std::lock_guard<std::mutex> lock(m_save_mutex);
+
+            // Une capture demandée pendant l'écriture garde l'état Saving jusqu'à la sienne.
+            if (!m_has_pending)
+            {
+                m_save_state.store(written ? save_state::Saved : save_state::Failed, std::memory_order_release);
+            }
+        }
+    }
+
+    bool scene::write(const snapshot &captured, const std::filesystem::path &path, const ref<ctx> &context)
+    {
+        std::unordered_map<uint64, uint32> indices;
+        std::vector<uint64> ids;
+        std::vector<scene_object_record> objects;
+
+        objects.reserve(captured.object_count);
+
+        for (const std::shared_ptr<const chunk> &objects_chunk : captured.chunks)
+        {
+            for (const scene_object &object : *objects_chunk)
+            {
+                scene_object_record record = {};
+                record.mesh                = get_asset_index(object.mesh, indices, ids);
+                record.vertex_shader       = get_asset_index(object.vertex_shader, indices, ids);
+                record.pixel_shader        = get_asset_index(object.pixel_shader, indices, ids);
+                record.texture             = get_asset_index(object.texture, indices, ids);
+
+                std::memcpy(record.location, object.location, sizeof(record.location));
+                std::memcpy(record.rotation, object.rotation, sizeof(record.rotation));
+                std::memcpy(record.scale, object.scale, sizeof(record.scale));
+
+                objects.push_back(record);
+            }
+        }
+
+        std::vector<scene_asset_record> assets(ids.size());
+        std::string names;
+        usize index;
+
+        for (index = 0; index < ids.size(); ++index)
+        {
+            auto found = captured.assets.find(ids[index]);
+
+            assets[index]    = {};
+            assets[index].id = ids[index];
+
+            // Une ressource sans nom connu garde son identifiant : elle pourra être retrouvée par un autre moyen.
+            if (found != captured.assets.end())
+            {
+                // Un nom tronqué ne désignerait plus la ressource : l'enregistrement échoue plutôt.
+                if (found->second.name.size() > scene_max_name_size)
+                {
+                    return false;
+                }
+
+                assets[index].name_offset = static_cast<uint32>(names.size());
+                assets[index].name_size   = static_cast<uint16>(found->second.name.size());
+                assets[index].kind        = static_cast<uint16>(found->second.kind);
+
+                names += found->second.name;
+            }
+        }
+
+        scene_header header   = {};
+        header.magic          = scene_magic;
+        header.version        = scene_version;
+        header.asset_count    = static_cast<uint32>(assets.size());
+        header.names_size     = static_cast<uint32>(names.size());
+        header.object_count   = static_cast<uint32>(objects.size());
+        header.objects_offset = static_cast<uint32>(sizeof(scene_header) + sizeof(scene_asset_record) * assets.size() + names.size());
+
+        // Les objets sont alignés sur 4 octets pour être lus directement.
+        const uint8 padding[4] = {};
+        const usize padding_size = (4 - header.objects_offset % 4) % 4;
+        header.objects_offset += static_cast<uint32>(padding_size);
+
+        std::filesystem::path temporary_path = path;
+        temporary_path += ".tmp";
+
+        file_stream fs = file_stream(context, temporary_path.c_str(), core_fs::file_mode::Create, core_fs::file_access::Write, core_fs::file_share::Read);
+
+        if (!fs.open())
+        {
+            return false;
+        }
+
+        usize bytes_written;
+
+        const bool written = fs.write(&header, sizeof(header), &bytes_written) &&
+                             fs.write(assets.data(), sizeof(scene_asset_record) * assets.size(), &bytes_written) &&
+                             fs.write(names.data(), names.size(), &bytes_written) &&
+                             fs.write(padding, padding_size, &bytes_written) &&
+                             fs.write(objects.data(), sizeof(scene_object_record) * objects.size(), &bytes_written);
+
+        fs.close();
+
+        std::error_code error;
+
+        if (!written)
+        {
+            std::filesystem::remove(temporary_path, error);
+
+            return false;
+        }
+
+        std::filesystem::rename(temporary_path, path, error);
+
+        return !error;
+    }
+} // namespace deep
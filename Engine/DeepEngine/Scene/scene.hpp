@@ -0,0 +1,169 @@
+#ifndef DEEP_ENGINE_SCENE_HPP
+#define DEEP_ENGINE_SCENE_HPP
+
+#include "DeepEngine/Scene/scene_format.hpp"
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/memory/ref_counted.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace deep
+{
+    /**
+     * @brief Objet ajouté à la scène, qui désigne ses ressources par leur identifiant.
+     */
+    struct scene_object
+    {
+        uint64 mesh;
+        uint64 vertex_shader;
+        uint64 pixel_shader;
+
+        // 0 si l'objet n'utilise pas de texture.
+        uint64 texture;
+
+        float location[3];
+        float rotation[3];
+        float scale[3];
+    };
+
+    /**
+     * @brief Objets ajoutés par l'utilisateur, enregistrés dans un fichier binaire en arrière-plan.
+     *
+     * Les objets sont rangés par blocs partagés et copiés à l'écriture : une capture pour l'enregistrement ne copie
+     * que les pointeurs des blocs, et seul un bloc modifié pendant qu'une capture le partage est dupliqué. Le thread
+     * de rendu n'attend donc jamais l'enregistrement, quelle que soit la taille de la scène.
+     *
+     * Les méthodes publiques doivent être appelées depuis le thread de rendu.
+     *
+     * La classe n'est pas exportée et n'est utilisée que de manière interne, à travers un pointeur.
+     */
+    class scene
+    {
+      public:
+        // Nombre d'objets par bloc partagé.
+        static constexpr uint32 chunk_size = 1024;
+
+        enum class save_state
+        {
+            Idle,
+            Saving,
+            Saved,
+            Failed
+        };
+
+      public:
+        explicit scene(const ref<ctx> &context);
+        ~scene();
+
+        scene(const scene &)            = delete;
+        scene &operator=(const scene &) = delete;
+
+        /**
+         * @brief Calcule l'identifiant d'une ressource à partir de son nom, stable d'une exécution à l'autre.
+         */
+        static uint64 make_asset_id(const char *name) noexcept;
+
+        /**
+         * @brief Enregistre le nom d'une ressource pour que les fichiers de scène puissent le retrouver.
+         * @return L'identifiant de la ressource.
+         */
+        uint64 register_asset(scene_asset_kind kind, const char *name);
+
+        /**
+         * @return Le nom d'une ressource enregistrée ou lue dans un fichier, nullptr si elle est inconnue.
+         */
+        const char *get_asset_name(uint64 id) const noexcept;
+
+        uint32 add_object(const scene_object &object);
+        void set_transform(uint32 index, const float *location, const float *rotation, const float *scale);
+        const scene_object &get_object(uint32 index) const noexcept;
+        uint32 get_object_count() const noexcept;
+        void clear();
+
+        /**
+         * @brief Capture la scène et l'écrit dans un fichier depuis un thread d'enregistrement.
+         *
+         * Si un enregistrement est en cours, la capture le suit une fois terminé. Le fichier est écrit à côté puis
+         * renommé : une scène enregistrée n'est jamais tronquée.
+         */
+        void save_async(const std::filesystem::path &path);
+
+        /**
+         * @brief Attend la fin des enregistrements demandés.
+         */
+        void wait();
+
+        save_state get_save_state() const noexcept;
+
+        /**
+         * @brief Remplace la scène par celle d'un fichier.
+         * @return false si le fichier n'existe pas ou n'est pas valide. La scène est alors inchangée.
+         */
+        bool load(const std::filesystem::path &path);
+
+      private:
+        using chunk = std::vector<scene_object>;
+
+        struct asset_info
+        {
+            scene_asset_kind kind;
+            std::string name;
+        };
+
+        /**
+         * @brief État de la scène figé au moment de la capture, partagé avec elle jusqu'à sa prochaine modification.
+         */
+        struct snapshot
+        {
+            std::vector<std::shared_ptr<const chunk>> chunks;
+            std::unordered_map<uint64, asset_info> assets;
+            uint32 object_count;
+            uint64 generation;
+        };
+
+      private:
+        // Duplique le bloc si une capture qui le partage n'a pas encore été libérée.
+        chunk &get_chunk_for_write(uint32 index);
+
+        void save_main();
+
+        static bool write(const snapshot &captured, const std::filesystem::path &path, const ref<ctx> &context);
+
+      private:
+        ref<ctx> m_context;
+
+        std::vector<std::shared_ptr<chunk>> m_chunks;
+        std::unordered_map<uint64, asset_info> m_assets;
+        uint32 m_object_count;
+
+        // Numéro de la dernière capture, et pour chaque bloc celui de la dernière capture qui le partage, 0 si aucune.
+        uint64 m_capture_generation;
+        std::vector<uint64> m_chunk_generations;
+
+        // Les captures jusqu'à ce numéro ont été écrites ou remplacées et ne partagent plus leurs blocs.
+        std::atomic<uint64> m_released_generation;
+
+        std::mutex m_save_mutex;
+        std::condition_variable m_save_condition;
+        std::thread m_save_thread;
+        bool m_saving;
+
+        // Dernière capture demandée, écrite après celle en cours.
+        snapshot m_pending;
+        std::filesystem::path m_pending_path;
+        bool m_has_pending;
+
+        std::atomic<save_state> m_save_state;
+    };
+} // namespace deep
+
+#endif
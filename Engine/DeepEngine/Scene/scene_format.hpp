@@ -0,0 +1,66 @@
+#ifndef DEEP_ENGINE_SCENE_FORMAT_HPP
+#define DEEP_ENGINE_SCENE_FORMAT_HPP
+
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    // 'DSCN'
+    constexpr uint32 scene_magic   = 0x4E435344;
+    constexpr uint16 scene_version = 1;
+
+    // Indice d'une référence absente, une texture pour un objet qui n'en utilise pas par exemple.
+    constexpr uint32 scene_no_asset = 0xFFFFFFFF;
+
+    // Longueur maximale d'un nom de ressource, limitée par scene_asset_record::name_size.
+    constexpr usize scene_max_name_size = 0xFFFF;
+
+    enum class scene_asset_kind : uint16
+    {
+        Mesh,
+        VertexShader,
+        PixelShader,
+        Texture
+    };
+
+    /**
+     * @brief En-tête d'un fichier de scène écrit par scene::save_async.
+     *
+     * L'en-tête est suivi de la table des ressources, de leurs noms puis des objets. Les objets désignent les
+     * ressources par leur indice dans la table, qui donne leur identifiant et leur nom. Toutes les valeurs sont
+     * en little-endian.
+     */
+    struct scene_header
+    {
+        uint32 magic;
+        uint16 version;
+        uint16 reserved;
+        uint32 asset_count;
+        uint32 names_size;
+        uint32 object_count;
+        uint32 objects_offset;
+    };
+
+    struct scene_asset_record
+    {
+        // Hash du nom de la ressource, voir scene::make_asset_id.
+        uint64 id;
+        uint32 name_offset;
+        uint16 name_size;
+        uint16 kind;
+    };
+
+    struct scene_object_record
+    {
+        uint32 mesh;
+        uint32 vertex_shader;
+        uint32 pixel_shader;
+        uint32 texture;
+
+        float location[3];
+        float rotation[3];
+        float scale[3];
+    };
+} // namespace deep
+
+#endif
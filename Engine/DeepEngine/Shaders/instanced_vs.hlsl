@@ -0,0 +1,27 @@
+cbuffer PerFrame : register(b0)
+{
+    matrix view;
+    matrix projection;
+};
+
+cbuffer PerObject : register(b1)
+{
+    matrix view_proj;
+};
+
+struct instance
+{
+    float4 world0 : World0;
+    float4 world1 : World1;
+    float4 world2 : World2;
+    float4 world3 : World3;
+};
+
+float4 main_vs(float3 position : Position, instance inst) : SV_Position
+{
+    // La matrice monde est envoyée telle qu'elle est en mémoire, une ligne par attribut.
+    float4 local = float4(position, 1.0f);
+    float4 world = float4(dot(inst.world0, local), dot(inst.world1, local), dot(inst.world2, local), dot(inst.world3, local));
+
+    return mul(world, view_proj);
+}
@@ -6,14 +6,26 @@
 #include "D3D/drawable/cube.hpp"
 #include "D3D/drawable/textured_cube.hpp"
 #include "D3D/drawable/plane.hpp"
+#include "D3D/drawable/instanced_drawable.hpp"
 
 namespace deep
 {
+    // Formes dont les instances peuvent être ajoutées à la scène.
+    enum class basic_shape_kind
+    {
+        Cube,
+        Plane
+    };
+
     struct basic_shapes
     {
         ref<D3D::cube> cube;
         ref<D3D::textured_cube> textured_cube;
         ref<D3D::plane> plane;
+
+        // Groupes d'instances toujours présents dans la scène, dessinés en un seul appel chacun.
+        ref<D3D::instanced_drawable> cube_instances;
+        ref<D3D::instanced_drawable> plane_instances;
     };
 } // namespace deep
 
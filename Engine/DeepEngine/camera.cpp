@@ -7,6 +7,8 @@ namespace deep
     camera::camera(const ref<ctx> &context, const fvec3 &location) noexcept
             : object(context),
               m_location(location),
+              m_previous_location(location),
+              m_interpolation(1.0f),
               m_yaw(0.0f),
               m_pitch(0.0f),
               m_z_near(0.0f),
@@ -89,7 +91,23 @@ namespace deep
 
     void camera::set_location(const fvec3 &location) noexcept
     {
-        m_location = location;
+        m_location          = location;
+        m_previous_location = location;
+    }
+
+    void camera::begin_tick() noexcept
+    {
+        m_previous_location = m_location;
+    }
+
+    void camera::set_interpolation(float alpha) noexcept
+    {
+        m_interpolation = alpha;
+    }
+
+    fvec3 camera::get_render_location() const noexcept
+    {
+        return m_previous_location * (1.0f - m_interpolation) + m_location * m_interpolation;
     }
 
     float camera::get_yaw() const noexcept
@@ -215,10 +233,10 @@ namespace deep
 
     fmat4 camera::get_view() const noexcept
     {
-        fvec3 forward = get_forward_axis();
-        fvec3 target  = m_location + forward;
+        fvec3 location = get_render_location();
+        fvec3 target   = location + get_forward_axis();
 
-        return fmat4::d3d_look_at_lh(m_location, target, fvec3(0.0f, 1.0f, 0.0f));
+        return fmat4::d3d_look_at_lh(location, target, fvec3(0.0f, 1.0f, 0.0f));
     }
 
     fmat4 camera::get_projection() const noexcept
@@ -31,10 +31,27 @@ namespace deep
         const fvec3 get_location() const noexcept;
 
         /**
-         * @brief Modifie la position relative au monde.
+         * @brief Modifie la position relative au monde, sans interpolation depuis la position précédente.
          */
         void set_location(const fvec3 &location) noexcept;
 
+        /**
+         * @brief Mémorise la position avant une mise à jour de la simulation, pour l'interpoler au rendu.
+         */
+        void begin_tick() noexcept;
+
+        /**
+         * @brief Place le rendu entre la position précédant la dernière mise à jour et la position actuelle.
+         * @param alpha La fraction du pas de simulation écoulée depuis la dernière mise à jour, entre 0 et 1.
+         * @remarks La rotation suit directement la souris et n'est pas interpolée.
+         */
+        void set_interpolation(float alpha) noexcept;
+
+        /**
+         * @brief Récupère la position affichée, interpolée entre les deux dernières mises à jour.
+         */
+        fvec3 get_render_location() const noexcept;
+
         float get_yaw() const noexcept;
         void set_yaw(float degrees) noexcept;
         float get_pitch() const noexcept;
@@ -66,6 +83,10 @@ namespace deep
         // Coordonnées relative au "world space".
         DEEP_FVEC3(m_location)
 
+        // Position avant la dernière mise à jour de la simulation.
+        DEEP_FVEC3(m_previous_location)
+        float m_interpolation;
+
         float m_yaw;
         float m_pitch;
 
@@ -3,17 +3,23 @@
 #include "D3D/shader/shader_factory.hpp"
 #include "D3D/drawable/drawable_factory.hpp"
 #include "D3D/device_context.hpp"
+#include "D3D/null_graphics.hpp"
+#include "D3D/software_graphics.hpp"
 #include "D3D/buffer/per_frame_buffer.hpp"
 #include "Assimp/loader.hpp"
+#include "DeepEngine/HotReload/hot_reloader.hpp"
+#include "DeepEngine/Assets/asset_loader.hpp"
+#include "DeepEngine/Scene/scene.hpp"
 
 #include <DeepLib/lib.hpp>
 #include <DeepLib/context.hpp>
 #include <DeepLib/time/time.hpp>
 #include <DeepLib/string/string_native.hpp>
-#include <DeepLib/stream/file_stream.hpp>
 #include <DeepCore/display.hpp>
 #include <DeepLib/filesystem/filesystem.hpp>
-#include <DeepLib/image/png.hpp>
+
+#include <chrono>
+#include <filesystem>
 
 #include <imgui.h>
 #include <imgui_impl_win32.h>
@@ -23,6 +29,71 @@ extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg
 
 namespace
 {
+    // Définition utilisée par les backends qui ne possèdent pas de fenêtre.
+    constexpr deep::uint32 headless_width  = 1280;
+    constexpr deep::uint32 headless_height = 720;
+
+    // Matrice monde des instances, ajoutée à l'input layout des sommets du shader instancié.
+    const deep::D3D::input_element_desc instance_ied[] = {
+        { "World", 0, deep::D3D::element_format::Float4, deep::D3D::device_context::instance_buffer_slot, 0, deep::D3D::input_rate::PerInstance, 1 },
+        { "World", 1, deep::D3D::element_format::Float4, deep::D3D::device_context::instance_buffer_slot, sizeof(float) * 4, deep::D3D::input_rate::PerInstance, 1 },
+        { "World", 2, deep::D3D::element_format::Float4, deep::D3D::device_context::instance_buffer_slot, sizeof(float) * 8, deep::D3D::input_rate::PerInstance, 1 },
+        { "World", 3, deep::D3D::element_format::Float4, deep::D3D::device_context::instance_buffer_slot, sizeof(float) * 12, deep::D3D::input_rate::PerInstance, 1 }
+    };
+
+    constexpr deep::uint32 instance_ied_count = sizeof(instance_ied) / sizeof(deep::D3D::input_element_desc);
+
+    /**
+     * @brief Input layouts des shaders des formes de base, qui dépendent de la compression des sommets.
+     */
+    struct basic_layouts
+    {
+        deep::D3D::input_element_desc basic[deep::D3D::vertex_quantizer::max_layout_elements];
+        deep::D3D::input_element_desc textured[deep::D3D::vertex_quantizer::max_layout_elements];
+        deep::D3D::input_element_desc instanced[deep::D3D::vertex_quantizer::max_layout_elements + instance_ied_count];
+
+        deep::uint32 basic_count;
+        deep::uint32 textured_count;
+        deep::uint32 instanced_count;
+    };
+
+    basic_layouts get_basic_layouts(deep::D3D::vertex_compression compression) noexcept
+    {
+        basic_layouts layouts;
+
+        layouts.basic_count    = deep::D3D::vertex_quantizer::get_input_layout({ false, false, compression }, layouts.basic);
+        layouts.textured_count = deep::D3D::vertex_quantizer::get_input_layout({ true, false, compression }, layouts.textured);
+
+        layouts.instanced_count = deep::D3D::vertex_quantizer::get_input_layout({ false, false, compression }, layouts.instanced);
+
+        for (const deep::D3D::input_element_desc &element : instance_ied)
+        {
+            layouts.instanced[layouts.instanced_count++] = element;
+        }
+
+        return layouts;
+    }
+
+    const deep::native_char *const basic_png_path  = DEEP_TEXT_NATIVE("Resources") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("Textures") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("texture.png");
+    const deep::native_char *const basic_dtex_path = DEEP_TEXT_NATIVE("Resources") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("Textures") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("texture.dtex");
+
+    /**
+     * @brief La texture préparée par DeepEngineTools (--cook-texture) est préférée à l'image PNG, qui doit être décodée.
+     */
+    const deep::native_char *get_basic_texture_path() noexcept
+    {
+        std::error_code error;
+
+        return std::filesystem::exists(basic_dtex_path, error) ? basic_dtex_path : basic_png_path;
+    }
+
+    // Noms des ressources des formes de base, tels qu'ils sont enregistrés dans les fichiers de scène.
+    const char *const basic_cube_name   = "basic_cube";
+    const char *const basic_plane_name  = "basic_plane";
+    const char *const instanced_vs_name = "instanced_vs.cso";
+    const char *const cube_ps_name      = "cube_ps.cso";
+    const char *const plane_ps_name     = "plane_ps.cso";
+
     bool window_activate_callback(void *data)
     {
         deep::window *win = static_cast<deep::window *>(data);
@@ -56,10 +127,10 @@ namespace deep
 {
     void init_imgui_d3d(D3D::graphics *graph)
     {
-        ImGui_ImplDX11_Init(graph->get_device().Get(), graph->get_device_context().get());
+        ImGui_ImplDX11_Init(graph->get_d3d_device().Get(), graph->get_device_context().get());
     }
 
-    ref<engine> engine::create() noexcept
+    ref<engine> engine::create(D3D::renderer_backend backend, D3D::vertex_compression vertex_compression) noexcept
     {
         ref<ctx> context = lib::create_ctx();
 
@@ -85,6 +156,81 @@ namespace deep
 
         eng->m_startup_tick_count  = time::get_tick_count();
         eng->m_startup_time_millis = time::get_current_time_millis();
+        eng->m_vertex_compression  = vertex_compression;
+
+        // Les ressources des formes de base sont lues en arrière-plan pendant la création de la fenêtre et du
+        // renderer : init_basic_shapes n'attend que celles qui ne sont pas encore prêtes.
+        eng->m_asset_loader = mem::alloc_type<asset_loader>(context.get(), context);
+
+        if (eng->m_asset_loader == nullptr)
+        {
+            context->err() << DEEP_TEXT_UTF8("[ERROR] Asset loader creation failed.\r\n");
+
+            return ref<engine>();
+        }
+
+        eng->m_scene = mem::alloc_type<scene>(context.get(), context);
+
+        if (eng->m_scene == nullptr)
+        {
+            context->err() << DEEP_TEXT_UTF8("[ERROR] Scene creation failed.\r\n");
+
+            return ref<engine>();
+        }
+
+        eng->m_scene->register_asset(scene_asset_kind::Mesh, basic_cube_name);
+        eng->m_scene->register_asset(scene_asset_kind::Mesh, basic_plane_name);
+        eng->m_scene->register_asset(scene_asset_kind::VertexShader, instanced_vs_name);
+        eng->m_scene->register_asset(scene_asset_kind::PixelShader, cube_ps_name);
+        eng->m_scene->register_asset(scene_asset_kind::PixelShader, plane_ps_name);
+
+        // Les ressources livrées sont regroupées dans une archive, absente pendant le développement.
+        if (eng->m_asset_loader->mount(DEEP_TEXT_NATIVE("resources.dpak")))
+        {
+            context->out() << DEEP_TEXT_UTF8("Mounted 'resources.dpak'.\r\n");
+        }
+
+        eng->load_basic_assets();
+
+        if (backend != D3D::renderer_backend::Direct3D11)
+        {
+            context->out() << DEEP_TEXT_UTF8("Creating camera...");
+
+            eng->m_camera = ref<camera>(context, mem::alloc_type<camera>(context.get(), context, fvec3(0.0f, 0.0f, 0.0f)));
+            if (!eng->m_camera.is_valid())
+            {
+                context->out() << DEEP_TEXT_UTF8(" failed\r\n");
+                context->err() << DEEP_TEXT_UTF8("[ERROR] Camera creation failed.\r\n");
+
+                return ref<engine>();
+            }
+            eng->m_camera->set_lens(90.0f, static_cast<float>(headless_width) / static_cast<float>(headless_height), 1.0f, 1000.0f);
+
+            context->out() << DEEP_TEXT_UTF8(" OK\r\n");
+
+            if (backend == D3D::renderer_backend::Software)
+            {
+                eng->m_renderer = ref_cast<D3D::renderer>(D3D::software_graphics::create(context, headless_width, headless_height, fvec4(0.0f, 0.0f, 0.0f, 1.0f)));
+            }
+            else
+            {
+                eng->m_renderer = ref_cast<D3D::renderer>(D3D::null_graphics::create(context, headless_width, headless_height, fvec4(0.0f, 0.0f, 0.0f, 1.0f)));
+            }
+
+            if (!eng->m_renderer.is_valid())
+            {
+                context->err() << DEEP_TEXT_UTF8("[ERROR] Headless renderer creation failed.\r\n");
+
+                return ref<engine>();
+            }
+
+            if (!eng->init_basic_shapes())
+            {
+                return ref<engine>();
+            }
+
+            return eng;
+        }
 
         uint32 primary_monitor_index = 0;
         uint32 width;
@@ -126,6 +272,17 @@ namespace deep
 
         eng->m_imgui_manager->init(eng->m_window->get_handle());
 
+        // L'icône est placée dans le panneau de débogage dès que son chargement est terminé.
+        ref<imgui_manager> manager = eng->m_imgui_manager;
+
+        eng->m_asset_loader->load_texture(DEEP_TEXT_NATIVE("Resources") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("Textures") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("icon.png"),
+                                          [manager](const asset_loader::asset &icon) {
+                                              if (icon.get_state() == asset_loader::asset_state::Ready)
+                                              {
+                                                  manager->get_debug_panel()->set_icon(icon.get_texture());
+                                              }
+                                          });
+
         context->out() << DEEP_TEXT_UTF8(" OK\r\nCreating camera...");
 
         eng->m_camera = ref<camera>(context, mem::alloc_type<camera>(context.get(), context, fvec3(0.0f, 0.0f, 0.0f)));
@@ -141,45 +298,23 @@ namespace deep
         context->out() << DEEP_TEXT_UTF8(" OK\r\n");
 
         eng->m_graphics = D3D::graphics::create(context, *eng->m_window, fvec4(0.0f, 0.0f, 0.0f, 1.0f), eng->m_camera->get_location(), init_imgui_d3d);
+        eng->m_renderer = ref_cast<D3D::renderer>(eng->m_graphics);
 
         eng->m_window->set_pre_callback(ImGui_ImplWin32_WndProcHandler);
         eng->m_window->set_activate_callback(window_activate_callback);
         eng->m_window->set_deactivate_callback(window_deactivate_callback);
 
+        // Les ressources sont enregistrées par init_basic_shapes au fur et à mesure de leur chargement.
+        eng->m_hot_reloader = mem::alloc_type<hot_reloader>(context.get(), context, eng->m_renderer);
+
         if (!eng->init_basic_shapes())
         {
             return ref<engine>();
         }
 
-        file_stream icon_stream = file_stream(context,
-                                              DEEP_TEXT_NATIVE("Resources") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("Textures") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("icon.png"),
-                                              core_fs::file_mode::Open,
-                                              core_fs::file_access::Read,
-                                              core_fs::file_share::Read);
-        icon_stream.open();
-
-        png icon_png = png::load(context, &icon_stream);
-
-        if (icon_png.is_valid() &&
-            icon_png.check() &&
-            icon_png.read_info())
-        {
-            image icon_img = icon_png.read_image();
-
-            if (icon_img.is_valid())
-            {
-                ref<D3D::texture> tex1 = D3D::resource_factory::create_texture(context, icon_img, eng->m_graphics->get_device());
-
-                eng->m_imgui_manager->get_debug_panel()->set_icon(tex1);
-            }
-            else
-            {
-                context->err() << DEEP_TEXT_UTF8("[ERROR] Cannot read image data from 'icon.png'.\r\n");
-            }
-        }
-        else
+        if (eng->m_hot_reloader != nullptr)
         {
-            context->err() << DEEP_TEXT_UTF8("[ERROR] Cannot load 'icon.png'.\r\n");
+            eng->m_hot_reloader->start();
         }
 
         eng->m_window->show();
@@ -201,13 +336,17 @@ namespace deep
 
     void engine::run() noexcept
     {
-        uint64 tick_count;
+        using clock = std::chrono::steady_clock;
+
         uint64 elapsed;
-        uint64 previous_tick_count = time::get_tick_count();
-        uint64 lag                 = 0;
-        uint32 cn                  = 0;
-        uint64 start_time          = time::get_current_time_millis();
+        clock::time_point previous_time = clock::now();
+        clock::duration lag             = clock::duration::zero();
+        uint32 cn                       = 0;
+        uint64 start_time               = time::get_current_time_millis();
         uint64 end_time;
+        uint64 frame_count    = 0;
+        uint64 run_start_time = start_time;
+        bool headless         = is_headless();
 
         ///////////////
         // TEST ZONE //
@@ -217,32 +356,73 @@ namespace deep
         // END OF TEST ZONE //
         //////////////////////
 
-        // Boucle infinie du jeu. S'arrête quand l'utilisateur ferme la fenêtre.
-        while (!m_should_close && m_window->process_message())
+        // Boucle infinie du jeu. S'arrête quand l'utilisateur ferme la fenêtre,
+        // ou quand le nombre d'images demandé a été atteint.
+        while (!m_should_close && (headless || m_window->process_message()))
         {
+            if (m_max_frames != 0 && frame_count >= m_max_frames)
+            {
+                break;
+            }
+
             // Calcule le temps passé à faire la boucle.
-            tick_count          = time::get_tick_count();
-            elapsed             = tick_count - previous_tick_count;
-            previous_tick_count = tick_count;
-            lag += elapsed; // Plus le système est lent, et plus le lag sera élevé.
+            const clock::time_point now = clock::now();
+            lag += now - previous_time; // Plus le système est lent, et plus le lag sera élevé.
+            previous_time = now;
 
-            if (!process_inputs())
+            if (!headless && !process_inputs())
             {
                 break;
             }
 
-            m_graphics->clear_buffer();
+            // La simulation rattrape le temps écoulé par pas fixes, quel que soit le nombre d'images par seconde.
+            const clock::duration step = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / m_simulation_rate));
+            const float step_seconds   = 1.0f / static_cast<float>(m_simulation_rate);
+            uint32 ticks               = 0;
 
-            m_graphics->draw_all(m_camera->get_projection(), m_camera->get_view());
+            while (lag >= step && ticks < max_ticks_per_frame)
+            {
+                m_camera->begin_tick();
 
-            if (m_imgui_manager->is_enabled())
+                update(step_seconds);
+
+                lag -= step;
+                ticks++;
+            }
+
+            if (lag >= step)
+            {
+                lag %= step;
+            }
+
+            // L'image affiche l'état entre les deux dernières mises à jour, selon le temps restant.
+            m_camera->set_interpolation(static_cast<float>(static_cast<double>(lag.count()) / static_cast<double>(step.count())));
+
+            // Les ressources rechargées sont échangées entre deux images.
+            if (m_hot_reloader != nullptr)
+            {
+                m_hot_reloader->apply(m_basic_shapes);
+            }
+
+            // Les ressources chargées en arrière-plan sont créées entre deux images.
+            m_asset_loader->process(*m_renderer);
+
+            m_renderer->clear_buffer();
+
+            m_renderer->draw_all(m_camera->get_projection(), m_camera->get_view());
+
+            if (!headless && m_imgui_manager->is_enabled())
             {
                 m_imgui_manager->draw_all(m_graphics);
             }
 
-            m_graphics->end_frame();
+            m_renderer->end_frame();
+
+            // Sans synchronisation verticale, seul le limiteur empêche la boucle d'occuper tout un cœur.
+            m_frame_limiter.wait();
 
             // Met à jour le nombre de FPS.
+            frame_count++;
             cn++;
             end_time = time::get_current_time_millis();
             elapsed  = end_time - start_time;
@@ -260,36 +440,98 @@ namespace deep
 
         get_context()->out() << "DeepEngine ran for " << running_time_millis << "ms.\r\n";
 
+        if (headless)
+        {
+            uint64 loop_time_millis            = time::get_current_time_millis() - run_start_time;
+            const D3D::frame_stats &last_frame = m_renderer->get_last_frame_stats();
+
+            get_context()->out() << "Rendered " << frame_count << " frames in " << loop_time_millis << "ms, "
+                                 << last_frame.draw_calls << " draw calls and "
+                                 << last_frame.vertices << " vertices in the last frame, recorded in "
+                                 << last_frame.command_lists << " command lists on "
+                                 << m_renderer->get_recording_thread_count() << " threads, "
+                                 << last_frame.pipeline_cache_hits << "/" << last_frame.pipeline_lookups << " pipeline cache hits and "
+                                 << last_frame.redundant_state_sets << " redundant state sets.\r\n";
+
+            return;
+        }
+
         //////////////
         // SHUTDOWN //
         //////////////
+        if (m_hot_reloader != nullptr)
+        {
+            m_hot_reloader->stop();
+        }
+
+        // Un enregistrement de la scène demandé juste avant de quitter doit aller à son terme.
+        m_scene->wait();
+
         m_dot_net_host.shutdown();
         m_imgui_manager->shutdown();
     }
 
+    void engine::load_basic_assets() noexcept
+    {
+        const basic_layouts layouts = get_basic_layouts(m_vertex_compression);
+
+        m_asset_loader->load_vertex_shader(DEEP_TEXT_NATIVE("cube_vs.cso"), layouts.basic, layouts.basic_count);
+        m_asset_loader->load_pixel_shader(DEEP_TEXT_NATIVE("cube_ps.cso"));
+        m_asset_loader->load_vertex_shader(DEEP_TEXT_NATIVE("textured_cube_vs.cso"), layouts.textured, layouts.textured_count);
+        m_asset_loader->load_pixel_shader(DEEP_TEXT_NATIVE("textured_cube_ps.cso"));
+        m_asset_loader->load_vertex_shader(DEEP_TEXT_NATIVE("plane_vs.cso"), layouts.basic, layouts.basic_count);
+        m_asset_loader->load_pixel_shader(DEEP_TEXT_NATIVE("plane_ps.cso"));
+        m_asset_loader->load_vertex_shader(DEEP_TEXT_NATIVE("instanced_vs.cso"), layouts.instanced, layouts.instanced_count);
+        m_asset_loader->load_texture(get_basic_texture_path());
+    }
+
     bool engine::init_basic_shapes() noexcept
     {
-        const D3D11_INPUT_ELEMENT_DESC ied[] = {
-            { "Position", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 }
+        // Les ressources ont été demandées par load_basic_assets : ces appels récupèrent les mêmes, dont le
+        // chargement a pu se terminer pendant la création de la fenêtre.
+        const native_char *texture_path = get_basic_texture_path();
+        const basic_layouts layouts     = get_basic_layouts(m_vertex_compression);
+
+        const asset_loader::handle assets[] = {
+            m_asset_loader->load_vertex_shader(DEEP_TEXT_NATIVE("cube_vs.cso"), layouts.basic, layouts.basic_count),
+            m_asset_loader->load_pixel_shader(DEEP_TEXT_NATIVE("cube_ps.cso")),
+            m_asset_loader->load_vertex_shader(DEEP_TEXT_NATIVE("textured_cube_vs.cso"), layouts.textured, layouts.textured_count),
+            m_asset_loader->load_pixel_shader(DEEP_TEXT_NATIVE("textured_cube_ps.cso")),
+            m_asset_loader->load_vertex_shader(DEEP_TEXT_NATIVE("plane_vs.cso"), layouts.basic, layouts.basic_count),
+            m_asset_loader->load_pixel_shader(DEEP_TEXT_NATIVE("plane_ps.cso")),
+            m_asset_loader->load_vertex_shader(DEEP_TEXT_NATIVE("instanced_vs.cso"), layouts.instanced, layouts.instanced_count),
+            m_asset_loader->load_texture(texture_path)
         };
 
-        const D3D11_INPUT_ELEMENT_DESC textured_ied[] = {
-            { "Position", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-            { "TexCoord", 0, DXGI_FORMAT_R32G32_FLOAT, 0, sizeof(float) * 3, D3D11_INPUT_PER_VERTEX_DATA, 0 }
-        };
+        for (const asset_loader::handle &handle : assets)
+        {
+            m_asset_loader->wait(handle, *m_renderer);
+        }
 
-        // Création du shader pour les cubes.
-        file_stream fs = file_stream(get_context(), DEEP_TEXT_NATIVE("cube_vs.cso"), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
-        fs.open();
+        ref<D3D::vertex_shader> cube_vs          = assets[0]->get_vertex_shader();
+        ref<D3D::pixel_shader> cube_ps           = assets[1]->get_pixel_shader();
+        ref<D3D::vertex_shader> textured_cube_vs = assets[2]->get_vertex_shader();
+        ref<D3D::pixel_shader> textured_cube_ps  = assets[3]->get_pixel_shader();
+        ref<D3D::vertex_shader> plane_vs         = assets[4]->get_vertex_shader();
+        ref<D3D::pixel_shader> plane_ps          = assets[5]->get_pixel_shader();
+        ref<D3D::vertex_shader> instanced_vs     = assets[6]->get_vertex_shader();
+        ref<D3D::texture> tex1                   = assets[7]->get_texture();
 
-        ref<D3D::vertex_shader> cube_vs = D3D::shader_factory::create_vertex_shader(get_context(), &fs, ied, sizeof(ied) / sizeof(D3D11_INPUT_ELEMENT_DESC), m_graphics->get_device());
-        fs.close();
+        // Une texture préparée invalide est remplacée par l'image PNG d'origine.
+        const bool cooked_texture = tex1.is_valid() && texture_path != basic_png_path;
 
-        fs = file_stream(get_context(), DEEP_TEXT_NATIVE("cube_ps.cso"), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
-        fs.open();
+        if (!tex1.is_valid() && texture_path != basic_png_path)
+        {
+            asset_loader::handle png_texture = m_asset_loader->load_texture(basic_png_path);
 
-        ref<D3D::pixel_shader> cube_ps = D3D::shader_factory::create_pixel_shader(get_context(), &fs, m_graphics->get_device());
-        fs.close();
+            m_asset_loader->wait(png_texture, *m_renderer);
+            tex1 = png_texture->get_texture();
+        }
+
+        if (!tex1.is_valid())
+        {
+            return false;
+        }
 
         m_basic_shapes.cube = D3D::drawable_factory::create_cube(get_context(),
                                                                  cube_vs,
@@ -297,100 +539,70 @@ namespace deep
                                                                  fvec3(0.0f, 0.0f, 0.0f),
                                                                  fvec3(),
                                                                  fvec3(1.0f, 1.0f, 1.0f),
-                                                                 m_graphics->get_device());
+                                                                 m_renderer->get_device(),
+                                                                 m_vertex_compression);
 
         if (!m_basic_shapes.cube.is_valid())
         {
             return false;
         }
 
-        // Création du shader pour les cubes texturés.
-        fs = file_stream(get_context(), DEEP_TEXT_NATIVE("textured_cube_vs.cso"), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
-        fs.open();
-
-        ref<D3D::vertex_shader> textured_cube_vs = D3D::shader_factory::create_vertex_shader(get_context(), &fs, textured_ied, sizeof(textured_ied) / sizeof(D3D11_INPUT_ELEMENT_DESC), m_graphics->get_device());
-        fs.close();
-
-        fs = file_stream(get_context(), DEEP_TEXT_NATIVE("textured_cube_ps.cso"), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
-        fs.open();
-
-        ref<D3D::pixel_shader> textured_cube_ps = D3D::shader_factory::create_pixel_shader(get_context(), &fs, m_graphics->get_device());
-        fs.close();
-
-        fs = file_stream(get_context(),
-                         DEEP_TEXT_NATIVE("Resources") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("Textures") DEEP_NATIVE_SEPARATOR DEEP_TEXT_NATIVE("texture.png"),
-                         core_fs::file_mode::Open,
-                         core_fs::file_access::Read,
-                         core_fs::file_share::Read);
-        fs.open();
-
-        png png_source = png::load(get_context(), &fs);
-
-        if (png_source.is_valid() && png_source.check() && png_source.read_info())
-        {
-            image img_tex1 = png_source.read_image(image::color_space::RGBA);
-
-            if (img_tex1.is_valid())
-            {
-                ref<D3D::texture> tex1  = D3D::resource_factory::create_texture(get_context(), img_tex1, m_graphics->get_device());
-                ref<D3D::sampler> samp1 = D3D::resource_factory::create_sampler(get_context(), m_graphics->get_device());
-
-                m_basic_shapes.textured_cube = D3D::drawable_factory::create_textured_cube(
-                        get_context(),
-                        textured_cube_vs,
-                        textured_cube_ps,
-                        fvec3(0.0f, 0.0f, 0.0f),
-                        fvec3(),
-                        fvec3(1.0f, 1.0f, 1.0f),
-                        tex1,
-                        samp1,
-                        m_graphics->get_device());
-
-                if (!m_basic_shapes.textured_cube.is_valid())
-                {
-                    return false;
-                }
-            }
-            else
-            {
-                get_context()->err() << DEEP_TEXT_UTF8("[ERROR] Cannot read image data from 'texture.png'.\r\n");
-
-                return false;
-            }
-        }
-        else
+        ref<D3D::sampler> samp1 = D3D::resource_factory::create_sampler(get_context(), m_renderer->get_device());
+
+        m_basic_shapes.textured_cube = D3D::drawable_factory::create_textured_cube(
+                get_context(),
+                textured_cube_vs,
+                textured_cube_ps,
+                fvec3(0.0f, 0.0f, 0.0f),
+                fvec3(),
+                fvec3(1.0f, 1.0f, 1.0f),
+                tex1,
+                samp1,
+                m_renderer->get_device(),
+                m_vertex_compression);
+
+        if (!m_basic_shapes.textured_cube.is_valid())
         {
-            get_context()->err() << DEEP_TEXT_UTF8("[ERROR] Cannot load 'texture.png'.\r\n");
-
             return false;
         }
 
-        // Création du shader pour les plateaux.
-        fs = file_stream(get_context(), DEEP_TEXT_NATIVE("plane_vs.cso"), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
-        fs.open();
-
-        ref<D3D::vertex_shader> plane_vs = D3D::shader_factory::create_vertex_shader(get_context(), &fs, ied, sizeof(ied) / sizeof(D3D11_INPUT_ELEMENT_DESC), m_graphics->get_device());
-        fs.close();
-
-        fs = file_stream(get_context(), DEEP_TEXT_NATIVE("plane_ps.cso"), core_fs::file_mode::Open, core_fs::file_access::Read, core_fs::file_share::Read);
-        fs.open();
-
-        ref<D3D::pixel_shader> plane_ps = D3D::shader_factory::create_pixel_shader(get_context(), &fs, m_graphics->get_device());
-        fs.close();
-
         m_basic_shapes.plane = D3D::drawable_factory::create_plane(get_context(),
                                                                    plane_vs,
                                                                    plane_ps,
                                                                    fvec3(0.0f, 0.0f, 0.0f),
                                                                    fvec3(),
                                                                    fvec3(1.0f, 1.0f, 1.0f),
-                                                                   m_graphics->get_device());
+                                                                   m_renderer->get_device(),
+                                                                   m_vertex_compression);
 
         if (!m_basic_shapes.plane.is_valid())
         {
             return false;
         }
 
+        m_basic_shapes.cube_instances  = D3D::drawable_factory::create_instanced(get_context(), m_basic_shapes.cube, instanced_vs, cube_ps, m_renderer->get_device());
+        m_basic_shapes.plane_instances = D3D::drawable_factory::create_instanced(get_context(), m_basic_shapes.plane, instanced_vs, plane_ps, m_renderer->get_device());
+
+        if (!m_basic_shapes.cube_instances.is_valid() || !m_basic_shapes.plane_instances.is_valid())
+        {
+            return false;
+        }
+
+        if (m_hot_reloader != nullptr)
+        {
+            m_hot_reloader->watch_vertex_shader(DEEP_TEXT_NATIVE("cube_vs.cso"), layouts.basic, layouts.basic_count, cube_vs);
+            m_hot_reloader->watch_pixel_shader(DEEP_TEXT_NATIVE("cube_ps.cso"), cube_ps);
+            m_hot_reloader->watch_vertex_shader(DEEP_TEXT_NATIVE("textured_cube_vs.cso"), layouts.textured, layouts.textured_count, textured_cube_vs);
+            m_hot_reloader->watch_pixel_shader(DEEP_TEXT_NATIVE("textured_cube_ps.cso"), textured_cube_ps);
+            m_hot_reloader->watch_vertex_shader(DEEP_TEXT_NATIVE("plane_vs.cso"), layouts.basic, layouts.basic_count, plane_vs);
+            m_hot_reloader->watch_pixel_shader(DEEP_TEXT_NATIVE("plane_ps.cso"), plane_ps);
+            m_hot_reloader->watch_vertex_shader(DEEP_TEXT_NATIVE("instanced_vs.cso"), layouts.instanced, layouts.instanced_count, instanced_vs);
+            m_hot_reloader->watch_texture(cooked_texture ? texture_path : basic_png_path, m_basic_shapes.textured_cube->get_texture());
+        }
+
+        m_renderer->add_drawable(ref_cast<D3D::drawable>(m_basic_shapes.cube_instances));
+        m_renderer->add_drawable(ref_cast<D3D::drawable>(m_basic_shapes.plane_instances));
+
         return true;
     }
 
@@ -440,13 +652,23 @@ namespace deep
                 case vkeys::F3:
                 {
                     get_context()->out() << "FPS: " << m_FPS << "\r\n";
+
+                    if (m_frame_limiter.is_enabled())
+                    {
+                        const frame_pacing_stats &pacing = m_frame_limiter.get_stats();
+
+                        get_context()->out() << "Frame pacing: " << static_cast<uint64>(pacing.mean_millis * 1000.0) << "us average, "
+                                             << static_cast<uint64>(pacing.jitter_millis * 1000.0) << "us jitter, "
+                                             << static_cast<uint64>(pacing.max_deviation_millis * 1000.0) << "us max deviation, "
+                                             << pacing.late_frames << " late frames.\r\n";
+                    }
                 }
                 break;
                 case vkeys::F9:
                 {
                     if (kbd.key_is_pressed(vkeys::Control))
                     {
-                        m_graphics->get_device_context().set_rasterizer_state(D3D::rasterizer_state::CullBackSolid);
+                        m_renderer->get_device_context().set_rasterizer_state(D3D::rasterizer_state::CullBackSolid);
                     }
                 }
                 break;
@@ -454,7 +676,7 @@ namespace deep
                 {
                     if (kbd.key_is_pressed(vkeys::Control))
                     {
-                        m_graphics->get_device_context().set_rasterizer_state(D3D::rasterizer_state::CullBackWireframe);
+                        m_renderer->get_device_context().set_rasterizer_state(D3D::rasterizer_state::CullBackWireframe);
                     }
                 }
                 break;
@@ -462,7 +684,7 @@ namespace deep
                 {
                     if (kbd.key_is_pressed(vkeys::Control))
                     {
-                        m_graphics->get_device_context().set_rasterizer_state(D3D::rasterizer_state::CullFrontSolid);
+                        m_renderer->get_device_context().set_rasterizer_state(D3D::rasterizer_state::CullFrontSolid);
                     }
                 }
                 break;
@@ -470,7 +692,7 @@ namespace deep
                 {
                     if (kbd.key_is_pressed(vkeys::Control))
                     {
-                        m_graphics->get_device_context().set_rasterizer_state(D3D::rasterizer_state::CullFrontWireframe);
+                        m_renderer->get_device_context().set_rasterizer_state(D3D::rasterizer_state::CullFrontWireframe);
                     }
                 }
                 break;
@@ -506,50 +728,66 @@ namespace deep
 
         if (m_gui_mode == gui_mode::Viewport)
         {
-            static constexpr float move_speed = 0.04f;
+            while (!ms.is_raw_delta_empty())
+            {
+                raw_mouse_delta raw_delta = ms.read_raw_delta();
+
+                if (raw_delta.x != 0)
+                {
+                    m_camera->rotate_delta_x(raw_delta.x);
+                }
+
+                if (raw_delta.y != 0)
+                {
+                    m_camera->rotate_delta_y(raw_delta.y);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    void engine::update(float step_seconds) noexcept
+    {
+        if (is_headless())
+        {
+            return;
+        }
+
+        keyboard &kbd = m_window->get_keyboard();
+
+        if (m_gui_mode == gui_mode::Viewport)
+        {
+            // Unités par seconde : 0.04 par mise à jour à 60 mises à jour par seconde.
+            static constexpr float move_speed = 2.4f;
+
+            const float distance = move_speed * step_seconds;
 
             if (kbd.key_is_pressed(vkeys::Z))
             {
-                m_camera->walk(move_speed);
+                m_camera->walk(distance);
             }
             if (kbd.key_is_pressed(vkeys::Q))
             {
-                m_camera->strafe(-move_speed);
+                m_camera->strafe(-distance);
             }
             if (kbd.key_is_pressed(vkeys::S))
             {
-                m_camera->walk(-move_speed);
+                m_camera->walk(-distance);
             }
             if (kbd.key_is_pressed(vkeys::D))
             {
-                m_camera->strafe(move_speed);
+                m_camera->strafe(distance);
             }
             if (kbd.key_is_pressed(vkeys::Spacebar))
             {
-                m_camera->move_vertically(move_speed);
+                m_camera->move_vertically(distance);
             }
             if (kbd.key_is_pressed(vkeys::Control))
             {
-                m_camera->move_vertically(-move_speed);
-            }
-
-            while (!ms.is_raw_delta_empty())
-            {
-                raw_mouse_delta raw_delta = ms.read_raw_delta();
-
-                if (raw_delta.x != 0)
-                {
-                    m_camera->rotate_delta_x(raw_delta.x);
-                }
-
-                if (raw_delta.y != 0)
-                {
-                    m_camera->rotate_delta_y(raw_delta.y);
-                }
+                m_camera->move_vertically(-distance);
             }
         }
-
-        return true;
     }
 
     engine::engine(const ref<ctx> &context) noexcept
@@ -558,8 +796,123 @@ namespace deep
               m_startup_tick_count(0),
               m_startup_time_millis(0),
               m_FPS(0),
-              m_gui_mode(gui_mode::UI)
+              m_gui_mode(gui_mode::UI),
+              m_max_frames(0),
+              m_vertex_compression(D3D::vertex_compression::None),
+              m_simulation_rate(default_simulation_rate),
+              m_hot_reloader(nullptr),
+              m_asset_loader(nullptr),
+              m_scene(nullptr)
+    {
+    }
+
+    engine::~engine() noexcept
+    {
+        if (m_hot_reloader != nullptr)
+        {
+            mem::dealloc_type(m_context.get_memory_manager(), m_hot_reloader);
+        }
+
+        if (m_asset_loader != nullptr)
+        {
+            mem::dealloc_type(m_context.get_memory_manager(), m_asset_loader);
+        }
+
+        if (m_scene != nullptr)
+        {
+            mem::dealloc_type(m_context.get_memory_manager(), m_scene);
+        }
+    }
+
+    bool engine::add_basic_shape(basic_shape_kind kind, const fvec3 &location, const fvec3 &rotation, const fvec3 &scale) noexcept
+    {
+        const bool cube = kind == basic_shape_kind::Cube;
+
+        scene_object object;
+        object.mesh          = scene::make_asset_id(cube ? basic_cube_name : basic_plane_name);
+        object.vertex_shader = scene::make_asset_id(instanced_vs_name);
+        object.pixel_shader  = scene::make_asset_id(cube ? cube_ps_name : plane_ps_name);
+        object.texture       = 0;
+
+        object.location[0] = location.x;
+        object.location[1] = location.y;
+        object.location[2] = location.z;
+        object.rotation[0] = rotation.x;
+        object.rotation[1] = rotation.y;
+        object.rotation[2] = rotation.z;
+        object.scale[0]    = scale.x;
+        object.scale[1]    = scale.y;
+        object.scale[2]    = scale.z;
+
+        if (!instantiate(object))
+        {
+            return false;
+        }
+
+        m_scene->add_object(object);
+
+        return true;
+    }
+
+    bool engine::load_scene(const std::filesystem::path &path) noexcept
+    {
+        if (!m_scene->load(path))
+        {
+            return false;
+        }
+
+        if (m_basic_shapes.cube_instances.is_valid())
+        {
+            m_basic_shapes.cube_instances->clear_instances();
+        }
+
+        if (m_basic_shapes.plane_instances.is_valid())
+        {
+            m_basic_shapes.plane_instances->clear_instances();
+        }
+
+        const uint32 object_count = m_scene->get_object_count();
+        uint32 instantiated       = 0;
+
+        for (uint32 index = 0; index < object_count; ++index)
+        {
+            if (instantiate(m_scene->get_object(index)))
+            {
+                instantiated++;
+            }
+        }
+
+        get_context()->out() << "Scene loaded: " << instantiated << "/" << object_count << " objects displayed.\r\n";
+
+        return true;
+    }
+
+    bool engine::instantiate(const scene_object &object) noexcept
     {
+        static const uint64 basic_cube_id  = scene::make_asset_id(basic_cube_name);
+        static const uint64 basic_plane_id = scene::make_asset_id(basic_plane_name);
+
+        ref<D3D::instanced_drawable> instances;
+
+        if (object.mesh == basic_cube_id)
+        {
+            instances = m_basic_shapes.cube_instances;
+        }
+        else if (object.mesh == basic_plane_id)
+        {
+            instances = m_basic_shapes.plane_instances;
+        }
+
+        if (!instances.is_valid())
+        {
+            return false;
+        }
+
+        const fvec3 location = fvec3(object.location[0], object.location[1], object.location[2]);
+        const fvec3 rotation = fvec3(object.rotation[0], object.rotation[1], object.rotation[2]);
+        const fvec3 scale    = fvec3(object.scale[0], object.scale[1], object.scale[2]);
+
+        return instances->add_instance(location, rotation, scale, m_renderer->get_device());
     }
 
     uint64 engine::get_time_millis() const noexcept
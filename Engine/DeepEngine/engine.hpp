@@ -9,19 +9,44 @@
 #include <DeepLib/maths/mat.hpp>
 
 #include "DeepEngine/camera.hpp"
+#include "DeepEngine/frame_limiter.hpp"
 #include "DeepEngine/GUI/gui.hpp"
 #include "DeepEngine/GUI/imgui_manager.hpp"
 #include "DeepEngine/basic_shapes.hpp"
+#include "D3D/renderer.hpp"
 #include "D3D/graphics.hpp"
+#include "D3D/vertex_quantization.hpp"
 
 #include "DeepEngine/Scripting/dot_net_host.hpp"
 
+#include <filesystem>
+
 namespace deep
 {
+    class hot_reloader;
+    class asset_loader;
+    class scene;
+    struct scene_object;
+
     class DEEP_ENGINE_API engine : public object
     {
       public:
-        static ref<engine> create() noexcept;
+        // Nombre de mises à jour de la simulation par seconde, indépendant du nombre d'images.
+        static constexpr uint32 default_simulation_rate = 60;
+
+        // Au-delà, le retard est abandonné : la simulation ralentit au lieu de bloquer le rendu.
+        static constexpr uint32 max_ticks_per_frame = 5;
+
+      public:
+        /**
+         * @brief Crée le moteur.
+         * @param backend Le backend de rendu à utiliser. Seul Direct3D 11 crée une fenêtre et une interface.
+         * @param vertex_compression Le format des sommets des formes de base et de leurs input layouts.
+         */
+        static ref<engine> create(D3D::renderer_backend backend                = D3D::renderer_backend::Direct3D11,
+                                  D3D::vertex_compression vertex_compression = D3D::vertex_compression::None) noexcept;
+
+        ~engine() noexcept;
 
         void run() noexcept;
 
@@ -29,6 +54,8 @@ namespace deep
         float get_time_seconds() const noexcept;
 
         ref<D3D::graphics> get_graphics() const noexcept;
+        ref<D3D::renderer> get_renderer() const noexcept;
+        bool is_headless() const noexcept;
         basic_shapes &get_basic_shapes() noexcept;
         ref<imgui_manager> get_imgui_manager() const noexcept;
         ref<window> get_window();
@@ -38,14 +65,63 @@ namespace deep
 
         void set_should_close(bool value) noexcept;
 
+        /**
+         * @brief Limite le nombre d'images à produire avant de quitter la boucle de jeu.
+         * @param max_frames Le nombre d'images, 0 pour ne pas limiter.
+         */
+        void set_max_frames(uint64 max_frames) noexcept;
+
+        /**
+         * @brief Modifie le nombre de mises à jour de la simulation par seconde.
+         * @param ticks_per_second Le nombre de mises à jour, default_simulation_rate si 0.
+         */
+        void set_simulation_rate(uint32 ticks_per_second) noexcept;
+        uint32 get_simulation_rate() const noexcept;
+
+        /**
+         * @brief Limiteur d'images appelé après chaque présentation, désactivé par défaut.
+         */
+        frame_limiter &get_frame_limiter() noexcept;
+
+        /**
+         * @brief Chargeur de ressources en arrière-plan, dont les résultats sont créés entre deux images.
+         */
+        asset_loader *get_asset_loader() noexcept;
+
+        /**
+         * @brief Objets ajoutés par l'utilisateur, enregistrés avec le projet.
+         */
+        scene *get_scene() noexcept;
+
+        /**
+         * @brief Ajoute une forme de base à la scène, affichée avec les instances de sa forme.
+         * @return false si l'instance ne peut pas être ajoutée.
+         */
+        bool add_basic_shape(basic_shape_kind kind, const fvec3 &location, const fvec3 &rotation, const fvec3 &scale) noexcept;
+
+        /**
+         * @brief Remplace la scène par celle d'un fichier et recrée les instances des formes de base.
+         * @return false si le fichier n'existe pas ou n'est pas valide. La scène affichée est alors inchangée.
+         */
+        bool load_scene(const std::filesystem::path &path) noexcept;
+
       private:
+        // Demande le chargement des ressources des formes de base, sans attendre.
+        void load_basic_assets() noexcept;
         bool init_basic_shapes() noexcept;
         bool process_inputs() noexcept;
 
+        // Avance la simulation d'un pas fixe.
+        void update(float step_seconds) noexcept;
+
+        // Ajoute l'instance d'un objet de la scène, sans modifier la scène.
+        bool instantiate(const scene_object &object) noexcept;
+
       private:
         bool m_should_close;
         ref<window> m_window;
         ref<D3D::graphics> m_graphics;
+        ref<D3D::renderer> m_renderer;
         basic_shapes m_basic_shapes;
         ref<imgui_manager> m_imgui_manager;
         uint64 m_startup_tick_count;
@@ -54,6 +130,17 @@ namespace deep
         ref<camera> m_camera;
         gui_mode m_gui_mode;
         dot_net_host m_dot_net_host;
+        uint64 m_max_frames;
+        D3D::vertex_compression m_vertex_compression;
+        uint32 m_simulation_rate;
+        frame_limiter m_frame_limiter;
+
+        // Rechargement des shaders et des textures modifiés, nul sans fenêtre.
+        hot_reloader *m_hot_reloader;
+
+        asset_loader *m_asset_loader;
+
+        scene *m_scene;
 
       protected:
         engine(const ref<ctx> &context) noexcept;
@@ -67,6 +154,16 @@ namespace deep
         return m_graphics;
     }
 
+    inline ref<D3D::renderer> engine::get_renderer() const noexcept
+    {
+        return m_renderer;
+    }
+
+    inline bool engine::is_headless() const noexcept
+    {
+        return !m_window.is_valid();
+    }
+
     inline basic_shapes &engine::get_basic_shapes() noexcept
     {
         return m_basic_shapes;
@@ -101,6 +198,36 @@ namespace deep
     {
         m_should_close = true;
     }
+
+    inline void engine::set_max_frames(uint64 max_frames) noexcept
+    {
+        m_max_frames = max_frames;
+    }
+
+    inline void engine::set_simulation_rate(uint32 ticks_per_second) noexcept
+    {
+        m_simulation_rate = ticks_per_second != 0 ? ticks_per_second : default_simulation_rate;
+    }
+
+    inline uint32 engine::get_simulation_rate() const noexcept
+    {
+        return m_simulation_rate;
+    }
+
+    inline frame_limiter &engine::get_frame_limiter() noexcept
+    {
+        return m_frame_limiter;
+    }
+
+    inline asset_loader *engine::get_asset_loader() noexcept
+    {
+        return m_asset_loader;
+    }
+
+    inline scene *engine::get_scene() noexcept
+    {
+        return m_scene;
+    }
 } // namespace deep
 
 #endif
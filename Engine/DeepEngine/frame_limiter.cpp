@@ -0,0 +1,215 @@
+#include "frame_limiter.hpp"
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+
+// Disponible depuis Windows 10 1803, absent des anciens SDK.
+#    ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#        define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#    endif
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace deep
+{
+    frame_limiter::frame_limiter() noexcept
+            : m_budget(0),
+              m_next_deadline(0),
+              m_spin(min_spin_nanos),
+              m_last_frame(0),
+              m_period_start(0),
+              m_period_frames(0),
+              m_period_late(0),
+              m_period_sum(0.0),
+              m_period_sum_squares(0.0),
+              m_period_max_deviation(0.0),
+              m_stats(),
+              m_timer(nullptr)
+    {
+#ifdef _WIN32
+        // Sans minuterie haute résolution, le sommeil n'est précis qu'à la période de l'ordonnanceur, environ 15 ms.
+        m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#endif
+    }
+
+    frame_limiter::~frame_limiter()
+    {
+#ifdef _WIN32
+        if (m_timer != nullptr)
+        {
+            CloseHandle(m_timer);
+        }
+#endif
+    }
+
+    void frame_limiter::set_target_fps(double fps) noexcept
+    {
+        set_frame_budget_micros(fps > 0.0 ? static_cast<uint64>(1000000.0 / fps + 0.5) : 0);
+    }
+
+    void frame_limiter::set_frame_budget_micros(uint64 micros) noexcept
+    {
+        m_budget        = static_cast<int64>(micros) * 1000;
+        m_next_deadline = 0;
+    }
+
+    uint64 frame_limiter::get_frame_budget_micros() const noexcept
+    {
+        return static_cast<uint64>(m_budget / 1000);
+    }
+
+    bool frame_limiter::is_enabled() const noexcept
+    {
+        return m_budget != 0;
+    }
+
+    void frame_limiter::wait() noexcept
+    {
+        int64 now = get_time_nanos();
+
+        if (m_budget == 0)
+        {
+            record_frame(now, false);
+
+            return;
+        }
+
+        // Première image limitée : l'échéance part de maintenant.
+        if (m_next_deadline == 0)
+        {
+            m_next_deadline = now;
+        }
+
+        const int64 deadline = m_next_deadline;
+
+        // L'image a pris plus que sa durée visée : il n'y a rien à attendre.
+        const bool late = now > deadline;
+
+        while (deadline - now > m_spin)
+        {
+            const int64 requested = deadline - now - m_spin;
+            const int64 before    = now;
+
+            sleep(requested);
+
+            now = get_time_nanos();
+
+            // La marge suit le retard de réveil : elle grandit aussitôt et ne diminue que lentement.
+            const int64 overshoot = now - before - requested;
+            const int64 target    = overshoot + overshoot / 4;
+
+            if (target > m_spin)
+            {
+                m_spin = target;
+            }
+            else
+            {
+                m_spin -= (m_spin - target) / 16;
+            }
+
+            m_spin = std::clamp(m_spin, min_spin_nanos, max_spin_nanos);
+        }
+
+        while (now < deadline)
+        {
+            std::this_thread::yield();
+
+            now = get_time_nanos();
+        }
+
+        // Une image en retard de plus d'une période ne fait pas rattraper les suivantes en rafale.
+        m_next_deadline = now - deadline > m_budget ? now + m_budget : deadline + m_budget;
+
+        record_frame(now, late);
+    }
+
+    const frame_pacing_stats &frame_limiter::get_stats() const noexcept
+    {
+        return m_stats;
+    }
+
+    int64 frame_limiter::get_time_nanos() noexcept
+    {
+        return static_cast<int64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void frame_limiter::sleep(int64 nanos) noexcept
+    {
+#ifdef _WIN32
+        if (m_timer != nullptr)
+        {
+            // Durée relative, en unités de 100 ns.
+            LARGE_INTEGER due;
+            due.QuadPart = -std::max<int64>(nanos / 100, 1);
+
+            if (SetWaitableTimer(m_timer, &due, 0, nullptr, nullptr, FALSE))
+            {
+                WaitForSingleObject(m_timer, INFINITE);
+
+                return;
+            }
+        }
+#endif
+
+        std::this_thread::sleep_for(std::chrono::nanoseconds(nanos));
+    }
+
+    void frame_limiter::record_frame(int64 now, bool late) noexcept
+    {
+        if (m_last_frame != 0)
+        {
+            const double interval = static_cast<double>(now - m_last_frame) / 1000000.0;
+
+            m_period_frames++;
+            m_period_sum += interval;
+            m_period_sum_squares += interval * interval;
+
+            if (m_budget != 0)
+            {
+                m_period_max_deviation = std::max(m_period_max_deviation, std::fabs(interval - static_cast<double>(m_budget) / 1000000.0));
+            }
+
+            if (late)
+            {
+                m_period_late++;
+            }
+        }
+        else
+        {
+            m_period_start = now;
+        }
+
+        m_last_frame = now;
+
+        if (now - m_period_start < stats_period_nanos || m_period_frames == 0)
+        {
+            return;
+        }
+
+        const double count = static_cast<double>(m_period_frames);
+        const double mean  = m_period_sum / count;
+
+        m_stats.frame_count          = m_period_frames;
+        m_stats.mean_millis          = mean;
+        m_stats.jitter_millis        = std::sqrt(std::max(m_period_sum_squares / count - mean * mean, 0.0));
+        m_stats.max_deviation_millis = m_period_max_deviation;
+        m_stats.late_frames          = m_period_late;
+
+        m_period_start         = now;
+        m_period_frames        = 0;
+        m_period_late          = 0;
+        m_period_sum           = 0.0;
+        m_period_sum_squares   = 0.0;
+        m_period_max_deviation = 0.0;
+    }
+} // namespace deep
@@ -0,0 +1,105 @@
+#ifndef DEEP_ENGINE_FRAME_LIMITER_HPP
+#define DEEP_ENGINE_FRAME_LIMITER_HPP
+
+#include "DeepEngine/deep_engine_export.h"
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    /**
+     * @brief Régularité des images sur la dernière période de mesure.
+     */
+    struct frame_pacing_stats
+    {
+        uint32 frame_count;
+
+        // Durée moyenne d'une image et son écart type.
+        double mean_millis;
+        double jitter_millis;
+
+        // Plus grand écart à la durée visée, 0 si le limiteur est désactivé.
+        double max_deviation_millis;
+
+        // Images dont le rendu a dépassé l'échéance visée.
+        uint32 late_frames;
+    };
+
+    /**
+     * @brief Limite le nombre d'images par seconde avec une attente mixte : sommeil puis attente active.
+     *
+     * Le thread dort jusqu'à peu avant l'échéance de l'image, puis attend activement le reste : le processeur reste
+     * au repos la majeure partie de l'attente sans dépendre de la précision du sommeil. La marge d'attente active
+     * s'adapte au retard de réveil mesuré. Les échéances se suivent à intervalle fixe, l'erreur d'une image n'est
+     * donc pas reportée sur les suivantes.
+     */
+    class DEEP_ENGINE_API frame_limiter
+    {
+      public:
+        // Durée d'une période de mesure de la régularité.
+        static constexpr int64 stats_period_nanos = 1000000000;
+
+        // Bornes de la marge d'attente active.
+        static constexpr int64 min_spin_nanos = 200000;
+        static constexpr int64 max_spin_nanos = 4000000;
+
+      public:
+        frame_limiter() noexcept;
+        ~frame_limiter();
+
+        frame_limiter(const frame_limiter &)            = delete;
+        frame_limiter &operator=(const frame_limiter &) = delete;
+
+        /**
+         * @param fps Le nombre d'images par seconde visé, 0 pour désactiver le limiteur.
+         */
+        void set_target_fps(double fps) noexcept;
+
+        /**
+         * @param micros La durée visée d'une image en microsecondes, 0 pour désactiver le limiteur.
+         */
+        void set_frame_budget_micros(uint64 micros) noexcept;
+        uint64 get_frame_budget_micros() const noexcept;
+
+        bool is_enabled() const noexcept;
+
+        /**
+         * @brief Attend l'échéance de l'image courante puis mesure sa durée.
+         *
+         * À appeler une fois par image, après sa présentation. Sans limite, seule la mesure est faite.
+         */
+        void wait() noexcept;
+
+        /**
+         * @brief Récupère les mesures de la dernière période terminée.
+         */
+        const frame_pacing_stats &get_stats() const noexcept;
+
+      private:
+        static int64 get_time_nanos() noexcept;
+
+        // Dort au moins la durée donnée, avec la meilleure précision offerte par le système.
+        void sleep(int64 nanos) noexcept;
+
+        void record_frame(int64 now, bool late) noexcept;
+
+      private:
+        int64 m_budget;
+        int64 m_next_deadline;
+        int64 m_spin;
+
+        int64 m_last_frame;
+        int64 m_period_start;
+        uint32 m_period_frames;
+        uint32 m_period_late;
+        double m_period_sum;
+        double m_period_sum_squares;
+        double m_period_max_deviation;
+
+        frame_pacing_stats m_stats;
+
+        // Minuterie haute résolution, nulle si le système n'en propose pas.
+        void *m_timer;
+    };
+} // namespace deep
+
+#endif
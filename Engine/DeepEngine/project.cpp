@@ -1,5 +1,7 @@
 #include "DeepEngine/project.hpp"
 #include "DeepEngine/engine.hpp"
+#include "DeepEngine/Assets/asset_database.hpp"
+#include "DeepEngine/Scene/scene.hpp"
 
 #include <DeepLib/memory/memory.hpp>
 #include <DeepLib/filesystem/filesystem.hpp>
@@ -18,12 +20,22 @@ namespace deep
     static const char *B                = "B";
     static const char *A                = "A";
     static const char *BORDER_SIZE      = "border_size";
+    static const char *SCENE_FILE       = "scene.dscn";
 
     project::project(const ref<ctx> &context) noexcept
-            : object(context)
+            : object(context),
+              m_assets(nullptr)
     {
     }
 
+    project::~project() noexcept
+    {
+        if (m_assets != nullptr)
+        {
+            mem::dealloc_type(m_context.get_memory_manager(), m_assets);
+        }
+    }
+
     ref<project> project::create(const ref<ctx> &context, string_native &folder_path, const char *name, ref<project> &current_proj) noexcept
     {
         if (current_proj.is_valid())
@@ -113,6 +125,15 @@ namespace deep
             fs::create_folder(context, *resources_folder);
         }
 
+        // La base des ressources du dossier précédent n'est plus valable.
+        if (current_proj->m_assets != nullptr)
+        {
+            mem::dealloc_type(context.get_memory_manager(), current_proj->m_assets);
+            current_proj->m_assets = nullptr;
+        }
+
+        current_proj->refresh_resources();
+
         return current_proj;
     }
 
@@ -173,9 +194,71 @@ namespace deep
             fs::create_folder(context, *resources_folder);
         }
 
+        // La base des ressources du dossier précédent n'est plus valable.
+        if (current_proj->m_assets != nullptr)
+        {
+            mem::dealloc_type(context.get_memory_manager(), current_proj->m_assets);
+            current_proj->m_assets = nullptr;
+        }
+
+        current_proj->refresh_resources();
+
         return current_proj;
     }
 
+    bool project::refresh_resources() noexcept
+    {
+        if (m_assets == nullptr)
+        {
+            m_assets = mem::alloc_type<asset_database>(m_context.get(), m_context, std::filesystem::path(*m_folder_path));
+
+            if (m_assets == nullptr)
+            {
+                return false;
+            }
+
+            m_assets->load();
+        }
+
+        const asset_database::refresh_statistics statistics = m_assets->refresh();
+
+        m_context->out() << "Resources: " << statistics.scanned << " found, "
+                         << statistics.hashed << " hashed, "
+                         << statistics.imported << " imported, "
+                         << statistics.failed << " failed, "
+                         << statistics.removed << " removed.\r\n";
+
+        return m_assets->save();
+    }
+
+    bool project::import_resources(const native_char *source_folder) noexcept
+    {
+        const std::filesystem::path source = std::filesystem::path(source_folder);
+        std::error_code error;
+
+        // Le dossier importé garde son nom sous 'resources', comme s'il y avait été déposé à la main.
+        const std::filesystem::path destination = std::filesystem::path(*m_folder_path) / "resources" / source.filename();
+
+        std::filesystem::copy(source,
+                              destination,
+                              std::filesystem::copy_options::recursive | std::filesystem::copy_options::overwrite_existing,
+                              error);
+
+        if (error)
+        {
+            m_context->err() << "[ERROR] Cannot copy the resources: " << error.message().c_str() << "\r\n";
+
+            return false;
+        }
+
+        return refresh_resources();
+    }
+
+    asset_database *project::get_asset_database() noexcept
+    {
+        return m_assets;
+    }
+
     void project::load_settings(ref<engine> &eng) noexcept
     {
         if (!eng.is_valid())
@@ -351,6 +434,25 @@ namespace deep
                 ui_text_color_A / 255.0f));
 
         im_manager->set_global_border_size(ui_border_size);
+
+        // Un projet sans scène enregistrée garde celle du moteur.
+        std::filesystem::path scene_path = std::filesystem::path(*m_folder_path) / SCENE_FILE;
+        std::error_code error;
+
+        if (std::filesystem::exists(scene_path, error) && !eng->load_scene(scene_path))
+        {
+            m_context->err() << "[ERROR] Cannot load the project scene.\r\n";
+        }
+    }
+
+    void project::save_scene(const ref<engine> &eng) noexcept
+    {
+        if (!eng.is_valid())
+        {
+            return;
+        }
+
+        eng->get_scene()->save_async(std::filesystem::path(*m_folder_path) / SCENE_FILE);
     }
 
     bool project::save_settings(const ref<engine> &eng) noexcept
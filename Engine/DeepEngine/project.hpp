@@ -14,6 +14,7 @@ using json = nlohmann::json;
 namespace deep
 {
     class engine;
+    class asset_database;
 
     class DEEP_ENGINE_API project : public object
     {
@@ -21,6 +22,7 @@ namespace deep
         project()                           = delete;
         project(const project &)            = delete;
         project &operator=(const project &) = delete;
+        ~project() noexcept;
 
         static ref<project> create(const ref<ctx> &context, string_native &folder_path, const char *name, ref<project> &current_proj) noexcept;
         static ref<project> open(const ref<ctx> &context, string_native &folder_path, ref<project> &current_proj) noexcept;
@@ -29,6 +31,29 @@ namespace deep
 
         bool save_settings(const ref<engine> &eng) noexcept;
 
+        /**
+         * @brief Enregistre la scène du moteur dans le dossier du projet, en arrière-plan.
+         */
+        void save_scene(const ref<engine> &eng) noexcept;
+
+        /**
+         * @brief Importe les ressources ajoutées ou modifiées depuis la dernière ouverture du projet.
+         *
+         * Appelée à la création et à l'ouverture du projet. Les ressources inchangées ne sont pas relues.
+         * @return false si la base des ressources ne peut pas être enregistrée.
+         */
+        bool refresh_resources() noexcept;
+
+        /**
+         * @brief Copie un dossier et son contenu dans le dossier des ressources du projet, puis importe les ressources.
+         *
+         * Les fichiers déjà présents sous le même nom sont remplacés.
+         * @return false si la copie échoue ou si la base des ressources ne peut pas être enregistrée.
+         */
+        bool import_resources(const native_char *source_folder) noexcept;
+
+        asset_database *get_asset_database() noexcept;
+
       protected:
         project(const ref<ctx> &context) noexcept;
 
@@ -36,6 +61,7 @@ namespace deep
         string_native m_folder_path;
         ref<file_stream> m_settings_stream;
         json m_settings;
+        asset_database *m_assets;
 
       public:
         friend memory_manager;
@@ -1,16 +1,447 @@
 #include "Assimp/loader.hpp"
+#include "Cooked/cooked_mesh.hpp"
 
 #include "D3D/resource_factory.hpp"
 #include "D3D/buffer/per_object_buffer.hpp"
+#include "DeepEngine/Assets/mapped_file.hpp"
+
+#include "LOD/simplifier.hpp"
+#include "Optimize/optimizer.hpp"
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
 namespace deep
 {
     namespace model
     {
+        namespace
+        {
+            // Les buffers d'indices du moteur sont en 16 bits.
+            constexpr uint32 max_mesh_indices = 0xFFFF;
+
+            // Erreur maximale d'un niveau de détail, en fraction du rayon de l'objet.
+            constexpr float max_lod_error = 0.05f;
+
+            // Un niveau qui garde plus de cette fraction des indices du précédent n'est pas conservé.
+            constexpr float min_lod_reduction = 0.75f;
+
+            /**
+             * @brief Maillage importé par Assimp, niveaux de détail calculés.
+             */
+            struct imported_model
+            {
+                std::vector<float> positions;
+                std::vector<cooked_mesh_submesh> submeshes;
+
+                // Indices de chaque niveau, le premier étant le maillage complet.
+                std::vector<std::vector<uint16>> lods;
+                std::vector<float> lod_errors;
+
+                float min[3];
+                float max[3];
+
+                // Efficacité du cache de sommets du niveau le plus fin, avant et après optimisation.
+                vertex_cache_statistics before;
+                vertex_cache_statistics after;
+            };
+
+            /**
+             * @brief Données d'un maillage prêtes à être envoyées au GPU, importées ou lues dans un fichier préparé.
+             */
+            struct mesh_view
+            {
+                const void *vertices;
+                uint32 vertex_count;
+                uint32 vertex_stride;
+                D3D::vertex_compression compression;
+
+                const uint16 *lod_indices[D3D::mesh::max_lod_count];
+                uint32 lod_index_counts[D3D::mesh::max_lod_count];
+                float lod_errors[D3D::mesh::max_lod_count];
+                uint32 lod_count;
+
+                fvec3 min;
+                fvec3 max;
+            };
+
+            /**
+             * @param report false pour ne rien écrire sur les sorties du contexte, l'appelant signalant lui-même l'échec.
+             */
+            bool import_model(const ref<ctx> &context, const char *filename, imported_model &out, bool report)
+            {
+                Assimp::Importer importer;
+
+                // Les transformations des nœuds sont appliquées aux sommets : tous les maillages partagent le repère de l'objet.
+                const aiScene *scene = importer.ReadFile(filename,
+                                                         aiProcess_Triangulate |
+                                                                 aiProcess_JoinIdenticalVertices |
+                                                                 aiProcess_PreTransformVertices);
+
+                if (scene == nullptr)
+                {
+                    if (report)
+                    {
+                        context->err() << "[ERROR] Unable to load '" << filename << "' model.\r\n";
+                    }
+
+                    return false;
+                }
+
+                std::vector<float> &positions = out.positions;
+                std::vector<uint32> indices;
+                unsigned int index;
+
+                for (index = 0; index < scene->mNumMeshes; ++index)
+                {
+                    const aiMesh *m   = scene->mMeshes[index];
+                    const uint32 base = static_cast<uint32>(positions.size() / 3);
+                    unsigned int vertex;
+                    unsigned int face;
+
+                    cooked_mesh_submesh submesh = {};
+                    submesh.first_index         = static_cast<uint32>(indices.size());
+                    submesh.first_vertex        = base;
+                    submesh.vertex_count        = m->mNumVertices;
+
+                    for (vertex = 0; vertex < m->mNumVertices; ++vertex)
+                    {
+                        positions.push_back(m->mVertices[vertex].x);
+                        positions.push_back(m->mVertices[vertex].y);
+                        positions.push_back(m->mVertices[vertex].z);
+                    }
+
+                    for (face = 0; face < m->mNumFaces; ++face)
+                    {
+                        // Points et lignes restent après la triangulation : ils ne sont pas dessinés.
+                        if (m->mFaces[face].mNumIndices != 3)
+                        {
+                            continue;
+                        }
+
+                        indices.push_back(base + m->mFaces[face].mIndices[0]);
+                        indices.push_back(base + m->mFaces[face].mIndices[1]);
+                        indices.push_back(base + m->mFaces[face].mIndices[2]);
+                    }
+
+                    submesh.index_count = static_cast<uint32>(indices.size()) - submesh.first_index;
+                    out.submeshes.push_back(submesh);
+                }
+
+                uint32 vertex_count      = static_cast<uint32>(positions.size() / 3);
+                const uint32 index_count = static_cast<uint32>(indices.size());
+
+                if (index_count == 0 || vertex_count > max_mesh_indices || index_count > max_mesh_indices)
+                {
+                    if (report)
+                    {
+                        context->err() << "[ERROR] '" << filename << "' model must have between 1 and " << max_mesh_indices << " vertices and indices.\r\n";
+                    }
+
+                    return false;
+                }
+
+                out.before = analyze_vertex_cache(indices.data(), index_count, vertex_count);
+
+                // Les faces sont réordonnées sous-maillage par sous-maillage pour que leurs plages restent valides.
+                std::vector<uint32> reordered(index_count);
+
+                for (const cooked_mesh_submesh &submesh : out.submeshes)
+                {
+                    uint32 *range = indices.data() + submesh.first_index;
+
+                    optimize_vertex_cache(range, submesh.index_count, vertex_count, reordered.data() + submesh.first_index);
+                    optimize_overdraw(reordered.data() + submesh.first_index, submesh.index_count, positions.data(), vertex_count, default_overdraw_threshold, range);
+                }
+
+                // Les sommets suivent ensuite l'ordre des faces, les sommets inutilisés étant retirés.
+                std::vector<float> fetched(positions.size());
+
+                vertex_count = optimize_vertex_fetch(indices.data(), index_count, positions.data(), vertex_count, sizeof(float) * 3, fetched.data());
+                fetched.resize(static_cast<usize>(vertex_count) * 3);
+                positions.swap(fetched);
+
+                for (cooked_mesh_submesh &submesh : out.submeshes)
+                {
+                    const uint32 *range = indices.data() + submesh.first_index;
+
+                    if (submesh.index_count == 0)
+                    {
+                        submesh.first_vertex = 0;
+                        submesh.vertex_count = 0;
+
+                        continue;
+                    }
+
+                    const auto bounds = std::minmax_element(range, range + submesh.index_count);
+
+                    submesh.first_vertex = *bounds.first;
+                    submesh.vertex_count = *bounds.second - *bounds.first + 1;
+                }
+
+                out.after = analyze_vertex_cache(indices.data(), index_count, vertex_count);
+
+                float *min = out.min;
+                float *max = out.max;
+
+                std::copy(positions.begin(), positions.begin() + 3, min);
+                std::copy(positions.begin(), positions.begin() + 3, max);
+
+                for (index = 0; index < vertex_count; ++index)
+                {
+                    unsigned int axis;
+
+                    for (axis = 0; axis < 3; ++axis)
+                    {
+                        min[axis] = std::min(min[axis], positions[index * 3 + axis]);
+                        max[axis] = std::max(max[axis], positions[index * 3 + axis]);
+                    }
+                }
+
+                out.lods.emplace_back(indices.begin(), indices.end());
+                out.lod_errors.push_back(0.0f);
+
+                // Chaîne de niveaux de détail : chaque niveau vise la moitié des indices du précédent.
+                const float radius = 0.5f * std::sqrt((max[0] - min[0]) * (max[0] - min[0]) +
+                                                      (max[1] - min[1]) * (max[1] - min[1]) +
+                                                      (max[2] - min[2]) * (max[2] - min[2]));
+
+                std::vector<uint32> previous = indices;
+                std::vector<uint32> simplified(index_count);
+                std::vector<uint32> ordered(index_count);
+                float error = 0.0f;
+
+                while (out.lods.size() < D3D::mesh::max_lod_count)
+                {
+                    const uint32 previous_count = static_cast<uint32>(previous.size());
+                    float lod_error;
+
+                    const uint32 count = simplify(positions.data(), vertex_count, previous.data(), previous_count, previous_count / 6 * 3, max_lod_error * radius, simplified.data(), &lod_error);
+
+                    if (count == 0 || count > previous_count * min_lod_reduction)
+                    {
+                        break;
+                    }
+
+                    // Chaque niveau est simplifié à partir du précédent : les erreurs s'additionnent.
+                    error += lod_error;
+
+                    // La simplification défait l'ordre des faces : chaque niveau est de nouveau optimisé pour le cache.
+                    optimize_vertex_cache(simplified.data(), count, vertex_count, ordered.data());
+
+                    out.lods.emplace_back(ordered.begin(), ordered.begin() + count);
+                    out.lod_errors.push_back(error);
+
+                    previous.assign(simplified.begin(), simplified.begin() + count);
+                }
+
+                return true;
+            }
+
+            mesh_view make_view(const imported_model &model)
+            {
+                mesh_view view     = {};
+                view.vertices      = model.positions.data();
+                view.vertex_count  = static_cast<uint32>(model.positions.size() / 3);
+                view.vertex_stride = sizeof(float) * 3;
+                view.compression   = D3D::vertex_compression::None;
+                view.lod_count     = static_cast<uint32>(model.lods.size());
+                view.min           = fvec3(model.min[0], model.min[1], model.min[2]);
+                view.max           = fvec3(model.max[0], model.max[1], model.max[2]);
+
+                uint32 lod;
+
+                for (lod = 0; lod < view.lod_count; ++lod)
+                {
+                    view.lod_indices[lod]      = model.lods[lod].data();
+                    view.lod_index_counts[lod] = static_cast<uint32>(model.lods[lod].size());
+                    view.lod_errors[lod]       = model.lod_errors[lod];
+                }
+
+                return view;
+            }
+
+            /**
+             * @brief Compresse les positions de la vue dans sa boîte englobante et la fait pointer sur storage.
+             */
+            void quantize_view(mesh_view &view, D3D::vertex_compression compression, std::vector<uint8> &storage)
+            {
+                const D3D::vertex_format format = { false, false, compression };
+
+                if (compression == view.compression)
+                {
+                    return;
+                }
+
+                storage.resize(static_cast<usize>(view.vertex_count) * D3D::vertex_quantizer::get_stride(format));
+                D3D::vertex_quantizer::quantize(format, view.vertices, view.vertex_count, view.min, view.max, storage.data());
+
+                view.vertices      = storage.data();
+                view.vertex_stride = D3D::vertex_quantizer::get_stride(format);
+                view.compression   = compression;
+            }
+
+            /**
+             * @brief Valide un fichier préparé et fait pointer la vue sur ses blocs, sans copie.
+             */
+            bool read_cooked(const uint8 *data, usize size, mesh_view &view)
+            {
+                if (size < sizeof(cooked_mesh_header))
+                {
+                    return false;
+                }
+
+                cooked_mesh_header header;
+                std::memcpy(&header, data, sizeof(header));
+
+                if (header.magic != cooked_mesh_magic || header.version != cooked_mesh_version)
+                {
+                    return false;
+                }
+
+                if (header.vertex_stride == 0 || header.vertex_count == 0 || header.vertex_count > max_mesh_indices ||
+                    header.lod_count == 0 || header.lod_count > D3D::mesh::max_lod_count)
+                {
+                    return false;
+                }
+
+                const D3D::vertex_compression compression = static_cast<D3D::vertex_compression>(header.vertex_compression);
+
+                if ((compression != D3D::vertex_compression::None && compression != D3D::vertex_compression::Quantized) ||
+                    header.vertex_stride != D3D::vertex_quantizer::get_stride({ false, false, compression }))
+                {
+                    return false;
+                }
+
+                const usize tables_size = sizeof(cooked_mesh_header) +
+                                          sizeof(cooked_mesh_submesh) * static_cast<usize>(header.submesh_count) +
+                                          sizeof(cooked_mesh_lod) * header.lod_count;
+
+                // Les blocs doivent être alignés pour être lus directement depuis la projection du fichier.
+                if (tables_size > size ||
+                    header.vertex_offset % cooked_mesh_alignment != 0 || header.index_offset % cooked_mesh_alignment != 0 ||
+                    header.vertex_size != header.vertex_count * header.vertex_stride ||
+                    static_cast<usize>(header.vertex_offset) + header.vertex_size > size ||
+                    static_cast<usize>(header.index_offset) + header.index_size > size)
+                {
+                    return false;
+                }
+
+                const usize index_count = header.index_size / sizeof(uint16);
+                const uint8 *lods       = data + tables_size - sizeof(cooked_mesh_lod) * header.lod_count;
+                uint32 lod;
+
+                for (lod = 0; lod < header.lod_count; ++lod)
+                {
+                    cooked_mesh_lod entry;
+                    std::memcpy(&entry, lods + sizeof(cooked_mesh_lod) * lod, sizeof(entry));
+
+                    if (entry.index_count == 0 || entry.index_count > max_mesh_indices ||
+                        static_cast<usize>(entry.first_index) + entry.index_count > index_count)
+                    {
+                        return false;
+                    }
+
+                    const uint16 *indices = reinterpret_cast<const uint16 *>(data + header.index_offset) + entry.first_index;
+                    uint32 index;
+
+                    // Un indice hors du bloc de sommets ferait lire le GPU au-delà du buffer.
+                    for (index = 0; index < entry.index_count; ++index)
+                    {
+                        if (indices[index] >= header.vertex_count)
+                        {
+                            return false;
+                        }
+                    }
+
+                    view.lod_indices[lod]      = indices;
+                    view.lod_index_counts[lod] = entry.index_count;
+                    view.lod_errors[lod]       = entry.error;
+                }
+
+                view.vertices      = data + header.vertex_offset;
+                view.vertex_count  = header.vertex_count;
+                view.vertex_stride = header.vertex_stride;
+                view.compression   = compression;
+                view.lod_count     = header.lod_count;
+                view.min           = fvec3(header.bounds_min[0], header.bounds_min[1], header.bounds_min[2]);
+                view.max           = fvec3(header.bounds_max[0], header.bounds_max[1], header.bounds_max[2]);
+
+                return true;
+            }
+
+            ref<D3D::mesh> create_mesh(const ref<ctx> &context,
+                                       const mesh_view &view,
+                                       const ref<D3D::vertex_shader> &vs,
+                                       const ref<D3D::pixel_shader> &ps,
+                                       const fvec3 &position,
+                                       const fvec3 &rotation,
+                                       const fvec3 &scale,
+                                       D3D::device_handle device)
+            {
+                D3D::mesh *c = mem::alloc_type<D3D::mesh>(context.get(), context);
+
+                if (c == nullptr)
+                {
+                    return ref<D3D::mesh>();
+                }
+
+                fmat4 model = fmat4();
+                model       = fmat4::translate(model, position);
+                model       = fmat4::rotate_x(model, rotation.x);
+                model       = fmat4::rotate_y(model, rotation.y);
+                model       = fmat4::rotate_z(model, rotation.z);
+                model       = fmat4::scale(model, scale);
+
+                fmat4 projection = fmat4::d3d_perspective_lh(1.0f, 3.0f / 4.0f, 0.5f, 10.0f);
+
+                const D3D::per_object_buffer pob = {
+                    projection * model
+                };
+
+                c->set_vertex_buffer(D3D::resource_factory::create_vertex_buffer(context, view.vertices, view.vertex_count, { false, false, view.compression }, device));
+                c->set_index_buffer(D3D::resource_factory::create_index_buffer(context, view.lod_indices[0], static_cast<uint16>(view.lod_index_counts[0]), device));
+                c->set_local_bounds(view.min, view.max);
+
+                if (view.compression != D3D::vertex_compression::None)
+                {
+                    c->set_vertex_dequantization(D3D::vertex_quantizer::get_dequantization(view.min, view.max));
+                }
+
+                uint32 lod;
+
+                for (lod = 1; lod < view.lod_count; ++lod)
+                {
+                    if (!c->add_lod(D3D::resource_factory::create_index_buffer(context, view.lod_indices[lod], static_cast<uint16>(view.lod_index_counts[lod]), device), view.lod_errors[lod]))
+                    {
+                        break;
+                    }
+                }
+
+                c->set_per_object_buffer(D3D::resource_factory::create_constant_buffer(context, &pob, sizeof(pob), device));
+                c->set_vertex_shader(vs);
+                c->set_pixel_shader(ps);
+
+                c->set_location(position);
+                c->set_rotation(rotation);
+                c->set_scale(scale);
+
+                return ref<D3D::mesh>(context, c);
+            }
+
+            usize align_offset(usize offset)
+            {
+                return (offset + cooked_mesh_alignment - 1) / cooked_mesh_alignment * cooked_mesh_alignment;
+            }
+        } // namespace
+
         void loader::print_info(const ref<ctx> &context, const char *filename) noexcept
         {
             unsigned int index;
@@ -60,49 +491,126 @@ namespace deep
                                     const fvec3 &position,
                                     const fvec3 &rotation,
                                     const fvec3 &scale,
-                                    const Microsoft::WRL::ComPtr<ID3D11Device> &device) noexcept
+                                    D3D::device_handle device,
+                                    D3D::vertex_compression compression) noexcept
         {
-            D3D::mesh *c = mem::alloc_type<D3D::mesh>(context.get(), context);
+            imported_model model;
+            std::vector<uint8> vertices;
 
-            if (c == nullptr)
+            if (!import_model(context, filename, model, true))
             {
                 return ref<D3D::mesh>();
             }
 
-            fmat4 model = fmat4();
-            model       = fmat4::translate(model, position);
-            model       = fmat4::rotate_x(model, rotation.x);
-            model       = fmat4::rotate_y(model, rotation.y);
-            model       = fmat4::rotate_z(model, rotation.z);
-            model       = fmat4::scale(model, scale);
+            mesh_view view = make_view(model);
+            quantize_view(view, compression, vertices);
 
-            fmat4 projection = fmat4::d3d_perspective_lh(1.0f, 3.0f / 4.0f, 0.5f, 10.0f);
+            return create_mesh(context, view, vs, ps, position, rotation, scale, device);
+        }
 
-            const D3D::per_object_buffer pob = {
-                projection * model
-            };
+        bool loader::cook(const ref<ctx> &context, const char *filename, stream *output, D3D::vertex_compression compression, cook_statistics *statistics) noexcept
+        {
+            imported_model model;
+            std::vector<uint8> vertices;
 
-            Assimp::Importer importer;
+            if (output == nullptr || !import_model(context, filename, model, false))
+            {
+                return false;
+            }
 
-            const aiScene *scene = importer.ReadFile(filename,
-                                                     aiProcess_Triangulate |
-                                                             aiProcess_JoinIdenticalVertices);
+            mesh_view view = make_view(model);
+            quantize_view(view, compression, vertices);
 
-            if (scene == nullptr)
+            const uint32 lod_count = static_cast<uint32>(model.lods.size());
+            uint32 lod;
+
+            std::vector<cooked_mesh_lod> lods(lod_count);
+            std::vector<uint16> indices;
+
+            for (lod = 0; lod < lod_count; ++lod)
             {
-                return ref<D3D::mesh>();
+                lods[lod].first_index = static_cast<uint32>(indices.size());
+                lods[lod].index_count = static_cast<uint32>(model.lods[lod].size());
+                lods[lod].error       = model.lod_errors[lod];
+
+                indices.insert(indices.end(), model.lods[lod].begin(), model.lods[lod].end());
             }
 
-            // c->m_vertex_buffer = D3D::resource_factory::create_vertex_buffer(context, vertices, sizeof(vertices), sizeof(vertex), device);
-            c->set_per_object_buffer(D3D::resource_factory::create_constant_buffer(context, &pob, sizeof(pob), device));
-            c->set_vertex_shader(vs);
-            c->set_pixel_shader(ps);
+            cooked_mesh_header header = {};
+            header.magic              = cooked_mesh_magic;
+            header.version            = cooked_mesh_version;
+            header.vertex_stride      = static_cast<uint16>(view.vertex_stride);
+            header.vertex_count       = view.vertex_count;
+            header.submesh_count      = static_cast<uint32>(model.submeshes.size());
+            header.lod_count          = lod_count;
+            header.vertex_compression = static_cast<uint32>(view.compression);
+
+            std::copy(model.min, model.min + 3, header.bounds_min);
+            std::copy(model.max, model.max + 3, header.bounds_max);
+
+            const usize tables_size = sizeof(header) +
+                                      sizeof(cooked_mesh_submesh) * model.submeshes.size() +
+                                      sizeof(cooked_mesh_lod) * lods.size();
 
-            c->set_location(position);
-            c->set_rotation(rotation);
-            c->set_scale(scale);
+            header.vertex_size   = header.vertex_count * header.vertex_stride;
+            header.vertex_offset = static_cast<uint32>(align_offset(tables_size));
+            header.index_size    = static_cast<uint32>(indices.size() * sizeof(uint16));
+            header.index_offset  = static_cast<uint32>(align_offset(header.vertex_offset + header.vertex_size));
+
+            if (statistics != nullptr)
+            {
+                statistics->before = model.before;
+                statistics->after  = model.after;
+            }
+
+            // Octets de remplissage écrits entre les blocs.
+            const uint8 padding[cooked_mesh_alignment] = {};
+            usize bytes_written;
+
+            return output->write(&header, sizeof(header), &bytes_written) &&
+                   output->write(model.submeshes.data(), sizeof(cooked_mesh_submesh) * model.submeshes.size(), &bytes_written) &&
+                   output->write(lods.data(), sizeof(cooked_mesh_lod) * lods.size(), &bytes_written) &&
+                   output->write(padding, header.vertex_offset - tables_size, &bytes_written) &&
+                   output->write(view.vertices, header.vertex_size, &bytes_written) &&
+                   output->write(padding, header.index_offset - (header.vertex_offset + header.vertex_size), &bytes_written) &&
+                   output->write(indices.data(), header.index_size, &bytes_written);
+        }
+
+        void loader::print_statistics(const ref<ctx> &context, const char *filename, const cook_statistics &statistics) noexcept
+        {
+            char line[128];
+            std::snprintf(line,
+                          sizeof(line),
+                          "    ACMR: %.3f -> %.3f, ATVR: %.3f -> %.3f\r\n",
+                          statistics.before.acmr,
+                          statistics.after.acmr,
+                          statistics.before.atvr,
+                          statistics.after.atvr);
+
+            context->out() << "'" << filename << "' vertex cache:\r\n" << line;
+        }
+
+        ref<D3D::mesh> loader::load_cooked(const ref<ctx> &context,
+                                           const char *filename,
+                                           const ref<D3D::vertex_shader> &vs,
+                                           const ref<D3D::pixel_shader> &ps,
+                                           const fvec3 &position,
+                                           const fvec3 &rotation,
+                                           const fvec3 &scale,
+                                           D3D::device_handle device) noexcept
+        {
+            mapped_file file;
+            mesh_view view = {};
+
+            if (!file.open(filename) || !read_cooked(file.get_data(), file.get_size(), view))
+            {
+                context->err() << "[ERROR] Unable to load '" << filename << "' cooked mesh.\r\n";
+
+                return ref<D3D::mesh>();
+            }
 
-            return ref<D3D::mesh>(context, c);
+            // Les buffers copient leurs données à la création : la projection peut être fermée ensuite.
+            return create_mesh(context, view, vs, ps, position, rotation, scale, device);
         }
     } // namespace model
 } // namespace deep
@@ -4,13 +4,27 @@
 #include "DeepEngine/deep_engine_export.h"
 
 #include "DeepLib/context.hpp"
+#include "DeepLib/stream/stream.hpp"
 
 #include "D3D/drawable/mesh.hpp"
+#include "D3D/vertex_quantization.hpp"
+#include "D3D/device_handle.hpp"
+
+#include "Optimize/optimizer.hpp"
 
 namespace deep
 {
     namespace model
     {
+        /**
+         * @brief Efficacité du cache de sommets d'un maillage préparé, avant et après le réordonnancement des faces.
+         */
+        struct cook_statistics
+        {
+            vertex_cache_statistics before;
+            vertex_cache_statistics after;
+        };
+
         class DEEP_ENGINE_API loader
         {
           public:
@@ -23,7 +37,44 @@ namespace deep
                                        const fvec3 &position,
                                        const fvec3 &rotation,
                                        const fvec3 &scale,
-                                       const Microsoft::WRL::ComPtr<ID3D11Device> &device) noexcept;
+                                       D3D::device_handle device,
+                                       D3D::vertex_compression compression = D3D::vertex_compression::None) noexcept;
+
+            /**
+             * @brief Importe un modèle et écrit le maillage préparé correspondant, niveaux de détail compris.
+             *
+             * Le fichier obtenu est chargé par load_cooked sans Assimp ni simplification.
+             * Rien n'est écrit sur les sorties du contexte, pas même les erreurs : plusieurs imports peuvent avoir lieu
+             * en même temps, l'appelant signale l'échec et affiche les statistiques avec print_statistics.
+             * @param compression Format des sommets écrits, que l'input layout du vertex shader doit suivre.
+             * @param statistics Reçoit l'efficacité du cache de sommets du maillage, peut être nul.
+             * @return false si le modèle ne peut pas être importé ou si l'écriture échoue.
+             */
+            static bool cook(const ref<ctx> &context,
+                             const char *filename,
+                             stream *output,
+                             D3D::vertex_compression compression = D3D::vertex_compression::None,
+                             cook_statistics *statistics         = nullptr) noexcept;
+
+            /**
+             * @brief Affiche les statistiques renvoyées par cook.
+             */
+            static void print_statistics(const ref<ctx> &context, const char *filename, const cook_statistics &statistics) noexcept;
+
+            /**
+             * @brief Charge un maillage écrit par cook.
+             *
+             * Le fichier est projeté en mémoire et ses blocs de sommets et d'indices sont passés tels quels
+             * aux buffers Direct3D, sans aucune conversion. Les sommets gardent le format choisi par cook.
+             */
+            static ref<D3D::mesh> load_cooked(const ref<ctx> &context,
+                                              const char *filename,
+                                              const ref<D3D::vertex_shader> &vs,
+                                              const ref<D3D::pixel_shader> &ps,
+                                              const fvec3 &position,
+                                              const fvec3 &rotation,
+                                              const fvec3 &scale,
+                                              D3D::device_handle device) noexcept;
         };
     } // namespace model
 } // namespace deep
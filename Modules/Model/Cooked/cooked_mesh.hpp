@@ -0,0 +1,74 @@
+#ifndef DEEP_ENGINE_MODEL_COOKED_MESH_HPP
+#define DEEP_ENGINE_MODEL_COOKED_MESH_HPP
+
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    namespace model
+    {
+        // 'DMSH'
+        constexpr uint32 cooked_mesh_magic   = 0x48534D44;
+        constexpr uint16 cooked_mesh_version = 1;
+
+        // Alignement des blocs de sommets et d'indices depuis le début du fichier.
+        constexpr uint32 cooked_mesh_alignment = 16;
+
+        /**
+         * @brief En-tête d'un fichier de maillage préparé par loader::cook.
+         *
+         * L'en-tête est suivi de la table des sous-maillages, de celle des niveaux de détail puis des blocs de
+         * sommets et d'indices, chacun aligné sur cooked_mesh_alignment. Les indices sont en 16 bits et ceux de
+         * tous les niveaux se suivent dans un seul bloc. Toutes les valeurs sont en little-endian.
+         */
+        struct cooked_mesh_header
+        {
+            uint32 magic;
+            uint16 version;
+            uint16 vertex_stride;
+            uint32 vertex_count;
+            uint32 submesh_count;
+            uint32 lod_count;
+
+            // Valeur de D3D::vertex_compression. Les positions quantifiées le sont dans la boîte englobante.
+            uint32 vertex_compression;
+
+            // Boîte englobante des sommets, dans le repère de l'objet.
+            float bounds_min[3];
+            float bounds_max[3];
+
+            // Positions des blocs depuis le début du fichier, et leurs tailles en octets.
+            uint32 vertex_offset;
+            uint32 vertex_size;
+            uint32 index_offset;
+            uint32 index_size;
+        };
+
+        /**
+         * @brief Plage d'un maillage de la scène d'origine dans le niveau de détail le plus fin.
+         */
+        struct cooked_mesh_submesh
+        {
+            uint32 first_index;
+            uint32 index_count;
+            uint32 first_vertex;
+            uint32 vertex_count;
+        };
+
+        /**
+         * @brief Indices d'un niveau de détail, le premier étant le maillage complet.
+         */
+        struct cooked_mesh_lod
+        {
+            // En nombre d'indices depuis le début du bloc d'indices.
+            uint32 first_index;
+            uint32 index_count;
+
+            // Erreur géométrique du niveau, en unités de l'objet.
+            float error;
+            uint32 reserved;
+        };
+    } // namespace model
+} // namespace deep
+
+#endif
@@ -0,0 +1,380 @@
+#include "LOD/simplifier.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace deep
+{
+    namespace model
+    {
+        namespace
+        {
+            // Nombre maximal de passes de fusion.
+            constexpr uint32 max_passes = 64;
+
+            /**
+             * @brief Matrice 4x4 symétrique de la somme des carrés des distances aux plans, pondérée par l'aire des faces.
+             */
+            struct quadric
+            {
+                double a00, a01, a02, a03;
+                double a11, a12, a13;
+                double a22, a23;
+                double a33;
+                double weight;
+            };
+
+            struct collapse
+            {
+                uint32 from;
+                uint32 to;
+                float cost;
+            };
+
+            void add_plane(quadric &q, double a, double b, double c, double d, double weight) noexcept
+            {
+                q.a00 += weight * a * a;
+                q.a01 += weight * a * b;
+                q.a02 += weight * a * c;
+                q.a03 += weight * a * d;
+                q.a11 += weight * b * b;
+                q.a12 += weight * b * c;
+                q.a13 += weight * b * d;
+                q.a22 += weight * c * c;
+                q.a23 += weight * c * d;
+                q.a33 += weight * d * d;
+                q.weight += weight;
+            }
+
+            void add_quadric(quadric &q, const quadric &other) noexcept
+            {
+                q.a00 += other.a00;
+                q.a01 += other.a01;
+                q.a02 += other.a02;
+                q.a03 += other.a03;
+                q.a11 += other.a11;
+                q.a12 += other.a12;
+                q.a13 += other.a13;
+                q.a22 += other.a22;
+                q.a23 += other.a23;
+                q.a33 += other.a33;
+                q.weight += other.weight;
+            }
+
+            /**
+             * @brief Évalue la moyenne pondérée des carrés des distances de p aux plans de deux quadriques.
+             */
+            float evaluate(const quadric &a, const quadric &b, const float *p) noexcept
+            {
+                const double x = p[0];
+                const double y = p[1];
+                const double z = p[2];
+
+                const double a00 = a.a00 + b.a00;
+                const double a01 = a.a01 + b.a01;
+                const double a02 = a.a02 + b.a02;
+                const double a03 = a.a03 + b.a03;
+                const double a11 = a.a11 + b.a11;
+                const double a12 = a.a12 + b.a12;
+                const double a13 = a.a13 + b.a13;
+                const double a22 = a.a22 + b.a22;
+                const double a23 = a.a23 + b.a23;
+                const double a33 = a.a33 + b.a33;
+
+                const double weight = a.weight + b.weight;
+
+                const double error = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x +
+                                     a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y +
+                                     a22 * z * z + 2.0 * a23 * z +
+                                     a33;
+
+                return weight > 0.0 ? static_cast<float>(std::fabs(error) / weight) : 0.0f;
+            }
+
+            void cross(const float *a, const float *b, const float *c, float *out) noexcept
+            {
+                const float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+                const float ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+
+                out[0] = ab[1] * ac[2] - ab[2] * ac[1];
+                out[1] = ab[2] * ac[0] - ab[0] * ac[2];
+                out[2] = ab[0] * ac[1] - ab[1] * ac[0];
+            }
+        } // namespace
+
+        uint32 simplify(const float *positions,
+                        uint32 vertex_count,
+                        const uint32 *indices,
+                        uint32 index_count,
+                        uint32 target_index_count,
+                        float max_error,
+                        uint32 *out_indices,
+                        float *out_error) noexcept
+        {
+            std::vector<uint32> current(indices, indices + index_count);
+            uint32 index;
+
+            if (out_error != nullptr)
+            {
+                *out_error = 0.0f;
+            }
+
+            // Quadriques des faces d'origine, accumulées sur le sommet conservé à chaque fusion.
+            std::vector<quadric> quadrics(vertex_count);
+            std::memset(quadrics.data(), 0, sizeof(quadric) * vertex_count);
+
+            for (index = 0; index + 2 < index_count; index += 3)
+            {
+                const float *p0 = &positions[indices[index + 0] * 3];
+                const float *p1 = &positions[indices[index + 1] * 3];
+                const float *p2 = &positions[indices[index + 2] * 3];
+
+                float normal[3];
+                cross(p0, p1, p2, normal);
+
+                const double length = std::sqrt(static_cast<double>(normal[0]) * normal[0] + static_cast<double>(normal[1]) * normal[1] + static_cast<double>(normal[2]) * normal[2]);
+
+                if (length <= 0.0)
+                {
+                    continue;
+                }
+
+                const double a = normal[0] / length;
+                const double b = normal[1] / length;
+                const double c = normal[2] / length;
+                const double d = -(a * p0[0] + b * p0[1] + c * p0[2]);
+
+                // Le double de l'aire du triangle sert de poids.
+                uint32 corner;
+
+                for (corner = 0; corner < 3; ++corner)
+                {
+                    add_plane(quadrics[indices[index + corner]], a, b, c, d, length);
+                }
+            }
+
+            // Une arête orientée sans arête opposée appartient à un bord ouvert : ses sommets sont verrouillés.
+            std::vector<uint8> locked(vertex_count, 0);
+            std::vector<uint64> edges;
+            edges.reserve(index_count);
+
+            for (index = 0; index + 2 < index_count; index += 3)
+            {
+                uint32 corner;
+
+                for (corner = 0; corner < 3; ++corner)
+                {
+                    const uint32 a = indices[index + corner];
+                    const uint32 b = indices[index + (corner + 1) % 3];
+
+                    edges.push_back(static_cast<uint64>(a) << 32 | b);
+                }
+            }
+
+            std::sort(edges.begin(), edges.end());
+
+            for (uint64 edge : edges)
+            {
+                const uint64 opposite = (edge << 32) | (edge >> 32);
+
+                if (!std::binary_search(edges.begin(), edges.end(), opposite))
+                {
+                    locked[static_cast<uint32>(edge >> 32)]        = 1;
+                    locked[static_cast<uint32>(edge & 0xFFFFFFFF)] = 1;
+                }
+            }
+
+            const float max_cost = max_error * max_error;
+            float result_cost    = 0.0f;
+
+            std::vector<uint32> adjacency_offsets(static_cast<usize>(vertex_count) + 1);
+            std::vector<uint32> adjacency;
+            std::vector<collapse> collapses;
+            std::vector<uint32> remap(vertex_count);
+            std::vector<uint8> touched(vertex_count);
+
+            uint32 pass;
+
+            for (pass = 0; pass < max_passes && current.size() > target_index_count; ++pass)
+            {
+                const uint32 triangle_count = static_cast<uint32>(current.size() / 3);
+
+                // Triangles de chaque sommet, rangés de manière contiguë.
+                std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0);
+
+                for (uint32 vertex : current)
+                {
+                    adjacency_offsets[vertex + 1]++;
+                }
+
+                for (index = 0; index < vertex_count; ++index)
+                {
+                    adjacency_offsets[index + 1] += adjacency_offsets[index];
+                }
+
+                adjacency.resize(current.size());
+
+                {
+                    std::vector<uint32> cursor(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+
+                    for (index = 0; index < current.size(); ++index)
+                    {
+                        adjacency[cursor[current[index]]++] = index / 3;
+                    }
+                }
+
+                // Pour chaque arête, la fusion la moins coûteuse des deux sens autorisés.
+                collapses.clear();
+
+                for (index = 0; index < current.size(); ++index)
+                {
+                    const uint32 a = current[index];
+                    const uint32 b = current[index - index % 3 + (index + 1) % 3];
+
+                    if (a > b && !locked[a] && !locked[b])
+                    {
+                        // L'arête sera aussi vue dans l'autre sens par le triangle voisin.
+                        continue;
+                    }
+
+                    const float cost_ab = locked[a] ? -1.0f : evaluate(quadrics[a], quadrics[b], &positions[b * 3]);
+                    const float cost_ba = locked[b] ? -1.0f : evaluate(quadrics[a], quadrics[b], &positions[a * 3]);
+
+                    if (cost_ab < 0.0f && cost_ba < 0.0f)
+                    {
+                        continue;
+                    }
+
+                    if (cost_ba < 0.0f || (cost_ab >= 0.0f && cost_ab <= cost_ba))
+                    {
+                        collapses.push_back({a, b, cost_ab});
+                    }
+                    else
+                    {
+                        collapses.push_back({b, a, cost_ba});
+                    }
+                }
+
+                std::sort(collapses.begin(), collapses.end(), [](const collapse &x, const collapse &y) { return x.cost < y.cost; });
+
+                for (index = 0; index < vertex_count; ++index)
+                {
+                    remap[index] = index;
+                }
+
+                std::fill(touched.begin(), touched.end(), 0);
+
+                const uint32 target_triangles = target_index_count / 3;
+                uint32 removed                = 0;
+                uint32 applied                = 0;
+
+                for (const collapse &candidate : collapses)
+                {
+                    if (candidate.cost > max_cost || triangle_count - removed <= target_triangles)
+                    {
+                        break;
+                    }
+
+                    if (touched[candidate.from] || touched[candidate.to])
+                    {
+                        continue;
+                    }
+
+                    const float *target = &positions[candidate.to * 3];
+                    bool flipped        = false;
+                    uint32 shared       = 0;
+                    uint32 slot;
+
+                    // Refuse les fusions qui retourneraient un triangle voisin.
+                    for (slot = adjacency_offsets[candidate.from]; slot < adjacency_offsets[candidate.from + 1] && !flipped; ++slot)
+                    {
+                        const uint32 *triangle = &current[adjacency[slot] * 3];
+
+                        if (triangle[0] == candidate.to || triangle[1] == candidate.to || triangle[2] == candidate.to)
+                        {
+                            shared++;
+                            continue;
+                        }
+
+                        const float *p[3];
+                        const float *moved[3];
+                        uint32 corner;
+
+                        for (corner = 0; corner < 3; ++corner)
+                        {
+                            p[corner]     = &positions[triangle[corner] * 3];
+                            moved[corner] = triangle[corner] == candidate.from ? target : p[corner];
+                        }
+
+                        float before[3];
+                        float after[3];
+
+                        cross(p[0], p[1], p[2], before);
+                        cross(moved[0], moved[1], moved[2], after);
+
+                        flipped = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0f;
+                    }
+
+                    if (flipped)
+                    {
+                        continue;
+                    }
+
+                    remap[candidate.from] = candidate.to;
+                    add_quadric(quadrics[candidate.to], quadrics[candidate.from]);
+
+                    // Les triangles voisins changent : leurs sommets attendent la passe suivante.
+                    for (slot = adjacency_offsets[candidate.from]; slot < adjacency_offsets[candidate.from + 1]; ++slot)
+                    {
+                        const uint32 *triangle = &current[adjacency[slot] * 3];
+
+                        touched[triangle[0]] = 1;
+                        touched[triangle[1]] = 1;
+                        touched[triangle[2]] = 1;
+                    }
+
+                    result_cost = std::max(result_cost, candidate.cost);
+                    removed += shared;
+                    applied++;
+                }
+
+                if (applied == 0)
+                {
+                    break;
+                }
+
+                // Réécrit les indices et retire les triangles dégénérés.
+                usize write = 0;
+
+                for (index = 0; index < current.size(); index += 3)
+                {
+                    const uint32 a = remap[current[index + 0]];
+                    const uint32 b = remap[current[index + 1]];
+                    const uint32 c = remap[current[index + 2]];
+
+                    if (a == b || b == c || c == a)
+                    {
+                        continue;
+                    }
+
+                    current[write++] = a;
+                    current[write++] = b;
+                    current[write++] = c;
+                }
+
+                current.resize(write);
+            }
+
+            std::copy(current.begin(), current.end(), out_indices);
+
+            if (out_error != nullptr)
+            {
+                *out_error = std::sqrt(result_cost);
+            }
+
+            return static_cast<uint32>(current.size());
+        }
+    } // namespace model
+} // namespace deep
@@ -0,0 +1,35 @@
+#ifndef DEEP_ENGINE_MODEL_SIMPLIFIER_HPP
+#define DEEP_ENGINE_MODEL_SIMPLIFIER_HPP
+
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    namespace model
+    {
+        /**
+         * @brief Simplifie un maillage indexé par fusion d'arêtes guidée par les quadriques d'erreur (Garland-Heckbert).
+         *
+         * Une arête est fusionnée en déplaçant l'un de ses sommets sur l'autre : les sommets ne sont jamais
+         * modifiés et seul le tableau d'indices est réduit, ce qui permet à tous les niveaux de détail de
+         * partager le même buffer de sommets. Les sommets des bords ouverts ne sont jamais déplacés.
+         *
+         * @param positions 3 flottants par sommet.
+         * @param target_index_count Le nombre d'indices visé, multiple de 3.
+         * @param max_error L'erreur géométrique maximale tolérée, en unités de l'objet.
+         * @param out_indices Reçoit les indices simplifiés, au moins index_count entrées.
+         * @param out_error Reçoit l'erreur géométrique du résultat, en unités de l'objet. Peut être nul.
+         * @return Le nombre d'indices écrits dans out_indices.
+         */
+        uint32 simplify(const float *positions,
+                        uint32 vertex_count,
+                        const uint32 *indices,
+                        uint32 index_count,
+                        uint32 target_index_count,
+                        float max_error,
+                        uint32 *out_indices,
+                        float *out_error) noexcept;
+    } // namespace model
+} // namespace deep
+
+#endif
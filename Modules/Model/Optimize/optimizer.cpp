@@ -0,0 +1,469 @@
+#include "Optimize/optimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace deep
+{
+    namespace model
+    {
+        namespace
+        {
+            // Taille du cache LRU simulé par optimize_vertex_cache. Plus grande que celle des GPU visés :
+            // l'algorithme reste efficace sur des caches plus petits que celui qu'il simule.
+            constexpr uint32 forsyth_cache_size = 32;
+
+            constexpr float cache_decay_power   = 1.5f;
+            constexpr float last_triangle_score = 0.75f;
+            constexpr float valence_boost_scale = 2.0f;
+            constexpr float valence_boost_power = 0.5f;
+
+            constexpr uint32 invalid_index = 0xFFFFFFFF;
+
+            /**
+             * @brief Score d'un sommet de Forsyth : favorise les sommets récents du cache et ceux qui terminent une zone.
+             * @param cache_position -1 si le sommet n'est pas dans le cache.
+             * @param remaining Le nombre de faces pas encore émises qui utilisent le sommet.
+             */
+            float vertex_score(int32 cache_position, uint32 remaining) noexcept
+            {
+                if (remaining == 0)
+                {
+                    return -1.0f;
+                }
+
+                float score = 0.0f;
+
+                if (cache_position >= 0)
+                {
+                    // Les sommets de la dernière face ont un score fixe : ils ne doivent pas être favorisés à l'excès.
+                    if (cache_position < 3)
+                    {
+                        score = last_triangle_score;
+                    }
+                    else
+                    {
+                        const float scale = 1.0f / static_cast<float>(forsyth_cache_size - 3);
+
+                        score = std::pow(1.0f - static_cast<float>(cache_position - 3) * scale, cache_decay_power);
+                    }
+                }
+
+                return score + valence_boost_scale * std::pow(static_cast<float>(remaining), -valence_boost_power);
+            }
+
+            /**
+             * @brief Cache FIFO simulé à l'aide de dates : un sommet est présent s'il a été chargé depuis moins de cache_size défauts.
+             */
+            struct fifo_cache
+            {
+                std::vector<uint32> timestamps;
+                uint32 time;
+                uint32 size;
+
+                fifo_cache(uint32 vertex_count, uint32 cache_size)
+                        : timestamps(vertex_count, 0),
+                          time(cache_size + 1),
+                          size(cache_size)
+                {
+                }
+
+                /**
+                 * @return Le nombre de sommets de la face absents du cache.
+                 */
+                uint32 add_triangle(const uint32 *triangle) noexcept
+                {
+                    uint32 misses = 0;
+                    uint32 corner;
+
+                    for (corner = 0; corner < 3; ++corner)
+                    {
+                        const uint32 vertex = triangle[corner];
+
+                        if (time - timestamps[vertex] > size)
+                        {
+                            timestamps[vertex] = time++;
+                            misses++;
+                        }
+                    }
+
+                    return misses;
+                }
+
+                void clear() noexcept
+                {
+                    time += size + 1;
+                }
+            };
+
+            /**
+             * @brief Groupe de faces consécutives déplacé d'un bloc par optimize_overdraw.
+             */
+            struct cluster
+            {
+                uint32 first_triangle;
+                uint32 triangle_count;
+                float sort_key;
+            };
+        } // namespace
+
+        vertex_cache_statistics analyze_vertex_cache(const uint32 *indices, uint32 index_count, uint32 vertex_count, uint32 cache_size) noexcept
+        {
+            vertex_cache_statistics statistics = {};
+
+            const uint32 triangle_count = index_count / 3;
+
+            if (triangle_count == 0 || vertex_count == 0)
+            {
+                return statistics;
+            }
+
+            fifo_cache cache(vertex_count, cache_size);
+            uint32 triangle;
+
+            for (triangle = 0; triangle < triangle_count; ++triangle)
+            {
+                statistics.vertices_transformed += cache.add_triangle(indices + triangle * 3);
+            }
+
+            statistics.acmr = static_cast<float>(statistics.vertices_transformed) / static_cast<float>(triangle_count);
+            statistics.atvr = static_cast<float>(statistics.vertices_transformed) / static_cast<float>(vertex_count);
+
+            return statistics;
+        }
+
+        void optimize_vertex_cache(const uint32 *indices, uint32 index_count, uint32 vertex_count, uint32 *out_indices) noexcept
+        {
+            const uint32 triangle_count = index_count / 3;
+
+            if (triangle_count == 0)
+            {
+                return;
+            }
+
+            // Liste des faces de chaque sommet. Les faces émises sont retirées en fin de liste.
+            std::vector<uint32> remaining(vertex_count, 0);
+            std::vector<uint32> offsets(vertex_count, 0);
+            std::vector<uint32> adjacency(triangle_count * 3);
+            uint32 vertex;
+            uint32 index;
+
+            for (index = 0; index < triangle_count * 3; ++index)
+            {
+                remaining[indices[index]]++;
+            }
+
+            uint32 offset = 0;
+
+            for (vertex = 0; vertex < vertex_count; ++vertex)
+            {
+                offsets[vertex] = offset;
+                offset += remaining[vertex];
+            }
+
+            std::vector<uint32> fill(offsets);
+
+            for (index = 0; index < triangle_count * 3; ++index)
+            {
+                adjacency[fill[indices[index]]++] = index / 3;
+            }
+
+            std::vector<int32> cache_positions(vertex_count, -1);
+            std::vector<float> vertex_scores(vertex_count);
+            std::vector<uint8> emitted(triangle_count, 0);
+
+            for (vertex = 0; vertex < vertex_count; ++vertex)
+            {
+                vertex_scores[vertex] = vertex_score(-1, remaining[vertex]);
+            }
+
+            // La première face émise est celle de meilleur score, c'est-à-dire dont les sommets ont le moins de voisines.
+            uint32 best_triangle = invalid_index;
+            float best_score     = -1.0f;
+            uint32 triangle;
+
+            for (triangle = 0; triangle < triangle_count; ++triangle)
+            {
+                const uint32 *corners = indices + triangle * 3;
+                const float score     = vertex_scores[corners[0]] + vertex_scores[corners[1]] + vertex_scores[corners[2]];
+
+                if (score > best_score)
+                {
+                    best_score    = score;
+                    best_triangle = triangle;
+                }
+            }
+
+            // Les trois places supplémentaires reçoivent les sommets de la face émise avant l'éviction des plus anciens.
+            uint32 cache[forsyth_cache_size + 3];
+            uint32 new_cache[forsyth_cache_size + 3];
+            uint32 cache_count = 0;
+
+            // Première face pas encore émise, reprise quand aucune face ne touche le cache.
+            uint32 cursor = 0;
+            uint32 output = 0;
+
+            while (best_triangle != invalid_index)
+            {
+                const uint32 *corners = indices + best_triangle * 3;
+                uint32 new_count      = 0;
+                uint32 corner;
+
+                out_indices[output++] = corners[0];
+                out_indices[output++] = corners[1];
+                out_indices[output++] = corners[2];
+
+                emitted[best_triangle] = 1;
+
+                for (corner = 0; corner < 3; ++corner)
+                {
+                    vertex = corners[corner];
+
+                    // Une face dégénérée répète un sommet : il n'est placé qu'une fois dans le cache.
+                    if (std::find(new_cache, new_cache + new_count, vertex) == new_cache + new_count)
+                    {
+                        new_cache[new_count++] = vertex;
+                    }
+
+                    uint32 *faces = adjacency.data() + offsets[vertex];
+                    uint32 *found = std::find(faces, faces + remaining[vertex], best_triangle);
+
+                    *found = faces[--remaining[vertex]];
+                }
+
+                for (index = 0; index < cache_count; ++index)
+                {
+                    if (cache[index] != corners[0] && cache[index] != corners[1] && cache[index] != corners[2])
+                    {
+                        new_cache[new_count++] = cache[index];
+                    }
+                }
+
+                // Les sommets évincés perdent leur bonus de cache.
+                for (index = 0; index < new_count; ++index)
+                {
+                    vertex = new_cache[index];
+
+                    cache_positions[vertex] = index < forsyth_cache_size ? static_cast<int32>(index) : -1;
+                    vertex_scores[vertex]   = vertex_score(cache_positions[vertex], remaining[vertex]);
+                }
+
+                cache_count = std::min(new_count, forsyth_cache_size);
+                std::memcpy(cache, new_cache, sizeof(uint32) * cache_count);
+
+                // Seules les faces des sommets dont le score a changé sont réévaluées.
+                best_triangle = invalid_index;
+                best_score    = -1.0f;
+
+                for (index = 0; index < new_count; ++index)
+                {
+                    vertex = new_cache[index];
+
+                    const uint32 *faces = adjacency.data() + offsets[vertex];
+                    uint32 face;
+
+                    for (face = 0; face < remaining[vertex]; ++face)
+                    {
+                        triangle                    = faces[face];
+                        const uint32 *other_corners = indices + triangle * 3;
+                        const float score           = vertex_scores[other_corners[0]] + vertex_scores[other_corners[1]] + vertex_scores[other_corners[2]];
+
+                        if (score > best_score)
+                        {
+                            best_score    = score;
+                            best_triangle = triangle;
+                        }
+                    }
+                }
+
+                if (best_triangle != invalid_index)
+                {
+                    continue;
+                }
+
+                // Aucune face ne touche le cache : on repart de la première face restante dans l'ordre d'origine.
+                while (cursor < triangle_count && emitted[cursor] != 0)
+                {
+                    cursor++;
+                }
+
+                if (cursor < triangle_count)
+                {
+                    best_triangle = cursor;
+                }
+            }
+        }
+
+        void optimize_overdraw(const uint32 *indices,
+                               uint32 index_count,
+                               const float *positions,
+                               uint32 vertex_count,
+                               float threshold,
+                               uint32 *out_indices) noexcept
+        {
+            const uint32 triangle_count = index_count / 3;
+
+            if (triangle_count == 0)
+            {
+                return;
+            }
+
+            const float mesh_acmr = analyze_vertex_cache(indices, index_count, vertex_count).acmr;
+
+            // Découpage en groupes : le cache repart de zéro au début de chaque groupe, puisqu'ils seront déplacés.
+            std::vector<cluster> clusters;
+            fifo_cache cache(vertex_count, default_vertex_cache_size);
+            cluster current      = {};
+            uint32 cluster_misses = 0;
+            uint32 triangle;
+
+            for (triangle = 0; triangle < triangle_count; ++triangle)
+            {
+                const uint32 misses = cache.add_triangle(indices + triangle * 3);
+
+                // Une face dont aucun sommet n'est en cache commence une nouvelle zone du maillage.
+                if (misses == 3 && current.triangle_count > 0)
+                {
+                    clusters.push_back(current);
+
+                    current.first_triangle = triangle;
+                    current.triangle_count = 0;
+                    cluster_misses         = 0;
+
+                    cache.clear();
+                    cache.add_triangle(indices + triangle * 3);
+                }
+
+                current.triangle_count++;
+                cluster_misses += misses;
+
+                // Un groupe assez efficace est fermé tôt : les petits groupes se trient plus finement.
+                if (static_cast<float>(cluster_misses) <= threshold * mesh_acmr * static_cast<float>(current.triangle_count) &&
+                    triangle + 1 < triangle_count)
+                {
+                    clusters.push_back(current);
+
+                    current.first_triangle = triangle + 1;
+                    current.triangle_count = 0;
+                    cluster_misses         = 0;
+
+                    cache.clear();
+                }
+            }
+
+            if (current.triangle_count > 0)
+            {
+                clusters.push_back(current);
+            }
+
+            // Centre de l'objet, pondéré par l'aire des faces.
+            float mesh_center[3] = {};
+            float mesh_area      = 0.0f;
+            std::vector<float> cluster_data(clusters.size() * 7, 0.0f);
+            usize cluster_index;
+
+            for (cluster_index = 0; cluster_index < clusters.size(); ++cluster_index)
+            {
+                const cluster &c = clusters[cluster_index];
+                float *data      = cluster_data.data() + cluster_index * 7;
+
+                for (triangle = c.first_triangle; triangle < c.first_triangle + c.triangle_count; ++triangle)
+                {
+                    const float *p0 = positions + indices[triangle * 3 + 0] * 3;
+                    const float *p1 = positions + indices[triangle * 3 + 1] * 3;
+                    const float *p2 = positions + indices[triangle * 3 + 2] * 3;
+
+                    const float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                    const float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+
+                    // Le produit vectoriel a pour norme le double de l'aire de la face.
+                    const float normal[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+                                             e1[2] * e2[0] - e1[0] * e2[2],
+                                             e1[0] * e2[1] - e1[1] * e2[0]};
+
+                    const float area = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+                    uint32 axis;
+
+                    for (axis = 0; axis < 3; ++axis)
+                    {
+                        data[axis] += (p0[axis] + p1[axis] + p2[axis]) / 3.0f * area;
+                        data[3 + axis] += normal[axis];
+                    }
+
+                    data[6] += area;
+                }
+
+                mesh_center[0] += data[0];
+                mesh_center[1] += data[1];
+                mesh_center[2] += data[2];
+                mesh_area += data[6];
+            }
+
+            if (mesh_area > 0.0f)
+            {
+                mesh_center[0] /= mesh_area;
+                mesh_center[1] /= mesh_area;
+                mesh_center[2] /= mesh_area;
+            }
+
+            // Un groupe loin du centre et tourné vers l'extérieur cache probablement le reste de l'objet.
+            for (cluster_index = 0; cluster_index < clusters.size(); ++cluster_index)
+            {
+                const float *data = cluster_data.data() + cluster_index * 7;
+
+                const float area   = data[6] > 0.0f ? data[6] : 1.0f;
+                const float length = std::sqrt(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+                const float scale  = length > 0.0f ? 1.0f / length : 0.0f;
+
+                clusters[cluster_index].sort_key = (data[0] / area - mesh_center[0]) * data[3] * scale +
+                                                   (data[1] / area - mesh_center[1]) * data[4] * scale +
+                                                   (data[2] / area - mesh_center[2]) * data[5] * scale;
+            }
+
+            std::stable_sort(clusters.begin(), clusters.end(), [](const cluster &a, const cluster &b) {
+                return a.sort_key > b.sort_key;
+            });
+
+            uint32 *output = out_indices;
+
+            for (const cluster &c : clusters)
+            {
+                std::memcpy(output, indices + c.first_triangle * 3, sizeof(uint32) * c.triangle_count * 3);
+                output += c.triangle_count * 3;
+            }
+        }
+
+        uint32 optimize_vertex_fetch(uint32 *indices,
+                                     uint32 index_count,
+                                     const void *vertices,
+                                     uint32 vertex_count,
+                                     uint32 stride,
+                                     void *out_vertices) noexcept
+        {
+            std::vector<uint32> remap(vertex_count, invalid_index);
+            uint32 next = 0;
+            uint32 index;
+
+            const uint8 *source = static_cast<const uint8 *>(vertices);
+            uint8 *destination  = static_cast<uint8 *>(out_vertices);
+
+            for (index = 0; index < index_count; ++index)
+            {
+                uint32 &target = remap[indices[index]];
+
+                if (target == invalid_index)
+                {
+                    std::memcpy(destination + static_cast<usize>(next) * stride, source + static_cast<usize>(indices[index]) * stride, stride);
+
+                    target = next++;
+                }
+
+                indices[index] = target;
+            }
+
+            return next;
+        }
+    } // namespace model
+} // namespace deep
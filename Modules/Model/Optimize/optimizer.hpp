@@ -0,0 +1,84 @@
+#ifndef DEEP_ENGINE_MODEL_OPTIMIZER_HPP
+#define DEEP_ENGINE_MODEL_OPTIMIZER_HPP
+
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    namespace model
+    {
+        // Taille du cache de sommets transformés simulé par défaut, en sommets.
+        constexpr uint32 default_vertex_cache_size = 16;
+
+        // Dégradation tolérée de l'ACMR par optimize_overdraw pour rendre les groupes de faces plus petits.
+        constexpr float default_overdraw_threshold = 1.05f;
+
+        /**
+         * @brief Efficacité d'un ordre d'indices vis-à-vis du cache de sommets transformés du GPU.
+         */
+        struct vertex_cache_statistics
+        {
+            // Nombre de sommets transformés par le vertex shader.
+            uint32 vertices_transformed;
+
+            // Sommets transformés par face (Average Cache Miss Ratio) : entre 0.5 et 3, au mieux proche de 0.5.
+            float acmr;
+
+            // Sommets transformés par sommet du maillage (Average Transformed Vertex Ratio) : au mieux 1.
+            float atvr;
+        };
+
+        /**
+         * @brief Simule un cache FIFO de sommets transformés sur une liste de faces.
+         */
+        vertex_cache_statistics analyze_vertex_cache(const uint32 *indices,
+                                                     uint32 index_count,
+                                                     uint32 vertex_count,
+                                                     uint32 cache_size = default_vertex_cache_size) noexcept;
+
+        /**
+         * @brief Réordonne les faces pour réutiliser au mieux le cache de sommets transformés (algorithme de Forsyth).
+         *
+         * Chaque sommet reçoit un score selon sa position dans un cache LRU simulé et le nombre de faces qui
+         * l'utilisent encore ; la face de meilleur score parmi celles qui touchent le cache est émise à chaque pas.
+         * Le temps d'exécution est linéaire en nombre de faces.
+         *
+         * @param out_indices Reçoit les faces réordonnées, index_count entrées. Ne doit pas être indices.
+         */
+        void optimize_vertex_cache(const uint32 *indices, uint32 index_count, uint32 vertex_count, uint32 *out_indices) noexcept;
+
+        /**
+         * @brief Réordonne des groupes de faces pour que celles qui en cachent d'autres soient dessinées en premier.
+         *
+         * Les faces, déjà optimisées par optimize_vertex_cache, sont découpées en groupes là où le cache repart de
+         * zéro puis là où l'ACMR du groupe reste sous threshold fois celui du maillage. Les groupes sont ensuite
+         * triés en commençant par ceux qui sont tournés vers l'extérieur de l'objet, à la manière de Tipsify.
+         *
+         * @param positions 3 flottants par sommet.
+         * @param out_indices Reçoit les faces réordonnées, index_count entrées. Ne doit pas être indices.
+         */
+        void optimize_overdraw(const uint32 *indices,
+                               uint32 index_count,
+                               const float *positions,
+                               uint32 vertex_count,
+                               float threshold,
+                               uint32 *out_indices) noexcept;
+
+        /**
+         * @brief Range les sommets dans l'ordre de leur première utilisation par les faces.
+         *
+         * Les indices sont renumérotés sur place et les sommets inutilisés sont retirés.
+         *
+         * @param out_vertices Reçoit les sommets réordonnés, au moins vertex_count * stride octets. Ne doit pas être vertices.
+         * @return Le nombre de sommets écrits dans out_vertices.
+         */
+        uint32 optimize_vertex_fetch(uint32 *indices,
+                                     uint32 index_count,
+                                     const void *vertices,
+                                     uint32 vertex_count,
+                                     uint32 stride,
+                                     void *out_vertices) noexcept;
+    } // namespace model
+} // namespace deep
+
+#endif
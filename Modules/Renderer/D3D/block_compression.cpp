@@ -0,0 +1,1061 @@
+#include "D3D/block_compression.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#include <emmintrin.h>
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace block_compression
+        {
+            namespace
+            {
+                constexpr uint32 pixel_count = block_size * block_size;
+
+                // Masque des pixels d'un bloc entier.
+                constexpr uint32 all_pixels = 0xFFFF;
+
+                // Poids d'interpolation des indices BC7 sur 4 bits, sur 64.
+                constexpr uint8 bc7_weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+                // Indice du bit de poids faible d'un masque de 4 bits non nul.
+                constexpr uint8 lowest_bit[16] = { 0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0 };
+
+                // Position sur l'axe de chaque indice d'un bloc de couleurs BC1 à 4 couleurs.
+                constexpr float bc1_positions[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+                /**
+                 * @brief Plus petite des 4 valeurs et indice de sa première occurrence.
+                 */
+                inline uint32 min_index(__m128 values, float &minimum) noexcept
+                {
+                    __m128 m = _mm_min_ps(values, _mm_shuffle_ps(values, values, _MM_SHUFFLE(2, 3, 0, 1)));
+                    m        = _mm_min_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+
+                    minimum = _mm_cvtss_f32(m);
+
+                    return lowest_bit[_mm_movemask_ps(_mm_cmpeq_ps(values, m))];
+                }
+
+                /**
+                 * @brief Palette de 4 à 16 couleurs rangée par canal, pour comparer 4 couleurs à la fois avec SSE.
+                 */
+                struct palette
+                {
+                    alignas(16) float channels[4][16];
+                    uint32 count;
+                };
+
+                /**
+                 * @brief Choisit pour chaque pixel la couleur la plus proche de la palette.
+                 * @param mask Les pixels à traiter, les autres gardent leur indice.
+                 * @return La somme des erreurs quadratiques des pixels traités.
+                 */
+                float select_indices(const uint8 *pixels, uint32 mask, uint32 channels, const palette &pal, uint8 *indices) noexcept
+                {
+                    float total = 0.0f;
+                    uint32 pixel;
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        if ((mask & (1u << pixel)) == 0)
+                        {
+                            continue;
+                        }
+
+                        const uint8 *texel = pixels + pixel * 4;
+                        float best         = FLT_MAX;
+                        uint32 best_index  = 0;
+                        uint32 group;
+
+                        for (group = 0; group < pal.count; group += 4)
+                        {
+                            __m128 distance = _mm_setzero_ps();
+                            uint32 channel;
+
+                            for (channel = 0; channel < channels; ++channel)
+                            {
+                                const __m128 delta = _mm_sub_ps(_mm_load_ps(pal.channels[channel] + group), _mm_set1_ps(static_cast<float>(texel[channel])));
+                                distance           = _mm_add_ps(distance, _mm_mul_ps(delta, delta));
+                            }
+
+                            float minimum;
+                            uint32 index = min_index(distance, minimum);
+
+                            if (minimum < best)
+                            {
+                                best       = minimum;
+                                best_index = group + index;
+                            }
+                        }
+
+                        indices[pixel] = static_cast<uint8>(best_index);
+                        total += best;
+                    }
+
+                    return total;
+                }
+
+                /**
+                 * @brief Calcule la moyenne et l'axe principal des pixels choisis, par itérations sur leur covariance.
+                 */
+                void compute_axis(const uint8 *pixels, uint32 mask, uint32 channels, float *mean, float *axis) noexcept
+                {
+                    float covariance[4][4] = {};
+                    uint32 count           = 0;
+                    uint32 pixel;
+                    uint32 i;
+                    uint32 j;
+
+                    for (i = 0; i < 4; ++i)
+                    {
+                        mean[i] = 0.0f;
+                        axis[i] = 0.0f;
+                    }
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        if ((mask & (1u << pixel)) != 0)
+                        {
+                            for (i = 0; i < channels; ++i)
+                            {
+                                mean[i] += static_cast<float>(pixels[pixel * 4 + i]);
+                            }
+
+                            count++;
+                        }
+                    }
+
+                    if (count == 0)
+                    {
+                        return;
+                    }
+
+                    for (i = 0; i < channels; ++i)
+                    {
+                        mean[i] /= static_cast<float>(count);
+                    }
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        if ((mask & (1u << pixel)) == 0)
+                        {
+                            continue;
+                        }
+
+                        float delta[4];
+
+                        for (i = 0; i < channels; ++i)
+                        {
+                            delta[i] = static_cast<float>(pixels[pixel * 4 + i]) - mean[i];
+                        }
+
+                        for (i = 0; i < channels; ++i)
+                        {
+                            for (j = i; j < channels; ++j)
+                            {
+                                covariance[i][j] += delta[i] * delta[j];
+                            }
+                        }
+                    }
+
+                    // La ligne de plus grande variance est un bon point de départ.
+                    uint32 start = 0;
+
+                    for (i = 0; i < channels; ++i)
+                    {
+                        for (j = 0; j < i; ++j)
+                        {
+                            covariance[i][j] = covariance[j][i];
+                        }
+
+                        if (covariance[i][i] > covariance[start][start])
+                        {
+                            start = i;
+                        }
+                    }
+
+                    if (covariance[start][start] <= 0.0f)
+                    {
+                        return;
+                    }
+
+                    float vector[4] = {};
+                    uint32 iteration;
+
+                    for (i = 0; i < channels; ++i)
+                    {
+                        vector[i] = covariance[start][i];
+                    }
+
+                    for (iteration = 0; iteration < 8; ++iteration)
+                    {
+                        float next[4] = {};
+                        float largest = 0.0f;
+
+                        for (i = 0; i < channels; ++i)
+                        {
+                            for (j = 0; j < channels; ++j)
+                            {
+                                next[i] += covariance[i][j] * vector[j];
+                            }
+
+                            largest = std::max(largest, std::fabs(next[i]));
+                        }
+
+                        if (largest <= 0.0f)
+                        {
+                            break;
+                        }
+
+                        for (i = 0; i < channels; ++i)
+                        {
+                            vector[i] = next[i] / largest;
+                        }
+                    }
+
+                    float length = 0.0f;
+
+                    for (i = 0; i < channels; ++i)
+                    {
+                        length += vector[i] * vector[i];
+                    }
+
+                    if (length <= 0.0f)
+                    {
+                        return;
+                    }
+
+                    length = 1.0f / std::sqrt(length);
+
+                    for (i = 0; i < channels; ++i)
+                    {
+                        axis[i] = vector[i] * length;
+                    }
+                }
+
+                /**
+                 * @brief Extrémités des pixels choisis le long de leur axe principal.
+                 * @param inset Fraction de l'intervalle retirée à chaque extrémité.
+                 */
+                void find_endpoints(const uint8 *pixels, uint32 mask, uint32 channels, float inset, float *first, float *second) noexcept
+                {
+                    float mean[4];
+                    float axis[4];
+                    float minimum = FLT_MAX;
+                    float maximum = -FLT_MAX;
+                    uint32 pixel;
+                    uint32 i;
+
+                    compute_axis(pixels, mask, channels, mean, axis);
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        if ((mask & (1u << pixel)) == 0)
+                        {
+                            continue;
+                        }
+
+                        float position = 0.0f;
+
+                        for (i = 0; i < channels; ++i)
+                        {
+                            position += (static_cast<float>(pixels[pixel * 4 + i]) - mean[i]) * axis[i];
+                        }
+
+                        minimum = std::min(minimum, position);
+                        maximum = std::max(maximum, position);
+                    }
+
+                    if (minimum > maximum)
+                    {
+                        minimum = 0.0f;
+                        maximum = 0.0f;
+                    }
+
+                    const float shrink = (maximum - minimum) * inset;
+
+                    minimum += shrink;
+                    maximum -= shrink;
+
+                    for (i = 0; i < 4; ++i)
+                    {
+                        first[i]  = std::min(255.0f, std::max(0.0f, mean[i] + axis[i] * maximum));
+                        second[i] = std::min(255.0f, std::max(0.0f, mean[i] + axis[i] * minimum));
+                    }
+                }
+
+                /**
+                 * @brief Réajuste les extrémités par moindres carrés, à partir de la position de chaque pixel entre elles.
+                 * @return false si les positions ne permettent pas de les déterminer.
+                 */
+                bool fit_endpoints(const uint8 *pixels, uint32 mask, uint32 channels, const float *positions, float *first, float *second) noexcept
+                {
+                    float a             = 0.0f;
+                    float b             = 0.0f;
+                    float c             = 0.0f;
+                    float first_sum[4]  = {};
+                    float second_sum[4] = {};
+                    uint32 pixel;
+                    uint32 i;
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        if ((mask & (1u << pixel)) == 0)
+                        {
+                            continue;
+                        }
+
+                        const float t = positions[pixel];
+                        const float s = 1.0f - t;
+
+                        a += s * s;
+                        b += s * t;
+                        c += t * t;
+
+                        for (i = 0; i < channels; ++i)
+                        {
+                            first_sum[i] += s * static_cast<float>(pixels[pixel * 4 + i]);
+                            second_sum[i] += t * static_cast<float>(pixels[pixel * 4 + i]);
+                        }
+                    }
+
+                    const float determinant = a * c - b * b;
+
+                    if (std::fabs(determinant) < 1e-3f)
+                    {
+                        return false;
+                    }
+
+                    const float inverse = 1.0f / determinant;
+
+                    for (i = 0; i < channels; ++i)
+                    {
+                        first[i]  = std::min(255.0f, std::max(0.0f, (c * first_sum[i] - b * second_sum[i]) * inverse));
+                        second[i] = std::min(255.0f, std::max(0.0f, (a * second_sum[i] - b * first_sum[i]) * inverse));
+                    }
+
+                    return true;
+                }
+
+                inline uint16 pack_565(const float *color) noexcept
+                {
+                    const uint32 r = static_cast<uint32>(color[0] * (31.0f / 255.0f) + 0.5f);
+                    const uint32 g = static_cast<uint32>(color[1] * (63.0f / 255.0f) + 0.5f);
+                    const uint32 b = static_cast<uint32>(color[2] * (31.0f / 255.0f) + 0.5f);
+
+                    return static_cast<uint16>((r << 11) | (g << 5) | b);
+                }
+
+                inline void unpack_565(uint16 value, uint8 *color) noexcept
+                {
+                    const uint32 r = (value >> 11) & 0x1F;
+                    const uint32 g = (value >> 5) & 0x3F;
+                    const uint32 b = value & 0x1F;
+
+                    color[0] = static_cast<uint8>((r << 3) | (r >> 2));
+                    color[1] = static_cast<uint8>((g << 2) | (g >> 4));
+                    color[2] = static_cast<uint8>((b << 3) | (b >> 2));
+                    color[3] = 255;
+                }
+
+                /**
+                 * @brief Couleurs décodées d'un bloc BC1, dans l'ordre des indices.
+                 */
+                void bc1_colors(uint16 first, uint16 second, bool four_colors, uint8 colors[4][4]) noexcept
+                {
+                    uint32 i;
+
+                    unpack_565(first, colors[0]);
+                    unpack_565(second, colors[1]);
+
+                    for (i = 0; i < 3; ++i)
+                    {
+                        if (four_colors)
+                        {
+                            colors[2][i] = static_cast<uint8>((2 * colors[0][i] + colors[1][i]) / 3);
+                            colors[3][i] = static_cast<uint8>((colors[0][i] + 2 * colors[1][i]) / 3);
+                        }
+                        else
+                        {
+                            colors[2][i] = static_cast<uint8>((colors[0][i] + colors[1][i]) / 2);
+                            colors[3][i] = 0;
+                        }
+                    }
+
+                    colors[2][3] = 255;
+                    colors[3][3] = four_colors ? 255 : 0;
+                }
+
+                struct bc1_candidate
+                {
+                    uint16 first;
+                    uint16 second;
+                    uint8 indices[pixel_count];
+                    float error;
+                };
+
+                /**
+                 * @brief Ordonne les extrémités selon le mode voulu puis choisit les indices de chaque pixel.
+                 */
+                void evaluate_bc1(const uint8 *pixels, uint32 opaque, bool three_colors, const float *first, const float *second, bc1_candidate &candidate) noexcept
+                {
+                    candidate.first  = pack_565(first);
+                    candidate.second = pack_565(second);
+
+                    // Le mode à 4 couleurs est indiqué par first > second, le mode à 3 couleurs par first <= second.
+                    if (three_colors ? candidate.first > candidate.second : candidate.first < candidate.second)
+                    {
+                        std::swap(candidate.first, candidate.second);
+                    }
+
+                    uint8 colors[4][4];
+                    bc1_colors(candidate.first, candidate.second, !three_colors, colors);
+
+                    palette pal = {};
+                    pal.count   = 4;
+                    uint32 entry;
+                    uint32 channel;
+
+                    for (entry = 0; entry < 4; ++entry)
+                    {
+                        for (channel = 0; channel < 3; ++channel)
+                        {
+                            pal.channels[channel][entry] = static_cast<float>(colors[entry][channel]);
+                        }
+                    }
+
+                    // En mode à 3 couleurs, la dernière est réservée aux pixels transparents.
+                    if (three_colors)
+                    {
+                        pal.channels[0][3] = FLT_MAX;
+                    }
+
+                    std::memset(candidate.indices, 3, sizeof(candidate.indices));
+                    candidate.error = select_indices(pixels, opaque, 3, pal, candidate.indices);
+                }
+
+                /**
+                 * @brief Encode les couleurs d'un bloc au format BC1, les pixels d'alpha inférieur à 128 devenant
+                 * transparents si transparency est vrai.
+                 */
+                void encode_color_block(const uint8 *pixels, bool transparency, uint8 *out) noexcept
+                {
+                    uint32 opaque = all_pixels;
+                    uint32 pixel;
+
+                    if (transparency)
+                    {
+                        for (pixel = 0; pixel < pixel_count; ++pixel)
+                        {
+                            if (pixels[pixel * 4 + 3] < 128)
+                            {
+                                opaque &= ~(1u << pixel);
+                            }
+                        }
+                    }
+
+                    const bool three_colors = opaque != all_pixels;
+
+                    float first[4];
+                    float second[4];
+
+                    find_endpoints(pixels, opaque, 3, 1.0f / 16.0f, first, second);
+
+                    bc1_candidate best;
+                    evaluate_bc1(pixels, opaque, three_colors, first, second, best);
+
+                    // Un réajustement par moindres carrés réduit l'erreur de la plupart des blocs en dégradé.
+                    if (!three_colors && best.first != best.second)
+                    {
+                        float positions[pixel_count];
+
+                        for (pixel = 0; pixel < pixel_count; ++pixel)
+                        {
+                            positions[pixel] = bc1_positions[best.indices[pixel]];
+                        }
+
+                        if (fit_endpoints(pixels, opaque, 3, positions, first, second))
+                        {
+                            bc1_candidate candidate;
+                            evaluate_bc1(pixels, opaque, false, first, second, candidate);
+
+                            if (candidate.error < best.error)
+                            {
+                                best = candidate;
+                            }
+                        }
+                    }
+
+                    uint32 bits = 0;
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        bits |= static_cast<uint32>(best.indices[pixel]) << (pixel * 2);
+                    }
+
+                    out[0] = static_cast<uint8>(best.first & 0xFF);
+                    out[1] = static_cast<uint8>(best.first >> 8);
+                    out[2] = static_cast<uint8>(best.second & 0xFF);
+                    out[3] = static_cast<uint8>(best.second >> 8);
+                    out[4] = static_cast<uint8>(bits & 0xFF);
+                    out[5] = static_cast<uint8>((bits >> 8) & 0xFF);
+                    out[6] = static_cast<uint8>((bits >> 16) & 0xFF);
+                    out[7] = static_cast<uint8>(bits >> 24);
+                }
+
+                void decode_color_block(const uint8 *block, bool four_colors, uint8 *pixels) noexcept
+                {
+                    const uint16 first  = static_cast<uint16>(block[0] | (block[1] << 8));
+                    const uint16 second = static_cast<uint16>(block[2] | (block[3] << 8));
+                    const uint32 bits   = static_cast<uint32>(block[4]) | (static_cast<uint32>(block[5]) << 8) | (static_cast<uint32>(block[6]) << 16) | (static_cast<uint32>(block[7]) << 24);
+
+                    uint8 colors[4][4];
+                    bc1_colors(first, second, four_colors || first > second, colors);
+
+                    uint32 pixel;
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        std::memcpy(pixels + pixel * 4, colors[(bits >> (pixel * 2)) & 0x3], 4);
+                    }
+                }
+
+                /**
+                 * @brief Encode l'alpha d'un bloc au format BC3 : 8 niveaux répartis entre l'alpha minimal et maximal.
+                 */
+                void encode_alpha_block(const uint8 *pixels, uint8 *out) noexcept
+                {
+                    uint8 minimum = 255;
+                    uint8 maximum = 0;
+                    uint32 pixel;
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        minimum = std::min(minimum, pixels[pixel * 4 + 3]);
+                        maximum = std::max(maximum, pixels[pixel * 4 + 3]);
+                    }
+
+                    out[0] = maximum;
+                    out[1] = minimum;
+
+                    uint64 bits = 0;
+
+                    if (maximum > minimum)
+                    {
+                        const float scale = 7.0f / static_cast<float>(maximum - minimum);
+
+                        for (pixel = 0; pixel < pixel_count; ++pixel)
+                        {
+                            // Position entre le maximum (0) et le minimum (7), les indices 0 et 1 désignant les extrémités.
+                            const uint32 step = static_cast<uint32>(static_cast<float>(maximum - pixels[pixel * 4 + 3]) * scale + 0.5f);
+                            uint64 index;
+
+                            if (step == 0)
+                            {
+                                index = 0;
+                            }
+                            else if (step == 7)
+                            {
+                                index = 1;
+                            }
+                            else
+                            {
+                                index = step + 1;
+                            }
+
+                            bits |= index << (pixel * 3);
+                        }
+                    }
+
+                    uint32 i;
+
+                    for (i = 0; i < 6; ++i)
+                    {
+                        out[2 + i] = static_cast<uint8>((bits >> (i * 8)) & 0xFF);
+                    }
+                }
+
+                void decode_alpha_block(const uint8 *block, uint8 *pixels) noexcept
+                {
+                    uint32 alphas[8];
+                    uint64 bits = 0;
+                    uint32 i;
+
+                    alphas[0] = block[0];
+                    alphas[1] = block[1];
+
+                    if (alphas[0] > alphas[1])
+                    {
+                        for (i = 1; i < 7; ++i)
+                        {
+                            alphas[i + 1] = ((7 - i) * alphas[0] + i * alphas[1]) / 7;
+                        }
+                    }
+                    else
+                    {
+                        for (i = 1; i < 5; ++i)
+                        {
+                            alphas[i + 1] = ((5 - i) * alphas[0] + i * alphas[1]) / 5;
+                        }
+
+                        alphas[6] = 0;
+                        alphas[7] = 255;
+                    }
+
+                    for (i = 0; i < 6; ++i)
+                    {
+                        bits |= static_cast<uint64>(block[2 + i]) << (i * 8);
+                    }
+
+                    for (i = 0; i < pixel_count; ++i)
+                    {
+                        pixels[i * 4 + 3] = static_cast<uint8>(alphas[(bits >> (i * 3)) & 0x7]);
+                    }
+                }
+
+                /**
+                 * @brief Écriture de champs de bits, du bit de poids faible au bit de poids fort.
+                 */
+                struct bit_writer
+                {
+                    uint8 *data;
+                    uint32 position;
+
+                    void write(uint32 value, uint32 count) noexcept
+                    {
+                        uint32 bit;
+
+                        for (bit = 0; bit < count; ++bit, ++position)
+                        {
+                            if ((value >> bit) & 1)
+                            {
+                                data[position >> 3] |= static_cast<uint8>(1u << (position & 7));
+                            }
+                        }
+                    }
+                };
+
+                struct bit_reader
+                {
+                    const uint8 *data;
+                    uint32 position;
+
+                    uint32 read(uint32 count) noexcept
+                    {
+                        uint32 value = 0;
+                        uint32 bit;
+
+                        for (bit = 0; bit < count; ++bit, ++position)
+                        {
+                            value |= static_cast<uint32>((data[position >> 3] >> (position & 7)) & 1) << bit;
+                        }
+
+                        return value;
+                    }
+                };
+
+                /**
+                 * @brief Extrémité BC7 du mode 6 : 4 canaux sur 7 bits et un bit de poids faible partagé.
+                 */
+                struct bc7_endpoint
+                {
+                    uint8 values[4];
+                    uint8 pbit;
+
+                    uint8 get(uint32 channel) const noexcept
+                    {
+                        return static_cast<uint8>((values[channel] << 1) | pbit);
+                    }
+                };
+
+                /**
+                 * @brief Quantifie une couleur en choisissant le bit partagé qui l'approche le mieux.
+                 * @param opaque true pour imposer le bit à 1, seul à conserver un alpha de 255.
+                 */
+                bc7_endpoint quantize_bc7(const float *color, bool opaque) noexcept
+                {
+                    bc7_endpoint best = {};
+                    float best_error  = FLT_MAX;
+                    uint8 pbit;
+
+                    for (pbit = opaque ? 1 : 0; pbit < 2; ++pbit)
+                    {
+                        bc7_endpoint candidate = {};
+                        candidate.pbit         = pbit;
+                        float error            = 0.0f;
+                        uint32 channel;
+
+                        for (channel = 0; channel < 4; ++channel)
+                        {
+                            const float value = std::min(127.0f, std::max(0.0f, std::floor((color[channel] - pbit) * 0.5f + 0.5f)));
+                            const float delta = static_cast<float>((static_cast<uint32>(value) << 1) | pbit) - color[channel];
+
+                            candidate.values[channel] = static_cast<uint8>(value);
+                            error += delta * delta;
+                        }
+
+                        if (error < best_error)
+                        {
+                            best       = candidate;
+                            best_error = error;
+                        }
+                    }
+
+                    return best;
+                }
+
+                struct bc7_candidate
+                {
+                    bc7_endpoint first;
+                    bc7_endpoint second;
+                    uint8 indices[pixel_count];
+                    float error;
+                };
+
+                void evaluate_bc7(const uint8 *pixels, bool opaque, const float *first, const float *second, bc7_candidate &candidate) noexcept
+                {
+                    candidate.first  = quantize_bc7(first, opaque);
+                    candidate.second = quantize_bc7(second, opaque);
+
+                    palette pal = {};
+                    pal.count   = 16;
+                    uint32 entry;
+                    uint32 channel;
+
+                    for (entry = 0; entry < 16; ++entry)
+                    {
+                        const uint32 weight = bc7_weights[entry];
+
+                        for (channel = 0; channel < 4; ++channel)
+                        {
+                            pal.channels[channel][entry] = static_cast<float>(((64 - weight) * candidate.first.get(channel) + weight * candidate.second.get(channel) + 32) >> 6);
+                        }
+                    }
+
+                    candidate.error = select_indices(pixels, all_pixels, 4, pal, candidate.indices);
+                }
+            } // namespace
+
+            uint32 get_block_bytes(texture_format format) noexcept
+            {
+                switch (format)
+                {
+                    case texture_format::BC1:
+                        return 8;
+                    case texture_format::BC3:
+                    case texture_format::BC7:
+                        return 16;
+                    default:
+                        return 0;
+                }
+            }
+
+            uint32 get_row_pitch(texture_format format, uint32 width) noexcept
+            {
+                const uint32 block_bytes = get_block_bytes(format);
+
+                if (block_bytes == 0)
+                {
+                    return width * 4;
+                }
+
+                return std::max(1u, (width + block_size - 1) / block_size) * block_bytes;
+            }
+
+            uint32 get_row_count(texture_format format, uint32 height) noexcept
+            {
+                if (get_block_bytes(format) == 0)
+                {
+                    return height;
+                }
+
+                return std::max(1u, (height + block_size - 1) / block_size);
+            }
+
+            void encode_bc1(const uint8 *pixels, uint8 *out) noexcept
+            {
+                encode_color_block(pixels, true, out);
+            }
+
+            void encode_bc3(const uint8 *pixels, uint8 *out) noexcept
+            {
+                encode_alpha_block(pixels, out);
+                encode_color_block(pixels, false, out + 8);
+            }
+
+            void encode_bc7(const uint8 *pixels, uint8 *out) noexcept
+            {
+                float first[4];
+                float second[4];
+                bool opaque = true;
+                uint32 pixel;
+
+                for (pixel = 0; pixel < pixel_count; ++pixel)
+                {
+                    opaque = opaque && pixels[pixel * 4 + 3] == 255;
+                }
+
+                find_endpoints(pixels, all_pixels, 4, 0.0f, first, second);
+
+                bc7_candidate best;
+                evaluate_bc7(pixels, opaque, first, second, best);
+
+                // Deux réajustements par moindres carrés : le premier corrige l'essentiel, le second affine les blocs en dégradé.
+                uint32 iteration;
+
+                for (iteration = 0; iteration < 2 && best.error > 0.0f; ++iteration)
+                {
+                    float positions[pixel_count];
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        positions[pixel] = static_cast<float>(bc7_weights[best.indices[pixel]]) * (1.0f / 64.0f);
+                    }
+
+                    if (!fit_endpoints(pixels, all_pixels, 4, positions, first, second))
+                    {
+                        break;
+                    }
+
+                    bc7_candidate candidate;
+                    evaluate_bc7(pixels, opaque, first, second, candidate);
+
+                    if (candidate.error >= best.error)
+                    {
+                        break;
+                    }
+
+                    best = candidate;
+                }
+
+                // Le bit de poids fort de l'indice du premier pixel est implicite et doit être nul.
+                if (best.indices[0] & 0x8)
+                {
+                    std::swap(best.first, best.second);
+
+                    for (pixel = 0; pixel < pixel_count; ++pixel)
+                    {
+                        best.indices[pixel] = static_cast<uint8>(15 - best.indices[pixel]);
+                    }
+                }
+
+                std::memset(out, 0, 16);
+
+                bit_writer writer = { out, 0 };
+                uint32 channel;
+
+                // Mode 6 : six bits nuls puis un bit à 1.
+                writer.write(1u << 6, 7);
+
+                for (channel = 0; channel < 4; ++channel)
+                {
+                    writer.write(best.first.values[channel], 7);
+                    writer.write(best.second.values[channel], 7);
+                }
+
+                writer.write(best.first.pbit, 1);
+                writer.write(best.second.pbit, 1);
+
+                for (pixel = 0; pixel < pixel_count; ++pixel)
+                {
+                    writer.write(best.indices[pixel], pixel == 0 ? 3 : 4);
+                }
+            }
+
+            void decode_bc1(const uint8 *block, uint8 *pixels) noexcept
+            {
+                decode_color_block(block, false, pixels);
+            }
+
+            void decode_bc3(const uint8 *block, uint8 *pixels) noexcept
+            {
+                decode_color_block(block + 8, true, pixels);
+                decode_alpha_block(block, pixels);
+            }
+
+            bool decode_bc7(const uint8 *block, uint8 *pixels) noexcept
+            {
+                if ((block[0] & 0x7F) != (1u << 6))
+                {
+                    return false;
+                }
+
+                bit_reader reader = { block, 7 };
+                bc7_endpoint first;
+                bc7_endpoint second;
+                uint32 channel;
+                uint32 pixel;
+
+                for (channel = 0; channel < 4; ++channel)
+                {
+                    first.values[channel]  = static_cast<uint8>(reader.read(7));
+                    second.values[channel] = static_cast<uint8>(reader.read(7));
+                }
+
+                first.pbit  = static_cast<uint8>(reader.read(1));
+                second.pbit = static_cast<uint8>(reader.read(1));
+
+                for (pixel = 0; pixel < pixel_count; ++pixel)
+                {
+                    const uint32 weight = bc7_weights[reader.read(pixel == 0 ? 3 : 4)];
+
+                    for (channel = 0; channel < 4; ++channel)
+                    {
+                        pixels[pixel * 4 + channel] = static_cast<uint8>(((64 - weight) * first.get(channel) + weight * second.get(channel) + 32) >> 6);
+                    }
+                }
+
+                return true;
+            }
+
+            void compress(texture_format format, const uint8 *pixels, uint32 width, uint32 height, usize row_bytes, bool bgra, uint8 *out, thread_pool *pool)
+            {
+                const uint32 block_bytes = get_block_bytes(format);
+
+                if (block_bytes == 0 || width == 0 || height == 0)
+                {
+                    return;
+                }
+
+                const uint32 blocks_x = get_row_pitch(format, width) / block_bytes;
+                const uint32 blocks_y = get_row_count(format, height);
+                const uint32 pitch    = blocks_x * block_bytes;
+                const uint32 tasks    = (blocks_y + block_rows_per_task - 1) / block_rows_per_task;
+
+                auto task = [&](uint32 task_index, uint32) {
+                    const uint32 first = task_index * block_rows_per_task;
+                    const uint32 last  = std::min(blocks_y, first + block_rows_per_task);
+                    uint8 block[pixel_count * 4];
+                    uint32 by;
+                    uint32 bx;
+                    uint32 x;
+                    uint32 y;
+
+                    for (by = first; by < last; ++by)
+                    {
+                        for (bx = 0; bx < blocks_x; ++bx)
+                        {
+                            // Les pixels hors de l'image répètent ceux du bord.
+                            for (y = 0; y < block_size; ++y)
+                            {
+                                const uint8 *row = pixels + static_cast<usize>(std::min(by * block_size + y, height - 1)) * row_bytes;
+
+                                for (x = 0; x < block_size; ++x)
+                                {
+                                    const uint8 *texel = row + static_cast<usize>(std::min(bx * block_size + x, width - 1)) * 4;
+                                    uint8 *target      = block + (y * block_size + x) * 4;
+
+                                    target[0] = texel[bgra ? 2 : 0];
+                                    target[1] = texel[1];
+                                    target[2] = texel[bgra ? 0 : 2];
+                                    target[3] = texel[3];
+                                }
+                            }
+
+                            uint8 *destination = out + static_cast<usize>(by) * pitch + static_cast<usize>(bx) * block_bytes;
+
+                            switch (format)
+                            {
+                                case texture_format::BC1:
+                                {
+                                    encode_bc1(block, destination);
+                                }
+                                break;
+                                case texture_format::BC3:
+                                {
+                                    encode_bc3(block, destination);
+                                }
+                                break;
+                                default:
+                                {
+                                    encode_bc7(block, destination);
+                                }
+                                break;
+                            }
+                        }
+                    }
+                };
+
+                if (pool != nullptr && tasks > 1)
+                {
+                    pool->parallel_for(tasks, task);
+                }
+                else
+                {
+                    uint32 task_index;
+
+                    for (task_index = 0; task_index < tasks; ++task_index)
+                    {
+                        task(task_index, 0);
+                    }
+                }
+            }
+
+            bool decompress(texture_format format, const uint8 *data, uint32 width, uint32 height, uint8 *pixels)
+            {
+                const uint32 block_bytes = get_block_bytes(format);
+
+                if (block_bytes == 0)
+                {
+                    std::memcpy(pixels, data, static_cast<usize>(width) * height * 4);
+
+                    return true;
+                }
+
+                const uint32 blocks_x = get_row_pitch(format, width) / block_bytes;
+                const uint32 blocks_y = get_row_count(format, height);
+                uint8 block[pixel_count * 4];
+                uint32 by;
+                uint32 bx;
+                uint32 x;
+                uint32 y;
+
+                for (by = 0; by < blocks_y; ++by)
+                {
+                    for (bx = 0; bx < blocks_x; ++bx)
+                    {
+                        const uint8 *source = data + (static_cast<usize>(by) * blocks_x + bx) * block_bytes;
+
+                        switch (format)
+                        {
+                            case texture_format::BC1:
+                            {
+                                decode_bc1(source, block);
+                            }
+                            break;
+                            case texture_format::BC3:
+                            {
+                                decode_bc3(source, block);
+                            }
+                            break;
+                            default:
+                            {
+                                if (!decode_bc7(source, block))
+                                {
+                                    return false;
+                                }
+                            }
+                            break;
+                        }
+
+                        for (y = 0; y < block_size && by * block_size + y < height; ++y)
+                        {
+                            for (x = 0; x < block_size && bx * block_size + x < width; ++x)
+                            {
+                                std::memcpy(pixels + (static_cast<usize>(by * block_size + y) * width + bx * block_size + x) * 4, block + (y * block_size + x) * 4, 4);
+                            }
+                        }
+                    }
+                }
+
+                return true;
+            }
+        } // namespace block_compression
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,76 @@
+#ifndef DEEP_ENGINE_D3D_BLOCK_COMPRESSION_HPP
+#define DEEP_ENGINE_D3D_BLOCK_COMPRESSION_HPP
+
+#include <DeepCore/types.hpp>
+
+#include "D3D/cooked_texture.hpp"
+#include "D3D/thread_pool.hpp"
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Compression des textures par blocs de 4x4 pixels, aux formats BC1, BC3 et BC7.
+         *
+         * BC1 et BC3 sont les chemins rapides : les extrémités sont prises sur l'axe principal des couleurs du bloc.
+         * BC7 est le chemin de qualité : il utilise le mode 6 (un seul sous-ensemble, RGBA sur 7 bits plus un bit
+         * partagé, 16 niveaux d'interpolation) et réajuste les extrémités par moindres carrés.
+         *
+         * Les blocs reçoivent et rendent des pixels RGBA : 16 pixels de 4 octets, ligne par ligne.
+         */
+        namespace block_compression
+        {
+            static constexpr uint32 block_size = 4;
+
+            // Nombre de lignes de blocs traitées par tâche lors d'une compression multithread.
+            static constexpr uint32 block_rows_per_task = 4;
+
+            /**
+             * @return La taille en octets d'un bloc compressé, 0 pour un format non compressé.
+             */
+            uint32 get_block_bytes(texture_format format) noexcept;
+
+            /**
+             * @brief Taille en octets d'une ligne de blocs ou de pixels d'une image de la largeur donnée.
+             */
+            uint32 get_row_pitch(texture_format format, uint32 width) noexcept;
+
+            /**
+             * @brief Nombre de lignes de blocs ou de pixels d'une image de la hauteur donnée.
+             */
+            uint32 get_row_count(texture_format format, uint32 height) noexcept;
+
+            void encode_bc1(const uint8 *pixels, uint8 *out) noexcept;
+            void encode_bc3(const uint8 *pixels, uint8 *out) noexcept;
+            void encode_bc7(const uint8 *pixels, uint8 *out) noexcept;
+
+            void decode_bc1(const uint8 *block, uint8 *pixels) noexcept;
+            void decode_bc3(const uint8 *block, uint8 *pixels) noexcept;
+
+            /**
+             * @brief Décode un bloc BC7. Seul le mode 6, produit par encode_bc7, est pris en charge.
+             * @return false si le bloc utilise un autre mode.
+             */
+            bool decode_bc7(const uint8 *block, uint8 *pixels) noexcept;
+
+            /**
+             * @brief Compresse une image 8 bits à 4 canaux.
+             *
+             * Les bords des images dont les dimensions ne sont pas multiples de 4 sont répétés.
+             * @param bgra true si les canaux de l'image sont dans l'ordre BGRA.
+             * @param out Au moins get_row_pitch(format, width) * get_row_count(format, height) octets.
+             * @param pool Threads se partageant les lignes de blocs, nul pour tout compresser sur le thread appelant.
+             */
+            void compress(texture_format format, const uint8 *pixels, uint32 width, uint32 height, usize row_bytes, bool bgra, uint8 *out, thread_pool *pool = nullptr);
+
+            /**
+             * @brief Décompresse une image en pixels RGBA, lignes contiguës.
+             * @return false si un bloc n'a pas pu être décodé.
+             */
+            bool decompress(texture_format format, const uint8 *data, uint32 width, uint32 height, uint8 *pixels);
+        } // namespace block_compression
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -1,28 +1,65 @@
 #include "constant_buffer.hpp"
 #include "D3D/device_context.hpp"
 
+#include <DeepLib/memory/memory.hpp>
+
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
+
+#include <cstring>
+
 namespace deep
 {
     namespace D3D
     {
+        constant_buffer::~constant_buffer() noexcept
+        {
+#ifdef DEEP_D3D11
+            release_native(m_buffer);
+#endif
+
+            if (m_data != nullptr)
+            {
+                mem::dealloc(get_context_ptr(), m_data);
+            }
+        }
+
         void constant_buffer::update(const void *data, const device_context &dc) noexcept
         {
-            dc.get()->UpdateSubresource(m_buffer.Get(), 0, nullptr, data, 0, 0);
+            if (dc.is_null())
+            {
+                if (m_data != nullptr)
+                {
+                    std::memcpy(m_data, data, m_bytes_size);
+                }
+
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            dc.get()->UpdateSubresource(m_buffer, 0, nullptr, data, 0, 0);
+#endif
         }
 
         ID3D11Buffer *constant_buffer::get() const noexcept
         {
-            return m_buffer.Get();
+            return m_buffer;
         }
 
         ID3D11Buffer *const *constant_buffer::get_address() const noexcept
         {
-            return m_buffer.GetAddressOf();
+            return &m_buffer;
         }
 
         uint32 constant_buffer::get_bytes_size() const noexcept
         {
             return m_bytes_size;
         }
+
+        const uint8 *constant_buffer::get_data() const noexcept
+        {
+            return m_data;
+        }
     } // namespace D3D
 } // namespace deep
@@ -3,8 +3,8 @@
 
 #include "deep_d3d_export.h"
 #include <DeepLib/object.hpp>
-#include <d3d11.h>
-#include <wrl.h>
+
+struct ID3D11Buffer;
 
 namespace deep
 {
@@ -12,17 +12,13 @@ namespace deep
     {
         class device_context;
 
-#ifndef DEEP_D3D_BUFFER
-#define DEEP_D3D_BUFFER
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11Buffer>;
-#endif
-
         class DEEP_D3D_API constant_buffer : public object
         {
           public:
             constant_buffer()                                   = delete;
             constant_buffer(const constant_buffer &)            = delete;
             constant_buffer &operator=(const constant_buffer &) = delete;
+            ~constant_buffer() noexcept;
 
             void update(const void *data, const device_context &dc) noexcept;
 
@@ -31,9 +27,16 @@ namespace deep
 
             uint32 get_bytes_size() const noexcept;
 
+            /**
+             * @brief Récupère la copie du contenu conservée côté CPU.
+             * @return nullptr si le buffer a été créé sur un périphérique Direct3D.
+             */
+            const uint8 *get_data() const noexcept;
+
           protected:
-            Microsoft::WRL::ComPtr<ID3D11Buffer> m_buffer;
+            ID3D11Buffer *m_buffer = nullptr;
             uint32 m_bytes_size;
+            uint8 *m_data = nullptr;
 
           protected:
             using object::object;
@@ -0,0 +1,227 @@
+#include "constant_ring_buffer.hpp"
+#include "D3D/device_context.hpp"
+
+#include <DeepLib/memory/memory.hpp>
+
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
+
+#include <cstring>
+
+namespace deep
+{
+    namespace D3D
+    {
+        constant_ring_buffer::~constant_ring_buffer() noexcept
+        {
+#ifdef DEEP_D3D11
+            release_native(m_buffer);
+#endif
+
+            if (m_data != nullptr)
+            {
+                mem::dealloc(get_context_ptr(), m_data);
+            }
+        }
+
+        bool constant_ring_buffer::allocate(uint32 bytes_size, constant_allocation *out) noexcept
+        {
+            if (out == nullptr || !fits(bytes_size))
+            {
+                return false;
+            }
+
+            const uint32 aligned_size = (bytes_size + alignment - 1) & ~(alignment - 1);
+
+            out->wrapped = m_wrapped;
+
+            // Plus assez de place avant la fin : on repart du début de l'anneau.
+            if (m_head + aligned_size > m_capacity)
+            {
+                m_head          = 0;
+                m_needs_discard = true;
+                out->wrapped    = true;
+                m_wrap_count++;
+            }
+
+            out->offset     = m_head;
+            out->bytes_size = aligned_size;
+
+            m_head += aligned_size;
+            m_frame_bytes += aligned_size;
+            m_wrapped = false;
+
+            return true;
+        }
+
+        bool constant_ring_buffer::push(const void *data, uint32 bytes_size, const device_context &dc, constant_allocation *out) noexcept
+        {
+            if (!fits(bytes_size) || !map(dc))
+            {
+                return false;
+            }
+
+            bool written = write(data, bytes_size, out);
+
+            // L'anneau était plein : le prochain map fournit un nouveau buffer et l'écriture repart du début.
+            if (!written)
+            {
+                unmap(dc);
+
+                if (!map(dc))
+                {
+                    return false;
+                }
+
+                written = write(data, bytes_size, out);
+            }
+
+            unmap(dc);
+
+            return written;
+        }
+
+        bool constant_ring_buffer::map(const device_context &dc) noexcept
+        {
+            if (m_mapped != nullptr)
+            {
+                return true;
+            }
+
+            // Sans périphérique, les écritures vont directement dans la copie conservée côté CPU.
+            if (dc.is_null())
+            {
+                if (m_data == nullptr)
+                {
+                    return false;
+                }
+
+                m_mapped        = m_data;
+                m_needs_discard = false;
+                m_frame_maps++;
+
+                return true;
+            }
+
+#ifdef DEEP_D3D11
+            // Après un retour au début, le GPU peut encore lire l'ancien contenu : le pilote en fournit une nouvelle copie.
+            const D3D11_MAP map_type = m_needs_discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+            D3D11_MAPPED_SUBRESOURCE mapped;
+
+            if (FAILED(dc.get()->Map(m_buffer, 0, map_type, 0, &mapped)))
+            {
+                return false;
+            }
+
+            m_mapped        = static_cast<uint8 *>(mapped.pData);
+            m_needs_discard = false;
+            m_frame_maps++;
+
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        bool constant_ring_buffer::write(const void *data, uint32 bytes_size, constant_allocation *out) noexcept
+        {
+            if (m_mapped == nullptr || m_needs_discard || out == nullptr || !fits(bytes_size))
+            {
+                return false;
+            }
+
+            const uint32 aligned_size = (bytes_size + alignment - 1) & ~(alignment - 1);
+
+            // Les dessins en attente lisent encore le contenu mappé : l'anneau ne repart du début qu'au prochain map.
+            if (m_head + aligned_size > m_capacity)
+            {
+                m_head          = 0;
+                m_needs_discard = true;
+                m_wrapped       = true;
+                m_wrap_count++;
+
+                return false;
+            }
+
+            allocate(bytes_size, out);
+
+            std::memcpy(m_mapped + out->offset, data, bytes_size);
+
+            return true;
+        }
+
+        void constant_ring_buffer::unmap(const device_context &dc) noexcept
+        {
+            if (m_mapped == nullptr)
+            {
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!dc.is_null())
+            {
+                dc.get()->Unmap(m_buffer, 0);
+            }
+#endif
+
+            m_mapped = nullptr;
+        }
+
+        bool constant_ring_buffer::is_mapped() const noexcept
+        {
+            return m_mapped != nullptr;
+        }
+
+        bool constant_ring_buffer::fits(uint32 bytes_size) const noexcept
+        {
+            return bytes_size != 0 && bytes_size <= m_capacity && ((bytes_size + alignment - 1) & ~(alignment - 1)) <= m_capacity;
+        }
+
+        void constant_ring_buffer::begin_frame() noexcept
+        {
+            m_frame_bytes = 0;
+            m_frame_maps  = 0;
+        }
+
+        ID3D11Buffer *constant_ring_buffer::get() const noexcept
+        {
+            return m_buffer;
+        }
+
+        ID3D11Buffer *const *constant_ring_buffer::get_address() const noexcept
+        {
+            return &m_buffer;
+        }
+
+        const uint8 *constant_ring_buffer::get_data() const noexcept
+        {
+            return m_data;
+        }
+
+        uint32 constant_ring_buffer::get_capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        uint32 constant_ring_buffer::get_head() const noexcept
+        {
+            return m_head;
+        }
+
+        uint32 constant_ring_buffer::get_frame_bytes() const noexcept
+        {
+            return m_frame_bytes;
+        }
+
+        uint64 constant_ring_buffer::get_wrap_count() const noexcept
+        {
+            return m_wrap_count;
+        }
+
+        uint32 constant_ring_buffer::get_frame_maps() const noexcept
+        {
+            return m_frame_maps;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,133 @@
+#ifndef DEEP_ENGINE_D3D_CONSTANT_RING_BUFFER_HPP
+#define DEEP_ENGINE_D3D_CONSTANT_RING_BUFFER_HPP
+
+#include "deep_d3d_export.h"
+#include <DeepLib/object.hpp>
+
+struct ID3D11Buffer;
+
+namespace deep
+{
+    namespace D3D
+    {
+        class device_context;
+
+        /**
+         * @brief Emplacement réservé dans un constant_ring_buffer.
+         */
+        struct constant_allocation
+        {
+            // Position en octets, multiple de constant_ring_buffer::alignment.
+            uint32 offset;
+            // Taille réservée, arrondie à constant_ring_buffer::alignment.
+            uint32 bytes_size;
+            // Indique que l'allocation a fait repartir l'anneau du début.
+            bool wrapped;
+        };
+
+        /**
+         * @brief Grand buffer de constantes dynamique dans lequel les objets écrivent leurs constantes à la suite.
+         *
+         * Chaque objet lie ensuite sa portion par décalage, ce qui remplace un UpdateSubresource par objet
+         * par une simple copie dans un buffer mappé. Les constantes d'une série de dessins sont écrites entre
+         * un seul map et unmap, avant ces dessins : le buffer est mappé avec D3D11_MAP_WRITE_DISCARD la première
+         * fois et après un retour au début de l'anneau, sinon avec D3D11_MAP_WRITE_NO_OVERWRITE.
+         *
+         * Sans périphérique, le contenu est conservé côté CPU et seule la logique d'allocation est exécutée.
+         */
+        class DEEP_D3D_API constant_ring_buffer : public object
+        {
+          public:
+            /**
+             * @brief Alignement des allocations : 16 constantes de 16 octets, imposé par VSSetConstantBuffers1.
+             */
+            static constexpr uint32 alignment = 256;
+
+            static constexpr uint32 default_capacity = 1024 * 1024;
+
+          public:
+            constant_ring_buffer()                                        = delete;
+            constant_ring_buffer(const constant_ring_buffer &)            = delete;
+            constant_ring_buffer &operator=(const constant_ring_buffer &) = delete;
+            ~constant_ring_buffer() noexcept;
+
+            /**
+             * @brief Réserve une portion alignée de l'anneau, sans rien écrire.
+             * @return false si la taille demandée dépasse la capacité de l'anneau.
+             */
+            bool allocate(uint32 bytes_size, constant_allocation *out) noexcept;
+
+            /**
+             * @brief Réserve une portion de l'anneau et y copie les données, avec un map et un unmap pour elles seules.
+             */
+            bool push(const void *data, uint32 bytes_size, const device_context &dc, constant_allocation *out) noexcept;
+
+            /**
+             * @brief Mappe l'anneau pour une série d'écritures, qui doit se terminer par unmap avant les dessins qui les lisent.
+             */
+            bool map(const device_context &dc) noexcept;
+
+            /**
+             * @brief Réserve une portion de l'anneau mappé et y copie les données.
+             *
+             * Lorsque l'anneau est plein, rien n'est écrit et il repartira du début au prochain map : l'appelant doit
+             * démapper, exécuter les dessins qui lisent les données déjà écrites, puis mapper de nouveau.
+             * @return false si l'anneau n'est pas mappé, s'il est plein ou si la taille dépasse sa capacité.
+             */
+            bool write(const void *data, uint32 bytes_size, constant_allocation *out) noexcept;
+            void unmap(const device_context &dc) noexcept;
+            bool is_mapped() const noexcept;
+
+            /**
+             * @brief Indique si une allocation de cette taille peut tenir dans l'anneau.
+             */
+            bool fits(uint32 bytes_size) const noexcept;
+
+            /**
+             * @brief Remet à zéro les compteurs de l'image courante.
+             */
+            void begin_frame() noexcept;
+
+            ID3D11Buffer *get() const noexcept;
+            ID3D11Buffer *const *get_address() const noexcept;
+
+            /**
+             * @brief Récupère la copie du contenu conservée côté CPU.
+             * @return nullptr si l'anneau a été créé sur un périphérique Direct3D.
+             */
+            const uint8 *get_data() const noexcept;
+
+            uint32 get_capacity() const noexcept;
+            uint32 get_head() const noexcept;
+            uint32 get_frame_bytes() const noexcept;
+            uint64 get_wrap_count() const noexcept;
+
+            /**
+             * @brief Nombre de map de l'image courante.
+             */
+            uint32 get_frame_maps() const noexcept;
+
+          protected:
+            ID3D11Buffer *m_buffer = nullptr;
+            uint8 *m_data        = nullptr;
+            uint32 m_capacity    = 0;
+            uint32 m_head        = 0;
+            uint32 m_frame_bytes = 0;
+            uint64 m_wrap_count  = 0;
+            uint32 m_frame_maps  = 0;
+            bool m_needs_discard = true;
+            bool m_wrapped       = false;
+
+            // Zone mappée en cours d'écriture, nulle hors d'un map.
+            uint8 *m_mapped = nullptr;
+
+          protected:
+            using object::object;
+
+          public:
+            friend class resource_factory;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
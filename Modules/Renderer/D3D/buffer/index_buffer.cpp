@@ -1,22 +1,45 @@
 #include "D3D/buffer/index_buffer.hpp"
 
+#include <DeepLib/memory/memory.hpp>
+
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
+
 namespace deep
 {
     namespace D3D
     {
+        index_buffer::~index_buffer() noexcept
+        {
+#ifdef DEEP_D3D11
+            release_native(m_buffer);
+#endif
+
+            if (m_data != nullptr)
+            {
+                mem::dealloc(get_context_ptr(), m_data);
+            }
+        }
+
         ID3D11Buffer *index_buffer::get() const noexcept
         {
-            return m_buffer.Get();
+            return m_buffer;
         }
 
         ID3D11Buffer *const *index_buffer::get_address() const noexcept
         {
-            return m_buffer.GetAddressOf();
+            return &m_buffer;
         }
 
         uint16 index_buffer::count() const noexcept
         {
             return m_count;
         }
+
+        const uint16 *index_buffer::get_data() const noexcept
+        {
+            return m_data;
+        }
     } // namespace D3D
 } // namespace deep
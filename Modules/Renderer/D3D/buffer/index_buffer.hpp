@@ -3,33 +3,36 @@
 
 #include "deep_d3d_export.h"
 #include <DeepLib/object.hpp>
-#include <d3d11.h>
-#include <wrl.h>
+
+struct ID3D11Buffer;
 
 namespace deep
 {
     namespace D3D
     {
-#ifndef DEEP_D3D_BUFFER
-#define DEEP_D3D_BUFFER
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11Buffer>;
-#endif
-
         class DEEP_D3D_API index_buffer : public object
         {
           public:
             index_buffer()                                = delete;
             index_buffer(const index_buffer &)            = delete;
             index_buffer &operator=(const index_buffer &) = delete;
+            ~index_buffer() noexcept;
 
             ID3D11Buffer *get() const noexcept;
             ID3D11Buffer *const *get_address() const noexcept;
 
             uint16 count() const noexcept;
 
+            /**
+             * @brief Récupère la copie des indices conservée côté CPU.
+             * @return nullptr si le buffer a été créé sur un périphérique Direct3D.
+             */
+            const uint16 *get_data() const noexcept;
+
           protected:
-            Microsoft::WRL::ComPtr<ID3D11Buffer> m_buffer;
+            ID3D11Buffer *m_buffer = nullptr;
             uint16 m_count;
+            uint16 *m_data = nullptr;
 
           protected:
             using object::object;
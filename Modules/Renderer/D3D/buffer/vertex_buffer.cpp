@@ -1,17 +1,95 @@
 #include "vertex_buffer.hpp"
+#include "D3D/device_context.hpp"
+
+#include <DeepLib/memory/memory.hpp>
+
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
+
+#include <cstring>
 
 namespace deep
 {
     namespace D3D
     {
+        vertex_buffer::~vertex_buffer() noexcept
+        {
+#ifdef DEEP_D3D11
+            release_native(m_buffer);
+#endif
+
+            if (m_data != nullptr)
+            {
+                mem::dealloc(get_context_ptr(), m_data);
+            }
+        }
+
+        void vertex_buffer::update(const void *data, uint32 bytes_size, const device_context &dc) noexcept
+        {
+            if (!m_dynamic || bytes_size > m_bytes_size)
+            {
+                return;
+            }
+
+            if (dc.is_null())
+            {
+                if (m_data != nullptr)
+                {
+                    std::memcpy(m_data, data, bytes_size);
+                }
+
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            D3D11_MAPPED_SUBRESOURCE mapped;
+
+            // Le contenu précédent est abandonné, le GPU peut continuer à lire l'ancienne version.
+            if (FAILED(dc.get()->Map(m_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+            {
+                return;
+            }
+
+            std::memcpy(mapped.pData, data, bytes_size);
+
+            dc.get()->Unmap(m_buffer, 0);
+#endif
+        }
+
         ID3D11Buffer *vertex_buffer::get() const noexcept
         {
-            return m_buffer.Get();
+            return m_buffer;
         }
 
         ID3D11Buffer *const *vertex_buffer::get_address() const noexcept
         {
-            return m_buffer.GetAddressOf();
+            return &m_buffer;
+        }
+
+        const uint8 *vertex_buffer::get_data() const noexcept
+        {
+            return m_data;
+        }
+
+        uint32 vertex_buffer::get_bytes_size() const noexcept
+        {
+            return m_bytes_size;
+        }
+
+        uint32 vertex_buffer::get_stride() const noexcept
+        {
+            return m_stride;
+        }
+
+        bool vertex_buffer::is_dynamic() const noexcept
+        {
+            return m_dynamic;
+        }
+
+        vertex_compression vertex_buffer::get_compression() const noexcept
+        {
+            return m_compression;
         }
     } // namespace D3D
 } // namespace deep
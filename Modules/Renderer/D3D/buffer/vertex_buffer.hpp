@@ -2,18 +2,16 @@
 #define DEEP_ENGINE_D3D_VERTEX_BUFFER_HPP
 
 #include "deep_d3d_export.h"
+#include "D3D/vertex_quantization.hpp"
 #include <DeepLib/object.hpp>
-#include <d3d11.h>
-#include <wrl.h>
+
+struct ID3D11Buffer;
 
 namespace deep
 {
     namespace D3D
     {
-#ifndef DEEP_D3D_BUFFER
-#define DEEP_D3D_BUFFER
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11Buffer>;
-#endif
+        class device_context;
 
         class DEEP_D3D_API vertex_buffer : public object
         {
@@ -21,14 +19,40 @@ namespace deep
             vertex_buffer()                                 = delete;
             vertex_buffer(const vertex_buffer &)            = delete;
             vertex_buffer &operator=(const vertex_buffer &) = delete;
+            ~vertex_buffer() noexcept;
+
+            /**
+             * @brief Remplace le début du contenu du buffer.
+             * @remarks Seuls les buffers créés avec resource_factory::create_dynamic_vertex_buffer peuvent être modifiés.
+             */
+            void update(const void *data, uint32 bytes_size, const device_context &dc) noexcept;
 
             ID3D11Buffer *get() const noexcept;
             ID3D11Buffer *const *get_address() const noexcept;
 
+            /**
+             * @brief Récupère la copie des sommets conservée côté CPU.
+             * @return nullptr si le buffer a été créé sur un périphérique Direct3D.
+             */
+            const uint8 *get_data() const noexcept;
+            uint32 get_bytes_size() const noexcept;
+            uint32 get_stride() const noexcept;
+            bool is_dynamic() const noexcept;
+
+            /**
+             * @brief Récupère la compression des sommets, lue par le rendu logiciel pour décoder les positions.
+             */
+            vertex_compression get_compression() const noexcept;
+
           protected:
-            Microsoft::WRL::ComPtr<ID3D11Buffer> m_buffer;
+            ID3D11Buffer *m_buffer = nullptr;
             uint32 m_stride;
             uint32 m_offset;
+            uint32 m_bytes_size = 0;
+            uint8 *m_data       = nullptr;
+            bool m_dynamic      = false;
+
+            vertex_compression m_compression = vertex_compression::None;
 
           protected:
             using object::object;
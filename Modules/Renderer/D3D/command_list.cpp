@@ -0,0 +1,321 @@
+#include "D3D/command_list.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace deep
+{
+    namespace D3D
+    {
+        void command_list::clear() noexcept
+        {
+            m_commands.clear();
+            m_data.clear();
+            m_push_count = 0;
+        }
+
+        void command_list::bind(const ref<vertex_shader> &shader)
+        {
+            add(command_type::BindVertexShader, &shader, shader.get());
+        }
+
+        void command_list::bind(const ref<pixel_shader> &shader)
+        {
+            add(command_type::BindPixelShader, &shader, shader.get());
+        }
+
+        void command_list::bind(const ref<vertex_buffer> &buffer)
+        {
+            add(command_type::BindVertexBuffer, &buffer, buffer.get());
+        }
+
+        void command_list::bind(const ref<index_buffer> &buffer)
+        {
+            add(command_type::BindIndexBuffer, &buffer, buffer.get());
+        }
+
+        void command_list::bind(const ref<texture> &tex)
+        {
+            add(command_type::BindTexture, &tex, tex.get());
+        }
+
+        void command_list::bind(const ref<sampler> &samp)
+        {
+            add(command_type::BindSampler, &samp, samp.get());
+        }
+
+        void command_list::bind_instances(const ref<vertex_buffer> &buffer)
+        {
+            add(command_type::BindInstances, &buffer, buffer.get());
+        }
+
+        void command_list::set_vs_constant_buffer(uint32 slot, const ref<constant_buffer> &buffer)
+        {
+            add(command_type::SetVSConstantBuffer, &buffer, buffer.get(), slot);
+        }
+
+        void command_list::set_ps_constant_buffer(uint32 slot, const ref<constant_buffer> &buffer)
+        {
+            add(command_type::SetPSConstantBuffer, &buffer, buffer.get(), slot);
+        }
+
+        void command_list::update(const ref<constant_buffer> &buffer, const void *data)
+        {
+            if (!buffer.is_valid())
+            {
+                return;
+            }
+
+            add_data(command_type::UpdateConstantBuffer, &buffer, buffer.get(), 0, data, buffer->get_bytes_size());
+        }
+
+        void command_list::update(const ref<vertex_buffer> &buffer, const void *data, uint32 bytes_size)
+        {
+            add_data(command_type::UpdateVertexBuffer, &buffer, buffer.get(), 0, data, bytes_size);
+        }
+
+        void command_list::push_vs_constants(uint32 slot, const void *data, uint32 bytes_size)
+        {
+            add_data(command_type::PushVSConstants, nullptr, nullptr, slot, data, bytes_size);
+            m_push_count++;
+        }
+
+        void command_list::set_primitive_topology(primitive_topology topology)
+        {
+            add(command_type::SetPrimitiveTopology, nullptr, nullptr, static_cast<uint32>(topology));
+        }
+
+        void command_list::set_rasterizer_state(rasterizer_state state)
+        {
+            add(command_type::SetRasterizerState, nullptr, nullptr, static_cast<uint32>(state));
+        }
+
+        void command_list::set_pipeline_state(pipeline_state_id id)
+        {
+            add(command_type::SetPipelineState, nullptr, nullptr, id);
+        }
+
+        void command_list::draw(uint32 vertex_count, uint32 start_vertex)
+        {
+            add(command_type::Draw, nullptr, nullptr, vertex_count, start_vertex);
+        }
+
+        void command_list::draw_indexed(uint32 index_count, uint32 start_index, int32 base_vertex)
+        {
+            add(command_type::DrawIndexed, nullptr, nullptr, index_count, start_index, static_cast<uint32>(base_vertex));
+        }
+
+        void command_list::draw_instanced(uint32 vertex_count, uint32 instance_count, uint32 start_vertex, uint32 start_instance)
+        {
+            add(command_type::DrawInstanced, nullptr, nullptr, vertex_count, instance_count, start_vertex, start_instance);
+        }
+
+        template<typename T>
+        const ref<T> &command_list::get_resource(const command &cmd) noexcept
+        {
+            const ref<T> &resource = *static_cast<const ref<T> *>(cmd.resource);
+
+            // Une référence réassignée ou détruite depuis l'enregistrement rompt le contrat de device_context::begin_recording.
+            assert(resource.get() == cmd.object);
+
+            return resource;
+        }
+
+        void command_list::execute(device_context &dc) noexcept
+        {
+            const usize count = m_commands.size();
+            usize first       = 0;
+            usize written     = 0;
+            usize replayed    = 0;
+
+            m_allocations.assign(m_push_count, constant_allocation {});
+
+            while (first < count)
+            {
+                const usize last = write_constants(dc, first, written);
+
+                replay(dc, first, last, replayed);
+
+                first = last;
+            }
+        }
+
+        usize command_list::write_constants(device_context &dc, usize first, usize &push_index) noexcept
+        {
+            const usize count                    = m_commands.size();
+            const ref<constant_ring_buffer> ring = dc.get_constant_ring();
+
+            // Sans anneau utilisable, chaque commande repasse par push_vs_constants, qui échoue de la même façon.
+            if (m_push_count == 0 || !dc.can_push_constants() || !ring->map(dc))
+            {
+                return count;
+            }
+
+            usize last = count;
+            usize index;
+
+            for (index = first; index < count; ++index)
+            {
+                const command &cmd = m_commands[index];
+
+                if (cmd.type != command_type::PushVSConstants)
+                {
+                    continue;
+                }
+
+                if (ring->fits(cmd.data_size) && !ring->write(m_data.data() + cmd.data_offset, cmd.data_size, &m_allocations[push_index]))
+                {
+                    last = index;
+
+                    break;
+                }
+
+                push_index++;
+            }
+
+            // Les dessins ne doivent pas lire un buffer encore mappé.
+            ring->unmap(dc);
+
+            return last;
+        }
+
+        void command_list::replay(device_context &dc, usize first, usize last, usize &push_index) const noexcept
+        {
+            usize index;
+
+            for (index = first; index < last; ++index)
+            {
+                const command &cmd = m_commands[index];
+                const uint8 *data  = m_data.data() + cmd.data_offset;
+
+                switch (cmd.type)
+                {
+                    case command_type::BindVertexShader:
+                    {
+                        dc.bind(get_resource<vertex_shader>(cmd));
+                    }
+                    break;
+                    case command_type::BindPixelShader:
+                    {
+                        dc.bind(get_resource<pixel_shader>(cmd));
+                    }
+                    break;
+                    case command_type::BindVertexBuffer:
+                    {
+                        dc.bind(get_resource<vertex_buffer>(cmd));
+                    }
+                    break;
+                    case command_type::BindIndexBuffer:
+                    {
+                        dc.bind(get_resource<index_buffer>(cmd));
+                    }
+                    break;
+                    case command_type::BindTexture:
+                    {
+                        dc.bind(get_resource<texture>(cmd));
+                    }
+                    break;
+                    case command_type::BindSampler:
+                    {
+                        dc.bind(get_resource<sampler>(cmd));
+                    }
+                    break;
+                    case command_type::BindInstances:
+                    {
+                        dc.bind_instances(get_resource<vertex_buffer>(cmd));
+                    }
+                    break;
+                    case command_type::SetVSConstantBuffer:
+                    {
+                        dc.set_vs_constant_buffer(cmd.args[0], get_resource<constant_buffer>(cmd));
+                    }
+                    break;
+                    case command_type::SetPSConstantBuffer:
+                    {
+                        dc.set_ps_constant_buffer(cmd.args[0], get_resource<constant_buffer>(cmd));
+                    }
+                    break;
+                    case command_type::UpdateConstantBuffer:
+                    {
+                        dc.update(get_resource<constant_buffer>(cmd), data);
+                    }
+                    break;
+                    case command_type::UpdateVertexBuffer:
+                    {
+                        dc.update(get_resource<vertex_buffer>(cmd), data, cmd.data_size);
+                    }
+                    break;
+                    case command_type::PushVSConstants:
+                    {
+                        const constant_allocation &allocation = m_allocations[push_index++];
+
+                        if (allocation.bytes_size != 0)
+                        {
+                            dc.bind_vs_constants(cmd.args[0], allocation, cmd.data_size);
+                        }
+                        else
+                        {
+                            dc.push_vs_constants(cmd.args[0], data, cmd.data_size);
+                        }
+                    }
+                    break;
+                    case command_type::SetPrimitiveTopology:
+                    {
+                        dc.set_primitive_topology(static_cast<primitive_topology>(cmd.args[0]));
+                    }
+                    break;
+                    case command_type::SetRasterizerState:
+                    {
+                        dc.set_rasterizer_state(static_cast<rasterizer_state>(cmd.args[0]));
+                    }
+                    break;
+                    case command_type::SetPipelineState:
+                    {
+                        dc.set_pipeline_state(cmd.args[0]);
+                    }
+                    break;
+                    case command_type::Draw:
+                    {
+                        dc.draw(cmd.args[0], cmd.args[1]);
+                    }
+                    break;
+                    case command_type::DrawIndexed:
+                    {
+                        dc.draw_indexed(cmd.args[0], cmd.args[1], static_cast<int32>(cmd.args[2]));
+                    }
+                    break;
+                    case command_type::DrawInstanced:
+                    {
+                        dc.draw_instanced(cmd.args[0], cmd.args[1], cmd.args[2], cmd.args[3]);
+                    }
+                    break;
+                }
+            }
+        }
+
+        uint32 command_list::get_command_count() const noexcept
+        {
+            return static_cast<uint32>(m_commands.size());
+        }
+
+        uint32 command_list::get_data_size() const noexcept
+        {
+            return static_cast<uint32>(m_data.size());
+        }
+
+        void command_list::add(command_type type, const void *resource, const void *object, uint32 arg0, uint32 arg1, uint32 arg2, uint32 arg3)
+        {
+            m_commands.push_back({ type, resource, object, { arg0, arg1, arg2, arg3 }, 0, 0 });
+        }
+
+        void command_list::add_data(command_type type, const void *resource, const void *object, uint32 slot, const void *data, uint32 bytes_size)
+        {
+            const uint32 offset = static_cast<uint32>(m_data.size());
+
+            m_data.resize(offset + bytes_size);
+            std::memcpy(m_data.data() + offset, data, bytes_size);
+
+            m_commands.push_back({ type, resource, object, { slot, 0, 0, 0 }, offset, bytes_size });
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,140 @@
+#ifndef DEEP_ENGINE_D3D_COMMAND_LIST_HPP
+#define DEEP_ENGINE_D3D_COMMAND_LIST_HPP
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/memory/ref_counted.hpp>
+
+#include "D3D/device_context.hpp"
+
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Suite de commandes de rendu enregistrée par un device_context, indépendante du backend.
+         *
+         * Un contexte en mode enregistrement y ajoute ses commandes au lieu de les exécuter, ce qui permet
+         * à plusieurs threads de préparer chacun une partie de l'image. Les listes sont ensuite rejouées
+         * dans l'ordre sur le contexte immédiat, qui filtre les liaisons redondantes et tient les compteurs.
+         *
+         * Les ressources sont conservées par l'adresse de la référence passée au contexte, sans toucher à son
+         * compteur depuis les threads de travail, et par la ressource qu'elle désignait : voir
+         * device_context::begin_recording. Les données des mises à jour sont copiées.
+         *
+         * Classe interne à DeepD3D, utilisée par renderer.
+         */
+        class command_list
+        {
+          public:
+            command_list() = default;
+
+            command_list(const command_list &)            = delete;
+            command_list &operator=(const command_list &) = delete;
+
+            void clear() noexcept;
+
+            void bind(const ref<vertex_shader> &shader);
+            void bind(const ref<pixel_shader> &shader);
+            void bind(const ref<vertex_buffer> &buffer);
+            void bind(const ref<index_buffer> &buffer);
+            void bind(const ref<texture> &tex);
+            void bind(const ref<sampler> &samp);
+            void bind_instances(const ref<vertex_buffer> &buffer);
+
+            void set_vs_constant_buffer(uint32 slot, const ref<constant_buffer> &buffer);
+            void set_ps_constant_buffer(uint32 slot, const ref<constant_buffer> &buffer);
+            void update(const ref<constant_buffer> &buffer, const void *data);
+            void update(const ref<vertex_buffer> &buffer, const void *data, uint32 bytes_size);
+            void push_vs_constants(uint32 slot, const void *data, uint32 bytes_size);
+
+            void set_primitive_topology(primitive_topology topology);
+            void set_rasterizer_state(rasterizer_state state);
+            void set_pipeline_state(pipeline_state_id id);
+
+            void draw(uint32 vertex_count, uint32 start_vertex);
+            void draw_indexed(uint32 index_count, uint32 start_index, int32 base_vertex);
+            void draw_instanced(uint32 vertex_count, uint32 instance_count, uint32 start_vertex, uint32 start_instance);
+
+            /**
+             * @brief Rejoue les commandes dans l'ordre de leur enregistrement.
+             *
+             * Les constantes poussées dans l'anneau sont d'abord toutes écrites en un seul map, puis les commandes
+             * sont rejouées et lient leurs portions. Si l'anneau se remplit en route, les commandes dont les
+             * constantes sont écrites sont rejouées avant de le remapper pour la suite.
+             */
+            void execute(device_context &dc) noexcept;
+
+            uint32 get_command_count() const noexcept;
+            uint32 get_data_size() const noexcept;
+
+          private:
+            enum class command_type : uint8
+            {
+                BindVertexShader,
+                BindPixelShader,
+                BindVertexBuffer,
+                BindIndexBuffer,
+                BindTexture,
+                BindSampler,
+                BindInstances,
+                SetVSConstantBuffer,
+                SetPSConstantBuffer,
+                UpdateConstantBuffer,
+                UpdateVertexBuffer,
+                PushVSConstants,
+                SetPrimitiveTopology,
+                SetRasterizerState,
+                SetPipelineState,
+                Draw,
+                DrawIndexed,
+                DrawInstanced
+            };
+
+            struct command
+            {
+                command_type type;
+
+                // Adresse de la référence vers la ressource concernée.
+                const void *resource;
+
+                // Ressource désignée par cette référence à l'enregistrement, comparée lors de la relecture.
+                const void *object;
+
+                // Slot, topologie, état ou paramètres de l'appel de dessin.
+                uint32 args[4];
+
+                // Portion de m_data copiée pour les mises à jour.
+                uint32 data_offset;
+                uint32 data_size;
+            };
+
+          private:
+            void add(command_type type, const void *resource, const void *object, uint32 arg0 = 0, uint32 arg1 = 0, uint32 arg2 = 0, uint32 arg3 = 0);
+            void add_data(command_type type, const void *resource, const void *object, uint32 slot, const void *data, uint32 bytes_size);
+
+            template<typename T>
+            static const ref<T> &get_resource(const command &cmd) noexcept;
+
+            /**
+             * @brief Écrit dans l'anneau les constantes des commandes à partir de 'first', en un seul map.
+             * @return La première commande dont les constantes n'ont pas pu être écrites, faute de place.
+             */
+            usize write_constants(device_context &dc, usize first, usize &push_index) noexcept;
+
+            // Rejoue les commandes de [first, last).
+            void replay(device_context &dc, usize first, usize last, usize &push_index) const noexcept;
+
+          private:
+            std::vector<command> m_commands;
+            std::vector<uint8> m_data;
+
+            // Portion de l'anneau de chaque PushVSConstants lors de la relecture, taille nulle si non écrite.
+            std::vector<constant_allocation> m_allocations;
+            uint32 m_push_count = 0;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
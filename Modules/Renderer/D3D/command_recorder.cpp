@@ -0,0 +1,65 @@
+#include "D3D/command_recorder.hpp"
+
+#include <algorithm>
+
+namespace deep
+{
+    namespace D3D
+    {
+        command_recorder::command_recorder(uint32 thread_count)
+                : m_thread_pool(thread_count)
+        {
+        }
+
+        uint32 command_recorder::record(uint32 count, device_context &target, const record_function &fn, bool parallel)
+        {
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            const uint32 max_chunks  = m_thread_pool.get_thread_count() * chunks_per_thread;
+            const uint32 chunk_count = parallel ? std::max(1u, std::min(max_chunks, count / min_chunk_size)) : 1;
+            const uint32 chunk_size  = (count + chunk_count - 1) / chunk_count;
+
+            while (m_chunks.size() < chunk_count)
+            {
+                m_chunks.push_back(std::make_unique<chunk>());
+            }
+
+            uint32 index;
+
+            // Les contextes sont préparés sur le thread appelant : aucun compteur de référence n'est modifié par les threads de travail.
+            for (index = 0; index < chunk_count; ++index)
+            {
+                m_chunks[index]->list.clear();
+                m_chunks[index]->recorder.begin_recording(&m_chunks[index]->list, target);
+            }
+
+            m_thread_pool.parallel_for(chunk_count, [&](uint32 chunk_index, uint32) {
+                chunk &current     = *m_chunks[chunk_index];
+                const uint32 first = chunk_index * chunk_size;
+                const uint32 last  = std::min(count, first + chunk_size);
+                uint32 item;
+
+                for (item = first; item < last; ++item)
+                {
+                    fn(item, current.recorder);
+                }
+            });
+
+            for (index = 0; index < chunk_count; ++index)
+            {
+                m_chunks[index]->recorder.end_recording();
+                m_chunks[index]->list.execute(target);
+            }
+
+            return chunk_count;
+        }
+
+        uint32 command_recorder::get_thread_count() const noexcept
+        {
+            return m_thread_pool.get_thread_count();
+        }
+    } // namespace D3D
+} // namespace deep
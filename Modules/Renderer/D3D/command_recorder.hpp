@@ -0,0 +1,71 @@
+#ifndef DEEP_ENGINE_D3D_COMMAND_RECORDER_HPP
+#define DEEP_ENGINE_D3D_COMMAND_RECORDER_HPP
+
+#include <DeepCore/types.hpp>
+
+#include "D3D/command_list.hpp"
+#include "D3D/device_context.hpp"
+#include "D3D/thread_pool.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Enregistre des commandes de dessin sur plusieurs threads puis les rejoue dans l'ordre.
+         *
+         * Les éléments à dessiner sont découpés en blocs contigus. Chaque bloc est enregistré dans sa propre
+         * liste par un contexte en mode enregistrement, puis les listes sont rejouées bloc après bloc sur le
+         * contexte cible : le résultat est identique à une soumission depuis un seul thread.
+         *
+         * Classe interne à DeepD3D, utilisée par renderer.
+         */
+        class command_recorder
+        {
+          public:
+            using record_function = std::function<void(uint32 index, device_context &dc)>;
+
+            // Nombre minimal d'éléments par bloc, en dessous duquel l'enregistrement coûte plus qu'il ne rapporte.
+            static constexpr uint32 min_chunk_size = 64;
+
+            // Nombre de blocs par thread, pour équilibrer la charge entre des objets de coûts différents.
+            static constexpr uint32 chunks_per_thread = 4;
+
+          public:
+            /**
+             * @param thread_count Le nombre de threads, 0 pour utiliser tous les cœurs.
+             */
+            explicit command_recorder(uint32 thread_count = 0);
+
+            command_recorder(const command_recorder &)            = delete;
+            command_recorder &operator=(const command_recorder &) = delete;
+
+            /**
+             * @brief Enregistre fn(index, dc) pour chaque index de [0, count) puis rejoue les commandes sur 'target'.
+             * @param parallel false pour tout enregistrer dans une seule liste sur le thread appelant, ce qui garde
+             * l'écriture groupée des constantes pour les petites scènes.
+             * @return Le nombre de listes rejouées.
+             */
+            uint32 record(uint32 count, device_context &target, const record_function &fn, bool parallel = true);
+
+            uint32 get_thread_count() const noexcept;
+
+          private:
+            struct chunk
+            {
+                command_list list;
+                device_context recorder;
+            };
+
+          private:
+            thread_pool m_thread_pool;
+            std::vector<std::unique_ptr<chunk>> m_chunks;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,145 @@
+#include "cooked_texture.hpp"
+#include "D3D/block_compression.hpp"
+#include "D3D/mipmap.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        bool texture_cooker::cook(const image &img, texture_format format, stream *output, thread_pool *pool) noexcept
+        {
+            if (output == nullptr || !img.is_valid())
+            {
+                return false;
+            }
+
+            bool bgra;
+            switch (img.get_color_space())
+            {
+                default:
+                    return false;
+                case image::color_space::RGBA:
+                {
+                    bgra = false;
+                }
+                break;
+                case image::color_space::BGRA:
+                {
+                    bgra = true;
+                }
+                break;
+            }
+
+            const uint32 width  = img.get_width();
+            const uint32 height = img.get_height();
+
+            mip_chain mips;
+
+            mips.build(*img, width, height, img.get_row_bytes(), true, pool);
+
+            const uint32 level_count = mips.get_count() + 1;
+
+            cooked_texture_header header = {};
+            header.magic                 = magic;
+            header.version               = version;
+            header.format                = static_cast<uint16>(format);
+            header.width                 = width;
+            header.height                = height;
+            header.level_count           = level_count;
+
+            std::vector<cooked_texture_level> levels(level_count);
+            const usize data_offset = sizeof(header) + sizeof(cooked_texture_level) * level_count;
+            usize data_size         = 0;
+            uint32 level;
+
+            for (level = 0; level < level_count; ++level)
+            {
+                const uint32 level_width  = level == 0 ? width : mips.get_level(level - 1).width;
+                const uint32 level_height = level == 0 ? height : mips.get_level(level - 1).height;
+
+                levels[level].row_pitch = block_compression::get_row_pitch(format, level_width);
+                levels[level].size      = levels[level].row_pitch * block_compression::get_row_count(format, level_height);
+                levels[level].offset    = static_cast<uint32>(data_offset + data_size);
+
+                data_size += levels[level].size;
+            }
+
+            std::vector<uint8> data(data_size);
+
+            for (level = 0; level < level_count; ++level)
+            {
+                const uint32 level_width  = level == 0 ? width : mips.get_level(level - 1).width;
+                const uint32 level_height = level == 0 ? height : mips.get_level(level - 1).height;
+                const uint8 *pixels       = level == 0 ? *img : mips.get_pixels(level - 1);
+                const usize row_bytes     = level == 0 ? img.get_row_bytes() : static_cast<usize>(level_width) * 4;
+                uint8 *destination        = data.data() + (levels[level].offset - data_offset);
+
+                if (format != texture_format::RGBA8)
+                {
+                    block_compression::compress(format, pixels, level_width, level_height, row_bytes, bgra, destination, pool);
+
+                    continue;
+                }
+
+                uint32 y;
+                uint32 x;
+
+                for (y = 0; y < level_height; ++y)
+                {
+                    const uint8 *row = pixels + y * row_bytes;
+                    uint8 *out       = destination + static_cast<usize>(y) * levels[level].row_pitch;
+
+                    if (!bgra)
+                    {
+                        std::memcpy(out, row, static_cast<usize>(level_width) * 4);
+
+                        continue;
+                    }
+
+                    for (x = 0; x < level_width; ++x)
+                    {
+                        out[x * 4 + 0] = row[x * 4 + 2];
+                        out[x * 4 + 1] = row[x * 4 + 1];
+                        out[x * 4 + 2] = row[x * 4 + 0];
+                        out[x * 4 + 3] = row[x * 4 + 3];
+                    }
+                }
+            }
+
+            usize bytes_written;
+
+            return output->write(&header, sizeof(header), &bytes_written) &&
+                   output->write(levels.data(), sizeof(cooked_texture_level) * level_count, &bytes_written) &&
+                   output->write(data.data(), data.size(), &bytes_written);
+        }
+
+        bool texture_cooker::parse_format(const char *name, texture_format &format) noexcept
+        {
+            if (std::strcmp(name, "rgba8") == 0)
+            {
+                format = texture_format::RGBA8;
+            }
+            else if (std::strcmp(name, "bc1") == 0)
+            {
+                format = texture_format::BC1;
+            }
+            else if (std::strcmp(name, "bc3") == 0)
+            {
+                format = texture_format::BC3;
+            }
+            else if (std::strcmp(name, "bc7") == 0)
+            {
+                format = texture_format::BC7;
+            }
+            else
+            {
+                return false;
+            }
+
+            return true;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,90 @@
+#ifndef DEEP_ENGINE_D3D_COOKED_TEXTURE_HPP
+#define DEEP_ENGINE_D3D_COOKED_TEXTURE_HPP
+
+#include "deep_d3d_export.h"
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/image/image.hpp>
+#include <DeepLib/stream/stream.hpp>
+
+namespace deep
+{
+    namespace D3D
+    {
+        class thread_pool;
+
+        /**
+         * @brief Format des pixels d'une texture préparée.
+         */
+        enum class texture_format : uint16
+        {
+            RGBA8 = 0,
+
+            // Couleurs sur 5:6:5 bits et alpha tout ou rien, 8 octets par bloc de 4x4 pixels.
+            BC1 = 1,
+
+            // Couleurs de BC1 et alpha interpolé sur 8 niveaux, 16 octets par bloc.
+            BC3 = 2,
+
+            // Couleurs et alpha interpolés sur 16 niveaux, 16 octets par bloc.
+            BC7 = 3
+        };
+
+        /**
+         * @brief En-tête d'un fichier de texture préparée, suivi de la table des niveaux puis de leurs données.
+         *
+         * Toutes les valeurs sont en little-endian.
+         */
+        struct cooked_texture_header
+        {
+            uint32 magic;
+            uint16 version;
+            uint16 format;
+            uint32 width;
+            uint32 height;
+            uint32 level_count;
+            uint32 reserved;
+        };
+
+        struct cooked_texture_level
+        {
+            // Position des données depuis le début du fichier.
+            uint32 offset;
+            uint32 size;
+
+            // Taille en octets d'une ligne de pixels, ou de blocs pour un format compressé.
+            uint32 row_pitch;
+            uint32 reserved;
+        };
+
+        /**
+         * @brief Prépare hors ligne les textures du moteur : toute la chaîne de mipmaps est calculée puis
+         * compressée par blocs, pour que resource_factory::create_texture envoie directement les données au GPU,
+         * sans décoder d'image au lancement.
+         */
+        class DEEP_D3D_API texture_cooker
+        {
+          public:
+            // 'DTEX'
+            static constexpr uint32 magic   = 0x58455444;
+            static constexpr uint16 version = 1;
+
+          public:
+            /**
+             * @brief Écrit la texture préparée d'une image RGBA ou BGRA.
+             *
+             * @param pool Threads de l'appelant qui se partagent les mipmaps et la compression, nul pour tout
+             * calculer sur le thread appelant, par exemple depuis un thread d'import déjà parallèle.
+             * @return false si l'image n'est pas prise en charge ou si l'écriture échoue.
+             */
+            static bool cook(const image &img, texture_format format, stream *output, thread_pool *pool = nullptr) noexcept;
+
+            /**
+             * @return Le format correspondant à son nom ('rgba8', 'bc1', 'bc3' ou 'bc7'), false s'il est inconnu.
+             */
+            static bool parse_format(const char *name, texture_format &format) noexcept;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,998 @@
+#include "D3D/culling/bvh.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace
+        {
+            // Reconstruction lorsque le coût SAH dépasse de 30% celui de la dernière reconstruction.
+            constexpr float rebuild_ratio = 1.3f;
+
+            // Au-delà de cette profondeur, la reconstruction coupe au milieu pour borner la récursion.
+            constexpr uint32 max_build_depth = 64;
+
+            constexpr uint32 all_planes = (1u << frustum::Count) - 1;
+
+            /**
+             * @brief Teste une boîte contre les plans du masque, retire du masque les plans dont elle est entièrement du bon côté.
+             * @return false si la boîte est entièrement hors du volume.
+             */
+            bool classify(const frustum &f, const float *min, const float *max, uint32 &mask) noexcept
+            {
+                const float center[3]  = {(min[0] + max[0]) * 0.5f, (min[1] + max[1]) * 0.5f, (min[2] + max[2]) * 0.5f};
+                const float extents[3] = {(max[0] - min[0]) * 0.5f, (max[1] - min[1]) * 0.5f, (max[2] - min[2]) * 0.5f};
+
+                uint32 index;
+
+                for (index = 0; index < frustum::Count; ++index)
+                {
+                    if ((mask & (1u << index)) == 0)
+                    {
+                        continue;
+                    }
+
+                    const float *plane = f.planes[index];
+
+                    const float distance = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+                    const float radius   = std::fabs(plane[0]) * extents[0] + std::fabs(plane[1]) * extents[1] + std::fabs(plane[2]) * extents[2];
+
+                    if (distance + radius < 0.0f)
+                    {
+                        return false;
+                    }
+
+                    if (distance - radius >= 0.0f)
+                    {
+                        mask &= ~(1u << index);
+                    }
+                }
+
+                return true;
+            }
+
+            /**
+             * @brief Calcule la distance d'entrée d'un rayon dans une boîte (méthode des tranches).
+             * @return false si le rayon manque la boîte avant max_distance.
+             */
+            bool intersect_ray(const float *origin, const float *inverse_direction, const float *min, const float *max, float max_distance, float &distance) noexcept
+            {
+                float t_min = 0.0f;
+                float t_max = max_distance;
+                uint32 axis;
+
+                for (axis = 0; axis < 3; ++axis)
+                {
+                    float t0 = (min[axis] - origin[axis]) * inverse_direction[axis];
+                    float t1 = (max[axis] - origin[axis]) * inverse_direction[axis];
+
+                    if (t0 > t1)
+                    {
+                        std::swap(t0, t1);
+                    }
+
+                    t_min = t0 > t_min ? t0 : t_min;
+                    t_max = t1 < t_max ? t1 : t_max;
+
+                    if (t_min > t_max)
+                    {
+                        return false;
+                    }
+                }
+
+                distance = t_min;
+
+                return true;
+            }
+        } // namespace
+
+        bvh::bvh(float margin)
+                : m_margin(margin),
+                  m_root(null_node),
+                  m_free_list(null_node),
+                  m_node_count(0),
+                  m_leaf_count(0),
+                  m_build_cost(0.0f),
+                  m_changes_since_build(0)
+        {
+        }
+
+        void bvh::insert(uint32 key, const fvec3 &center, const fvec3 &extents)
+        {
+            if (key >= m_leaves.size())
+            {
+                m_leaves.resize(static_cast<usize>(key) + 1, null_node);
+                m_tight_bounds.resize(static_cast<usize>(key) + 1);
+            }
+
+            if (m_leaves[key] != null_node)
+            {
+                update(key, center, extents);
+                return;
+            }
+
+            const box tight   = make_box(center, extents);
+            const uint32 leaf = allocate_node();
+
+            node &n  = m_nodes[leaf];
+            n.key    = key;
+            n.bounds = make_box(center, fvec3(extents.x + m_margin, extents.y + m_margin, extents.z + m_margin));
+
+            m_tight_bounds[key] = tight;
+            m_leaves[key]       = leaf;
+            m_leaf_count++;
+            m_changes_since_build++;
+
+            insert_leaf(leaf);
+        }
+
+        bool bvh::update(uint32 key, const fvec3 &center, const fvec3 &extents)
+        {
+            if (!contains(key))
+            {
+                insert(key, center, extents);
+                return true;
+            }
+
+            const box tight   = make_box(center, extents);
+            const uint32 leaf = m_leaves[key];
+
+            m_tight_bounds[key] = tight;
+
+            if (contains(m_nodes[leaf].bounds, tight))
+            {
+                return false;
+            }
+
+            const box fat = make_box(center, fvec3(extents.x + m_margin, extents.y + m_margin, extents.z + m_margin));
+
+            m_changes_since_build++;
+
+            // Un objet téléporté agrandirait tous ses ancêtres : il est réinséré à sa nouvelle place.
+            if (!overlaps(m_nodes[leaf].bounds, fat))
+            {
+                remove_leaf(leaf);
+                m_nodes[leaf].bounds = fat;
+                insert_leaf(leaf);
+
+                return true;
+            }
+
+            m_nodes[leaf].bounds = fat;
+            refit(m_nodes[leaf].parent);
+
+            return true;
+        }
+
+        void bvh::remove(uint32 key) noexcept
+        {
+            if (!contains(key))
+            {
+                return;
+            }
+
+            const uint32 leaf = m_leaves[key];
+
+            remove_leaf(leaf);
+            free_node(leaf);
+
+            m_leaves[key] = null_node;
+            m_leaf_count--;
+            m_changes_since_build++;
+        }
+
+        bool bvh::contains(uint32 key) const noexcept
+        {
+            return key < m_leaves.size() && m_leaves[key] != null_node;
+        }
+
+        void bvh::clear() noexcept
+        {
+            m_nodes.clear();
+            m_leaves.clear();
+            m_tight_bounds.clear();
+
+            m_root                = null_node;
+            m_free_list           = null_node;
+            m_node_count          = 0;
+            m_leaf_count          = 0;
+            m_build_cost          = 0.0f;
+            m_changes_since_build = 0;
+        }
+
+        void bvh::build()
+        {
+            std::vector<build_item> items;
+            items.reserve(m_leaf_count);
+
+            uint32 index;
+
+            // Les feuilles sont conservées, seuls les nœuds internes sont reconstruits.
+            for (index = 0; index < static_cast<uint32>(m_nodes.size()); ++index)
+            {
+                if (m_nodes[index].height == 0)
+                {
+                    const box &b = m_nodes[index].bounds;
+
+                    items.push_back({b, {(b.min[0] + b.max[0]) * 0.5f, (b.min[1] + b.max[1]) * 0.5f, (b.min[2] + b.max[2]) * 0.5f}, index});
+                }
+                else if (m_nodes[index].height > 0)
+                {
+                    free_node(index);
+                }
+            }
+
+            m_root                = null_node;
+            m_changes_since_build = 0;
+
+            if (items.empty())
+            {
+                m_build_cost = 0.0f;
+                return;
+            }
+
+            m_nodes.reserve(items.size() * 2);
+
+            m_root                 = build_range(items.data(), static_cast<uint32>(items.size()), 0);
+            m_nodes[m_root].parent = null_node;
+
+            m_build_cost = get_cost();
+        }
+
+        bool bvh::optimize()
+        {
+            if (m_root == null_node)
+            {
+                return false;
+            }
+
+            // Le coût n'est recalculé qu'après un nombre de changements proportionnel à la taille de l'arbre.
+            const uint32 threshold = m_leaf_count / 8 > 0 ? m_leaf_count / 8 : 1;
+
+            if (m_changes_since_build < threshold)
+            {
+                return false;
+            }
+
+            if (m_build_cost > 0.0f && get_cost() <= m_build_cost * rebuild_ratio)
+            {
+                m_changes_since_build = 0;
+                return false;
+            }
+
+            build();
+
+            return true;
+        }
+
+        float bvh::get_cost() const noexcept
+        {
+            if (m_root == null_node || is_leaf(m_root))
+            {
+                return 0.0f;
+            }
+
+            const float root_area = area(m_nodes[m_root].bounds);
+
+            if (root_area <= 0.0f)
+            {
+                return 0.0f;
+            }
+
+            float total = 0.0f;
+
+            for (const node &n : m_nodes)
+            {
+                if (n.height > 0)
+                {
+                    total += area(n.bounds);
+                }
+            }
+
+            return total / root_area;
+        }
+
+        uint32 bvh::get_leaf_count() const noexcept
+        {
+            return m_leaf_count;
+        }
+
+        uint32 bvh::get_node_count() const noexcept
+        {
+            return m_node_count;
+        }
+
+        uint32 bvh::get_height() const noexcept
+        {
+            return m_root == null_node ? 0 : static_cast<uint32>(m_nodes[m_root].height);
+        }
+
+        void bvh::query_frustum(const frustum &f, std::vector<uint32> &out) const
+        {
+            if (m_root == null_node)
+            {
+                return;
+            }
+
+            // Chaque entrée porte les plans restant à tester : un nœud entièrement dans un plan en dispense ses descendants.
+            std::vector<std::pair<uint32, uint32>> stack;
+            stack.reserve(64);
+            stack.emplace_back(m_root, all_planes);
+
+            while (!stack.empty())
+            {
+                const uint32 index = stack.back().first;
+                uint32 mask        = stack.back().second;
+                stack.pop_back();
+
+                const node &n = m_nodes[index];
+
+                if (mask != 0 && !classify(f, n.bounds.min, n.bounds.max, mask))
+                {
+                    continue;
+                }
+
+                if (is_leaf(index))
+                {
+                    const box &tight = m_tight_bounds[n.key];
+
+                    if (mask == 0 || classify(f, tight.min, tight.max, mask))
+                    {
+                        out.push_back(n.key);
+                    }
+
+                    continue;
+                }
+
+                stack.emplace_back(n.left, mask);
+                stack.emplace_back(n.right, mask);
+            }
+        }
+
+        void bvh::query_bounds(const fvec3 &center, const fvec3 &extents, std::vector<uint32> &out) const
+        {
+            if (m_root == null_node)
+            {
+                return;
+            }
+
+            const box query = make_box(center, extents);
+
+            std::vector<uint32> stack;
+            stack.reserve(64);
+            stack.push_back(m_root);
+
+            while (!stack.empty())
+            {
+                const uint32 index = stack.back();
+                stack.pop_back();
+
+                const node &n = m_nodes[index];
+
+                if (!overlaps(n.bounds, query))
+                {
+                    continue;
+                }
+
+                if (is_leaf(index))
+                {
+                    if (overlaps(m_tight_bounds[n.key], query))
+                    {
+                        out.push_back(n.key);
+                    }
+
+                    continue;
+                }
+
+                stack.push_back(n.left);
+                stack.push_back(n.right);
+            }
+        }
+
+        bool bvh::ray_cast(const fvec3 &origin, const fvec3 &direction, float max_distance, uint32 &key, float &distance) const
+        {
+            if (m_root == null_node)
+            {
+                return false;
+            }
+
+            const float ray_origin[3]    = {origin.x, origin.y, origin.z};
+            const float ray_direction[3] = {direction.x, direction.y, direction.z};
+            float inverse_direction[3];
+            uint32 axis;
+
+            // Une composante nulle donne une tranche infinie, sans produire de NaN.
+            for (axis = 0; axis < 3; ++axis)
+            {
+                inverse_direction[axis] = ray_direction[axis] != 0.0f ? 1.0f / ray_direction[axis] : FLT_MAX;
+            }
+
+            float best = max_distance;
+            bool hit   = false;
+            float entry;
+
+            if (!intersect_ray(ray_origin, inverse_direction, m_nodes[m_root].bounds.min, m_nodes[m_root].bounds.max, best, entry))
+            {
+                return false;
+            }
+
+            std::vector<std::pair<uint32, float>> stack;
+            stack.reserve(64);
+            stack.emplace_back(m_root, entry);
+
+            while (!stack.empty())
+            {
+                const uint32 index = stack.back().first;
+                const float enter  = stack.back().second;
+                stack.pop_back();
+
+                if (enter >= best)
+                {
+                    continue;
+                }
+
+                const node &n = m_nodes[index];
+
+                if (is_leaf(index))
+                {
+                    const box &tight = m_tight_bounds[n.key];
+
+                    if (intersect_ray(ray_origin, inverse_direction, tight.min, tight.max, best, entry) && entry < best)
+                    {
+                        best = entry;
+                        key  = n.key;
+                        hit  = true;
+                    }
+
+                    continue;
+                }
+
+                float left_entry  = 0.0f;
+                float right_entry = 0.0f;
+
+                const bool left_hit  = intersect_ray(ray_origin, inverse_direction, m_nodes[n.left].bounds.min, m_nodes[n.left].bounds.max, best, left_entry);
+                const bool right_hit = intersect_ray(ray_origin, inverse_direction, m_nodes[n.right].bounds.min, m_nodes[n.right].bounds.max, best, right_entry);
+
+                // L'enfant le plus proche est empilé en dernier afin d'être parcouru en premier.
+                if (left_hit && right_hit)
+                {
+                    if (left_entry < right_entry)
+                    {
+                        stack.emplace_back(n.right, right_entry);
+                        stack.emplace_back(n.left, left_entry);
+                    }
+                    else
+                    {
+                        stack.emplace_back(n.left, left_entry);
+                        stack.emplace_back(n.right, right_entry);
+                    }
+                }
+                else if (left_hit)
+                {
+                    stack.emplace_back(n.left, left_entry);
+                }
+                else if (right_hit)
+                {
+                    stack.emplace_back(n.right, right_entry);
+                }
+            }
+
+            if (hit)
+            {
+                distance = best;
+            }
+
+            return hit;
+        }
+
+        uint32 bvh::allocate_node()
+        {
+            uint32 index;
+
+            if (m_free_list == null_node)
+            {
+                index = static_cast<uint32>(m_nodes.size());
+                m_nodes.emplace_back();
+            }
+            else
+            {
+                index       = m_free_list;
+                m_free_list = m_nodes[index].parent;
+            }
+
+            node &n  = m_nodes[index];
+            n.parent = null_node;
+            n.left   = null_node;
+            n.right  = null_node;
+            n.key    = null_node;
+            n.height = 0;
+
+            m_node_count++;
+
+            return index;
+        }
+
+        void bvh::free_node(uint32 index) noexcept
+        {
+            m_nodes[index].parent = m_free_list;
+            m_nodes[index].height = -1;
+
+            m_free_list = index;
+            m_node_count--;
+        }
+
+        void bvh::insert_leaf(uint32 leaf)
+        {
+            if (m_root == null_node)
+            {
+                m_root               = leaf;
+                m_nodes[leaf].parent = null_node;
+
+                return;
+            }
+
+            const box leaf_bounds = m_nodes[leaf].bounds;
+            uint32 index          = m_root;
+
+            // Descend vers le frère qui augmente le moins la surface totale de l'arbre.
+            while (!is_leaf(index))
+            {
+                const node &n = m_nodes[index];
+
+                const float node_area     = area(n.bounds);
+                const float combined_area = area(merge(n.bounds, leaf_bounds));
+
+                // Coût d'un nouveau parent commun à ce nœud et à la feuille.
+                const float cost = 2.0f * combined_area;
+
+                // Coût minimal ajouté aux ancêtres en descendant plus bas.
+                const float inheritance = 2.0f * (combined_area - node_area);
+
+                float left_cost  = area(merge(m_nodes[n.left].bounds, leaf_bounds)) + inheritance;
+                float right_cost = area(merge(m_nodes[n.right].bounds, leaf_bounds)) + inheritance;
+
+                if (!is_leaf(n.left))
+                {
+                    left_cost -= area(m_nodes[n.left].bounds);
+                }
+
+                if (!is_leaf(n.right))
+                {
+                    right_cost -= area(m_nodes[n.right].bounds);
+                }
+
+                if (cost < left_cost && cost < right_cost)
+                {
+                    break;
+                }
+
+                index = left_cost < right_cost ? n.left : n.right;
+            }
+
+            const uint32 sibling    = index;
+            const uint32 old_parent = m_nodes[sibling].parent;
+            const uint32 new_parent = allocate_node();
+
+            node &parent  = m_nodes[new_parent];
+            parent.parent = old_parent;
+            parent.bounds = merge(leaf_bounds, m_nodes[sibling].bounds);
+            parent.height = m_nodes[sibling].height + 1;
+            parent.left   = sibling;
+            parent.right  = leaf;
+
+            m_nodes[sibling].parent = new_parent;
+            m_nodes[leaf].parent    = new_parent;
+
+            if (old_parent == null_node)
+            {
+                m_root = new_parent;
+            }
+            else if (m_nodes[old_parent].left == sibling)
+            {
+                m_nodes[old_parent].left = new_parent;
+            }
+            else
+            {
+                m_nodes[old_parent].right = new_parent;
+            }
+
+            // Remonte en rééquilibrant et en agrandissant les ancêtres.
+            index = new_parent;
+
+            while (index != null_node)
+            {
+                index = balance(index);
+
+                node &n  = m_nodes[index];
+                n.height = 1 + std::max(m_nodes[n.left].height, m_nodes[n.right].height);
+                n.bounds = merge(m_nodes[n.left].bounds, m_nodes[n.right].bounds);
+
+                index = n.parent;
+            }
+        }
+
+        void bvh::remove_leaf(uint32 leaf) noexcept
+        {
+            if (leaf == m_root)
+            {
+                m_root = null_node;
+                return;
+            }
+
+            const uint32 parent       = m_nodes[leaf].parent;
+            const uint32 grand_parent = m_nodes[parent].parent;
+            const uint32 sibling      = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+            free_node(parent);
+
+            if (grand_parent == null_node)
+            {
+                m_root                  = sibling;
+                m_nodes[sibling].parent = null_node;
+
+                return;
+            }
+
+            if (m_nodes[grand_parent].left == parent)
+            {
+                m_nodes[grand_parent].left = sibling;
+            }
+            else
+            {
+                m_nodes[grand_parent].right = sibling;
+            }
+
+            m_nodes[sibling].parent = grand_parent;
+
+            uint32 index = grand_parent;
+
+            while (index != null_node)
+            {
+                index = balance(index);
+
+                node &n  = m_nodes[index];
+                n.height = 1 + std::max(m_nodes[n.left].height, m_nodes[n.right].height);
+                n.bounds = merge(m_nodes[n.left].bounds, m_nodes[n.right].bounds);
+
+                index = n.parent;
+            }
+        }
+
+        uint32 bvh::balance(uint32 index) noexcept
+        {
+            node &a = m_nodes[index];
+
+            if (is_leaf(index) || a.height < 2)
+            {
+                return index;
+            }
+
+            const uint32 index_b = a.left;
+            const uint32 index_c = a.right;
+
+            node &b = m_nodes[index_b];
+            node &c = m_nodes[index_c];
+
+            const int32 difference = c.height - b.height;
+
+            // Le sous-arbre droit est trop haut : c remonte à la place de a.
+            if (difference > 1)
+            {
+                const uint32 index_f = c.left;
+                const uint32 index_g = c.right;
+
+                node &f = m_nodes[index_f];
+                node &g = m_nodes[index_g];
+
+                c.left   = index;
+                c.parent = a.parent;
+                a.parent = index_c;
+
+                if (c.parent == null_node)
+                {
+                    m_root = index_c;
+                }
+                else if (m_nodes[c.parent].left == index)
+                {
+                    m_nodes[c.parent].left = index_c;
+                }
+                else
+                {
+                    m_nodes[c.parent].right = index_c;
+                }
+
+                if (f.height > g.height)
+                {
+                    c.right  = index_f;
+                    a.right  = index_g;
+                    g.parent = index;
+
+                    a.bounds = merge(b.bounds, g.bounds);
+                    c.bounds = merge(a.bounds, f.bounds);
+                    a.height = 1 + std::max(b.height, g.height);
+                    c.height = 1 + std::max(a.height, f.height);
+                }
+                else
+                {
+                    c.right  = index_g;
+                    a.right  = index_f;
+                    f.parent = index;
+
+                    a.bounds = merge(b.bounds, f.bounds);
+                    c.bounds = merge(a.bounds, g.bounds);
+                    a.height = 1 + std::max(b.height, f.height);
+                    c.height = 1 + std::max(a.height, g.height);
+                }
+
+                return index_c;
+            }
+
+            // Le sous-arbre gauche est trop haut : b remonte à la place de a.
+            if (difference < -1)
+            {
+                const uint32 index_d = b.left;
+                const uint32 index_e = b.right;
+
+                node &d = m_nodes[index_d];
+                node &e = m_nodes[index_e];
+
+                b.left   = index;
+                b.parent = a.parent;
+                a.parent = index_b;
+
+                if (b.parent == null_node)
+                {
+                    m_root = index_b;
+                }
+                else if (m_nodes[b.parent].left == index)
+                {
+                    m_nodes[b.parent].left = index_b;
+                }
+                else
+                {
+                    m_nodes[b.parent].right = index_b;
+                }
+
+                if (d.height > e.height)
+                {
+                    b.right  = index_d;
+                    a.left   = index_e;
+                    e.parent = index;
+
+                    a.bounds = merge(c.bounds, e.bounds);
+                    b.bounds = merge(a.bounds, d.bounds);
+                    a.height = 1 + std::max(c.height, e.height);
+                    b.height = 1 + std::max(a.height, d.height);
+                }
+                else
+                {
+                    b.right  = index_e;
+                    a.left   = index_d;
+                    d.parent = index;
+
+                    a.bounds = merge(c.bounds, d.bounds);
+                    b.bounds = merge(a.bounds, e.bounds);
+                    a.height = 1 + std::max(c.height, d.height);
+                    b.height = 1 + std::max(a.height, e.height);
+                }
+
+                return index_b;
+            }
+
+            return index;
+        }
+
+        void bvh::refit(uint32 index) noexcept
+        {
+            // Les ancêtres ne dépendent que de leurs enfants : la remontée s'arrête au premier nœud inchangé.
+            while (index != null_node)
+            {
+                node &n = m_nodes[index];
+
+                const box bounds = merge(m_nodes[n.left].bounds, m_nodes[n.right].bounds);
+
+                if (std::memcmp(&bounds, &n.bounds, sizeof(box)) == 0)
+                {
+                    return;
+                }
+
+                n.bounds = bounds;
+                index    = n.parent;
+            }
+        }
+
+        uint32 bvh::build_range(build_item *items, uint32 count, uint32 depth)
+        {
+            if (count == 1)
+            {
+                return items[0].leaf;
+            }
+
+            float centroid_min[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+            float centroid_max[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+            uint32 index;
+            uint32 axis;
+
+            for (index = 0; index < count; ++index)
+            {
+                const float *centroid = items[index].centroid;
+
+                for (axis = 0; axis < 3; ++axis)
+                {
+                    centroid_min[axis] = std::min(centroid_min[axis], centroid[axis]);
+                    centroid_max[axis] = std::max(centroid_max[axis], centroid[axis]);
+                }
+            }
+
+            // Boîte vide : neutre pour merge.
+            const box empty = {{FLT_MAX, FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+
+            uint32 best_axis  = 3;
+            uint32 best_split = 0;
+            float best_cost   = FLT_MAX;
+
+            if (depth < max_build_depth)
+            {
+                // Les petits intervalles n'ont pas besoin de plus d'intervalles que d'objets.
+                const uint32 bins = count < bin_count ? count : bin_count;
+
+                // Les trois axes sont répartis en un seul parcours des objets.
+                box bin_bounds[3][bin_count];
+                uint32 bin_counts[3][bin_count] = {};
+                float scale[3];
+                uint32 bin;
+
+                for (axis = 0; axis < 3; ++axis)
+                {
+                    const float extent = centroid_max[axis] - centroid_min[axis];
+
+                    scale[axis] = extent > 0.0f ? static_cast<float>(bins) / extent : 0.0f;
+
+                    for (bin = 0; bin < bins; ++bin)
+                    {
+                        bin_bounds[axis][bin] = empty;
+                    }
+                }
+
+                for (index = 0; index < count; ++index)
+                {
+                    const build_item &item = items[index];
+
+                    for (axis = 0; axis < 3; ++axis)
+                    {
+                        bin = std::min(static_cast<uint32>((item.centroid[axis] - centroid_min[axis]) * scale[axis]), bins - 1);
+
+                        bin_counts[axis][bin]++;
+                        bin_bounds[axis][bin] = merge(bin_bounds[axis][bin], item.bounds);
+                    }
+                }
+
+                for (axis = 0; axis < 3; ++axis)
+                {
+                    if (scale[axis] == 0.0f)
+                    {
+                        continue;
+                    }
+
+                    // Surfaces cumulées depuis la droite : right_area[i] couvre les intervalles [i, bins).
+                    float right_area[bin_count];
+                    uint32 right_count[bin_count];
+                    box accumulated          = empty;
+                    uint32 accumulated_count = 0;
+
+                    for (bin = bins - 1; bin > 0; --bin)
+                    {
+                        accumulated = merge(accumulated, bin_bounds[axis][bin]);
+                        accumulated_count += bin_counts[axis][bin];
+
+                        right_area[bin]  = accumulated_count > 0 ? area(accumulated) : 0.0f;
+                        right_count[bin] = accumulated_count;
+                    }
+
+                    accumulated       = empty;
+                    accumulated_count = 0;
+
+                    for (bin = 1; bin < bins; ++bin)
+                    {
+                        accumulated = merge(accumulated, bin_bounds[axis][bin - 1]);
+                        accumulated_count += bin_counts[axis][bin - 1];
+
+                        if (accumulated_count == 0 || right_count[bin] == 0)
+                        {
+                            continue;
+                        }
+
+                        const float cost = static_cast<float>(accumulated_count) * area(accumulated) +
+                                           static_cast<float>(right_count[bin]) * right_area[bin];
+
+                        if (cost < best_cost)
+                        {
+                            best_cost  = cost;
+                            best_axis  = axis;
+                            best_split = bin;
+                        }
+                    }
+                }
+            }
+
+            uint32 middle = count / 2;
+
+            if (best_axis < 3)
+            {
+                const uint32 bins = count < bin_count ? count : bin_count;
+                const float scale = static_cast<float>(bins) / (centroid_max[best_axis] - centroid_min[best_axis]);
+
+                build_item *split = std::partition(items, items + count, [&](const build_item &item) {
+                    const float centroid = item.centroid[best_axis];
+                    return std::min(static_cast<uint32>((centroid - centroid_min[best_axis]) * scale), bins - 1) < best_split;
+                });
+
+                middle = static_cast<uint32>(split - items);
+            }
+
+            if (middle == 0 || middle == count)
+            {
+                middle = count / 2;
+            }
+
+            const uint32 left         = build_range(items, middle, depth + 1);
+            const uint32 right        = build_range(items + middle, count - middle, depth + 1);
+            const uint32 index_parent = allocate_node();
+
+            node &parent  = m_nodes[index_parent];
+            parent.left   = left;
+            parent.right  = right;
+            parent.bounds = merge(m_nodes[left].bounds, m_nodes[right].bounds);
+            parent.height = 1 + std::max(m_nodes[left].height, m_nodes[right].height);
+
+            m_nodes[left].parent  = index_parent;
+            m_nodes[right].parent = index_parent;
+
+            return index_parent;
+        }
+
+        bool bvh::is_leaf(uint32 index) const noexcept
+        {
+            return m_nodes[index].left == null_node;
+        }
+
+        bvh::box bvh::make_box(const fvec3 &center, const fvec3 &extents) noexcept
+        {
+            return {{center.x - extents.x, center.y - extents.y, center.z - extents.z},
+                    {center.x + extents.x, center.y + extents.y, center.z + extents.z}};
+        }
+
+        bvh::box bvh::merge(const box &a, const box &b) noexcept
+        {
+            return {{std::min(a.min[0], b.min[0]), std::min(a.min[1], b.min[1]), std::min(a.min[2], b.min[2])},
+                    {std::max(a.max[0], b.max[0]), std::max(a.max[1], b.max[1]), std::max(a.max[2], b.max[2])}};
+        }
+
+        bool bvh::contains(const box &outer, const box &inner) noexcept
+        {
+            return outer.min[0] <= inner.min[0] && outer.min[1] <= inner.min[1] && outer.min[2] <= inner.min[2] &&
+                   outer.max[0] >= inner.max[0] && outer.max[1] >= inner.max[1] && outer.max[2] >= inner.max[2];
+        }
+
+        bool bvh::overlaps(const box &a, const box &b) noexcept
+        {
+            return a.min[0] <= b.max[0] && a.min[1] <= b.max[1] && a.min[2] <= b.max[2] &&
+                   a.max[0] >= b.min[0] && a.max[1] >= b.min[1] && a.max[2] >= b.min[2];
+        }
+
+        float bvh::area(const box &b) noexcept
+        {
+            const float x = b.max[0] - b.min[0];
+            const float y = b.max[1] - b.min[1];
+            const float z = b.max[2] - b.min[2];
+
+            return x * y + y * z + z * x;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,164 @@
+#ifndef DEEP_ENGINE_D3D_BVH_HPP
+#define DEEP_ENGINE_D3D_BVH_HPP
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/maths/vec.hpp>
+
+#include "D3D/culling/frustum.hpp"
+
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Hiérarchie dynamique de boîtes englobantes, indexée par une clé choisie par l'appelant.
+         *
+         * Chaque feuille conserve la boîte exacte de son objet et une boîte élargie d'une marge :
+         * tant que l'objet reste dans sa boîte élargie, un déplacement ne modifie pas l'arbre.
+         * Au-delà, la feuille est agrandie et ses ancêtres réajustés sans restructurer l'arbre.
+         * La qualité de l'arbre est surveillée par son coût SAH, qui déclenche une reconstruction
+         * complète par surface (SAH, par intervalles) lorsqu'il s'est trop dégradé.
+         *
+         * Classe interne à DeepD3D, utilisée par renderer.
+         */
+        class bvh
+        {
+          public:
+            static constexpr uint32 null_node = 0xFFFFFFFF;
+
+            // Nombre d'intervalles évalués par axe lors d'une reconstruction.
+            static constexpr uint32 bin_count = 16;
+
+          public:
+            /**
+             * @param margin Marge ajoutée autour des boîtes des feuilles, en unités du monde.
+             */
+            explicit bvh(float margin = 0.1f);
+
+            bvh(const bvh &)            = delete;
+            bvh &operator=(const bvh &) = delete;
+
+            /**
+             * @brief Ajoute un objet, ou le déplace s'il est déjà présent.
+             */
+            void insert(uint32 key, const fvec3 &center, const fvec3 &extents);
+
+            /**
+             * @brief Déplace un objet en réajustant ses ancêtres.
+             * @return true si l'arbre a été modifié, false si l'objet est resté dans sa boîte élargie.
+             */
+            bool update(uint32 key, const fvec3 &center, const fvec3 &extents);
+
+            void remove(uint32 key) noexcept;
+            bool contains(uint32 key) const noexcept;
+            void clear() noexcept;
+
+            /**
+             * @brief Reconstruit tout l'arbre par partitionnement SAH.
+             */
+            void build();
+
+            /**
+             * @brief Reconstruit l'arbre si son coût SAH a trop augmenté depuis la dernière reconstruction.
+             * @return true si l'arbre a été reconstruit.
+             */
+            bool optimize();
+
+            /**
+             * @brief Coût SAH de l'arbre : somme des surfaces des nœuds internes rapportée à celle de la racine.
+             */
+            float get_cost() const noexcept;
+
+            uint32 get_leaf_count() const noexcept;
+            uint32 get_node_count() const noexcept;
+            uint32 get_height() const noexcept;
+
+            /**
+             * @brief Ajoute à 'out' les clés des objets au moins en partie dans le volume de vue.
+             */
+            void query_frustum(const frustum &f, std::vector<uint32> &out) const;
+
+            /**
+             * @brief Ajoute à 'out' les clés des objets dont la boîte touche la boîte donnée.
+             */
+            void query_bounds(const fvec3 &center, const fvec3 &extents, std::vector<uint32> &out) const;
+
+            /**
+             * @brief Recherche la boîte la plus proche touchée par un rayon.
+             * @param direction La direction du rayon, non nécessairement normalisée : les distances sont exprimées en multiples de sa longueur.
+             * @return false si aucune boîte n'est touchée avant max_distance.
+             */
+            bool ray_cast(const fvec3 &origin, const fvec3 &direction, float max_distance, uint32 &key, float &distance) const;
+
+          private:
+            struct box
+            {
+                float min[3];
+                float max[3];
+            };
+
+            struct node
+            {
+                box bounds;
+
+                // Parent du nœud, ou nœud libre suivant pour les nœuds libérés.
+                uint32 parent;
+                uint32 left;
+                uint32 right;
+
+                // Clé de l'objet pour une feuille.
+                uint32 key;
+
+                // 0 pour une feuille, -1 pour un nœud libre.
+                int32 height;
+            };
+
+            // Copie contiguë d'une feuille, partitionnée en place lors d'une reconstruction.
+            struct build_item
+            {
+                box bounds;
+                float centroid[3];
+                uint32 leaf;
+            };
+
+          private:
+            uint32 allocate_node();
+            void free_node(uint32 index) noexcept;
+
+            void insert_leaf(uint32 leaf);
+            void remove_leaf(uint32 leaf) noexcept;
+            uint32 balance(uint32 index) noexcept;
+            void refit(uint32 index) noexcept;
+
+            uint32 build_range(build_item *items, uint32 count, uint32 depth);
+
+            bool is_leaf(uint32 index) const noexcept;
+
+            static box make_box(const fvec3 &center, const fvec3 &extents) noexcept;
+            static box merge(const box &a, const box &b) noexcept;
+            static bool contains(const box &outer, const box &inner) noexcept;
+            static bool overlaps(const box &a, const box &b) noexcept;
+            static float area(const box &b) noexcept;
+
+          private:
+            float m_margin;
+
+            std::vector<node> m_nodes;
+            uint32 m_root;
+            uint32 m_free_list;
+            uint32 m_node_count;
+
+            // Feuille et boîte exacte de chaque clé.
+            std::vector<uint32> m_leaves;
+            std::vector<box> m_tight_bounds;
+            uint32 m_leaf_count;
+
+            float m_build_cost;
+            uint32 m_changes_since_build;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,200 @@
+#include "D3D/culling/bvh_benchmark.hpp"
+#include "D3D/culling/bvh.hpp"
+#include "D3D/culling/frustum.hpp"
+
+#include <DeepLib/maths/vec.hpp>
+#include <DeepLib/maths/mat.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace
+        {
+            /**
+             * @brief Générateur congruentiel linéaire : la suite ne dépend que de la graine.
+             */
+            class random_sequence
+            {
+              public:
+                explicit random_sequence(uint32 seed) noexcept
+                        : m_state(seed)
+                {
+                }
+
+                float next(float min, float max) noexcept
+                {
+                    m_state = m_state * 1664525u + 1013904223u;
+
+                    // Les 24 bits de poids fort tiennent exactement dans un float.
+                    return min + (max - min) * static_cast<float>(m_state >> 8) * (1.0f / 16777216.0f);
+                }
+
+                fvec3 next_vector(float min, float max) noexcept
+                {
+                    const float x = next(min, max);
+                    const float y = next(min, max);
+                    const float z = next(min, max);
+
+                    return fvec3(x, y, z);
+                }
+
+              private:
+                uint32 m_state;
+            };
+
+            int64 get_time_nanos() noexcept
+            {
+                return static_cast<int64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+            }
+
+            double get_average(int64 start, int64 end, uint32 count) noexcept
+            {
+                return count != 0 ? static_cast<double>(end - start) / static_cast<double>(count) : 0.0;
+            }
+        } // namespace
+
+        bvh_benchmark_results bvh_benchmark::run(uint32 box_count, uint32 query_count) noexcept
+        {
+            bvh_benchmark_results results = {};
+            results.box_count             = box_count;
+            results.query_count           = query_count;
+
+            if (box_count == 0)
+            {
+                return results;
+            }
+
+            // Environ une boîte pour 64 unités cubes, quelle que soit la taille de la scène.
+            const float half_size = 2.0f * std::cbrt(static_cast<float>(box_count));
+
+            random_sequence random(0x2545F491u);
+
+            std::vector<fvec3> centers(box_count);
+            std::vector<fvec3> extents(box_count);
+            std::vector<fvec3> moved(box_count);
+            uint32 index;
+
+            for (index = 0; index < box_count; ++index)
+            {
+                centers[index] = random.next_vector(-half_size, half_size);
+                extents[index] = random.next_vector(0.25f, 1.0f);
+
+                // La marge des feuilles est de 0.1 : un déplacement sur huit la dépasse.
+                const float step   = index % 8 == 0 ? 1.0f : 0.04f;
+                const fvec3 offset = random.next_vector(-step, step);
+
+                moved[index] = fvec3(centers[index].x + offset.x, centers[index].y + offset.y, centers[index].z + offset.z);
+            }
+
+            // Les requêtes sont préparées avant les mesures.
+            std::vector<frustum> frustums(query_count);
+            std::vector<fvec3> query_centers(query_count);
+            std::vector<fvec3> query_extents(query_count);
+            std::vector<fvec3> ray_origins(query_count);
+            std::vector<fvec3> ray_directions(query_count);
+
+            const fmat4 projection = fmat4::d3d_perspective_fov_lh(1.0f, 16.0f / 9.0f, 0.1f, half_size);
+
+            for (index = 0; index < query_count; ++index)
+            {
+                const fvec3 eye    = random.next_vector(-half_size, half_size);
+                const fvec3 target = random.next_vector(-half_size, half_size);
+
+                frustums[index]      = frustum::from_view_projection(projection * fmat4::d3d_look_at_lh(eye, target, fvec3(0.0f, 1.0f, 0.0f)));
+                query_centers[index] = random.next_vector(-half_size, half_size);
+                query_extents[index] = random.next_vector(1.0f, 4.0f);
+                ray_origins[index]   = eye;
+
+                // Une direction nulle ne toucherait rien : elle est remplacée par l'axe z.
+                fvec3 direction = fvec3(target.x - eye.x, target.y - eye.y, target.z - eye.z);
+
+                if (direction.x == 0.0f && direction.y == 0.0f && direction.z == 0.0f)
+                {
+                    direction = fvec3(0.0f, 0.0f, 1.0f);
+                }
+
+                ray_directions[index] = direction;
+            }
+
+            bvh tree;
+            std::vector<uint32> found;
+            found.reserve(box_count);
+
+            int64 start = get_time_nanos();
+
+            for (index = 0; index < box_count; ++index)
+            {
+                tree.insert(index, centers[index], extents[index]);
+            }
+
+            results.insert_nanos = get_average(start, get_time_nanos(), box_count);
+
+            start = get_time_nanos();
+
+            for (index = 0; index < box_count; ++index)
+            {
+                if (tree.update(index, moved[index], extents[index]))
+                {
+                    results.tree_updates++;
+                }
+            }
+
+            results.update_nanos = get_average(start, get_time_nanos(), box_count);
+
+            // Le renderer optimise l'arbre après ses mises à jour, avant les requêtes de l'image.
+            tree.optimize();
+
+            usize total = 0;
+            start       = get_time_nanos();
+
+            for (index = 0; index < query_count; ++index)
+            {
+                found.clear();
+                tree.query_frustum(frustums[index], found);
+                total += found.size();
+            }
+
+            results.query_frustum_nanos = get_average(start, get_time_nanos(), query_count);
+            results.frustum_hits        = get_average(0, static_cast<int64>(total), query_count);
+
+            total = 0;
+            start = get_time_nanos();
+
+            for (index = 0; index < query_count; ++index)
+            {
+                found.clear();
+                tree.query_bounds(query_centers[index], query_extents[index], found);
+                total += found.size();
+            }
+
+            results.query_bounds_nanos = get_average(start, get_time_nanos(), query_count);
+            results.bounds_hits        = get_average(0, static_cast<int64>(total), query_count);
+
+            start = get_time_nanos();
+
+            for (index = 0; index < query_count; ++index)
+            {
+                uint32 key;
+                float distance;
+
+                // La distance est exprimée en longueurs de direction : le rayon s'arrête à la cible.
+                if (tree.ray_cast(ray_origins[index], ray_directions[index], 1.0f, key, distance))
+                {
+                    results.ray_hits++;
+                }
+            }
+
+            results.ray_cast_nanos = get_average(start, get_time_nanos(), query_count);
+
+            results.height = tree.get_height();
+            results.cost   = tree.get_cost();
+
+            return results;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,61 @@
+#ifndef DEEP_ENGINE_D3D_BVH_BENCHMARK_HPP
+#define DEEP_ENGINE_D3D_BVH_BENCHMARK_HPP
+
+#include "deep_d3d_export.h"
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Temps mesurés par bvh_benchmark.
+         */
+        struct bvh_benchmark_results
+        {
+            uint32 box_count;
+            uint32 query_count;
+
+            // Durées moyennes d'un appel, en nanosecondes.
+            double insert_nanos;
+            double update_nanos;
+            double query_frustum_nanos;
+            double query_bounds_nanos;
+            double ray_cast_nanos;
+
+            // Nombre moyen d'objets trouvés par requête et nombre de rayons ayant touché une boîte.
+            double frustum_hits;
+            double bounds_hits;
+            uint32 ray_hits;
+
+            // Mises à jour qui ont modifié l'arbre, les autres sont restées dans la marge des feuilles.
+            uint32 tree_updates;
+
+            // État de l'arbre à la fin des mesures.
+            uint32 height;
+            float cost;
+        };
+
+        /**
+         * @brief Mesure les opérations de la hiérarchie de boîtes utilisée par le renderer, sans GPU.
+         *
+         * Les boîtes sont réparties au hasard avec une graine fixe, dans un cube dont le volume croît avec leur
+         * nombre : deux exécutions travaillent sur la même scène et la densité ne dépend pas de la taille.
+         */
+        class DEEP_D3D_API bvh_benchmark
+        {
+          public:
+            static constexpr uint32 default_query_count = 1000;
+
+          public:
+            /**
+             * @brief Insère les boîtes, les déplace une fois puis lance les requêtes.
+             *
+             * Un déplacement sur huit sort de la marge de sa feuille, les autres restent dedans.
+             */
+            static bvh_benchmark_results run(uint32 box_count, uint32 query_count = default_query_count) noexcept;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,73 @@
+#include "D3D/culling/frustum.hpp"
+#include "D3D/transform.hpp"
+
+#include <cmath>
+
+namespace deep
+{
+    namespace D3D
+    {
+        frustum frustum::from_view_projection(const fmat4 &view_projection) noexcept
+        {
+            float m[16];
+            load_matrix(view_projection, m);
+
+            // Ligne j : coefficients de la composante j du point projeté.
+            const float *x = m;
+            const float *y = m + 4;
+            const float *z = m + 8;
+            const float *w = m + 12;
+
+            frustum result;
+            uint32 index;
+
+            // Volume Direct3D : -w <= x <= w, -w <= y <= w, 0 <= z <= w.
+            for (index = 0; index < 4; ++index)
+            {
+                result.planes[Left][index]   = w[index] + x[index];
+                result.planes[Right][index]  = w[index] - x[index];
+                result.planes[Bottom][index] = w[index] + y[index];
+                result.planes[Top][index]    = w[index] - y[index];
+                result.planes[Near][index]   = z[index];
+                result.planes[Far][index]    = w[index] - z[index];
+            }
+
+            // Normalise les plans afin que les distances soient exprimées en unités du monde.
+            for (index = 0; index < Count; ++index)
+            {
+                float *plane = result.planes[index];
+                float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+
+                if (length > 0.0f)
+                {
+                    plane[0] /= length;
+                    plane[1] /= length;
+                    plane[2] /= length;
+                    plane[3] /= length;
+                }
+            }
+
+            return result;
+        }
+
+        bool frustum::intersects(const fvec3 &center, const fvec3 &extents) const noexcept
+        {
+            uint32 index;
+
+            for (index = 0; index < Count; ++index)
+            {
+                const float *plane = planes[index];
+
+                const float distance = plane[0] * center.x + plane[1] * center.y + plane[2] * center.z + plane[3];
+                const float radius   = std::fabs(plane[0]) * extents.x + std::fabs(plane[1]) * extents.y + std::fabs(plane[2]) * extents.z;
+
+                if (distance + radius < 0.0f)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,47 @@
+#ifndef DEEP_ENGINE_D3D_FRUSTUM_HPP
+#define DEEP_ENGINE_D3D_FRUSTUM_HPP
+
+#include "deep_d3d_export.h"
+#include <DeepCore/types.hpp>
+#include <DeepLib/maths/vec.hpp>
+#include <DeepLib/maths/mat.hpp>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Les 6 plans du volume de vue, normales orientées vers l'intérieur.
+         *
+         * Chaque plan est stocké sous la forme (a, b, c, d) : un point p est du bon côté si a*x + b*y + c*z + d >= 0.
+         */
+        struct DEEP_D3D_API frustum
+        {
+            enum plane_index : uint32
+            {
+                Left,
+                Right,
+                Bottom,
+                Top,
+                Near,
+                Far,
+                Count
+            };
+
+            float planes[Count][4];
+
+            /**
+             * @brief Extrait les plans d'une matrice vue-projection, telle qu'envoyée aux shaders.
+             */
+            static frustum from_view_projection(const fmat4 &view_projection) noexcept;
+
+            /**
+             * @brief Teste une boîte alignée sur les axes, décrite par son centre et ses demi-dimensions.
+             * @return false si la boîte est entièrement hors du volume.
+             */
+            bool intersects(const fvec3 &center, const fvec3 &extents) const noexcept;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,229 @@
+#include "D3D/culling/frustum_culler.hpp"
+
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace
+        {
+            // Assez grand pour ne jamais être éliminé, assez petit pour que la somme des termes reste finie.
+            constexpr float unbounded_extent = 1.0e30f;
+        } // namespace
+
+        void frustum_culler::resize(uint32 count)
+        {
+            const uint32 previous = m_count;
+            const usize padded    = (static_cast<usize>(count) + lane_count - 1) / lane_count * lane_count;
+
+            m_center_x.resize(padded, 0.0f);
+            m_center_y.resize(padded, 0.0f);
+            m_center_z.resize(padded, 0.0f);
+            m_extents_x.resize(padded, 0.0f);
+            m_extents_y.resize(padded, 0.0f);
+            m_extents_z.resize(padded, 0.0f);
+            m_versions.resize(padded, 0);
+            m_visible.resize(padded, 1);
+
+            m_count = count;
+
+            uint32 index;
+
+            // Version impossible : la boîte sera calculée au prochain passage.
+            for (index = previous; index < count; ++index)
+            {
+                set_unbounded(index, ~static_cast<uint64>(0));
+            }
+        }
+
+        uint32 frustum_culler::get_count() const noexcept
+        {
+            return m_count;
+        }
+
+        void frustum_culler::set_bounds(uint32 index, const fvec3 &center, const fvec3 &extents, uint64 version) noexcept
+        {
+            if (index >= m_count)
+            {
+                return;
+            }
+
+            m_center_x[index]  = center.x;
+            m_center_y[index]  = center.y;
+            m_center_z[index]  = center.z;
+            m_extents_x[index] = extents.x;
+            m_extents_y[index] = extents.y;
+            m_extents_z[index] = extents.z;
+            m_versions[index]  = version;
+        }
+
+        void frustum_culler::set_unbounded(uint32 index, uint64 version) noexcept
+        {
+            set_bounds(index, fvec3(0.0f, 0.0f, 0.0f), fvec3(unbounded_extent, unbounded_extent, unbounded_extent), version);
+        }
+
+        uint64 frustum_culler::get_version(uint32 index) const noexcept
+        {
+            return index < m_count ? m_versions[index] : 0;
+        }
+
+        bool frustum_culler::get_bounds(uint32 index, fvec3 &center, fvec3 &extents) const noexcept
+        {
+            if (index >= m_count || m_extents_x[index] >= unbounded_extent)
+            {
+                return false;
+            }
+
+            center  = fvec3(m_center_x[index], m_center_y[index], m_center_z[index]);
+            extents = fvec3(m_extents_x[index], m_extents_y[index], m_extents_z[index]);
+
+            return true;
+        }
+
+        bool frustum_culler::is_visible(uint32 index) const noexcept
+        {
+            return index >= m_count || m_visible[index] != 0;
+        }
+
+        uint32 frustum_culler::cull(const frustum &f) noexcept
+        {
+            uint8 *visible = m_visible.data();
+
+            const float *cx = m_center_x.data();
+            const float *cy = m_center_y.data();
+            const float *cz = m_center_z.data();
+            const float *ex = m_extents_x.data();
+            const float *ey = m_extents_y.data();
+            const float *ez = m_extents_z.data();
+
+            float abs_planes[frustum::Count][3];
+            uint32 plane;
+
+            for (plane = 0; plane < frustum::Count; ++plane)
+            {
+                abs_planes[plane][0] = std::fabs(f.planes[plane][0]);
+                abs_planes[plane][1] = std::fabs(f.planes[plane][1]);
+                abs_planes[plane][2] = std::fabs(f.planes[plane][2]);
+            }
+
+            uint32 visible_count = 0;
+            uint32 base;
+
+            // Une boîte est hors du volume si, pour un plan, dist(centre) + |n|.demi-dimensions < 0.
+#if defined(__AVX__)
+            for (base = 0; base < m_count; base += 8)
+            {
+                const __m256 center_x  = _mm256_loadu_ps(cx + base);
+                const __m256 center_y  = _mm256_loadu_ps(cy + base);
+                const __m256 center_z  = _mm256_loadu_ps(cz + base);
+                const __m256 extents_x = _mm256_loadu_ps(ex + base);
+                const __m256 extents_y = _mm256_loadu_ps(ey + base);
+                const __m256 extents_z = _mm256_loadu_ps(ez + base);
+
+                __m256 outside = _mm256_setzero_ps();
+
+                for (plane = 0; plane < frustum::Count; ++plane)
+                {
+                    __m256 distance = _mm256_set1_ps(f.planes[plane][3]);
+                    distance        = _mm256_add_ps(distance, _mm256_mul_ps(center_x, _mm256_set1_ps(f.planes[plane][0])));
+                    distance        = _mm256_add_ps(distance, _mm256_mul_ps(center_y, _mm256_set1_ps(f.planes[plane][1])));
+                    distance        = _mm256_add_ps(distance, _mm256_mul_ps(center_z, _mm256_set1_ps(f.planes[plane][2])));
+
+                    __m256 radius = _mm256_mul_ps(extents_x, _mm256_set1_ps(abs_planes[plane][0]));
+                    radius        = _mm256_add_ps(radius, _mm256_mul_ps(extents_y, _mm256_set1_ps(abs_planes[plane][1])));
+                    radius        = _mm256_add_ps(radius, _mm256_mul_ps(extents_z, _mm256_set1_ps(abs_planes[plane][2])));
+
+                    outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ));
+                }
+
+                const uint32 mask  = static_cast<uint32>(_mm256_movemask_ps(outside));
+                const uint32 lanes = m_count - base < 8 ? m_count - base : 8;
+                uint32 lane;
+
+                for (lane = 0; lane < lanes; ++lane)
+                {
+                    const uint8 is_visible = ((mask >> lane) & 1) == 0 ? 1 : 0;
+
+                    visible[base + lane] = is_visible;
+                    visible_count += is_visible;
+                }
+            }
+#else
+            for (base = 0; base < m_count; base += 4)
+            {
+                const __m128 center_x  = _mm_loadu_ps(cx + base);
+                const __m128 center_y  = _mm_loadu_ps(cy + base);
+                const __m128 center_z  = _mm_loadu_ps(cz + base);
+                const __m128 extents_x = _mm_loadu_ps(ex + base);
+                const __m128 extents_y = _mm_loadu_ps(ey + base);
+                const __m128 extents_z = _mm_loadu_ps(ez + base);
+
+                __m128 outside = _mm_setzero_ps();
+
+                for (plane = 0; plane < frustum::Count; ++plane)
+                {
+                    __m128 distance = _mm_set1_ps(f.planes[plane][3]);
+                    distance        = _mm_add_ps(distance, _mm_mul_ps(center_x, _mm_set1_ps(f.planes[plane][0])));
+                    distance        = _mm_add_ps(distance, _mm_mul_ps(center_y, _mm_set1_ps(f.planes[plane][1])));
+                    distance        = _mm_add_ps(distance, _mm_mul_ps(center_z, _mm_set1_ps(f.planes[plane][2])));
+
+                    __m128 radius = _mm_mul_ps(extents_x, _mm_set1_ps(abs_planes[plane][0]));
+                    radius        = _mm_add_ps(radius, _mm_mul_ps(extents_y, _mm_set1_ps(abs_planes[plane][1])));
+                    radius        = _mm_add_ps(radius, _mm_mul_ps(extents_z, _mm_set1_ps(abs_planes[plane][2])));
+
+                    outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+                }
+
+                const uint32 mask  = static_cast<uint32>(_mm_movemask_ps(outside));
+                const uint32 lanes = m_count - base < 4 ? m_count - base : 4;
+                uint32 lane;
+
+                for (lane = 0; lane < lanes; ++lane)
+                {
+                    const uint8 is_visible = ((mask >> lane) & 1) == 0 ? 1 : 0;
+
+                    visible[base + lane] = is_visible;
+                    visible_count += is_visible;
+                }
+            }
+#endif
+
+            return visible_count;
+        }
+
+        uint32 frustum_culler::cull(const frustum &f, const bvh &tree)
+        {
+            uint32 visible_count = 0;
+            uint32 index;
+
+            for (index = 0; index < m_count; ++index)
+            {
+                const uint8 is_visible = m_extents_x[index] >= unbounded_extent ? 1 : 0;
+
+                m_visible[index] = is_visible;
+                visible_count += is_visible;
+            }
+
+            m_query.clear();
+            tree.query_frustum(f, m_query);
+
+            for (uint32 key : m_query)
+            {
+                if (key < m_count && m_visible[key] == 0)
+                {
+                    m_visible[key] = 1;
+                    visible_count++;
+                }
+            }
+
+            return visible_count;
+        }
+    } // namespace D3D
+} // namespace deep
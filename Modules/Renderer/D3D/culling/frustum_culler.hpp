@@ -0,0 +1,101 @@
+#ifndef DEEP_ENGINE_D3D_FRUSTUM_CULLER_HPP
+#define DEEP_ENGINE_D3D_FRUSTUM_CULLER_HPP
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/maths/vec.hpp>
+
+#include "D3D/culling/frustum.hpp"
+#include "D3D/culling/bvh.hpp"
+
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Boîtes englobantes des objets de la scène, rangées en structure de tableaux.
+         *
+         * Chaque composante est stockée dans son propre tableau afin que les plans du volume de vue
+         * soient testés sur 4 boîtes à la fois avec SSE, ou 8 avec AVX.
+         *
+         * Classe interne à DeepD3D, utilisée par renderer.
+         */
+        class frustum_culler
+        {
+          public:
+            // Les tableaux sont complétés jusqu'à un multiple de la largeur des registres AVX.
+            static constexpr uint32 lane_count = 8;
+
+          public:
+            frustum_culler() = default;
+
+            frustum_culler(const frustum_culler &)            = delete;
+            frustum_culler &operator=(const frustum_culler &) = delete;
+
+            /**
+             * @brief Modifie le nombre de boîtes, les nouvelles boîtes sont infinies jusqu'à leur première mise à jour.
+             */
+            void resize(uint32 count);
+            uint32 get_count() const noexcept;
+
+            /**
+             * @param version La version de la transformation ayant servi à calculer la boîte.
+             */
+            void set_bounds(uint32 index, const fvec3 &center, const fvec3 &extents, uint64 version) noexcept;
+
+            /**
+             * @brief Rend la boîte infinie : l'objet n'est jamais éliminé.
+             */
+            void set_unbounded(uint32 index, uint64 version) noexcept;
+
+            /**
+             * @brief Récupère la version de la transformation associée à une boîte, afin de ne la recalculer qu'après un changement.
+             */
+            uint64 get_version(uint32 index) const noexcept;
+
+            /**
+             * @brief Récupère la dernière boîte enregistrée.
+             * @return false si la boîte est infinie.
+             */
+            bool get_bounds(uint32 index, fvec3 &center, fvec3 &extents) const noexcept;
+
+            /**
+             * @brief Teste toutes les boîtes contre le volume de vue.
+             * @return Le nombre de boîtes au moins en partie dans le volume.
+             */
+            uint32 cull(const frustum &f) noexcept;
+
+            /**
+             * @brief Variante hiérarchique pour les grandes scènes : seules les boîtes atteintes dans l'arbre sont visibles.
+             *
+             * Les indices des boîtes servent de clés dans l'arbre. Les boîtes infinies, qui n'y figurent pas, restent visibles.
+             * @return Le nombre de boîtes au moins en partie dans le volume.
+             */
+            uint32 cull(const frustum &f, const bvh &tree);
+
+            /**
+             * @brief Indique si une boîte était visible lors du dernier appel à cull.
+             */
+            bool is_visible(uint32 index) const noexcept;
+
+          private:
+            uint32 m_count = 0;
+
+            std::vector<float> m_center_x;
+            std::vector<float> m_center_y;
+            std::vector<float> m_center_z;
+            std::vector<float> m_extents_x;
+            std::vector<float> m_extents_y;
+            std::vector<float> m_extents_z;
+
+            std::vector<uint64> m_versions;
+            std::vector<uint8> m_visible;
+
+            // Clés renvoyées par l'arbre, conservées d'une image à l'autre.
+            std::vector<uint32> m_query;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
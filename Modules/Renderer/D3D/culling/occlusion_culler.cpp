@@ -0,0 +1,504 @@
+#include "D3D/culling/occlusion_culler.hpp"
+#include "D3D/transform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+
+#include <emmintrin.h>
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace
+        {
+            // Les sommets plus proches de la caméra que cette valeur de w ne sont pas projetés.
+            constexpr float near_w = 1.0e-4f;
+
+            // Matrice, centre et demi-dimensions d'un occultant.
+            constexpr usize occluder_stride = 16 + 3 + 3;
+
+            // Nombre de boîtes testées par tâche.
+            constexpr uint32 occludee_batch = 64;
+
+            // Sommets d'une boîte : le bit 0 choisit x, le bit 1 y, le bit 2 z.
+            constexpr uint8 box_triangles[12][3] = {
+                    {0, 2, 6}, {0, 6, 4}, // -x
+                    {1, 5, 7}, {1, 7, 3}, // +x
+                    {0, 4, 5}, {0, 5, 1}, // -y
+                    {2, 3, 7}, {2, 7, 6}, // +y
+                    {0, 1, 3}, {0, 3, 2}, // -z
+                    {4, 6, 7}, {4, 7, 5}  // +z
+            };
+
+            void transform(const float *m, float x, float y, float z, float *out) noexcept
+            {
+                uint32 row;
+
+                for (row = 0; row < 4; ++row)
+                {
+                    out[row] = m[row * 4 + 0] * x + m[row * 4 + 1] * y + m[row * 4 + 2] * z + m[row * 4 + 3];
+                }
+            }
+        } // namespace
+
+        occlusion_culler::occlusion_culler(uint32 width, uint32 height, uint32 thread_count)
+                : m_width(width),
+                  m_height(height),
+                  m_tiles_x(width / tile_width),
+                  m_tiles_y(height / tile_height),
+                  m_depth(static_cast<usize>(width) * height, 1.0f),
+                  m_tile_max(static_cast<usize>(width / tile_width) * (height / tile_height), 1.0f),
+                  m_thread_pool(thread_count)
+        {
+        }
+
+        void occlusion_culler::begin_frame() noexcept
+        {
+            for (const occludee &box : m_occludees)
+            {
+                m_occluded[box.key] = 0;
+            }
+
+            m_occluders.clear();
+            m_triangles.clear();
+            m_occludees.clear();
+        }
+
+        void occlusion_culler::add_occluder(const float *world_view_proj, const fvec3 &center, const fvec3 &extents)
+        {
+            m_occluders.insert(m_occluders.end(), world_view_proj, world_view_proj + 16);
+
+            m_occluders.push_back(center.x);
+            m_occluders.push_back(center.y);
+            m_occluders.push_back(center.z);
+            m_occluders.push_back(extents.x);
+            m_occluders.push_back(extents.y);
+            m_occluders.push_back(extents.z);
+        }
+
+        void occlusion_culler::add_occludee(uint32 key, const fvec3 &center, const fvec3 &extents)
+        {
+            if (key >= m_occluded.size())
+            {
+                m_occluded.resize(static_cast<usize>(key) + 1, 0);
+            }
+
+            m_occludees.push_back({key, center, extents});
+        }
+
+        uint32 occlusion_culler::cull(const fmat4 &view_projection)
+        {
+            if (m_occluders.empty() || m_occludees.empty())
+            {
+                return 0;
+            }
+
+            setup_triangles();
+
+            if (m_triangles.empty())
+            {
+                return 0;
+            }
+
+            // Chaque bande couvre une ligne de tuiles : les threads n'écrivent jamais dans les mêmes pixels.
+            m_thread_pool.parallel_for(m_tiles_y, [this](uint32 band, uint32) { raster_band(band); });
+
+            float m[16];
+            load_matrix(view_projection, m);
+
+            const uint32 occludee_count = static_cast<uint32>(m_occludees.size());
+            const uint32 batch_count    = (occludee_count + occludee_batch - 1) / occludee_batch;
+
+            std::atomic<uint32> occluded_count(0);
+
+            m_thread_pool.parallel_for(batch_count, [&](uint32 batch, uint32) {
+                const uint32 first = batch * occludee_batch;
+                const uint32 last  = std::min(first + occludee_batch, occludee_count);
+                uint32 hidden      = 0;
+                uint32 index;
+
+                for (index = first; index < last; ++index)
+                {
+                    const occludee &box = m_occludees[index];
+
+                    if (!is_box_visible(m, box))
+                    {
+                        m_occluded[box.key] = 1;
+                        hidden++;
+                    }
+                }
+
+                occluded_count.fetch_add(hidden, std::memory_order_relaxed);
+            });
+
+            return occluded_count.load(std::memory_order_relaxed);
+        }
+
+        bool occlusion_culler::is_occluded(uint32 key) const noexcept
+        {
+            return key < m_occluded.size() && m_occluded[key] != 0;
+        }
+
+        uint32 occlusion_culler::get_occluder_count() const noexcept
+        {
+            return static_cast<uint32>(m_occluders.size() / occluder_stride);
+        }
+
+        uint32 occlusion_culler::get_triangle_count() const noexcept
+        {
+            return static_cast<uint32>(m_triangles.size());
+        }
+
+        uint32 occlusion_culler::get_width() const noexcept
+        {
+            return m_width;
+        }
+
+        uint32 occlusion_culler::get_height() const noexcept
+        {
+            return m_height;
+        }
+
+        const float *occlusion_culler::get_depth_buffer() const noexcept
+        {
+            return m_depth.data();
+        }
+
+        void occlusion_culler::setup_triangles()
+        {
+            const float width  = static_cast<float>(m_width);
+            const float height = static_cast<float>(m_height);
+            usize offset;
+
+            for (offset = 0; offset + occluder_stride <= m_occluders.size(); offset += occluder_stride)
+            {
+                const float *m       = &m_occluders[offset];
+                const float *center  = m + 16;
+                const float *extents = m + 19;
+
+                float clip[8][4];
+                uint32 corner;
+
+                for (corner = 0; corner < 8; ++corner)
+                {
+                    transform(m,
+                              center[0] + ((corner & 1) != 0 ? extents[0] : -extents[0]),
+                              center[1] + ((corner & 2) != 0 ? extents[1] : -extents[1]),
+                              center[2] + ((corner & 4) != 0 ? extents[2] : -extents[2]),
+                              clip[corner]);
+                }
+
+                for (const uint8 *indices : box_triangles)
+                {
+                    screen_triangle tri;
+                    bool rejected = false;
+                    uint32 vertex;
+
+                    for (vertex = 0; vertex < 3; ++vertex)
+                    {
+                        const float *p = clip[indices[vertex]];
+
+                        // Les triangles coupant le plan proche sont ignorés : ne rien rastériser reste conservatif.
+                        if (p[3] <= near_w || p[2] < 0.0f)
+                        {
+                            rejected = true;
+                            break;
+                        }
+
+                        const float inv_w = 1.0f / p[3];
+
+                        tri.x[vertex] = (p[0] * inv_w * 0.5f + 0.5f) * width;
+                        tri.y[vertex] = (0.5f - p[1] * inv_w * 0.5f) * height;
+                        tri.z[vertex] = p[2] * inv_w;
+                    }
+
+                    if (rejected)
+                    {
+                        continue;
+                    }
+
+                    const float min_x = std::min(tri.x[0], std::min(tri.x[1], tri.x[2]));
+                    const float max_x = std::max(tri.x[0], std::max(tri.x[1], tri.x[2]));
+                    const float min_y = std::min(tri.y[0], std::min(tri.y[1], tri.y[2]));
+                    const float max_y = std::max(tri.y[0], std::max(tri.y[1], tri.y[2]));
+
+                    if (max_x < 0.0f || min_x > width || max_y < 0.0f || min_y > height)
+                    {
+                        continue;
+                    }
+
+                    // Lignes dont le centre est couvert par la boîte du triangle.
+                    tri.min_y = static_cast<int32>(std::ceil(std::max(min_y, 0.0f) - 0.5f));
+                    tri.max_y = static_cast<int32>(std::floor(std::min(max_y, height) - 0.5f));
+
+                    if (tri.min_y < 0)
+                    {
+                        tri.min_y = 0;
+                    }
+
+                    if (tri.max_y > static_cast<int32>(m_height) - 1)
+                    {
+                        tri.max_y = static_cast<int32>(m_height) - 1;
+                    }
+
+                    if (tri.min_y <= tri.max_y)
+                    {
+                        m_triangles.push_back(tri);
+                    }
+                }
+            }
+        }
+
+        void occlusion_culler::raster_band(uint32 band) noexcept
+        {
+            const int32 y0 = static_cast<int32>(band * tile_height);
+            const int32 y1 = y0 + static_cast<int32>(tile_height) - 1;
+
+            std::fill(m_depth.begin() + static_cast<usize>(y0) * m_width, m_depth.begin() + static_cast<usize>(y1 + 1) * m_width, 1.0f);
+
+            for (const screen_triangle &tri : m_triangles)
+            {
+                if (tri.max_y < y0 || tri.min_y > y1)
+                {
+                    continue;
+                }
+
+                raster_triangle(tri, std::max(tri.min_y, y0), std::min(tri.max_y, y1));
+            }
+
+            uint32 tile;
+
+            // Profondeur la plus lointaine de chaque tuile de la bande.
+            for (tile = 0; tile < m_tiles_x; ++tile)
+            {
+                __m128 farthest = _mm_setzero_ps();
+                uint32 row;
+
+                for (row = 0; row < tile_height; ++row)
+                {
+                    const float *pixels = &m_depth[(static_cast<usize>(y0) + row) * m_width + tile * tile_width];
+
+                    farthest = _mm_max_ps(farthest, _mm_loadu_ps(pixels));
+                    farthest = _mm_max_ps(farthest, _mm_loadu_ps(pixels + 4));
+                }
+
+                float lanes[4];
+                _mm_storeu_ps(lanes, farthest);
+
+                m_tile_max[band * m_tiles_x + tile] = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+            }
+        }
+
+        void occlusion_culler::raster_triangle(const screen_triangle &tri, int32 y0, int32 y1) noexcept
+        {
+            float x[3] = {tri.x[0], tri.x[1], tri.x[2]};
+            float y[3] = {tri.y[0], tri.y[1], tri.y[2]};
+            float z[3] = {tri.z[0], tri.z[1], tri.z[2]};
+
+            float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+
+            if (std::fabs(area) < 1.0e-8f)
+            {
+                return;
+            }
+
+            // Les deux faces sont rastérisées : l'ordre des sommets est rendu cohérent.
+            if (area < 0.0f)
+            {
+                std::swap(x[1], x[2]);
+                std::swap(y[1], y[2]);
+                std::swap(z[1], z[2]);
+                area = -area;
+            }
+
+            // Fonction de l'arête (a, b) : e(p) = ea * px + eb * py + ec, positive à l'intérieur.
+            float ea[3];
+            float eb[3];
+            float ec[3];
+            uint32 edge;
+
+            for (edge = 0; edge < 3; ++edge)
+            {
+                const uint32 a = edge;
+                const uint32 b = (edge + 1) % 3;
+
+                ea[edge] = -(y[b] - y[a]);
+                eb[edge] = x[b] - x[a];
+                ec[edge] = (y[b] - y[a]) * x[a] - (x[b] - x[a]) * y[a];
+            }
+
+            const float dz_dx = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+            const float dz_dy = ((z[2] - z[0]) * (x[1] - x[0]) - (z[1] - z[0]) * (x[2] - x[0])) / area;
+            const float dz_c  = z[0] - dz_dx * x[0] - dz_dy * y[0];
+
+            const float min_x = std::max(std::min(x[0], std::min(x[1], x[2])), 0.0f);
+            const float max_x = std::min(std::max(x[0], std::max(x[1], x[2])), static_cast<float>(m_width));
+
+            int32 x0 = static_cast<int32>(std::ceil(min_x - 0.5f));
+            int32 x1 = static_cast<int32>(std::floor(max_x - 0.5f));
+
+            x0 = std::max(x0, 0);
+            x1 = std::min(x1, static_cast<int32>(m_width) - 1);
+
+            if (x0 > x1)
+            {
+                return;
+            }
+
+            // La largeur du tampon est un multiple de 4 : un groupe aligné ne dépasse jamais la ligne.
+            x0 &= ~3;
+
+            const __m128 lane_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const __m128 ea0          = _mm_set1_ps(ea[0]);
+            const __m128 ea1          = _mm_set1_ps(ea[1]);
+            const __m128 ea2          = _mm_set1_ps(ea[2]);
+            const __m128 dz_dx4       = _mm_set1_ps(dz_dx);
+            const __m128 zero         = _mm_setzero_ps();
+
+            int32 row;
+
+            for (row = y0; row <= y1; ++row)
+            {
+                const float py = static_cast<float>(row) + 0.5f;
+
+                const __m128 e0_row = _mm_set1_ps(eb[0] * py + ec[0]);
+                const __m128 e1_row = _mm_set1_ps(eb[1] * py + ec[1]);
+                const __m128 e2_row = _mm_set1_ps(eb[2] * py + ec[2]);
+                const __m128 z_row  = _mm_set1_ps(dz_dy * py + dz_c);
+
+                float *pixels = &m_depth[static_cast<usize>(row) * m_width];
+                int32 column;
+
+                for (column = x0; column <= x1; column += 4)
+                {
+                    const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(column)), lane_offsets);
+
+                    const __m128 e0 = _mm_add_ps(_mm_mul_ps(ea0, px), e0_row);
+                    const __m128 e1 = _mm_add_ps(_mm_mul_ps(ea1, px), e1_row);
+                    const __m128 e2 = _mm_add_ps(_mm_mul_ps(ea2, px), e2_row);
+
+                    const __m128 inside = _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_and_ps(_mm_cmpge_ps(e1, zero), _mm_cmpge_ps(e2, zero)));
+
+                    if (_mm_movemask_ps(inside) == 0)
+                    {
+                        continue;
+                    }
+
+                    const __m128 depth   = _mm_add_ps(_mm_mul_ps(dz_dx4, px), z_row);
+                    const __m128 current = _mm_loadu_ps(pixels + column);
+                    const __m128 nearest = _mm_min_ps(current, depth);
+
+                    _mm_storeu_ps(pixels + column, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+                }
+            }
+        }
+
+        bool occlusion_culler::is_box_visible(const float *view_projection, const occludee &box) const noexcept
+        {
+            const float width  = static_cast<float>(m_width);
+            const float height = static_cast<float>(m_height);
+
+            float min_x = FLT_MAX;
+            float max_x = -FLT_MAX;
+            float min_y = FLT_MAX;
+            float max_y = -FLT_MAX;
+            float min_z = FLT_MAX;
+            uint32 corner;
+
+            for (corner = 0; corner < 8; ++corner)
+            {
+                float p[4];
+
+                transform(view_projection,
+                          box.center.x + ((corner & 1) != 0 ? box.extents.x : -box.extents.x),
+                          box.center.y + ((corner & 2) != 0 ? box.extents.y : -box.extents.y),
+                          box.center.z + ((corner & 4) != 0 ? box.extents.z : -box.extents.z),
+                          p);
+
+                // Une boîte coupant le plan proche est considérée comme visible.
+                if (p[3] <= near_w || p[2] < 0.0f)
+                {
+                    return true;
+                }
+
+                const float inv_w = 1.0f / p[3];
+                const float x     = (p[0] * inv_w * 0.5f + 0.5f) * width;
+                const float y     = (0.5f - p[1] * inv_w * 0.5f) * height;
+
+                min_x = std::min(min_x, x);
+                max_x = std::max(max_x, x);
+                min_y = std::min(min_y, y);
+                max_y = std::max(max_y, y);
+                min_z = std::min(min_z, p[2] * inv_w);
+            }
+
+            // Tous les pixels touchés par le rectangle projeté de la boîte.
+            const int32 x0 = static_cast<int32>(std::floor(std::max(min_x, 0.0f)));
+            const int32 x1 = static_cast<int32>(std::floor(std::min(max_x, width - 1.0f)));
+            const int32 y0 = static_cast<int32>(std::floor(std::max(min_y, 0.0f)));
+            const int32 y1 = static_cast<int32>(std::floor(std::min(max_y, height - 1.0f)));
+
+            if (x0 > x1 || y0 > y1)
+            {
+                return true;
+            }
+
+            const __m128 lane_offsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            const __m128 nearest      = _mm_set1_ps(min_z);
+            const __m128 first_column = _mm_set1_ps(static_cast<float>(x0));
+            const __m128 last_column  = _mm_set1_ps(static_cast<float>(x1));
+
+            const int32 tile_y0 = y0 / static_cast<int32>(tile_height);
+            const int32 tile_y1 = y1 / static_cast<int32>(tile_height);
+            const int32 tile_x0 = x0 / static_cast<int32>(tile_width);
+            const int32 tile_x1 = x1 / static_cast<int32>(tile_width);
+
+            int32 tile_y;
+            int32 tile_x;
+
+            for (tile_y = tile_y0; tile_y <= tile_y1; ++tile_y)
+            {
+                for (tile_x = tile_x0; tile_x <= tile_x1; ++tile_x)
+                {
+                    // Tous les occultants de la tuile sont devant la boîte.
+                    if (m_tile_max[static_cast<usize>(tile_y) * m_tiles_x + tile_x] < min_z)
+                    {
+                        continue;
+                    }
+
+                    const int32 row_first    = std::max(y0, tile_y * static_cast<int32>(tile_height));
+                    const int32 row_last     = std::min(y1, (tile_y + 1) * static_cast<int32>(tile_height) - 1);
+                    const int32 column_first = std::max(x0, tile_x * static_cast<int32>(tile_width)) & ~3;
+                    const int32 column_last  = std::min(x1, (tile_x + 1) * static_cast<int32>(tile_width) - 1);
+
+                    int32 row;
+                    int32 column;
+
+                    for (row = row_first; row <= row_last; ++row)
+                    {
+                        const float *pixels = &m_depth[static_cast<usize>(row) * m_width];
+
+                        for (column = column_first; column <= column_last; column += 4)
+                        {
+                            const __m128 columns = _mm_add_ps(_mm_set1_ps(static_cast<float>(column)), lane_offsets);
+                            const __m128 covered = _mm_and_ps(_mm_cmpge_ps(columns, first_column), _mm_cmple_ps(columns, last_column));
+
+                            // Un pixel dont l'occultant est derrière le point le plus proche de la boîte la laisse voir.
+                            const __m128 visible = _mm_and_ps(covered, _mm_cmpge_ps(_mm_loadu_ps(pixels + column), nearest));
+
+                            if (_mm_movemask_ps(visible) != 0)
+                            {
+                                return true;
+                            }
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,129 @@
+#ifndef DEEP_ENGINE_D3D_OCCLUSION_CULLER_HPP
+#define DEEP_ENGINE_D3D_OCCLUSION_CULLER_HPP
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/maths/vec.hpp>
+#include <DeepLib/maths/mat.hpp>
+
+#include "D3D/thread_pool.hpp"
+
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Élimination des objets cachés par un tampon de profondeur basse résolution rempli sur le CPU.
+         *
+         * Les occultants désignés sont rastérisés par bandes de tuiles en parallèle, 4 pixels à la fois
+         * avec SSE, en conservant la profondeur la plus proche. Chaque tuile garde aussi la profondeur
+         * la plus lointaine de ses pixels, ce qui permet de rejeter une boîte sans lire ses pixels.
+         * Les boîtes des objets à tester sont ensuite projetées et comparées au tampon en parallèle.
+         *
+         * Classe interne à DeepD3D, utilisée par renderer.
+         */
+        class occlusion_culler
+        {
+          public:
+            static constexpr uint32 default_width  = 256;
+            static constexpr uint32 default_height = 128;
+
+            static constexpr uint32 tile_width  = 8;
+            static constexpr uint32 tile_height = 8;
+
+          public:
+            /**
+             * @param width Largeur du tampon, multiple de tile_width.
+             * @param height Hauteur du tampon, multiple de tile_height.
+             * @param thread_count Le nombre de threads, 0 pour utiliser tous les cœurs.
+             */
+            occlusion_culler(uint32 width = default_width, uint32 height = default_height, uint32 thread_count = 0);
+
+            occlusion_culler(const occlusion_culler &)            = delete;
+            occlusion_culler &operator=(const occlusion_culler &) = delete;
+
+            /**
+             * @brief Oublie les occultants et les objets à tester de l'image précédente.
+             */
+            void begin_frame() noexcept;
+
+            /**
+             * @brief Ajoute une boîte pleine occultante.
+             * @param world_view_proj La matrice monde-vue-projection de l'objet, 16 flottants (voir transform.hpp).
+             * @param center Le centre de la boîte, dans l'espace de l'objet.
+             * @param extents Les demi-dimensions de la boîte, dans l'espace de l'objet.
+             */
+            void add_occluder(const float *world_view_proj, const fvec3 &center, const fvec3 &extents);
+
+            /**
+             * @brief Ajoute une boîte alignée sur les axes du monde à tester contre les occultants.
+             */
+            void add_occludee(uint32 key, const fvec3 &center, const fvec3 &extents);
+
+            /**
+             * @brief Rastérise les occultants puis teste les boîtes ajoutées.
+             * @return Le nombre de boîtes entièrement cachées.
+             */
+            uint32 cull(const fmat4 &view_projection);
+
+            /**
+             * @brief Indique si la boîte de clé 'key' était cachée lors du dernier appel à cull.
+             */
+            bool is_occluded(uint32 key) const noexcept;
+
+            uint32 get_occluder_count() const noexcept;
+            uint32 get_triangle_count() const noexcept;
+
+            uint32 get_width() const noexcept;
+            uint32 get_height() const noexcept;
+            const float *get_depth_buffer() const noexcept;
+
+          private:
+            struct screen_triangle
+            {
+                float x[3];
+                float y[3];
+                float z[3];
+
+                int32 min_y;
+                int32 max_y;
+            };
+
+            struct occludee
+            {
+                uint32 key;
+                fvec3 center;
+                fvec3 extents;
+            };
+
+          private:
+            void setup_triangles();
+            void raster_band(uint32 band) noexcept;
+            void raster_triangle(const screen_triangle &tri, int32 y0, int32 y1) noexcept;
+            bool is_box_visible(const float *view_projection, const occludee &box) const noexcept;
+
+          private:
+            uint32 m_width;
+            uint32 m_height;
+            uint32 m_tiles_x;
+            uint32 m_tiles_y;
+
+            std::vector<float> m_depth;
+
+            // Profondeur la plus lointaine de chaque tuile.
+            std::vector<float> m_tile_max;
+
+            // 16 flottants de matrice suivis du centre et des demi-dimensions de chaque occultant.
+            std::vector<float> m_occluders;
+            std::vector<screen_triangle> m_triangles;
+
+            std::vector<occludee> m_occludees;
+            std::vector<uint8> m_occluded;
+
+            thread_pool m_thread_pool;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
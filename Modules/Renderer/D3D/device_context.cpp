@@ -1,82 +1,212 @@
 #include "device_context.hpp"
+#include "D3D/command_list.hpp"
+#include "D3D/pipeline_state_cache.hpp"
+
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
 
 namespace deep
 {
     namespace D3D
     {
+        device_context::~device_context() noexcept
+        {
+#ifdef DEEP_D3D11
+            release_native(m_device_context1);
+            release_native(m_device_context);
+#endif
+        }
+
         ID3D11DeviceContext *device_context::get() const noexcept
         {
-            return m_device_context.Get();
+            return m_device_context;
         }
 
         ID3D11DeviceContext *const *device_context::get_address() const noexcept
         {
-            return m_device_context.GetAddressOf();
+            return &m_device_context;
+        }
+
+        bool device_context::is_null() const noexcept
+        {
+            return !m_device_context;
         }
 
         void device_context::bind(const ref<vertex_shader> &shader) noexcept
         {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->bind(shader);
+
+                return;
+            }
+
             if (!shader.is_valid() || shader == m_binded_vertex_shader)
             {
                 return;
             }
 
-            m_device_context->VSSetShader(shader->get(), nullptr, 0);
-            m_device_context->IASetInputLayout(shader->get_input_layout());
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->VSSetShader(shader->get(), nullptr, 0);
+                m_device_context->IASetInputLayout(shader->get_input_layout());
+            }
+#endif
 
             m_binded_vertex_shader = shader;
+            m_frame_stats.shader_binds++;
         }
 
         void device_context::bind(const ref<pixel_shader> &shader) noexcept
         {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->bind(shader);
+
+                return;
+            }
+
             if (!shader.is_valid() || shader == m_binded_pixel_shader)
             {
                 return;
             }
 
-            m_device_context->PSSetShader(shader->get(), nullptr, 0);
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->PSSetShader(shader->get(), nullptr, 0);
+            }
+#endif
 
             m_binded_pixel_shader = shader;
+            m_frame_stats.shader_binds++;
         }
 
         void device_context::bind(const ref<vertex_buffer> &buffer) noexcept
         {
-            if (!buffer.is_valid())
+            if (m_command_list != nullptr)
             {
+                m_command_list->bind(buffer);
+
                 return;
             }
 
-            m_device_context->IASetVertexBuffers(0, 1, buffer->get_address(), &buffer->m_stride, &buffer->m_offset);
+            if (!buffer.is_valid() || buffer == m_binded_vertex_buffer)
+            {
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->IASetVertexBuffers(0, 1, buffer->get_address(), &buffer->m_stride, &buffer->m_offset);
+            }
+#endif
+
+            m_binded_vertex_buffer = buffer;
+            m_frame_stats.buffer_binds++;
         }
 
         void device_context::bind(const ref<index_buffer> &buffer) noexcept
         {
-            if (!buffer.is_valid())
+            if (m_command_list != nullptr)
+            {
+                m_command_list->bind(buffer);
+
+                return;
+            }
+
+            if (!buffer.is_valid() || buffer == m_binded_index_buffer)
             {
                 return;
             }
 
-            m_device_context->IASetIndexBuffer(buffer->get(), DXGI_FORMAT_R16_UINT, 0);
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->IASetIndexBuffer(buffer->get(), DXGI_FORMAT_R16_UINT, 0);
+            }
+#endif
+
+            m_binded_index_buffer = buffer;
+            m_frame_stats.buffer_binds++;
         }
 
         void device_context::bind(const ref<texture> &tex) noexcept
         {
-            if (!tex.is_valid())
+            if (m_command_list != nullptr)
             {
+                m_command_list->bind(tex);
+
                 return;
             }
 
-            m_device_context->PSSetShaderResources(0, 1, tex->m_texture_view.GetAddressOf());
+            if (!tex.is_valid() || tex == m_binded_texture)
+            {
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->PSSetShaderResources(0, 1, &tex->m_texture_view);
+            }
+#endif
+
+            m_binded_texture = tex;
+            m_frame_stats.texture_binds++;
         }
 
         void device_context::bind(const ref<sampler> &samp) noexcept
         {
-            if (!samp.is_valid())
+            if (m_command_list != nullptr)
+            {
+                m_command_list->bind(samp);
+
+                return;
+            }
+
+            if (!samp.is_valid() || samp == m_binded_sampler)
+            {
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->PSSetSamplers(0, 1, &samp->m_sampler_state);
+            }
+#endif
+
+            m_binded_sampler = samp;
+            m_frame_stats.state_changes++;
+        }
+
+        void device_context::bind_instances(const ref<vertex_buffer> &buffer) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->bind_instances(buffer);
+
+                return;
+            }
+
+            if (!buffer.is_valid() || buffer == m_binded_instance_buffer)
             {
                 return;
             }
 
-            m_device_context->PSSetSamplers(0, 1, samp->m_sampler_state.GetAddressOf());
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->IASetVertexBuffers(instance_buffer_slot, 1, buffer->get_address(), &buffer->m_stride, &buffer->m_offset);
+            }
+#endif
+
+            m_binded_instance_buffer = buffer;
+            m_frame_stats.buffer_binds++;
         }
 
         ref<vertex_shader> device_context::get_binded_vertex_shader() const noexcept
@@ -94,37 +224,554 @@ namespace deep
             return m_binded_texture;
         }
 
+        ref<sampler> device_context::get_binded_sampler() const noexcept
+        {
+            return m_binded_sampler;
+        }
+
+        ref<vertex_buffer> device_context::get_binded_vertex_buffer() const noexcept
+        {
+            return m_binded_vertex_buffer;
+        }
+
+        ref<index_buffer> device_context::get_binded_index_buffer() const noexcept
+        {
+            return m_binded_index_buffer;
+        }
+
+        ref<vertex_buffer> device_context::get_binded_instance_buffer() const noexcept
+        {
+            return m_binded_instance_buffer;
+        }
+
+        ref<constant_buffer> device_context::get_binded_vs_constant_buffer(uint32 slot) const noexcept
+        {
+            if (slot >= constant_buffer_slot_count)
+            {
+                return ref<constant_buffer>();
+            }
+
+            return m_binded_vs_constant_buffers[slot];
+        }
+
+        ref<constant_buffer> device_context::get_binded_ps_constant_buffer(uint32 slot) const noexcept
+        {
+            if (slot >= constant_buffer_slot_count)
+            {
+                return ref<constant_buffer>();
+            }
+
+            return m_binded_ps_constant_buffers[slot];
+        }
+
+        void device_context::set_vs_constant_buffer(uint32 slot, const ref<constant_buffer> &buffer) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->set_vs_constant_buffer(slot, buffer);
+
+                return;
+            }
+
+            if (!buffer.is_valid())
+            {
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->VSSetConstantBuffers(slot, 1, buffer->get_address());
+            }
+#endif
+
+            if (slot < constant_buffer_slot_count)
+            {
+                m_binded_vs_constant_buffers[slot] = buffer;
+                m_vs_ring_ranges[slot]             = {};
+            }
+
+            m_frame_stats.buffer_binds++;
+        }
+
+        void device_context::set_ps_constant_buffer(uint32 slot, const ref<constant_buffer> &buffer) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->set_ps_constant_buffer(slot, buffer);
+
+                return;
+            }
+
+            if (!buffer.is_valid())
+            {
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->PSSetConstantBuffers(slot, 1, buffer->get_address());
+            }
+#endif
+
+            if (slot < constant_buffer_slot_count)
+            {
+                m_binded_ps_constant_buffers[slot] = buffer;
+            }
+
+            m_frame_stats.buffer_binds++;
+        }
+
+        void device_context::update(const ref<constant_buffer> &buffer, const void *data) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->update(buffer, data);
+
+                return;
+            }
+
+            if (!buffer.is_valid())
+            {
+                return;
+            }
+
+            buffer->update(data, *this);
+
+            m_frame_stats.buffer_uploads++;
+            m_frame_stats.buffer_upload_bytes += buffer->get_bytes_size();
+        }
+
+        void device_context::set_constant_ring(const ref<constant_ring_buffer> &ring) noexcept
+        {
+            m_constant_ring = ring;
+        }
+
+        ref<constant_ring_buffer> device_context::get_constant_ring() const noexcept
+        {
+            return m_constant_ring;
+        }
+
+        bool device_context::push_vs_constants(uint32 slot, const void *data, uint32 bytes_size) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                if (!m_recording_ring || slot >= constant_buffer_slot_count)
+                {
+                    return false;
+                }
+
+                m_command_list->push_vs_constants(slot, data, bytes_size);
+
+                return true;
+            }
+
+            if (!can_push_constants() || slot >= constant_buffer_slot_count)
+            {
+                return false;
+            }
+
+            constant_allocation allocation;
+
+            if (!m_constant_ring->push(data, bytes_size, *this, &allocation))
+            {
+                return false;
+            }
+
+            bind_vs_constants(slot, allocation, bytes_size);
+
+            return true;
+        }
+
+        void device_context::bind_vs_constants(uint32 slot, const constant_allocation &allocation, uint32 bytes_size) noexcept
+        {
+            if (slot >= constant_buffer_slot_count)
+            {
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                // Décalage et taille s'expriment en constantes de 16 octets.
+                const UINT first_constant = allocation.offset / 16;
+                const UINT constant_count = allocation.bytes_size / 16;
+
+                m_device_context1->VSSetConstantBuffers1(slot, 1, m_constant_ring->get_address(), &first_constant, &constant_count);
+            }
+#endif
+
+            m_binded_vs_constant_buffers[slot] = ref<constant_buffer>();
+            m_vs_ring_ranges[slot]             = allocation;
+
+            m_frame_stats.buffer_binds++;
+            m_frame_stats.buffer_uploads++;
+            m_frame_stats.buffer_upload_bytes += bytes_size;
+            m_frame_stats.ring_constant_bytes += allocation.bytes_size;
+        }
+
+        const uint8 *device_context::get_vs_constant_data(uint32 slot, uint32 *bytes_size) const noexcept
+        {
+            if (slot >= constant_buffer_slot_count)
+            {
+                return nullptr;
+            }
+
+            const constant_allocation &range = m_vs_ring_ranges[slot];
+
+            if (range.bytes_size != 0 && m_constant_ring.is_valid() && m_constant_ring->get_data() != nullptr)
+            {
+                if (bytes_size != nullptr)
+                {
+                    *bytes_size = range.bytes_size;
+                }
+
+                return m_constant_ring->get_data() + range.offset;
+            }
+
+            const ref<constant_buffer> &buffer = m_binded_vs_constant_buffers[slot];
+
+            if (!buffer.is_valid() || buffer->get_data() == nullptr)
+            {
+                return nullptr;
+            }
+
+            if (bytes_size != nullptr)
+            {
+                *bytes_size = buffer->get_bytes_size();
+            }
+
+            return buffer->get_data();
+        }
+
+        void device_context::update(const ref<vertex_buffer> &buffer, const void *data, uint32 bytes_size) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->update(buffer, data, bytes_size);
+
+                return;
+            }
+
+            if (!buffer.is_valid())
+            {
+                return;
+            }
+
+            buffer->update(data, bytes_size, *this);
+
+            m_frame_stats.buffer_uploads++;
+            m_frame_stats.buffer_upload_bytes += bytes_size;
+        }
+
+        void device_context::set_primitive_topology(primitive_topology topology) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->set_primitive_topology(topology);
+
+                return;
+            }
+
+            if (topology == m_primitive_topology)
+            {
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->IASetPrimitiveTopology(static_cast<D3D11_PRIMITIVE_TOPOLOGY>(topology));
+            }
+#endif
+
+            m_primitive_topology = topology;
+            m_frame_stats.state_changes++;
+        }
+
+        primitive_topology device_context::get_primitive_topology() const noexcept
+        {
+            return m_primitive_topology;
+        }
+
+        void device_context::draw(uint32 vertex_count, uint32 start_vertex) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->draw(vertex_count, start_vertex);
+
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->Draw(vertex_count, start_vertex);
+            }
+#endif
+
+            m_frame_stats.draw_calls++;
+            m_frame_stats.vertices += vertex_count;
+
+            if (m_draw_callback != nullptr)
+            {
+                const draw_call call = { vertex_count, start_vertex, 0, false, 1, 0, false };
+
+                m_draw_callback(*this, call, m_draw_callback_data);
+            }
+        }
+
+        void device_context::draw_indexed(uint32 index_count, uint32 start_index, int32 base_vertex) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->draw_indexed(index_count, start_index, base_vertex);
+
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->DrawIndexed(index_count, start_index, base_vertex);
+            }
+#endif
+
+            m_frame_stats.draw_calls++;
+            m_frame_stats.vertices += index_count;
+
+            if (m_draw_callback != nullptr)
+            {
+                const draw_call call = { index_count, start_index, base_vertex, true, 1, 0, false };
+
+                m_draw_callback(*this, call, m_draw_callback_data);
+            }
+        }
+
+        void device_context::draw_instanced(uint32 vertex_count, uint32 instance_count, uint32 start_vertex, uint32 start_instance) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->draw_instanced(vertex_count, instance_count, start_vertex, start_instance);
+
+                return;
+            }
+
+            if (instance_count == 0)
+            {
+                return;
+            }
+
+#ifdef DEEP_D3D11
+            if (!is_null())
+            {
+                m_device_context->DrawInstanced(vertex_count, instance_count, start_vertex, start_instance);
+            }
+#endif
+
+            m_frame_stats.draw_calls++;
+            m_frame_stats.vertices += vertex_count * instance_count;
+
+            if (m_draw_callback != nullptr)
+            {
+                const draw_call call = { vertex_count, start_vertex, 0, false, instance_count, start_instance, true };
+
+                m_draw_callback(*this, call, m_draw_callback_data);
+            }
+        }
+
+        void device_context::set_pipeline_state(pipeline_state_id id) noexcept
+        {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->set_pipeline_state(id);
+
+                return;
+            }
+
+            if (m_pipeline_cache == nullptr)
+            {
+                return;
+            }
+
+            if (id == m_pipeline_state)
+            {
+                m_frame_stats.redundant_state_sets++;
+
+                return;
+            }
+
+            const pipeline_state_cache::state *next = m_pipeline_cache->get(id);
+
+            if (next == nullptr)
+            {
+                return;
+            }
+
+            const pipeline_state_cache::state *current = m_pipeline_cache->get(m_pipeline_state);
+
+            // Seules les parties qui changent sont transmises : deux états qui ne diffèrent que par le mélange
+            // partagent le même objet de rastérisation.
+            if (current == nullptr || current->rasterizer != next->rasterizer)
+            {
+#ifdef DEEP_D3D11
+                if (!is_null() && next->rasterizer_state != nullptr)
+                {
+                    m_device_context->RSSetState(next->rasterizer_state);
+                }
+#endif
+
+                m_frame_stats.state_changes++;
+            }
+
+            if (current == nullptr || current->depth_stencil != next->depth_stencil)
+            {
+#ifdef DEEP_D3D11
+                if (!is_null() && next->depth_stencil_state != nullptr)
+                {
+                    m_device_context->OMSetDepthStencilState(next->depth_stencil_state, next->desc.depth_stencil.stencil_ref);
+                }
+#endif
+
+                m_frame_stats.state_changes++;
+            }
+
+            if (current == nullptr || current->blend != next->blend)
+            {
+#ifdef DEEP_D3D11
+                if (!is_null() && next->blend_state != nullptr)
+                {
+                    m_device_context->OMSetBlendState(next->blend_state, nullptr, 0xFFFFFFFF);
+                }
+#endif
+
+                m_frame_stats.state_changes++;
+            }
+
+            const rasterizer_desc &raster = next->desc.rasterizer;
+
+            if (raster.cull == cull_mode::Front)
+            {
+                m_rasterizer_state = raster.fill == fill_mode::Wireframe ? rasterizer_state::CullFrontWireframe : rasterizer_state::CullFrontSolid;
+            }
+            else
+            {
+                m_rasterizer_state = raster.fill == fill_mode::Wireframe ? rasterizer_state::CullBackWireframe : rasterizer_state::CullBackSolid;
+            }
+
+            m_pipeline_state = id;
+        }
+
+        pipeline_state_id device_context::get_pipeline_state() const noexcept
+        {
+            return m_pipeline_state;
+        }
+
+        const pipeline_state_desc *device_context::get_pipeline_state_desc() const noexcept
+        {
+            if (m_pipeline_cache == nullptr)
+            {
+                return nullptr;
+            }
+
+            const pipeline_state_cache::state *current = m_pipeline_cache->get(m_pipeline_state);
+
+            return current != nullptr ? &current->desc : nullptr;
+        }
+
         void device_context::set_rasterizer_state(rasterizer_state state) noexcept
         {
+            if (m_command_list != nullptr)
+            {
+                m_command_list->set_rasterizer_state(state);
+
+                return;
+            }
+
+            if (m_pipeline_cache == nullptr)
+            {
+                return;
+            }
+
+            const pipeline_state_desc *current_desc = get_pipeline_state_desc();
+            pipeline_state_desc desc                = current_desc != nullptr ? *current_desc : default_pipeline_state_desc();
+
             switch (state)
             {
                 default:
-                    break;
+                    return;
                 case rasterizer_state::CullBackSolid:
                 {
-                    m_device_context->RSSetState(m_rasterizer_state_cull_back_solid.Get());
-                    m_rasterizer_state = rasterizer_state::CullBackSolid;
+                    desc.rasterizer.cull = cull_mode::Back;
+                    desc.rasterizer.fill = fill_mode::Solid;
                 }
                 break;
                 case rasterizer_state::CullBackWireframe:
                 {
-                    m_device_context->RSSetState(m_rasterizer_state_cull_back_wireframe.Get());
-                    m_rasterizer_state = rasterizer_state::CullBackWireframe;
+                    desc.rasterizer.cull = cull_mode::Back;
+                    desc.rasterizer.fill = fill_mode::Wireframe;
                 }
                 break;
                 case rasterizer_state::CullFrontSolid:
                 {
-                    m_device_context->RSSetState(m_rasterizer_state_cull_front_solid.Get());
-                    m_rasterizer_state = rasterizer_state::CullFrontSolid;
+                    desc.rasterizer.cull = cull_mode::Front;
+                    desc.rasterizer.fill = fill_mode::Solid;
                 }
                 break;
                 case rasterizer_state::CullFrontWireframe:
                 {
-                    m_device_context->RSSetState(m_rasterizer_state_cull_front_wireframe.Get());
-                    m_rasterizer_state = rasterizer_state::CullFrontWireframe;
+                    desc.rasterizer.cull = cull_mode::Front;
+                    desc.rasterizer.fill = fill_mode::Wireframe;
                 }
                 break;
             }
+
+            set_pipeline_state(m_pipeline_cache->get_or_create(desc));
+        }
+
+        rasterizer_state device_context::get_rasterizer_state() const noexcept
+        {
+            return m_rasterizer_state;
+        }
+
+        const frame_stats &device_context::get_frame_stats() const noexcept
+        {
+            return m_frame_stats;
+        }
+
+        void device_context::reset_frame_stats() noexcept
+        {
+            m_frame_stats = {};
+        }
+
+        void device_context::set_draw_callback(draw_callback callback, void *data) noexcept
+        {
+            m_draw_callback      = callback;
+            m_draw_callback_data = data;
+        }
+
+        void device_context::begin_recording(command_list *list, const device_context &target) noexcept
+        {
+            m_command_list   = list;
+            m_recording_ring = target.can_push_constants();
+        }
+
+        void device_context::end_recording() noexcept
+        {
+            m_command_list   = nullptr;
+            m_recording_ring = false;
+        }
+
+        bool device_context::is_recording() const noexcept
+        {
+            return m_command_list != nullptr;
+        }
+
+        bool device_context::can_push_constants() const noexcept
+        {
+            // Lier une portion de buffer nécessite Direct3D 11.1.
+            return m_constant_ring.is_valid() && (is_null() || m_device_context1 != nullptr);
         }
     } // namespace D3D
 } // namespace deep
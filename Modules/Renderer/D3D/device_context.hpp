@@ -10,18 +10,42 @@
 #include "D3D/shader/pixel_shader.hpp"
 #include "D3D/buffer/vertex_buffer.hpp"
 #include "D3D/buffer/index_buffer.hpp"
+#include "D3D/buffer/constant_buffer.hpp"
+#include "D3D/buffer/constant_ring_buffer.hpp"
 #include "D3D/texture.hpp"
 #include "D3D/sampler.hpp"
+#include "D3D/pipeline_state.hpp"
 
-#include <d3d11.h>
-#include <wrl.h>
+struct ID3D11DeviceContext;
+struct ID3D11DeviceContext1;
 
 namespace deep
 {
     namespace D3D
     {
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11DeviceContext>;
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11RasterizerState>;
+        template class DEEP_D3D_API ref<vertex_buffer>;
+        template class DEEP_D3D_API ref<index_buffer>;
+        template class DEEP_D3D_API ref<constant_buffer>;
+        template class DEEP_D3D_API ref<constant_ring_buffer>;
+        template class DEEP_D3D_API ref<vertex_shader>;
+        template class DEEP_D3D_API ref<pixel_shader>;
+        template class DEEP_D3D_API ref<texture>;
+        template class DEEP_D3D_API ref<sampler>;
+
+        /**
+         * @brief Interprétation des sommets par les appels de dessin.
+         *
+         * Les valeurs sont celles de D3D11_PRIMITIVE_TOPOLOGY, transmises telles quelles par le backend Direct3D 11.
+         */
+        enum class primitive_topology : uint32
+        {
+            Undefined     = 0,
+            PointList     = 1,
+            LineList      = 2,
+            LineStrip     = 3,
+            TriangleList  = 4,
+            TriangleStrip = 5
+        };
 
         enum class rasterizer_state
         {
@@ -32,16 +56,80 @@ namespace deep
             CullFrontWireframe
         };
 
+        /**
+         * @brief Compteurs des commandes envoyées au contexte durant une image.
+         */
+        struct frame_stats
+        {
+            uint32 draw_calls;
+            uint32 vertices;
+            uint32 shader_binds;
+            uint32 buffer_binds;
+            uint32 texture_binds;
+            uint32 state_changes;
+            uint32 buffer_uploads;
+            uint64 buffer_upload_bytes;
+            uint32 ring_constant_bytes;
+            uint32 ring_maps;
+            uint32 culled_drawables;
+            uint32 occluded_drawables;
+            // Objets visibles non dessinés faute de mémoire pour la file de dessin.
+            uint32 dropped_drawables;
+            uint32 command_lists;
+            uint32 pipeline_lookups;
+            uint32 pipeline_cache_hits;
+            uint32 redundant_state_sets;
+        };
+
+        /**
+         * @brief Paramètres d'un appel de dessin.
+         */
+        struct draw_call
+        {
+            uint32 count;
+            uint32 start;
+            int32 base_vertex;
+            bool indexed;
+            uint32 instance_count;
+            uint32 start_instance;
+            bool instanced;
+        };
+
+        class device_context;
+        class command_list;
+        class pipeline_state_cache;
+
+        using draw_callback = void (*)(const device_context &dc, const draw_call &call, void *data);
+
+        /**
+         * @brief Enveloppe le contexte Direct3D 11.
+         *
+         * Toutes les commandes passent par cette classe afin d'être comptabilisées.
+         * Seul graphics lui associe un contexte Direct3D : sans DEEP_D3D11, la classe est compilée sans le SDK Windows.
+         * Si aucun contexte Direct3D n'est associé (backend nul), les commandes sont
+         * uniquement enregistrées et jamais transmises au GPU.
+         * L'état lié est conservé afin qu'un backend logiciel puisse exécuter les appels de dessin.
+         */
         class DEEP_D3D_API device_context
         {
+          public:
+            static constexpr uint32 constant_buffer_slot_count = 4;
+            static constexpr uint32 instance_buffer_slot       = 1;
+
           public:
             device_context()                                  = default;
             device_context(const device_context &)            = delete;
             device_context &operator=(const device_context &) = delete;
+            ~device_context() noexcept;
 
             ID3D11DeviceContext *get() const noexcept;
             ID3D11DeviceContext *const *get_address() const noexcept;
 
+            /**
+             * @brief Indique si le contexte n'est relié à aucun périphérique.
+             */
+            bool is_null() const noexcept;
+
             void bind(const ref<vertex_shader> &shader) noexcept;
             void bind(const ref<pixel_shader> &shader) noexcept;
             void bind(const ref<vertex_buffer> &buffer) noexcept;
@@ -49,25 +137,136 @@ namespace deep
             void bind(const ref<texture> &tex) noexcept;
             void bind(const ref<sampler> &samp) noexcept;
 
+            /**
+             * @brief Lie le buffer contenant les données par instance, lues par draw_instanced.
+             */
+            void bind_instances(const ref<vertex_buffer> &buffer) noexcept;
+
             ref<vertex_shader> get_binded_vertex_shader() const noexcept;
             ref<pixel_shader> get_binded_pixel_shader() const noexcept;
             ref<texture> get_binded_texture() const noexcept;
+            ref<sampler> get_binded_sampler() const noexcept;
+            ref<vertex_buffer> get_binded_vertex_buffer() const noexcept;
+            ref<index_buffer> get_binded_index_buffer() const noexcept;
+            ref<vertex_buffer> get_binded_instance_buffer() const noexcept;
+            ref<constant_buffer> get_binded_vs_constant_buffer(uint32 slot) const noexcept;
+            ref<constant_buffer> get_binded_ps_constant_buffer(uint32 slot) const noexcept;
 
+            void set_vs_constant_buffer(uint32 slot, const ref<constant_buffer> &buffer) noexcept;
+            void set_ps_constant_buffer(uint32 slot, const ref<constant_buffer> &buffer) noexcept;
+            void update(const ref<constant_buffer> &buffer, const void *data) noexcept;
+
+            /**
+             * @brief Définit l'anneau dans lequel push_vs_constants écrit les constantes de chaque objet.
+             */
+            void set_constant_ring(const ref<constant_ring_buffer> &ring) noexcept;
+            ref<constant_ring_buffer> get_constant_ring() const noexcept;
+
+            /**
+             * @brief Écrit des constantes dans l'anneau et lie leur portion au slot du vertex shader.
+             * @return false si aucun anneau n'est utilisable, l'appelant doit alors passer par un constant_buffer.
+             */
+            bool push_vs_constants(uint32 slot, const void *data, uint32 bytes_size) noexcept;
+
+            /**
+             * @brief Lie au slot du vertex shader une portion de l'anneau déjà écrite, par exemple par command_list.
+             * @param bytes_size La taille des constantes écrites, pour les compteurs.
+             */
+            void bind_vs_constants(uint32 slot, const constant_allocation &allocation, uint32 bytes_size) noexcept;
+
+            /**
+             * @brief Récupère la copie CPU des constantes liées à un slot du vertex shader, qu'elles viennent d'un buffer ou de l'anneau.
+             * @return nullptr si le contenu n'est pas conservé côté CPU.
+             */
+            const uint8 *get_vs_constant_data(uint32 slot, uint32 *bytes_size) const noexcept;
+            void update(const ref<vertex_buffer> &buffer, const void *data, uint32 bytes_size) noexcept;
+
+            void set_primitive_topology(primitive_topology topology) noexcept;
+            primitive_topology get_primitive_topology() const noexcept;
+
+            void draw(uint32 vertex_count, uint32 start_vertex) noexcept;
+            void draw_indexed(uint32 index_count, uint32 start_index, int32 base_vertex) noexcept;
+            void draw_instanced(uint32 vertex_count, uint32 instance_count, uint32 start_vertex, uint32 start_instance) noexcept;
+
+            /**
+             * @brief Applique un état de pipeline du cache du renderer.
+             *
+             * Seules les parties qui diffèrent de l'état courant sont transmises au GPU. Appliquer l'état
+             * déjà lié est compté comme redondant dans les compteurs de l'image.
+             */
+            void set_pipeline_state(pipeline_state_id id) noexcept;
+            pipeline_state_id get_pipeline_state() const noexcept;
+
+            /**
+             * @return nullptr si aucun état de pipeline n'a été appliqué.
+             */
+            const pipeline_state_desc *get_pipeline_state_desc() const noexcept;
+
+            /**
+             * @brief Remplace le remplissage et l'élimination des faces de l'état de pipeline courant.
+             */
             void set_rasterizer_state(rasterizer_state state) noexcept;
+            rasterizer_state get_rasterizer_state() const noexcept;
+
+            const frame_stats &get_frame_stats() const noexcept;
+            void reset_frame_stats() noexcept;
+
+            /**
+             * @brief Définit la fonction appelée à chaque appel de dessin, après sa transmission au GPU.
+             */
+            void set_draw_callback(draw_callback callback, void *data) noexcept;
+
+            /**
+             * @brief Ajoute les commandes suivantes à une liste au lieu de les exécuter.
+             *
+             * Un contexte qui enregistre peut être utilisé depuis un thread de travail. Les liaisons redondantes
+             * ne sont pas filtrées et les compteurs restent inchangés : les deux ont lieu lors de la relecture.
+             *
+             * La liste ne copie pas les références reçues, pour ne pas modifier leur compteur depuis plusieurs threads :
+             * chaque référence passée au contexte doit rester en vie et désigner la même ressource jusqu'à la relecture.
+             * C'est le cas des membres des drawables, que le renderer conserve pendant toute l'image ; une référence
+             * temporaire ne doit pas être passée. Les builds de debug vérifient ce contrat lors de la relecture.
+             * @param target Le contexte sur lequel la liste sera rejouée, qui indique si l'anneau de constantes est utilisable.
+             */
+            void begin_recording(command_list *list, const device_context &target) noexcept;
+            void end_recording() noexcept;
+            bool is_recording() const noexcept;
+
+          private:
+            bool can_push_constants() const noexcept;
 
           private:
-            Microsoft::WRL::ComPtr<ID3D11DeviceContext> m_device_context;
-            Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_rasterizer_state_cull_back_solid;
-            Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_rasterizer_state_cull_back_wireframe;
-            Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_rasterizer_state_cull_front_solid;
-            Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_rasterizer_state_cull_front_wireframe;
+            ID3D11DeviceContext *m_device_context = nullptr;
+            // Non nul uniquement si le matériel sait lier un buffer de constantes par décalage.
+            ID3D11DeviceContext1 *m_device_context1 = nullptr;
             DEEP_REF(vertex_shader, m_binded_vertex_shader)
             DEEP_REF(pixel_shader, m_binded_pixel_shader)
             DEEP_REF(texture, m_binded_texture)
-            rasterizer_state m_rasterizer_state;
+            DEEP_REF(sampler, m_binded_sampler)
+            DEEP_REF(vertex_buffer, m_binded_vertex_buffer)
+            DEEP_REF(index_buffer, m_binded_index_buffer)
+            DEEP_REF(vertex_buffer, m_binded_instance_buffer)
+            ref<constant_buffer> m_binded_vs_constant_buffers[constant_buffer_slot_count];
+            ref<constant_buffer> m_binded_ps_constant_buffers[constant_buffer_slot_count];
+            DEEP_REF(constant_ring_buffer, m_constant_ring)
+            // Portion de l'anneau liée à chaque slot du vertex shader, taille nulle si aucune.
+            constant_allocation m_vs_ring_ranges[constant_buffer_slot_count] = {};
+            // Cache appartenant au renderer, nul tant que celui-ci ne l'a pas créé.
+            pipeline_state_cache *m_pipeline_cache        = nullptr;
+            pipeline_state_id m_pipeline_state            = invalid_pipeline_state;
+            rasterizer_state m_rasterizer_state           = rasterizer_state::Unknown;
+            primitive_topology m_primitive_topology       = primitive_topology::Undefined;
+            frame_stats m_frame_stats                     = {};
+            draw_callback m_draw_callback                 = nullptr;
+            void *m_draw_callback_data                    = nullptr;
+            command_list *m_command_list                  = nullptr;
+            // Indique, pendant un enregistrement, si le contexte cible pourra écrire dans l'anneau.
+            bool m_recording_ring = false;
 
           public:
             friend class graphics;
+            friend class renderer;
+            friend class command_list;
         };
     } // namespace D3D
 } // namespace deep
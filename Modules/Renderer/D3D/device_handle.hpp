@@ -0,0 +1,61 @@
+#ifndef DEEP_ENGINE_D3D_DEVICE_HANDLE_HPP
+#define DEEP_ENGINE_D3D_DEVICE_HANDLE_HPP
+
+#include <cstddef>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Référence opaque vers le périphérique d'un backend, passée aux fabriques de ressources.
+         *
+         * La poignée ne possède pas le périphérique, qui appartient au renderer : elle ne doit pas lui survivre.
+         * Une poignée nulle désigne un backend sans GPU, pour lequel les ressources conservent leur contenu côté CPU.
+         */
+        class device_handle
+        {
+          public:
+            constexpr device_handle() noexcept = default;
+            constexpr device_handle(std::nullptr_t) noexcept;
+            constexpr explicit device_handle(void *native) noexcept;
+
+            /**
+             * @brief Récupère le périphérique natif, par exemple un ID3D11Device pour le backend Direct3D 11.
+             */
+            constexpr void *get_native() const noexcept;
+            constexpr bool is_null() const noexcept;
+
+            constexpr explicit operator bool() const noexcept;
+
+          private:
+            void *m_native = nullptr;
+        };
+
+        inline constexpr device_handle::device_handle(std::nullptr_t) noexcept
+        {
+        }
+
+        inline constexpr device_handle::device_handle(void *native) noexcept
+                : m_native(native)
+        {
+        }
+
+        inline constexpr void *device_handle::get_native() const noexcept
+        {
+            return m_native;
+        }
+
+        inline constexpr bool device_handle::is_null() const noexcept
+        {
+            return m_native == nullptr;
+        }
+
+        inline constexpr device_handle::operator bool() const noexcept
+        {
+            return m_native != nullptr;
+        }
+    } // namespace D3D
+} // namespace deep
+
+#endif
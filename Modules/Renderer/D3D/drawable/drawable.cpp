@@ -1,4 +1,5 @@
 #include "D3D/drawable/drawable.hpp"
+#include "D3D/transform.hpp"
 
 namespace deep
 {
@@ -24,6 +25,15 @@ namespace deep
             return m_per_object_buffer;
         }
 
+        ref<texture> drawable::get_texture() const noexcept
+        {
+            return ref<texture>();
+        }
+
+        void drawable::set_texture(const ref<texture> & /*tex*/) noexcept
+        {
+        }
+
         void drawable::set_vertex_buffer(const ref<vertex_buffer> &buffer) noexcept
         {
             m_vertex_buffer = buffer;
@@ -62,16 +72,136 @@ namespace deep
         void drawable::set_location(const fvec3 &location) noexcept
         {
             m_location = location;
+
+            invalidate_world();
         }
 
         void drawable::set_rotation(const fvec3 &rotation) noexcept
         {
             m_rotation = rotation;
+
+            invalidate_world();
         }
 
         void drawable::set_scale(const fvec3 &scale) noexcept
         {
             m_scale = scale;
+
+            invalidate_world();
+        }
+
+        const fmat4 &drawable::get_world() noexcept
+        {
+            if (m_world_dirty)
+            {
+                fmat4 model = fmat4();
+                model       = fmat4::translate(model, m_location);
+                model       = fmat4::rotate_x(model, m_rotation.x);
+                model       = fmat4::rotate_y(model, m_rotation.y);
+                model       = fmat4::rotate_z(model, m_rotation.z);
+                model       = fmat4::scale(model, m_scale);
+
+                m_world       = model;
+                m_world_dirty = false;
+            }
+
+            return m_world;
+        }
+
+        uint64 drawable::get_transform_version() const noexcept
+        {
+            return m_transform_version;
+        }
+
+        void drawable::set_vertex_dequantization(const vertex_dequantization &dequantization) noexcept
+        {
+            m_dequantization     = dequantization;
+            m_quantized          = true;
+            m_vertex_world_dirty = true;
+        }
+
+        const fmat4 &drawable::get_vertex_world() noexcept
+        {
+            if (!m_quantized)
+            {
+                return get_world();
+            }
+
+            const fmat4 &world = get_world();
+
+            if (m_vertex_world_dirty || m_vertex_world_version != m_transform_version)
+            {
+                // Les positions quantifiées, entre 0 et 1, sont d'abord ramenées dans la boîte de l'objet.
+                fmat4 model = fmat4::translate(world, m_dequantization.offset);
+                model       = fmat4::scale(model, m_dequantization.scale);
+
+                m_vertex_world         = model;
+                m_vertex_world_version = m_transform_version;
+                m_vertex_world_dirty   = false;
+            }
+
+            return m_vertex_world;
+        }
+
+        void drawable::set_local_bounds(const fvec3 &min, const fvec3 &max) noexcept
+        {
+            m_local_center  = fvec3((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f);
+            m_local_extents = fvec3((max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f);
+            m_has_bounds    = true;
+
+            m_transform_version++;
+        }
+
+        bool drawable::get_world_bounds(fvec3 &center, fvec3 &extents) noexcept
+        {
+            if (!m_has_bounds)
+            {
+                return false;
+            }
+
+            transform_bounds(get_world(), m_local_center, m_local_extents, center, extents);
+
+            return true;
+        }
+
+        bool drawable::get_local_bounds(fvec3 &center, fvec3 &extents) const noexcept
+        {
+            if (!m_has_bounds)
+            {
+                return false;
+            }
+
+            center  = m_local_center;
+            extents = m_local_extents;
+
+            return true;
+        }
+
+        void drawable::set_occluder(bool occluder) noexcept
+        {
+            m_occluder = occluder;
+        }
+
+        bool drawable::is_occluder() const noexcept
+        {
+            return m_occluder && m_has_bounds;
+        }
+
+        void drawable::invalidate_world() noexcept
+        {
+            m_world_dirty = true;
+            m_transform_version++;
+        }
+
+        void drawable::upload_per_object(device_context &dc, const void *data, uint32 bytes_size) noexcept
+        {
+            if (dc.push_vs_constants(1, data, bytes_size))
+            {
+                return;
+            }
+
+            dc.set_vs_constant_buffer(1, m_per_object_buffer);
+            dc.update(m_per_object_buffer, data);
         }
     } // namespace D3D
 } // namespace deep
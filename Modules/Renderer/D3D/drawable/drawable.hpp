@@ -11,16 +11,13 @@
 #include "D3D/buffer/constant_buffer.hpp"
 #include "D3D/shader/vertex_shader.hpp"
 #include "D3D/shader/pixel_shader.hpp"
+#include "D3D/texture.hpp"
+#include "D3D/vertex_quantization.hpp"
 
 namespace deep
 {
     namespace D3D
     {
-        template class DEEP_D3D_API ref<vertex_buffer>;
-        template class DEEP_D3D_API ref<constant_buffer>;
-        template class DEEP_D3D_API ref<vertex_shader>;
-        template class DEEP_D3D_API ref<pixel_shader>;
-
         class DEEP_D3D_API drawable : public object
         {
           public:
@@ -35,11 +32,21 @@ namespace deep
             virtual ref<pixel_shader> get_pixel_shader() const noexcept;
             virtual ref<constant_buffer> get_per_object_buffer() const noexcept;
 
+            /**
+             * @brief Récupère la texture échantillonnée par l'objet, utilisée pour trier les appels de dessin.
+             */
+            virtual ref<texture> get_texture() const noexcept;
+
             virtual void set_vertex_buffer(const ref<vertex_buffer> &buffer) noexcept;
             virtual void set_vertex_shader(const ref<vertex_shader> &shader) noexcept;
             virtual void set_pixel_shader(const ref<pixel_shader> &shader) noexcept;
             virtual void set_per_object_buffer(const ref<constant_buffer> &buffer) noexcept;
 
+            /**
+             * @brief Remplace la texture échantillonnée par l'objet. Sans effet pour les objets non texturés.
+             */
+            virtual void set_texture(const ref<texture> &tex) noexcept;
+
             virtual fvec3 get_location() const noexcept;
             virtual fvec3 get_rotation() const noexcept;
             virtual fvec3 get_scale() const noexcept;
@@ -48,6 +55,67 @@ namespace deep
             virtual void set_rotation(const fvec3 &rotation) noexcept;
             virtual void set_scale(const fvec3 &scale) noexcept;
 
+            /**
+             * @brief Récupère la matrice monde, recalculée seulement si la position, la rotation ou l'échelle a changé.
+             */
+            const fmat4 &get_world() noexcept;
+
+            /**
+             * @brief Compteur incrémenté à chaque modification de la transformation.
+             *
+             * Permet aux traitements ultérieurs de savoir si l'objet a bougé depuis leur dernier passage.
+             */
+            uint64 get_transform_version() const noexcept;
+
+            /**
+             * @brief Indique que les positions du buffer de sommets sont quantifiées dans la boîte donnée.
+             */
+            void set_vertex_dequantization(const vertex_dequantization &dequantization) noexcept;
+
+            /**
+             * @brief Récupère la matrice appliquée aux positions du buffer de sommets.
+             *
+             * Il s'agit de la matrice monde, précédée de la déquantification des positions lorsqu'elles sont quantifiées.
+             */
+            const fmat4 &get_vertex_world() noexcept;
+
+            /**
+             * @brief Définit la boîte englobante de la géométrie, dans l'espace de l'objet.
+             */
+            void set_local_bounds(const fvec3 &min, const fvec3 &max) noexcept;
+
+            /**
+             * @brief Calcule la boîte englobante alignée sur les axes du monde.
+             * @return false si l'objet n'a pas de boîte englobante et ne doit jamais être éliminé.
+             */
+            virtual bool get_world_bounds(fvec3 &center, fvec3 &extents) noexcept;
+
+            /**
+             * @brief Récupère la boîte englobante dans l'espace de l'objet.
+             * @return false si l'objet n'a pas de boîte englobante.
+             */
+            bool get_local_bounds(fvec3 &center, fvec3 &extents) const noexcept;
+
+            /**
+             * @brief Désigne l'objet comme occultant pour l'élimination des objets cachés.
+             *
+             * La boîte locale, transformée par la matrice monde, est rastérisée comme un volume plein :
+             * seuls les objets qui remplissent leur boîte, comme les cubes et les plans, doivent être désignés.
+             */
+            void set_occluder(bool occluder) noexcept;
+            virtual bool is_occluder() const noexcept;
+
+          protected:
+            void invalidate_world() noexcept;
+
+            /**
+             * @brief Envoie les constantes par objet au slot 1 du vertex shader.
+             *
+             * Les constantes sont écrites dans l'anneau de l'image lorsque le contexte en possède un,
+             * sinon dans le buffer par objet.
+             */
+            void upload_per_object(device_context &dc, const void *data, uint32 bytes_size) noexcept;
+
           protected:
             ref<vertex_buffer> m_vertex_buffer;
             ref<vertex_shader> m_vertex_shader;
@@ -58,6 +126,22 @@ namespace deep
             DEEP_FVEC3(m_rotation)
             DEEP_FVEC3(m_scale)
 
+            DEEP_FMAT4(m_world)
+            bool m_world_dirty         = true;
+            uint64 m_transform_version = 0;
+
+            DEEP_FVEC3(m_local_center)
+            DEEP_FVEC3(m_local_extents)
+            bool m_has_bounds = false;
+            bool m_occluder   = false;
+
+            vertex_dequantization m_dequantization;
+            bool m_quantized = false;
+
+            DEEP_FMAT4(m_vertex_world)
+            uint64 m_vertex_world_version = 0;
+            bool m_vertex_world_dirty     = true;
+
           protected:
             using object::object;
         };
@@ -7,11 +7,13 @@
 #include <DeepLib/maths/vec.hpp>
 #include <DeepLib/maths/math.hpp>
 
+#include <vector>
+
 namespace deep
 {
     namespace D3D
     {
-        ref<triangle> drawable_factory::create_triangle(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<triangle> drawable_factory::create_triangle(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, device_handle device) noexcept
         {
             struct vertex
             {
@@ -46,7 +48,7 @@ namespace deep
             return ref<triangle>(context, tr);
         }
 
-        ref<rectangle> drawable_factory::create_rectangle(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<rectangle> drawable_factory::create_rectangle(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, device_handle device) noexcept
         {
             struct vertex
             {
@@ -86,7 +88,7 @@ namespace deep
             return ref<rectangle>(context, rect);
         }
 
-        ref<cube> drawable_factory::create_cube(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, const fvec3 &position, const fvec3 &rotation, const fvec3 &scale, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<cube> drawable_factory::create_cube(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, const fvec3 &position, const fvec3 &rotation, const fvec3 &scale, device_handle device, vertex_compression compression) noexcept
         {
             struct vertex
             {
@@ -189,12 +191,14 @@ namespace deep
                 projection * model
             };
 
-            c->m_vertex_buffer     = resource_factory::create_vertex_buffer(context, vertices, sizeof(vertices), sizeof(vertex), device);
+            c->m_vertex_buffer     = create_vertices(context, *c, vertices, sizeof(vertices) / sizeof(vertex), { false, false, compression }, device);
             c->m_per_object_buffer = resource_factory::create_constant_buffer(context, &pob, sizeof(pob), device);
             c->m_color_buffer      = resource_factory::create_constant_buffer(context, &colors, sizeof(colors), device);
             c->m_vertex_shader     = vs;
             c->m_pixel_shader      = ps;
 
+            c->set_local_bounds(fvec3(-1.0f, -1.0f, -1.0f), fvec3(1.0f, 1.0f, 1.0f));
+
             c->m_location = position;
             c->m_rotation = rotation;
             c->m_scale    = scale;
@@ -202,7 +206,7 @@ namespace deep
             return ref<cube>(context, c);
         }
 
-        ref<textured_cube> drawable_factory::create_textured_cube(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, const fvec3 &position, const fvec3 &rotation, const fvec3 &scale, const ref<texture> &tex, const ref<sampler> &samp, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<textured_cube> drawable_factory::create_textured_cube(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, const fvec3 &position, const fvec3 &rotation, const fvec3 &scale, const ref<texture> &tex, const ref<sampler> &samp, device_handle device, vertex_compression compression) noexcept
         {
             struct vertex
             {
@@ -293,11 +297,13 @@ namespace deep
                 projection * model
             };
 
-            c->m_vertex_buffer     = resource_factory::create_vertex_buffer(context, vertices, sizeof(vertices), sizeof(vertex), device);
+            c->m_vertex_buffer     = create_vertices(context, *c, vertices, sizeof(vertices) / sizeof(vertex), { true, false, compression }, device);
             c->m_per_object_buffer = resource_factory::create_constant_buffer(context, &pob, sizeof(pob), device);
             c->m_vertex_shader     = vs;
             c->m_pixel_shader      = ps;
 
+            c->set_local_bounds(fvec3(-1.0f, -1.0f, -1.0f), fvec3(1.0f, 1.0f, 1.0f));
+
             c->m_location = position;
             c->m_rotation = rotation;
             c->m_scale    = fvec3(1.0f, 1.0f, 1.0f);
@@ -305,7 +311,7 @@ namespace deep
             return ref<textured_cube>(context, c);
         }
 
-        ref<plane> drawable_factory::create_plane(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, const fvec3 &position, const fvec3 &rotation, const fvec3 &scale, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<plane> drawable_factory::create_plane(const ref<ctx> &context, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, const fvec3 &position, const fvec3 &rotation, const fvec3 &scale, device_handle device, vertex_compression compression) noexcept
         {
             struct vertex
             {
@@ -359,12 +365,14 @@ namespace deep
                 projection * model
             };
 
-            p->m_vertex_buffer     = resource_factory::create_vertex_buffer(context, vertices, sizeof(vertices), sizeof(vertex), device);
+            p->m_vertex_buffer     = create_vertices(context, *p, vertices, sizeof(vertices) / sizeof(vertex), { false, false, compression }, device);
             p->m_per_object_buffer = resource_factory::create_constant_buffer(context, &pob, sizeof(pob), device);
             p->m_color_buffer      = resource_factory::create_constant_buffer(context, &colors, sizeof(colors), device);
             p->m_vertex_shader     = vs;
             p->m_pixel_shader      = ps;
 
+            p->set_local_bounds(fvec3(-1.0f, 1.0f, -1.0f), fvec3(1.0f, 1.0f, 1.0f));
+
             p->m_location = position;
             p->m_rotation = rotation;
             p->m_scale    = fvec3(1.0f, 1.0f, 1.0f);
@@ -372,7 +380,7 @@ namespace deep
             return ref<plane>(context, p);
         }
 
-        ref<cube> drawable_factory::from(const ref<ctx> &context, ref<cube> &from_cube, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, const fvec3 &position, const fvec3 &rotation, const fvec3 &scale, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<cube> drawable_factory::from(const ref<ctx> &context, ref<cube> &from_cube, const ref<vertex_shader> &vs, const ref<pixel_shader> &ps, const fvec3 &position, const fvec3 &rotation, const fvec3 &scale, device_handle device) noexcept
         {
             if (!from_cube.is_valid())
             {
@@ -404,6 +412,10 @@ namespace deep
             c->m_color_buffer      = from_cube->m_color_buffer;
             c->m_vertex_shader     = vs;
             c->m_pixel_shader      = ps;
+            c->m_dequantization    = from_cube->m_dequantization;
+            c->m_quantized         = from_cube->m_quantized;
+
+            c->set_local_bounds(fvec3(-1.0f, -1.0f, -1.0f), fvec3(1.0f, 1.0f, 1.0f));
 
             c->m_location = position;
             c->m_rotation = rotation;
@@ -419,7 +431,7 @@ namespace deep
                                           const fvec3 &position,
                                           const fvec3 &rotation,
                                           const fvec3 &scale,
-                                          Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+                                          device_handle device) noexcept
         {
             if (!from_plane.is_valid())
             {
@@ -451,6 +463,10 @@ namespace deep
             p->m_color_buffer      = from_plane->m_color_buffer;
             p->m_vertex_shader     = vs;
             p->m_pixel_shader      = ps;
+            p->m_dequantization    = from_plane->m_dequantization;
+            p->m_quantized         = from_plane->m_quantized;
+
+            p->set_local_bounds(fvec3(-1.0f, 1.0f, -1.0f), fvec3(1.0f, 1.0f, 1.0f));
 
             p->m_location = position;
             p->m_rotation = rotation;
@@ -458,5 +474,123 @@ namespace deep
 
             return ref<plane>(context, p);
         }
+
+        ref<instanced_drawable> drawable_factory::create_instanced(const ref<ctx> &context,
+                                                                   const ref<cube> &from_cube,
+                                                                   const ref<vertex_shader> &vs,
+                                                                   const ref<pixel_shader> &ps,
+                                                                   device_handle device) noexcept
+        {
+            if (!from_cube.is_valid())
+            {
+                return ref<instanced_drawable>();
+            }
+
+            ref<instanced_drawable> group = create_instanced(context, from_cube->m_vertex_buffer, from_cube->m_color_buffer, vs, ps, device);
+
+            if (group.is_valid() && from_cube->m_has_bounds)
+            {
+                group->m_local_center  = from_cube->m_local_center;
+                group->m_local_extents = from_cube->m_local_extents;
+                group->m_has_bounds    = true;
+            }
+
+            if (group.is_valid())
+            {
+                group->m_dequantization = from_cube->m_dequantization;
+                group->m_quantized      = from_cube->m_quantized;
+            }
+
+            return group;
+        }
+
+        ref<instanced_drawable> drawable_factory::create_instanced(const ref<ctx> &context,
+                                                                   const ref<plane> &from_plane,
+                                                                   const ref<vertex_shader> &vs,
+                                                                   const ref<pixel_shader> &ps,
+                                                                   device_handle device) noexcept
+        {
+            if (!from_plane.is_valid())
+            {
+                return ref<instanced_drawable>();
+            }
+
+            ref<instanced_drawable> group = create_instanced(context, from_plane->m_vertex_buffer, from_plane->m_color_buffer, vs, ps, device);
+
+            if (group.is_valid() && from_plane->m_has_bounds)
+            {
+                group->m_local_center  = from_plane->m_local_center;
+                group->m_local_extents = from_plane->m_local_extents;
+                group->m_has_bounds    = true;
+            }
+
+            if (group.is_valid())
+            {
+                group->m_dequantization = from_plane->m_dequantization;
+                group->m_quantized      = from_plane->m_quantized;
+            }
+
+            return group;
+        }
+
+        ref<vertex_buffer> drawable_factory::create_vertices(const ref<ctx> &context,
+                                                             drawable &target,
+                                                             const void *vertices,
+                                                             uint32 vertex_count,
+                                                             const vertex_format &format,
+                                                             device_handle device) noexcept
+        {
+            if (format.compression == vertex_compression::None)
+            {
+                return resource_factory::create_vertex_buffer(context, vertices, vertex_count, format, device);
+            }
+
+            fvec3 min;
+            fvec3 max;
+
+            vertex_quantizer::compute_bounds(format, vertices, vertex_count, min, max);
+
+            std::vector<uint8> quantized(static_cast<usize>(vertex_count) * vertex_quantizer::get_stride(format));
+            vertex_quantizer::quantize(format, vertices, vertex_count, min, max, quantized.data());
+
+            target.set_vertex_dequantization(vertex_quantizer::get_dequantization(min, max));
+
+            return resource_factory::create_vertex_buffer(context, quantized.data(), vertex_count, format, device);
+        }
+
+        ref<instanced_drawable> drawable_factory::create_instanced(const ref<ctx> &context,
+                                                                   const ref<vertex_buffer> &vb,
+                                                                   const ref<constant_buffer> &colors,
+                                                                   const ref<vertex_shader> &vs,
+                                                                   const ref<pixel_shader> &ps,
+                                                                   device_handle device) noexcept
+        {
+            if (!vb.is_valid() || vb->get_stride() == 0)
+            {
+                return ref<instanced_drawable>();
+            }
+
+            instanced_drawable *group = mem::alloc_type<instanced_drawable>(context.get(), context);
+
+            if (group == nullptr)
+            {
+                return ref<instanced_drawable>();
+            }
+
+            const per_object_buffer pob = {
+                fmat4()
+            };
+
+            group->m_vertex_buffer     = vb;
+            group->m_vertex_count      = vb->get_bytes_size() / vb->get_stride();
+            group->m_per_object_buffer = resource_factory::create_constant_buffer(context, &pob, sizeof(pob), device);
+            group->m_color_buffer      = colors;
+            group->m_vertex_shader     = vs;
+            group->m_pixel_shader      = ps;
+
+            group->m_scale = fvec3(1.0f, 1.0f, 1.0f);
+
+            return ref<instanced_drawable>(context, group);
+        }
     } // namespace D3D
 } // namespace deep
@@ -10,6 +10,9 @@
 #include "D3D/drawable/cube.hpp"
 #include "D3D/drawable/textured_cube.hpp"
 #include "D3D/drawable/plane.hpp"
+#include "D3D/drawable/instanced_drawable.hpp"
+#include "D3D/vertex_quantization.hpp"
+#include "D3D/device_handle.hpp"
 
 #include <DeepLib/memory/ref_counted.hpp>
 #include <DeepLib/maths/vec.hpp>
@@ -24,20 +27,25 @@ namespace deep
             static ref<triangle> create_triangle(const ref<ctx> &context,
                                                  const ref<vertex_shader> &vs,
                                                  const ref<pixel_shader> &ps,
-                                                 Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
+                                                 device_handle device) noexcept;
 
             static ref<rectangle> create_rectangle(const ref<ctx> &context,
                                                    const ref<vertex_shader> &vs,
                                                    const ref<pixel_shader> &ps,
-                                                   Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
+                                                   device_handle device) noexcept;
 
+            /**
+             * @param compression Format des sommets, qui doit correspondre à l'input layout du vertex shader
+             * (vertex_quantizer::get_input_layout).
+             */
             static ref<cube> create_cube(const ref<ctx> &context,
                                          const ref<vertex_shader> &vs,
                                          const ref<pixel_shader> &ps,
                                          const fvec3 &position,
                                          const fvec3 &rotation,
                                          const fvec3 &scale,
-                                         Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
+                                         device_handle device,
+                                         vertex_compression compression = vertex_compression::None) noexcept;
 
             static ref<textured_cube> create_textured_cube(const ref<ctx> &context,
                                                            const ref<vertex_shader> &vs,
@@ -47,7 +55,8 @@ namespace deep
                                                            const fvec3 &scale,
                                                            const ref<texture> &tex,
                                                            const ref<sampler> &samp,
-                                                           Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
+                                                           device_handle device,
+                                                           vertex_compression compression = vertex_compression::None) noexcept;
 
             static ref<plane> create_plane(const ref<ctx> &context,
                                            const ref<vertex_shader> &vs,
@@ -55,7 +64,8 @@ namespace deep
                                            const fvec3 &position,
                                            const fvec3 &rotation,
                                            const fvec3 &scale,
-                                           Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
+                                           device_handle device,
+                                           vertex_compression compression = vertex_compression::None) noexcept;
 
             static ref<cube> from(const ref<ctx> &context,
                                   ref<cube> &from_cube,
@@ -64,7 +74,7 @@ namespace deep
                                   const fvec3 &position,
                                   const fvec3 &rotation,
                                   const fvec3 &scale,
-                                  Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
+                                  device_handle device) noexcept;
 
             static ref<plane> from(const ref<ctx> &context,
                                    ref<plane> &from_plane,
@@ -73,7 +83,42 @@ namespace deep
                                    const fvec3 &position,
                                    const fvec3 &rotation,
                                    const fvec3 &scale,
-                                   Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
+                                   device_handle device) noexcept;
+
+            /**
+             * @brief Crée un groupe d'instances vide reprenant la géométrie et les couleurs d'un cube.
+             * @param vs Un vertex shader lisant la matrice monde depuis le buffer d'instances.
+             */
+            static ref<instanced_drawable> create_instanced(const ref<ctx> &context,
+                                                            const ref<cube> &from_cube,
+                                                            const ref<vertex_shader> &vs,
+                                                            const ref<pixel_shader> &ps,
+                                                            device_handle device) noexcept;
+
+            static ref<instanced_drawable> create_instanced(const ref<ctx> &context,
+                                                            const ref<plane> &from_plane,
+                                                            const ref<vertex_shader> &vs,
+                                                            const ref<pixel_shader> &ps,
+                                                            device_handle device) noexcept;
+
+          private:
+            /**
+             * @brief Crée le buffer de sommets d'un objet, en quantifiant les sommets si le format le demande.
+             * @param vertices Sommets non compressés.
+             */
+            static ref<vertex_buffer> create_vertices(const ref<ctx> &context,
+                                                      drawable &target,
+                                                      const void *vertices,
+                                                      uint32 vertex_count,
+                                                      const vertex_format &format,
+                                                      device_handle device) noexcept;
+
+            static ref<instanced_drawable> create_instanced(const ref<ctx> &context,
+                                                            const ref<vertex_buffer> &vb,
+                                                            const ref<constant_buffer> &colors,
+                                                            const ref<vertex_shader> &vs,
+                                                            const ref<pixel_shader> &ps,
+                                                            device_handle device) noexcept;
         };
     } // namespace D3D
 } // namespace deep
@@ -0,0 +1,229 @@
+#include "D3D/drawable/instanced_drawable.hpp"
+#include "D3D/buffer/per_object_buffer.hpp"
+#include "D3D/resource_factory.hpp"
+#include "D3D/transform.hpp"
+
+#include <DeepLib/memory/memory.hpp>
+
+#include <cmath>
+#include <cstring>
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace
+        {
+            // Minimum puis maximum de la boîte monde d'une instance.
+            constexpr uint32 instance_bounds_size = 6;
+        } // namespace
+
+        instanced_drawable::~instanced_drawable() noexcept
+        {
+            if (m_instances != nullptr)
+            {
+                mem::dealloc(get_context_ptr(), m_instances);
+            }
+
+            if (m_instance_bounds != nullptr)
+            {
+                mem::dealloc(get_context_ptr(), m_instance_bounds);
+            }
+        }
+
+        void instanced_drawable::draw(device_context &dc, const fmat4 &view_projection)
+        {
+            if (m_instance_count == 0 || !m_instance_buffer.is_valid())
+            {
+                return;
+            }
+
+            dc.bind(m_vertex_shader);
+            dc.bind(m_pixel_shader);
+
+            dc.bind(m_vertex_buffer);
+            dc.bind_instances(m_instance_buffer);
+
+            dc.set_ps_constant_buffer(0, m_color_buffer);
+
+            if (m_instances_dirty)
+            {
+                dc.update(m_instance_buffer, m_instances, m_instance_count * instance_stride);
+
+                m_instances_dirty = false;
+            }
+
+            const per_object_buffer pob = {
+                view_projection
+            };
+
+            upload_per_object(dc, &pob, sizeof(pob));
+
+            dc.set_primitive_topology(primitive_topology::TriangleList);
+
+            dc.draw_instanced(m_vertex_count, m_instance_count, 0, 0);
+        }
+
+        bool instanced_drawable::add_instance(const fvec3 &location, const fvec3 &rotation, const fvec3 &scale, device_handle device) noexcept
+        {
+            if (m_instance_count == m_instance_capacity)
+            {
+                uint32 capacity = m_instance_capacity == 0 ? 64 : m_instance_capacity * 2;
+
+                float *instances = mem::alloc<float>(get_context_ptr(), capacity * instance_stride);
+
+                if (instances == nullptr)
+                {
+                    return false;
+                }
+
+                float *bounds = mem::alloc<float>(get_context_ptr(), capacity * instance_bounds_size);
+
+                if (bounds == nullptr)
+                {
+                    mem::dealloc(get_context_ptr(), instances);
+
+                    return false;
+                }
+
+                ref<vertex_buffer> buffer = resource_factory::create_dynamic_vertex_buffer(get_context(), capacity * instance_stride, instance_stride, device);
+
+                if (!buffer.is_valid())
+                {
+                    mem::dealloc(get_context_ptr(), instances);
+                    mem::dealloc(get_context_ptr(), bounds);
+
+                    return false;
+                }
+
+                if (m_instances != nullptr)
+                {
+                    std::memcpy(instances, m_instances, m_instance_count * instance_stride);
+
+                    mem::dealloc(get_context_ptr(), m_instances);
+                }
+
+                if (m_instance_bounds != nullptr)
+                {
+                    std::memcpy(bounds, m_instance_bounds, m_instance_count * instance_bounds_size * sizeof(float));
+
+                    mem::dealloc(get_context_ptr(), m_instance_bounds);
+                }
+
+                m_instances         = instances;
+                m_instance_bounds   = bounds;
+                m_instance_buffer   = buffer;
+                m_instance_capacity = capacity;
+            }
+
+            m_instance_count++;
+
+            set_instance(m_instance_count - 1, location, rotation, scale);
+
+            return true;
+        }
+
+        void instanced_drawable::set_instance(uint32 index, const fvec3 &location, const fvec3 &rotation, const fvec3 &scale) noexcept
+        {
+            if (index >= m_instance_count)
+            {
+                return;
+            }
+
+            fmat4 model = fmat4();
+            model       = fmat4::translate(model, location);
+            model       = fmat4::rotate_x(model, rotation.x);
+            model       = fmat4::rotate_y(model, rotation.y);
+            model       = fmat4::rotate_z(model, rotation.z);
+            model       = fmat4::scale(model, scale);
+
+            if (m_quantized)
+            {
+                // Le vertex shader lit la matrice de l'instance : la déquantification des positions y est intégrée.
+                fmat4 vertex_world = fmat4::translate(model, m_dequantization.offset);
+                vertex_world       = fmat4::scale(vertex_world, m_dequantization.scale);
+
+                load_matrix(vertex_world, m_instances + index * 16);
+            }
+            else
+            {
+                load_matrix(model, m_instances + index * 16);
+            }
+
+            m_instances_dirty = true;
+
+            if (m_has_bounds)
+            {
+                fvec3 center;
+                fvec3 extents;
+
+                transform_bounds(model, m_local_center, m_local_extents, center, extents);
+
+                float *bounds = m_instance_bounds + index * instance_bounds_size;
+
+                bounds[0] = center.x - extents.x;
+                bounds[1] = center.y - extents.y;
+                bounds[2] = center.z - extents.z;
+                bounds[3] = center.x + extents.x;
+                bounds[4] = center.y + extents.y;
+                bounds[5] = center.z + extents.z;
+
+                // L'instance a pu quitter un bord de la boîte commune : elle est reconstruite à la prochaine lecture.
+                m_bounds_dirty = true;
+
+                m_transform_version++;
+            }
+        }
+
+        void instanced_drawable::clear_instances() noexcept
+        {
+            m_instance_count  = 0;
+            m_instances_dirty = true;
+
+            m_transform_version++;
+        }
+
+        uint32 instanced_drawable::get_instance_count() const noexcept
+        {
+            return m_instance_count;
+        }
+
+        bool instanced_drawable::get_world_bounds(fvec3 &center, fvec3 &extents) noexcept
+        {
+            if (!m_has_bounds || m_instance_count == 0)
+            {
+                return false;
+            }
+
+            if (m_bounds_dirty)
+            {
+                const float *bounds = m_instance_bounds;
+
+                m_instances_min = fvec3(bounds[0], bounds[1], bounds[2]);
+                m_instances_max = fvec3(bounds[3], bounds[4], bounds[5]);
+
+                uint32 index;
+
+                for (index = 1; index < m_instance_count; ++index)
+                {
+                    bounds += instance_bounds_size;
+
+                    m_instances_min = fvec3(std::fmin(m_instances_min.x, bounds[0]), std::fmin(m_instances_min.y, bounds[1]), std::fmin(m_instances_min.z, bounds[2]));
+                    m_instances_max = fvec3(std::fmax(m_instances_max.x, bounds[3]), std::fmax(m_instances_max.y, bounds[4]), std::fmax(m_instances_max.z, bounds[5]));
+                }
+
+                m_bounds_dirty = false;
+            }
+
+            center  = fvec3((m_instances_min.x + m_instances_max.x) * 0.5f, (m_instances_min.y + m_instances_max.y) * 0.5f, (m_instances_min.z + m_instances_max.z) * 0.5f);
+            extents = fvec3((m_instances_max.x - m_instances_min.x) * 0.5f, (m_instances_max.y - m_instances_min.y) * 0.5f, (m_instances_max.z - m_instances_min.z) * 0.5f);
+
+            return true;
+        }
+
+        bool instanced_drawable::is_occluder() const noexcept
+        {
+            return false;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,84 @@
+#ifndef DEEP_ENGINE_D3D_INSTANCED_DRAWABLE_HPP
+#define DEEP_ENGINE_D3D_INSTANCED_DRAWABLE_HPP
+
+#include "deep_d3d_export.h"
+#include "D3D/drawable/drawable.hpp"
+#include "D3D/device_handle.hpp"
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Groupe d'objets partageant la même géométrie et les mêmes shaders, dessinés en un seul appel.
+         *
+         * La matrice monde de chaque instance est stockée dans un buffer d'instances, envoyé au GPU
+         * uniquement lorsqu'une instance est ajoutée ou modifiée. Le buffer par objet ne contient
+         * que la matrice vue-projection.
+         */
+        class DEEP_D3D_API instanced_drawable : public drawable
+        {
+          public:
+            /**
+             * @brief Taille en octets des données d'une instance : sa matrice monde.
+             */
+            static constexpr uint32 instance_stride = sizeof(float) * 16;
+
+          public:
+            ~instanced_drawable() noexcept;
+
+            virtual void draw(device_context &dc, const fmat4 &view_projection) override;
+
+            /**
+             * @brief Ajoute une instance au groupe.
+             * @param device Le périphérique utilisé pour agrandir le buffer d'instances si nécessaire.
+             */
+            bool add_instance(const fvec3 &location, const fvec3 &rotation, const fvec3 &scale, device_handle device) noexcept;
+            void set_instance(uint32 index, const fvec3 &location, const fvec3 &rotation, const fvec3 &scale) noexcept;
+
+            /**
+             * @brief Retire toutes les instances, en gardant le buffer pour celles ajoutées ensuite.
+             */
+            void clear_instances() noexcept;
+
+            uint32 get_instance_count() const noexcept;
+
+            /**
+             * @brief Boîte englobant toutes les instances.
+             * @remarks La boîte est reconstruite à partir des boîtes des instances après un déplacement.
+             */
+            virtual bool get_world_bounds(fvec3 &center, fvec3 &extents) noexcept override;
+
+            /**
+             * @brief La boîte commune aux instances n'est pas pleine : un groupe d'instances n'est jamais occultant.
+             */
+            virtual bool is_occluder() const noexcept override;
+
+          protected:
+            ref<constant_buffer> m_color_buffer;
+            ref<vertex_buffer> m_instance_buffer;
+
+            // Matrices monde des instances, conservées pour reconstruire le buffer lorsqu'il est agrandi.
+            float *m_instances         = nullptr;
+            uint32 m_instance_count    = 0;
+            uint32 m_instance_capacity = 0;
+            uint32 m_vertex_count      = 0;
+            bool m_instances_dirty     = false;
+
+            // Boîte monde de chaque instance (minimum puis maximum), pour reconstruire la boîte commune.
+            float *m_instance_bounds   = nullptr;
+            bool m_bounds_dirty        = false;
+
+            DEEP_FVEC3(m_instances_min)
+            DEEP_FVEC3(m_instances_max)
+
+          protected:
+            using drawable::drawable;
+
+          public:
+            friend class drawable_factory;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -1,5 +1,8 @@
 #include "D3D/drawable/mesh.hpp"
 #include "D3D/buffer/per_object_buffer.hpp"
+#include "D3D/transform.hpp"
+
+#include <cmath>
 
 namespace deep
 {
@@ -7,30 +10,102 @@ namespace deep
     {
         void mesh::draw(device_context &dc, const fmat4 &view_projection)
         {
+            m_last_lod = select_lod(view_projection);
+
+            const ref<index_buffer> &indices = m_last_lod == 0 ? m_index_buffer : m_lod_index_buffers[m_last_lod - 1];
+
             dc.bind(m_vertex_shader);
             dc.bind(m_pixel_shader);
 
             dc.bind(m_vertex_buffer);
-            dc.bind(m_index_buffer);
-
-            dc.get()->VSSetConstantBuffers(1, 1, m_per_object_buffer->get_address());
-
-            fmat4 model = fmat4();
-            model       = fmat4::translate(model, m_location);
-            model       = fmat4::rotate_x(model, m_rotation.x);
-            model       = fmat4::rotate_y(model, m_rotation.y);
-            model       = fmat4::rotate_z(model, m_rotation.z);
-            model       = fmat4::scale(model, m_scale);
+            dc.bind(indices);
 
             const per_object_buffer pob = {
-                view_projection * model
+                view_projection * get_vertex_world()
             };
 
-            m_per_object_buffer->update(&pob, dc);
+            upload_per_object(dc, &pob, sizeof(pob));
+
+            dc.set_primitive_topology(primitive_topology::TriangleList);
+
+            dc.draw_indexed(indices->count(), 0, 0);
+        }
+
+        void mesh::set_index_buffer(const ref<index_buffer> &buffer) noexcept
+        {
+            m_index_buffer = buffer;
+        }
+
+        bool mesh::add_lod(const ref<index_buffer> &buffer, float error) noexcept
+        {
+            if (m_lod_count >= max_lod_count || !buffer.is_valid())
+            {
+                return false;
+            }
+
+            m_lod_index_buffers[m_lod_count - 1] = buffer;
+            m_lod_errors[m_lod_count - 1]        = error;
+            m_lod_count++;
+
+            return true;
+        }
+
+        uint32 mesh::get_lod_count() const noexcept
+        {
+            return m_lod_count;
+        }
+
+        uint32 mesh::get_last_lod() const noexcept
+        {
+            return m_last_lod;
+        }
+
+        void mesh::set_lod_threshold(float threshold) noexcept
+        {
+            m_lod_threshold = threshold;
+        }
+
+        float mesh::get_lod_threshold() const noexcept
+        {
+            return m_lod_threshold;
+        }
+
+        uint32 mesh::select_lod(const fmat4 &view_projection) const noexcept
+        {
+            if (m_lod_count == 1)
+            {
+                return 0;
+            }
+
+            const float w = transform_point(view_projection, get_location()).w;
+
+            // Objet traversant le plan proche : toujours au niveau complet.
+            if (w <= 0.0f)
+            {
+                return 0;
+            }
+
+            float e[16];
+            load_matrix(view_projection, e);
+
+            // Agrandissement vertical d'une longueur du monde, en coordonnées de découpage.
+            const float projection_y = std::sqrt(e[4] * e[4] + e[5] * e[5] + e[6] * e[6]);
+            const float scale        = std::fmax(std::fabs(m_scale.x), std::fmax(std::fabs(m_scale.y), std::fabs(m_scale.z)));
+
+            // L'écran couvre 2 unités en coordonnées normalisées : l'erreur est ramenée à une fraction de sa hauteur.
+            const float factor = scale * projection_y / (2.0f * w);
+
+            uint32 lod;
 
-            dc.get()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            for (lod = m_lod_count - 1; lod > 0; --lod)
+            {
+                if (m_lod_errors[lod - 1] * factor <= m_lod_threshold)
+                {
+                    return lod;
+                }
+            }
 
-            dc.get()->DrawIndexed(m_index_buffer->count(), 0, 0);
+            return 0;
         }
     } // namespace D3D
 } // namespace deep
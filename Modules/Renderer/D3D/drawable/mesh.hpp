@@ -11,14 +11,64 @@ namespace deep
 {
     namespace D3D
     {
+        /**
+         * @brief Maillage indexé, avec une chaîne optionnelle de niveaux de détail.
+         *
+         * Les niveaux de détail ne sont que des buffers d'indices plus courts sur le même buffer de sommets.
+         * À chaque dessin, le niveau le plus grossier dont l'erreur géométrique projetée à l'écran
+         * reste sous le seuil est choisi.
+         */
         class DEEP_D3D_API mesh : public drawable
         {
+          public:
+            // Niveau complet compris.
+            static constexpr uint32 max_lod_count = 4;
+
+            // Erreur tolérée en fraction de la hauteur de l'écran : environ 2 pixels en 1080p.
+            static constexpr float default_lod_threshold = 1.0f / 540.0f;
+
           public:
             virtual void draw(device_context &dc, const fmat4 &view_projection) override;
 
+            void set_index_buffer(const ref<index_buffer> &buffer) noexcept;
+
+            /**
+             * @brief Ajoute un niveau de détail plus grossier que le dernier ajouté.
+             * @param error L'erreur géométrique du niveau par rapport au maillage complet, en unités de l'objet.
+             * @return false si la chaîne est pleine.
+             */
+            bool add_lod(const ref<index_buffer> &buffer, float error) noexcept;
+
+            /**
+             * @brief Nombre de niveaux de détail, maillage complet compris.
+             */
+            uint32 get_lod_count() const noexcept;
+
+            /**
+             * @brief Niveau de détail utilisé lors du dernier dessin, 0 pour le maillage complet.
+             */
+            uint32 get_last_lod() const noexcept;
+
+            /**
+             * @brief Définit l'erreur tolérée, en fraction de la hauteur de l'écran.
+             */
+            void set_lod_threshold(float threshold) noexcept;
+            float get_lod_threshold() const noexcept;
+
+            /**
+             * @brief Choisit le niveau de détail à utiliser pour une matrice vue-projection.
+             */
+            uint32 select_lod(const fmat4 &view_projection) const noexcept;
+
           protected:
             DEEP_REF(index_buffer, m_index_buffer)
 
+            ref<index_buffer> m_lod_index_buffers[max_lod_count - 1];
+            float m_lod_errors[max_lod_count - 1] = {};
+            uint32 m_lod_count                    = 1;
+            uint32 m_last_lod                     = 0;
+            float m_lod_threshold                 = default_lod_threshold;
+
           protected:
             using drawable::drawable;
 
@@ -12,25 +12,17 @@ namespace deep
 
             dc.bind(m_vertex_buffer);
 
-            dc.get()->VSSetConstantBuffers(1, 1, m_per_object_buffer->get_address());
-            dc.get()->PSSetConstantBuffers(0, 1, m_color_buffer->get_address());
-
-            fmat4 model = fmat4();
-            model       = fmat4::translate(model, m_location);
-            model       = fmat4::rotate_x(model, m_rotation.x);
-            model       = fmat4::rotate_y(model, m_rotation.y);
-            model       = fmat4::rotate_z(model, m_rotation.z);
-            model       = fmat4::scale(model, m_scale);
+            dc.set_ps_constant_buffer(0, m_color_buffer);
 
             const per_object_buffer pob = {
-                view_projection * model
+                view_projection * get_vertex_world()
             };
 
-            m_per_object_buffer->update(&pob, dc);
+            upload_per_object(dc, &pob, sizeof(pob));
 
-            dc.get()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            dc.set_primitive_topology(primitive_topology::TriangleList);
 
-            dc.get()->Draw(6, 0);
+            dc.draw(6, 0);
         }
     } // namespace D3D
 } // namespace deep
@@ -9,9 +9,9 @@ namespace deep
             dc.bind(m_vertex_shader);
             dc.bind(m_pixel_shader);
 
-            dc.get()->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+            dc.set_primitive_topology(primitive_topology::TriangleList);
 
-            dc.get()->Draw(6, 0);
+            dc.draw(6, 0);
         }
     } // namespace D3D
 } // namespace deep
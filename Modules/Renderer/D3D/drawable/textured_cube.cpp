@@ -12,27 +12,28 @@ namespace deep
 
             dc.bind(m_vertex_buffer);
 
-            dc.get()->VSSetConstantBuffers(1, 1, m_per_object_buffer->get_address());
-
             dc.bind(m_texture);
             dc.bind(m_sampler);
 
-            fmat4 model = fmat4();
-            model       = fmat4::translate(model, m_location);
-            model       = fmat4::rotate_x(model, m_rotation.x);
-            model       = fmat4::rotate_y(model, m_rotation.y);
-            model       = fmat4::rotate_z(model, m_rotation.z);
-            model       = fmat4::scale(model, m_scale);
-
             const per_object_buffer pob = {
-                view_projection * model
+                view_projection * get_vertex_world()
             };
 
-            m_per_object_buffer->update(&pob, dc);
+            upload_per_object(dc, &pob, sizeof(pob));
+
+            dc.set_primitive_topology(primitive_topology::TriangleList);
+
+            dc.draw(6 * 6, 0);
+        }
 
-            dc.get()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        ref<texture> textured_cube::get_texture() const noexcept
+        {
+            return m_texture;
+        }
 
-            dc.get()->Draw(6 * 6, 0);
+        void textured_cube::set_texture(const ref<texture> &tex) noexcept
+        {
+            m_texture = tex;
         }
     } // namespace D3D
 } // namespace deep
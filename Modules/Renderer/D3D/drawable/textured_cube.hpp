@@ -15,6 +15,9 @@ namespace deep
           public:
             virtual void draw(device_context &dc, const fmat4 &view_projection) override;
 
+            virtual ref<texture> get_texture() const noexcept override;
+            virtual void set_texture(const ref<texture> &tex) noexcept override;
+
           protected:
             DEEP_REF(texture, m_texture)
             DEEP_REF(sampler, m_sampler)
@@ -1,5 +1,6 @@
 #include "D3D/graphics.hpp"
 #include "D3D/error.hpp"
+#include "D3D/native_d3d11.hpp"
 #include "D3D/resource_factory.hpp"
 #include "D3D/shader/shader_factory.hpp"
 #include "D3D/buffer/per_frame_buffer.hpp"
@@ -18,13 +19,11 @@ namespace deep
     namespace D3D
     {
         graphics::graphics(const ref<ctx> &context, window_handle win) noexcept
-                : object(context),
-                  m_background_color(),
+                : renderer(context),
                   m_window_handle(win),
                   m_device(nullptr),
                   m_swap_chain(nullptr),
-                  m_back_buffer_view(nullptr),
-                  m_drawables(context)
+                  m_back_buffer_view(nullptr)
         {
         }
 
@@ -115,17 +114,6 @@ namespace deep
                                   &graph->m_back_buffer_mirror_view),
                           context, graph->m_device)
 
-            D3D11_DEPTH_STENCIL_DESC ds_desc = {};
-            ds_desc.DepthEnable              = TRUE;
-            ds_desc.DepthWriteMask           = D3D11_DEPTH_WRITE_MASK_ALL;
-            ds_desc.DepthFunc                = D3D11_COMPARISON_LESS;
-
-            wrl::ComPtr<ID3D11DepthStencilState> ds_state;
-
-            DEEP_DX_CHECK(graph->m_device->CreateDepthStencilState(&ds_desc, &ds_state), context, graph->m_device)
-
-            graph->m_device_context.get()->OMSetDepthStencilState(ds_state.Get(), 1);
-
             D3D11_TEXTURE2D_DESC depth_stencil_texture_desc = { 0 };
             depth_stencil_texture_desc.Width                = static_cast<UINT>(width);
             depth_stencil_texture_desc.Height               = static_cast<UINT>(height);
@@ -161,24 +149,12 @@ namespace deep
 
             graph->m_device_context.get()->RSSetViewports(1, &vp);
 
-            D3D11_RASTERIZER_DESC raster_desc = {};
-            raster_desc.FillMode              = D3D11_FILL_SOLID;
-            raster_desc.CullMode              = D3D11_CULL_BACK;
-            raster_desc.FrontCounterClockwise = false;
-
-            graph->m_device->CreateRasterizerState(&raster_desc, &graph->m_device_context.m_rasterizer_state_cull_back_solid);
-
-            raster_desc.FillMode = D3D11_FILL_WIREFRAME;
-            graph->m_device->CreateRasterizerState(&raster_desc, &graph->m_device_context.m_rasterizer_state_cull_back_wireframe);
-
-            raster_desc.FillMode = D3D11_FILL_SOLID;
-            raster_desc.CullMode = D3D11_CULL_FRONT;
-            graph->m_device->CreateRasterizerState(&raster_desc, &graph->m_device_context.m_rasterizer_state_cull_front_solid);
-
-            raster_desc.FillMode = D3D11_FILL_WIREFRAME;
-            graph->m_device->CreateRasterizerState(&raster_desc, &graph->m_device_context.m_rasterizer_state_cull_front_wireframe);
+            if (!graph->init_pipeline_states(graph->get_device()))
+            {
+                mem::dealloc_type(context.get_memory_manager(), graph);
 
-            graph->m_device_context.set_rasterizer_state(rasterizer_state::CullBackSolid);
+                return ref<graphics>();
+            }
 
             fmat4 view;
             view = fmat4::translate(view, initial_location);
@@ -190,7 +166,17 @@ namespace deep
                 projection
             };
 
-            graph->m_per_frame_buffer = resource_factory::create_constant_buffer(context, &pfb, sizeof(pfb), graph->m_device);
+            graph->m_per_frame_buffer = resource_factory::create_constant_buffer(context, &pfb, sizeof(pfb), graph->get_device());
+
+            // Les constantes par objet passent par un anneau lié par décalage, si le matériel le permet.
+            D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+
+            if (SUCCEEDED(graph->m_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+                options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer &&
+                SUCCEEDED(graph->m_device_context.m_device_context->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void **>(&graph->m_device_context.m_device_context1))))
+            {
+                graph->init_constant_ring(graph->get_device());
+            }
 
             if (post_init != nullptr)
             {
@@ -202,6 +188,11 @@ namespace deep
             return ref<graphics>(context, graph);
         }
 
+        renderer_backend graphics::get_backend() const noexcept
+        {
+            return renderer_backend::Direct3D11;
+        }
+
         void graphics::clear_buffer() noexcept
         {
             const float color[] = {
@@ -215,28 +206,12 @@ namespace deep
             m_device_context.get()->ClearDepthStencilView(m_depth_stencil_view.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
         }
 
-        void graphics::add_drawable(const ref<drawable> &dr) noexcept
-        {
-            m_drawables.add(dr);
-        }
-
         void graphics::draw_all(const fmat4 &projection, const fmat4 &view) noexcept
         {
-            usize count = m_drawables.count();
-            usize index;
-
-            m_device_context.get()->VSSetConstantBuffers(0, 1, m_per_frame_buffer->get_address());
-            m_device_context.get()->PSSetConstantBuffers(0, 1, m_per_frame_buffer->get_address());
+            m_device_context.set_vs_constant_buffer(0, m_per_frame_buffer);
+            m_device_context.set_ps_constant_buffer(0, m_per_frame_buffer);
 
-            const fmat4 view_projection = projection * view;
-
-            for (index = 0; index < count; ++index)
-            {
-                if (m_drawables[index].is_valid())
-                {
-                    m_drawables[index]->draw(m_device_context, view_projection);
-                }
-            }
+            submit_drawables(projection * view);
 
             // Copie du backbuffer dans le miroir.
             Microsoft::WRL::ComPtr<ID3D11Resource> mirror_source;
@@ -248,9 +223,11 @@ namespace deep
         void graphics::end_frame() noexcept
         {
             // Affiche l'image finale à l'utilisateur.
-            m_swap_chain->Present(1, 0);
+            m_swap_chain->Present(m_sync_interval, 0);
 
             print_debug_messages();
+
+            finish_frame();
         }
 
         void graphics::print_debug_messages() noexcept
@@ -292,17 +269,12 @@ namespace deep
             }
         }
 
-        fvec4 graphics::get_background_color() const noexcept
+        device_handle graphics::get_device() noexcept
         {
-            return m_background_color;
+            return device_handle(m_device.Get());
         }
 
-        void graphics::set_background_color(const fvec4 &color) noexcept
-        {
-            m_background_color = color;
-        }
-
-        Microsoft::WRL::ComPtr<ID3D11Device> graphics::get_device() noexcept
+        Microsoft::WRL::ComPtr<ID3D11Device> graphics::get_d3d_device() noexcept
         {
             return m_device;
         }
@@ -338,16 +310,6 @@ namespace deep
             return m_back_buffer_mirror_view;
         }
 
-        device_context &graphics::get_device_context() noexcept
-        {
-            return m_device_context;
-        }
-
-        const device_context &graphics::get_device_context() const noexcept
-        {
-            return m_device_context;
-        }
-
         ref<constant_buffer> graphics::get_per_frame_buffer() noexcept
         {
             return m_per_frame_buffer;
@@ -5,12 +5,10 @@
 #include <DeepCore/types.hpp>
 #include <DeepLib/object.hpp>
 #include <DeepLib/memory/memory.hpp>
-#include <DeepLib/collection/array_list.hpp>
 #include <DeepLib/window/window.hpp>
 #include <DeepLib/maths/vec.hpp>
 
-#include "D3D/device_context.hpp"
-#include "D3D/drawable/drawable.hpp"
+#include "D3D/renderer.hpp"
 #include "D3D/resource.hpp"
 #include "D3D/shader/shader.hpp"
 
@@ -30,9 +28,10 @@ namespace deep
         template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11Texture2D>;
         template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11Debug>;
 
-        template class DEEP_D3D_API array_list<ref<drawable>>;
-
-        class DEEP_D3D_API graphics : public object
+        /**
+         * @brief Backend Direct3D 11, disponible uniquement lorsque DeepD3D est compilé avec DEEP_D3D11.
+         */
+        class DEEP_D3D_API graphics : public renderer
         {
           public:
             using post_init_callback = void (*)(graphics *graph);
@@ -45,19 +44,21 @@ namespace deep
 
             static ref<graphics> create(const ref<ctx> &context, window &win, const fvec4 &background_color, const fvec3 &initial_location, post_init_callback post_init = nullptr) noexcept;
 
-            void clear_buffer() noexcept;
+            virtual renderer_backend get_backend() const noexcept override;
 
-            void add_drawable(const ref<drawable> &dr) noexcept;
+            virtual void clear_buffer() noexcept override;
 
-            void draw_all(const fmat4 &projection, const fmat4 &view) noexcept;
+            virtual void draw_all(const fmat4 &projection, const fmat4 &view) noexcept override;
 
-            void end_frame() noexcept;
+            virtual void end_frame() noexcept override;
             void print_debug_messages() noexcept;
 
-            fvec4 get_background_color() const noexcept;
-            void set_background_color(const fvec4 &color) noexcept;
+            virtual device_handle get_device() noexcept override;
 
-            Microsoft::WRL::ComPtr<ID3D11Device> get_device() noexcept;
+            /**
+             * @brief Récupère le périphérique Direct3D 11, par exemple pour initialiser ImGui.
+             */
+            Microsoft::WRL::ComPtr<ID3D11Device> get_d3d_device() noexcept;
             Microsoft::WRL::ComPtr<IDXGISwapChain> get_swap_chain() noexcept;
 
             Microsoft::WRL::ComPtr<ID3D11RenderTargetView> get_back_buffer_view() noexcept;
@@ -66,22 +67,15 @@ namespace deep
             Microsoft::WRL::ComPtr<ID3D11DepthStencilView> get_depth_stencil_view() noexcept;
             Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> get_back_buffer_mirror_view() noexcept;
 
-            device_context &get_device_context() noexcept;
-            const device_context &get_device_context() const noexcept;
-
             ref<constant_buffer> get_per_frame_buffer() noexcept;
 
           protected:
             graphics(const ref<ctx> &context, window_handle win) noexcept;
 
           private:
-            DEEP_FVEC4(m_background_color)
-
             window_handle m_window_handle;
             // Le 'device' permet la création de ressources Direct3D.
             Microsoft::WRL::ComPtr<ID3D11Device> m_device;
-            // La 'device context' permet l'utilisation des ressources créées avec le 'device'.
-            device_context m_device_context;
             Microsoft::WRL::ComPtr<IDXGISwapChain> m_swap_chain;
             Microsoft::WRL::ComPtr<ID3D11RenderTargetView> m_back_buffer_view;
             Microsoft::WRL::ComPtr<ID3D11DepthStencilView> m_depth_stencil_view;
@@ -93,8 +87,6 @@ namespace deep
 
             DEEP_REF(constant_buffer, m_per_frame_buffer)
 
-            array_list<ref<drawable>> m_drawables;
-
           public:
             friend memory_manager;
         };
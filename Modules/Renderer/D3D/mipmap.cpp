@@ -0,0 +1,260 @@
+#include "D3D/mipmap.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <emmintrin.h>
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace
+        {
+            // Résolution de la table d'encodage : assez fine pour retrouver chaque valeur sRGB après décodage.
+            constexpr uint32 encode_table_size = 4096;
+
+            /**
+             * @brief Tables de conversion entre valeurs 8 bits et intensités linéaires.
+             */
+            struct color_tables
+            {
+                float decode[256];
+                uint8 encode[encode_table_size];
+
+                explicit color_tables(bool srgb) noexcept
+                {
+                    uint32 index;
+
+                    for (index = 0; index < 256; ++index)
+                    {
+                        const float value = static_cast<float>(index) / 255.0f;
+
+                        if (!srgb)
+                        {
+                            decode[index] = value;
+                        }
+                        else if (value <= 0.04045f)
+                        {
+                            decode[index] = value / 12.92f;
+                        }
+                        else
+                        {
+                            decode[index] = std::pow((value + 0.055f) / 1.055f, 2.4f);
+                        }
+                    }
+
+                    for (index = 0; index < encode_table_size; ++index)
+                    {
+                        const float value = static_cast<float>(index) / static_cast<float>(encode_table_size - 1);
+                        float encoded;
+
+                        if (!srgb)
+                        {
+                            encoded = value;
+                        }
+                        else if (value <= 0.0031308f)
+                        {
+                            encoded = value * 12.92f;
+                        }
+                        else
+                        {
+                            encoded = 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+                        }
+
+                        encode[index] = static_cast<uint8>(std::min(255.0f, encoded * 255.0f + 0.5f));
+                    }
+                }
+            };
+
+            const color_tables &get_tables(bool srgb) noexcept
+            {
+                static const color_tables srgb_tables(true);
+                static const color_tables linear_tables(false);
+
+                return srgb ? srgb_tables : linear_tables;
+            }
+
+            inline __m128 decode_texel(const uint8 *texel, const color_tables &tables) noexcept
+            {
+                return _mm_setr_ps(tables.decode[texel[0]], tables.decode[texel[1]], tables.decode[texel[2]], static_cast<float>(texel[3]) * (1.0f / 255.0f));
+            }
+
+            inline void encode_texel(__m128 color, const color_tables &tables, uint8 *out) noexcept
+            {
+                const __m128 scale = _mm_setr_ps(static_cast<float>(encode_table_size - 1), static_cast<float>(encode_table_size - 1), static_cast<float>(encode_table_size - 1), 255.0f);
+
+                color = _mm_min_ps(_mm_max_ps(color, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+
+                alignas(16) int32 indices[4];
+                _mm_store_si128(reinterpret_cast<__m128i *>(indices), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(color, scale), _mm_set1_ps(0.5f))));
+
+                out[0] = tables.encode[indices[0]];
+                out[1] = tables.encode[indices[1]];
+                out[2] = tables.encode[indices[2]];
+                out[3] = static_cast<uint8>(indices[3]);
+            }
+
+            /**
+             * @brief Calcule une ligne du niveau 1 à partir des pixels 8 bits du niveau 0.
+             */
+            void downsample_row(const uint8 *pixels, usize row_bytes, uint32 width, uint32 height, uint32 y, uint32 level_width, const color_tables &tables, float *linear, uint8 *out) noexcept
+            {
+                // Une dimension impaire ignore sa dernière ligne ou colonne, une dimension de 1 est répétée.
+                const uint8 *row0   = pixels + static_cast<usize>(std::min(y * 2, height - 1)) * row_bytes;
+                const uint8 *row1   = pixels + static_cast<usize>(std::min(y * 2 + 1, height - 1)) * row_bytes;
+                const __m128 factor = _mm_set1_ps(0.25f);
+                uint32 x;
+
+                for (x = 0; x < level_width; ++x)
+                {
+                    const usize x0 = static_cast<usize>(x * 2) * 4;
+                    const usize x1 = static_cast<usize>(std::min(x * 2 + 1, width - 1)) * 4;
+
+                    __m128 sum = _mm_add_ps(decode_texel(row0 + x0, tables), decode_texel(row0 + x1, tables));
+                    sum        = _mm_add_ps(sum, _mm_add_ps(decode_texel(row1 + x0, tables), decode_texel(row1 + x1, tables)));
+                    sum        = _mm_mul_ps(sum, factor);
+
+                    _mm_storeu_ps(linear + static_cast<usize>(x) * 4, sum);
+                    encode_texel(sum, tables, out + static_cast<usize>(x) * 4);
+                }
+            }
+
+            /**
+             * @brief Calcule une ligne d'un niveau à partir des intensités linéaires du niveau précédent.
+             */
+            void downsample_row(const float *previous, uint32 width, uint32 height, uint32 y, uint32 level_width, const color_tables &tables, float *linear, uint8 *out) noexcept
+            {
+                const float *row0   = previous + static_cast<usize>(std::min(y * 2, height - 1)) * width * 4;
+                const float *row1   = previous + static_cast<usize>(std::min(y * 2 + 1, height - 1)) * width * 4;
+                const __m128 factor = _mm_set1_ps(0.25f);
+                uint32 x;
+
+                for (x = 0; x < level_width; ++x)
+                {
+                    const usize x0 = static_cast<usize>(x * 2) * 4;
+                    const usize x1 = static_cast<usize>(std::min(x * 2 + 1, width - 1)) * 4;
+
+                    __m128 sum = _mm_add_ps(_mm_loadu_ps(row0 + x0), _mm_loadu_ps(row0 + x1));
+                    sum        = _mm_add_ps(sum, _mm_add_ps(_mm_loadu_ps(row1 + x0), _mm_loadu_ps(row1 + x1)));
+                    sum        = _mm_mul_ps(sum, factor);
+
+                    _mm_storeu_ps(linear + static_cast<usize>(x) * 4, sum);
+                    encode_texel(sum, tables, out + static_cast<usize>(x) * 4);
+                }
+            }
+        } // namespace
+
+        uint32 mip_chain::get_level_count(uint32 width, uint32 height) noexcept
+        {
+            uint32 size  = std::max(width, height);
+            uint32 count = 1;
+
+            while (size > 1)
+            {
+                size /= 2;
+                count++;
+            }
+
+            return count;
+        }
+
+        void mip_chain::build(const uint8 *pixels, uint32 width, uint32 height, usize row_bytes, bool srgb, thread_pool *pool)
+        {
+            const color_tables &tables = get_tables(srgb);
+            const uint32 count         = get_level_count(width, height) - 1;
+
+            m_levels.resize(count);
+
+            usize total         = 0;
+            uint32 level_width  = width;
+            uint32 level_height = height;
+            uint32 index;
+
+            for (index = 0; index < count; ++index)
+            {
+                level_width  = std::max(1u, level_width / 2);
+                level_height = std::max(1u, level_height / 2);
+
+                m_levels[index] = { level_width, level_height, total };
+                total += static_cast<usize>(level_width) * level_height * 4;
+            }
+
+            m_pixels.resize(total);
+
+            if (count == 0)
+            {
+                return;
+            }
+
+            const usize first_size = static_cast<usize>(m_levels[0].width) * m_levels[0].height * 4;
+
+            m_previous.resize(first_size);
+            m_current.resize(first_size);
+
+            uint32 source_width  = width;
+            uint32 source_height = height;
+
+            for (index = 0; index < count; ++index)
+            {
+                const level &current = m_levels[index];
+                const uint32 tasks   = (current.height + rows_per_task - 1) / rows_per_task;
+
+                auto task = [&](uint32 task_index, uint32) {
+                    const uint32 first = task_index * rows_per_task;
+                    const uint32 last  = std::min(current.height, first + rows_per_task);
+                    uint32 y;
+
+                    for (y = first; y < last; ++y)
+                    {
+                        float *linear = m_current.data() + static_cast<usize>(y) * current.width * 4;
+                        uint8 *out    = m_pixels.data() + current.offset + static_cast<usize>(y) * current.width * 4;
+
+                        if (index == 0)
+                        {
+                            downsample_row(pixels, row_bytes, source_width, source_height, y, current.width, tables, linear, out);
+                        }
+                        else
+                        {
+                            downsample_row(m_previous.data(), source_width, source_height, y, current.width, tables, linear, out);
+                        }
+                    }
+                };
+
+                if (pool != nullptr && static_cast<usize>(current.width) * current.height >= parallel_pixel_count)
+                {
+                    pool->parallel_for(tasks, task);
+                }
+                else
+                {
+                    uint32 task_index;
+
+                    for (task_index = 0; task_index < tasks; ++task_index)
+                    {
+                        task(task_index, 0);
+                    }
+                }
+
+                m_previous.swap(m_current);
+
+                source_width  = current.width;
+                source_height = current.height;
+            }
+        }
+
+        uint32 mip_chain::get_count() const noexcept
+        {
+            return static_cast<uint32>(m_levels.size());
+        }
+
+        const mip_chain::level &mip_chain::get_level(uint32 index) const noexcept
+        {
+            return m_levels[index];
+        }
+
+        const uint8 *mip_chain::get_pixels(uint32 index) const noexcept
+        {
+            return m_pixels.data() + m_levels[index].offset;
+        }
+    } // namespace D3D
+} // namespace deep
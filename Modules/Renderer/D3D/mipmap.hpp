@@ -0,0 +1,85 @@
+#ifndef DEEP_ENGINE_D3D_MIPMAP_HPP
+#define DEEP_ENGINE_D3D_MIPMAP_HPP
+
+#include <DeepCore/types.hpp>
+
+#include "D3D/thread_pool.hpp"
+
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Chaîne de mipmaps d'une image 8 bits à 4 canaux, construite sur le CPU.
+         *
+         * Chaque niveau est la moyenne de blocs de 2x2 pixels du niveau précédent. Les couleurs sont moyennées
+         * dans l'espace linéaire puis réencodées en sRGB, l'alpha est moyenné tel quel : une texture réduite garde
+         * la même luminosité apparente. Les niveaux intermédiaires sont conservés en flottants, 4 canaux à la fois
+         * avec SSE, pour ne pas accumuler d'erreurs d'arrondi d'un niveau à l'autre.
+         *
+         * L'ordre des canaux est conservé : une image BGRA produit des niveaux BGRA.
+         *
+         * Classe interne à DeepD3D, utilisée par resource_factory.
+         */
+        class mip_chain
+        {
+          public:
+            struct level
+            {
+                uint32 width;
+                uint32 height;
+
+                // Position du niveau dans les données de la chaîne, ses lignes sont contiguës.
+                usize offset;
+            };
+
+            // Nombre de pixels d'un niveau à partir duquel ses lignes sont réparties entre plusieurs threads.
+            static constexpr usize parallel_pixel_count = 256 * 256;
+
+            // Nombre de lignes traitées par tâche lors d'une construction multithread.
+            static constexpr uint32 rows_per_task = 16;
+
+          public:
+            mip_chain() = default;
+
+            mip_chain(const mip_chain &)            = delete;
+            mip_chain &operator=(const mip_chain &) = delete;
+
+            /**
+             * @brief Nombre de niveaux d'une chaîne complète, niveau 0 compris, jusqu'à 1x1.
+             */
+            static uint32 get_level_count(uint32 width, uint32 height) noexcept;
+
+            /**
+             * @brief Construit tous les niveaux sous le niveau 0.
+             * @param pixels Le niveau 0, qui n'est pas copié.
+             * @param srgb false pour moyenner les couleurs telles quelles, pour des données non colorimétriques.
+             * @param pool Threads utilisés pour les grands niveaux, nul pour tout calculer sur le thread appelant.
+             */
+            void build(const uint8 *pixels, uint32 width, uint32 height, usize row_bytes, bool srgb = true, thread_pool *pool = nullptr);
+
+            /**
+             * @return Le nombre de niveaux construits, sans le niveau 0.
+             */
+            uint32 get_count() const noexcept;
+
+            /**
+             * @param index L'indice du niveau construit, 0 correspondant au niveau 1 de la texture.
+             */
+            const level &get_level(uint32 index) const noexcept;
+            const uint8 *get_pixels(uint32 index) const noexcept;
+
+          private:
+            std::vector<level> m_levels;
+            std::vector<uint8> m_pixels;
+
+            // Niveau précédent et niveau courant dans l'espace linéaire, 4 flottants par pixel.
+            std::vector<float> m_previous;
+            std::vector<float> m_current;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
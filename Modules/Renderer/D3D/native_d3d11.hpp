@@ -0,0 +1,62 @@
+#ifndef DEEP_ENGINE_D3D_NATIVE_D3D11_HPP
+#define DEEP_ENGINE_D3D_NATIVE_D3D11_HPP
+
+#include "D3D/device_handle.hpp"
+#include "D3D/shader/input_layout.hpp"
+
+#include <d3d11.h>
+#include <d3d11_1.h>
+#include <wrl.h>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Périphérique Direct3D 11 désigné par une poignée créée par graphics.
+         */
+        inline ID3D11Device *get_d3d11_device(device_handle device) noexcept
+        {
+            return static_cast<ID3D11Device *>(device.get_native());
+        }
+
+        /**
+         * @brief Libère un objet COM conservé par pointeur brut et remet le pointeur à zéro.
+         */
+        template<typename T>
+        inline void release_native(T *&object) noexcept
+        {
+            if (object != nullptr)
+            {
+                object->Release();
+                object = nullptr;
+            }
+        }
+
+        /**
+         * @brief Format DXGI d'un élément d'input layout.
+         */
+        inline DXGI_FORMAT to_d3d(element_format format) noexcept
+        {
+            switch (format)
+            {
+                default:
+                    return DXGI_FORMAT_UNKNOWN;
+                case element_format::Float2:
+                    return DXGI_FORMAT_R32G32_FLOAT;
+                case element_format::Float3:
+                    return DXGI_FORMAT_R32G32B32_FLOAT;
+                case element_format::Float4:
+                    return DXGI_FORMAT_R32G32B32A32_FLOAT;
+                case element_format::Half2:
+                    return DXGI_FORMAT_R16G16_FLOAT;
+                case element_format::Unorm16x4:
+                    return DXGI_FORMAT_R16G16B16A16_UNORM;
+                case element_format::Snorm16x2:
+                    return DXGI_FORMAT_R16G16_SNORM;
+            }
+        }
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,71 @@
+#include "D3D/null_graphics.hpp"
+
+#include <DeepLib/context.hpp>
+
+namespace deep
+{
+    namespace D3D
+    {
+        null_graphics::null_graphics(const ref<ctx> &context, uint32 width, uint32 height) noexcept
+                : renderer(context),
+                  m_width(width),
+                  m_height(height)
+        {
+        }
+
+        ref<null_graphics> null_graphics::create(const ref<ctx> &context, uint32 width, uint32 height, const fvec4 &background_color) noexcept
+        {
+            context->out() << "Null renderer initialization...";
+
+            null_graphics *graph = mem::alloc_type<null_graphics>(context.get(), context, width, height);
+
+            if (graph == nullptr)
+            {
+                return ref<null_graphics>();
+            }
+
+            graph->m_background_color = background_color;
+
+            if (!graph->init_constant_ring(nullptr) || !graph->init_pipeline_states(nullptr))
+            {
+                mem::dealloc_type(context.get_memory_manager(), graph);
+
+                return ref<null_graphics>();
+            }
+
+            context->out() << " OK\r\n";
+
+            return ref<null_graphics>(context, graph);
+        }
+
+        renderer_backend null_graphics::get_backend() const noexcept
+        {
+            return renderer_backend::Null;
+        }
+
+        void null_graphics::clear_buffer() noexcept
+        {
+            // Aucune cible de rendu à effacer.
+        }
+
+        void null_graphics::draw_all(const fmat4 &projection, const fmat4 &view) noexcept
+        {
+            submit_drawables(projection * view);
+        }
+
+        void null_graphics::end_frame() noexcept
+        {
+            finish_frame();
+        }
+
+        uint32 null_graphics::get_width() const noexcept
+        {
+            return m_width;
+        }
+
+        uint32 null_graphics::get_height() const noexcept
+        {
+            return m_height;
+        }
+    } // namespace D3D
+} // namespace deep
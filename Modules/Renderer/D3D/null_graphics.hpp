@@ -0,0 +1,57 @@
+#ifndef DEEP_ENGINE_D3D_NULL_GRAPHICS_HPP
+#define DEEP_ENGINE_D3D_NULL_GRAPHICS_HPP
+
+#include "deep_d3d_export.h"
+#include <DeepCore/types.hpp>
+#include <DeepLib/memory/memory.hpp>
+#include <DeepLib/maths/vec.hpp>
+
+#include "D3D/renderer.hpp"
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Backend de rendu sans GPU ni fenêtre.
+         *
+         * Les objets de la scène sont soumis normalement mais les commandes sont seulement
+         * comptabilisées par le contexte, ce qui permet de mesurer le coût CPU d'une image.
+         *
+         * Le backend ne dépend pas du SDK Windows : il se compile et s'exécute aussi sous Linux.
+         */
+        class DEEP_D3D_API null_graphics : public renderer
+        {
+          public:
+            null_graphics()                                 = delete;
+            null_graphics(const null_graphics &)            = delete;
+            null_graphics &operator=(const null_graphics &) = delete;
+            ~null_graphics()                                = default;
+
+            static ref<null_graphics> create(const ref<ctx> &context, uint32 width, uint32 height, const fvec4 &background_color) noexcept;
+
+            virtual renderer_backend get_backend() const noexcept override;
+
+            virtual void clear_buffer() noexcept override;
+
+            virtual void draw_all(const fmat4 &projection, const fmat4 &view) noexcept override;
+
+            virtual void end_frame() noexcept override;
+
+            uint32 get_width() const noexcept;
+            uint32 get_height() const noexcept;
+
+          protected:
+            null_graphics(const ref<ctx> &context, uint32 width, uint32 height) noexcept;
+
+          private:
+            uint32 m_width;
+            uint32 m_height;
+
+          public:
+            friend memory_manager;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
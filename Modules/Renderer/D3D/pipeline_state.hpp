@@ -0,0 +1,207 @@
+#ifndef DEEP_ENGINE_D3D_PIPELINE_STATE_HPP
+#define DEEP_ENGINE_D3D_PIPELINE_STATE_HPP
+
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Identifiant d'un état de pipeline enregistré dans le cache du renderer.
+         */
+        using pipeline_state_id = uint32;
+
+        static constexpr pipeline_state_id invalid_pipeline_state = 0xFFFFFFFF;
+
+        enum class fill_mode : uint8
+        {
+            Solid,
+            Wireframe
+        };
+
+        enum class cull_mode : uint8
+        {
+            None,
+            Front,
+            Back
+        };
+
+        enum class comparison_func : uint8
+        {
+            Never,
+            Less,
+            Equal,
+            LessEqual,
+            Greater,
+            NotEqual,
+            GreaterEqual,
+            Always
+        };
+
+        enum class stencil_op : uint8
+        {
+            Keep,
+            Zero,
+            Replace,
+            IncrementSaturate,
+            DecrementSaturate,
+            Invert,
+            Increment,
+            Decrement
+        };
+
+        enum class blend_factor : uint8
+        {
+            Zero,
+            One,
+            SrcColor,
+            InvSrcColor,
+            SrcAlpha,
+            InvSrcAlpha,
+            DestAlpha,
+            InvDestAlpha,
+            DestColor,
+            InvDestColor
+        };
+
+        enum class blend_op : uint8
+        {
+            Add,
+            Subtract,
+            RevSubtract,
+            Min,
+            Max
+        };
+
+        /**
+         * @brief Description des états du pipeline, indépendante du backend.
+         *
+         * Les structures ne contiennent aucun octet de remplissage : elles sont comparées et hachées octet par octet.
+         * Elles doivent donc être initialisées avec les fonctions default_*, puis modifiées champ par champ.
+         */
+        struct rasterizer_desc
+        {
+            int32 depth_bias;
+            float slope_scaled_depth_bias;
+            fill_mode fill;
+            cull_mode cull;
+            uint8 front_counter_clockwise;
+            uint8 depth_clip;
+        };
+
+        struct stencil_face_desc
+        {
+            stencil_op fail;
+            stencil_op depth_fail;
+            stencil_op pass;
+            comparison_func func;
+        };
+
+        struct depth_stencil_desc
+        {
+            stencil_face_desc front;
+            stencil_face_desc back;
+            uint8 depth_enable;
+            uint8 depth_write;
+            comparison_func depth_func;
+            uint8 stencil_enable;
+            uint8 stencil_read_mask;
+            uint8 stencil_write_mask;
+            uint8 stencil_ref;
+            uint8 reserved;
+        };
+
+        struct blend_desc
+        {
+            uint8 blend_enable;
+            blend_factor src;
+            blend_factor dest;
+            blend_op op;
+            blend_factor src_alpha;
+            blend_factor dest_alpha;
+            blend_op op_alpha;
+            uint8 write_mask;
+            uint8 alpha_to_coverage;
+            uint8 reserved[3];
+        };
+
+        struct pipeline_state_desc
+        {
+            rasterizer_desc rasterizer;
+            depth_stencil_desc depth_stencil;
+            blend_desc blend;
+        };
+
+        static_assert(sizeof(rasterizer_desc) == 12, "rasterizer_desc must not contain padding.");
+        static_assert(sizeof(depth_stencil_desc) == 16, "depth_stencil_desc must not contain padding.");
+        static_assert(sizeof(blend_desc) == 12, "blend_desc must not contain padding.");
+        static_assert(sizeof(pipeline_state_desc) == 40, "pipeline_state_desc must not contain padding.");
+
+        /**
+         * @brief Remplissage plein, faces arrière éliminées, sans découpage par les plans proche et lointain.
+         */
+        inline rasterizer_desc default_rasterizer_desc() noexcept
+        {
+            rasterizer_desc desc         = {};
+            desc.fill                    = fill_mode::Solid;
+            desc.cull                    = cull_mode::Back;
+            desc.front_counter_clockwise = 0;
+            desc.depth_clip              = 0;
+
+            return desc;
+        }
+
+        /**
+         * @brief Test et écriture de la profondeur avec la comparaison 'inférieur', sans stencil.
+         */
+        inline depth_stencil_desc default_depth_stencil_desc() noexcept
+        {
+            const stencil_face_desc face = { stencil_op::Keep, stencil_op::Keep, stencil_op::Keep, comparison_func::Always };
+
+            depth_stencil_desc desc = {};
+            desc.front              = face;
+            desc.back               = face;
+            desc.depth_enable       = 1;
+            desc.depth_write        = 1;
+            desc.depth_func         = comparison_func::Less;
+            desc.stencil_enable     = 0;
+            desc.stencil_read_mask  = 0xFF;
+            desc.stencil_write_mask = 0xFF;
+            desc.stencil_ref        = 1;
+
+            return desc;
+        }
+
+        /**
+         * @brief Objets opaques : pas de mélange, tous les canaux écrits.
+         */
+        inline blend_desc default_blend_desc() noexcept
+        {
+            blend_desc desc        = {};
+            desc.blend_enable      = 0;
+            desc.src               = blend_factor::One;
+            desc.dest              = blend_factor::Zero;
+            desc.op                = blend_op::Add;
+            desc.src_alpha         = blend_factor::One;
+            desc.dest_alpha        = blend_factor::Zero;
+            desc.op_alpha          = blend_op::Add;
+            desc.write_mask        = 0x0F;
+            desc.alpha_to_coverage = 0;
+
+            return desc;
+        }
+
+        inline pipeline_state_desc default_pipeline_state_desc() noexcept
+        {
+            pipeline_state_desc desc = {};
+            desc.rasterizer          = default_rasterizer_desc();
+            desc.depth_stencil       = default_depth_stencil_desc();
+            desc.blend               = default_blend_desc();
+
+            return desc;
+        }
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,305 @@
+#include "D3D/pipeline_state_cache.hpp"
+
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
+
+namespace deep
+{
+    namespace D3D
+    {
+#ifdef DEEP_D3D11
+        namespace
+        {
+            D3D11_COMPARISON_FUNC to_d3d(comparison_func func) noexcept
+            {
+                // Les valeurs Direct3D suivent le même ordre en partant de 1.
+                return static_cast<D3D11_COMPARISON_FUNC>(static_cast<uint32>(func) + 1);
+            }
+
+            D3D11_STENCIL_OP to_d3d(stencil_op op) noexcept
+            {
+                return static_cast<D3D11_STENCIL_OP>(static_cast<uint32>(op) + 1);
+            }
+
+            D3D11_BLEND_OP to_d3d(blend_op op) noexcept
+            {
+                return static_cast<D3D11_BLEND_OP>(static_cast<uint32>(op) + 1);
+            }
+
+            D3D11_BLEND to_d3d(blend_factor factor) noexcept
+            {
+                switch (factor)
+                {
+                    case blend_factor::Zero:
+                        return D3D11_BLEND_ZERO;
+                    case blend_factor::One:
+                        return D3D11_BLEND_ONE;
+                    case blend_factor::SrcColor:
+                        return D3D11_BLEND_SRC_COLOR;
+                    case blend_factor::InvSrcColor:
+                        return D3D11_BLEND_INV_SRC_COLOR;
+                    case blend_factor::SrcAlpha:
+                        return D3D11_BLEND_SRC_ALPHA;
+                    case blend_factor::InvSrcAlpha:
+                        return D3D11_BLEND_INV_SRC_ALPHA;
+                    case blend_factor::DestAlpha:
+                        return D3D11_BLEND_DEST_ALPHA;
+                    case blend_factor::InvDestAlpha:
+                        return D3D11_BLEND_INV_DEST_ALPHA;
+                    case blend_factor::DestColor:
+                        return D3D11_BLEND_DEST_COLOR;
+                    case blend_factor::InvDestColor:
+                        return D3D11_BLEND_INV_DEST_COLOR;
+                }
+
+                return D3D11_BLEND_ONE;
+            }
+
+            D3D11_DEPTH_STENCILOP_DESC to_d3d(const stencil_face_desc &face) noexcept
+            {
+                D3D11_DEPTH_STENCILOP_DESC desc;
+                desc.StencilFailOp      = to_d3d(face.fail);
+                desc.StencilDepthFailOp = to_d3d(face.depth_fail);
+                desc.StencilPassOp      = to_d3d(face.pass);
+                desc.StencilFunc        = to_d3d(face.func);
+
+                return desc;
+            }
+        } // namespace
+#endif
+
+        pipeline_state_cache::pipeline_state_cache(device_handle device)
+                : m_device(device),
+                  m_frame_lookups(0),
+                  m_frame_hits(0)
+        {
+        }
+
+        pipeline_state_cache::~pipeline_state_cache() noexcept
+        {
+#ifdef DEEP_D3D11
+            for (ID3D11RasterizerState *&rasterizer_state : m_rasterizer_states)
+            {
+                release_native(rasterizer_state);
+            }
+
+            for (ID3D11DepthStencilState *&depth_stencil_state : m_depth_stencil_states)
+            {
+                release_native(depth_stencil_state);
+            }
+
+            for (ID3D11BlendState *&blend_state : m_blend_states)
+            {
+                release_native(blend_state);
+            }
+#endif
+        }
+
+        pipeline_state_id pipeline_state_cache::get_or_create(const pipeline_state_desc &desc)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_frame_lookups.fetch_add(1, std::memory_order_relaxed);
+
+            auto found = m_ids.find(desc);
+
+            if (found != m_ids.end())
+            {
+                m_frame_hits.fetch_add(1, std::memory_order_relaxed);
+
+                return found->second;
+            }
+
+            state created = {};
+            created.desc  = desc;
+
+            if (!create_rasterizer(desc.rasterizer, created.rasterizer) ||
+                !create_depth_stencil(desc.depth_stencil, created.depth_stencil) ||
+                !create_blend(desc.blend, created.blend))
+            {
+                return invalid_pipeline_state;
+            }
+
+            created.rasterizer_state    = m_rasterizer_states[created.rasterizer];
+            created.depth_stencil_state = m_depth_stencil_states[created.depth_stencil];
+            created.blend_state         = m_blend_states[created.blend];
+
+            const pipeline_state_id id = static_cast<pipeline_state_id>(m_states.size());
+
+            m_states.push_back(created);
+            m_ids.emplace(desc, id);
+
+            return id;
+        }
+
+        const pipeline_state_cache::state *pipeline_state_cache::get(pipeline_state_id id) const noexcept
+        {
+            if (id >= m_states.size())
+            {
+                return nullptr;
+            }
+
+            return &m_states[id];
+        }
+
+        uint32 pipeline_state_cache::get_state_count() const noexcept
+        {
+            return static_cast<uint32>(m_states.size());
+        }
+
+        uint32 pipeline_state_cache::get_rasterizer_count() const noexcept
+        {
+            return static_cast<uint32>(m_rasterizer_states.size());
+        }
+
+        uint32 pipeline_state_cache::get_depth_stencil_count() const noexcept
+        {
+            return static_cast<uint32>(m_depth_stencil_states.size());
+        }
+
+        uint32 pipeline_state_cache::get_blend_count() const noexcept
+        {
+            return static_cast<uint32>(m_blend_states.size());
+        }
+
+        void pipeline_state_cache::begin_frame() noexcept
+        {
+            m_frame_lookups.store(0, std::memory_order_relaxed);
+            m_frame_hits.store(0, std::memory_order_relaxed);
+        }
+
+        uint32 pipeline_state_cache::get_frame_lookups() const noexcept
+        {
+            return m_frame_lookups.load(std::memory_order_relaxed);
+        }
+
+        uint32 pipeline_state_cache::get_frame_hits() const noexcept
+        {
+            return m_frame_hits.load(std::memory_order_relaxed);
+        }
+
+        bool pipeline_state_cache::create_rasterizer(const rasterizer_desc &desc, uint32 &index)
+        {
+            auto found = m_rasterizer_ids.find(desc);
+
+            if (found != m_rasterizer_ids.end())
+            {
+                index = found->second;
+
+                return true;
+            }
+
+            ID3D11RasterizerState *rasterizer_state = nullptr;
+
+#ifdef DEEP_D3D11
+            if (m_device)
+            {
+                D3D11_RASTERIZER_DESC d3d_desc = {};
+                d3d_desc.FillMode              = desc.fill == fill_mode::Wireframe ? D3D11_FILL_WIREFRAME : D3D11_FILL_SOLID;
+                d3d_desc.CullMode              = desc.cull == cull_mode::None ? D3D11_CULL_NONE : (desc.cull == cull_mode::Front ? D3D11_CULL_FRONT : D3D11_CULL_BACK);
+                d3d_desc.FrontCounterClockwise = desc.front_counter_clockwise != 0;
+                d3d_desc.DepthBias             = desc.depth_bias;
+                d3d_desc.SlopeScaledDepthBias  = desc.slope_scaled_depth_bias;
+                d3d_desc.DepthClipEnable       = desc.depth_clip != 0;
+
+                if (FAILED(get_d3d11_device(m_device)->CreateRasterizerState(&d3d_desc, &rasterizer_state)))
+                {
+                    return false;
+                }
+            }
+#endif
+
+            index = static_cast<uint32>(m_rasterizer_states.size());
+
+            m_rasterizer_states.push_back(rasterizer_state);
+            m_rasterizer_ids.emplace(desc, index);
+
+            return true;
+        }
+
+        bool pipeline_state_cache::create_depth_stencil(const depth_stencil_desc &desc, uint32 &index)
+        {
+            auto found = m_depth_stencil_ids.find(desc);
+
+            if (found != m_depth_stencil_ids.end())
+            {
+                index = found->second;
+
+                return true;
+            }
+
+            ID3D11DepthStencilState *depth_stencil_state = nullptr;
+
+#ifdef DEEP_D3D11
+            if (m_device)
+            {
+                D3D11_DEPTH_STENCIL_DESC d3d_desc = {};
+                d3d_desc.DepthEnable              = desc.depth_enable != 0;
+                d3d_desc.DepthWriteMask           = desc.depth_write != 0 ? D3D11_DEPTH_WRITE_MASK_ALL : D3D11_DEPTH_WRITE_MASK_ZERO;
+                d3d_desc.DepthFunc                = to_d3d(desc.depth_func);
+                d3d_desc.StencilEnable            = desc.stencil_enable != 0;
+                d3d_desc.StencilReadMask          = desc.stencil_read_mask;
+                d3d_desc.StencilWriteMask         = desc.stencil_write_mask;
+                d3d_desc.FrontFace                = to_d3d(desc.front);
+                d3d_desc.BackFace                 = to_d3d(desc.back);
+
+                if (FAILED(get_d3d11_device(m_device)->CreateDepthStencilState(&d3d_desc, &depth_stencil_state)))
+                {
+                    return false;
+                }
+            }
+#endif
+
+            index = static_cast<uint32>(m_depth_stencil_states.size());
+
+            m_depth_stencil_states.push_back(depth_stencil_state);
+            m_depth_stencil_ids.emplace(desc, index);
+
+            return true;
+        }
+
+        bool pipeline_state_cache::create_blend(const blend_desc &desc, uint32 &index)
+        {
+            auto found = m_blend_ids.find(desc);
+
+            if (found != m_blend_ids.end())
+            {
+                index = found->second;
+
+                return true;
+            }
+
+            ID3D11BlendState *blend_state = nullptr;
+
+#ifdef DEEP_D3D11
+            if (m_device)
+            {
+                D3D11_BLEND_DESC d3d_desc                      = {};
+                d3d_desc.AlphaToCoverageEnable                 = desc.alpha_to_coverage != 0;
+                d3d_desc.IndependentBlendEnable                = FALSE;
+                d3d_desc.RenderTarget[0].BlendEnable           = desc.blend_enable != 0;
+                d3d_desc.RenderTarget[0].SrcBlend              = to_d3d(desc.src);
+                d3d_desc.RenderTarget[0].DestBlend             = to_d3d(desc.dest);
+                d3d_desc.RenderTarget[0].BlendOp               = to_d3d(desc.op);
+                d3d_desc.RenderTarget[0].SrcBlendAlpha         = to_d3d(desc.src_alpha);
+                d3d_desc.RenderTarget[0].DestBlendAlpha        = to_d3d(desc.dest_alpha);
+                d3d_desc.RenderTarget[0].BlendOpAlpha          = to_d3d(desc.op_alpha);
+                d3d_desc.RenderTarget[0].RenderTargetWriteMask = desc.write_mask;
+
+                if (FAILED(get_d3d11_device(m_device)->CreateBlendState(&d3d_desc, &blend_state)))
+                {
+                    return false;
+                }
+            }
+#endif
+
+            index = static_cast<uint32>(m_blend_states.size());
+
+            m_blend_states.push_back(blend_state);
+            m_blend_ids.emplace(desc, index);
+
+            return true;
+        }
+    } // namespace D3D
+} // namespace deep
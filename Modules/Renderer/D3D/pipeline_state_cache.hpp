@@ -0,0 +1,147 @@
+#ifndef DEEP_ENGINE_D3D_PIPELINE_STATE_CACHE_HPP
+#define DEEP_ENGINE_D3D_PIPELINE_STATE_CACHE_HPP
+
+#include <DeepCore/types.hpp>
+
+#include "D3D/device_handle.hpp"
+#include "D3D/pipeline_state.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+struct ID3D11RasterizerState;
+struct ID3D11DepthStencilState;
+struct ID3D11BlendState;
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Cache des états de pipeline, indexé par le haché de leur description complète.
+         *
+         * Chaque combinaison demandée reçoit un identifiant stable. Les objets Direct3D de rastérisation,
+         * de profondeur et de mélange sont dédupliqués séparément : deux combinaisons qui ne diffèrent que
+         * par leur mélange partagent le même objet de rastérisation. Sans périphérique, seules les
+         * descriptions sont conservées.
+         *
+         * get_or_create peut être appelée depuis plusieurs threads. Les autres accesseurs ne doivent pas
+         * l'être pendant qu'un autre thread crée un état.
+         *
+         * Classe interne à DeepD3D, utilisée par renderer et device_context.
+         */
+        class pipeline_state_cache
+        {
+          public:
+            /**
+             * @brief Objets Direct3D d'un état de pipeline et indices de ses parties dédupliquées.
+             */
+            struct state
+            {
+                pipeline_state_desc desc;
+
+                uint32 rasterizer;
+                uint32 depth_stencil;
+                uint32 blend;
+
+                ID3D11RasterizerState *rasterizer_state;
+                ID3D11DepthStencilState *depth_stencil_state;
+                ID3D11BlendState *blend_state;
+            };
+
+          public:
+            /**
+             * @param device Le périphérique du renderer, qui doit survivre au cache.
+             */
+            explicit pipeline_state_cache(device_handle device);
+            ~pipeline_state_cache() noexcept;
+
+            pipeline_state_cache(const pipeline_state_cache &)            = delete;
+            pipeline_state_cache &operator=(const pipeline_state_cache &) = delete;
+
+            /**
+             * @brief Récupère l'identifiant de l'état décrit, en le créant s'il n'existe pas encore.
+             * @return invalid_pipeline_state si le périphérique a refusé de créer un objet.
+             */
+            pipeline_state_id get_or_create(const pipeline_state_desc &desc);
+
+            /**
+             * @return nullptr si l'identifiant est inconnu.
+             */
+            const state *get(pipeline_state_id id) const noexcept;
+
+            uint32 get_state_count() const noexcept;
+            uint32 get_rasterizer_count() const noexcept;
+            uint32 get_depth_stencil_count() const noexcept;
+            uint32 get_blend_count() const noexcept;
+
+            /**
+             * @brief Remet à zéro les compteurs de recherches de l'image courante.
+             */
+            void begin_frame() noexcept;
+
+            uint32 get_frame_lookups() const noexcept;
+            uint32 get_frame_hits() const noexcept;
+
+          private:
+            // FNV-1a sur les octets de la description : elles ne font que quelques dizaines d'octets.
+            struct desc_hash
+            {
+                template <typename T>
+                usize operator()(const T &desc) const noexcept
+                {
+                    const uint8 *bytes = reinterpret_cast<const uint8 *>(&desc);
+                    uint64 hash        = 14695981039346656037ull;
+                    usize index;
+
+                    for (index = 0; index < sizeof(T); ++index)
+                    {
+                        hash ^= bytes[index];
+                        hash *= 1099511628211ull;
+                    }
+
+                    return static_cast<usize>(hash);
+                }
+            };
+
+            struct desc_equal
+            {
+                template <typename T>
+                bool operator()(const T &a, const T &b) const noexcept
+                {
+                    return std::memcmp(&a, &b, sizeof(T)) == 0;
+                }
+            };
+
+          private:
+            bool create_rasterizer(const rasterizer_desc &desc, uint32 &index);
+            bool create_depth_stencil(const depth_stencil_desc &desc, uint32 &index);
+            bool create_blend(const blend_desc &desc, uint32 &index);
+
+          private:
+            device_handle m_device;
+
+            std::mutex m_mutex;
+
+            std::unordered_map<pipeline_state_desc, pipeline_state_id, desc_hash, desc_equal> m_ids;
+            std::vector<state> m_states;
+
+            std::unordered_map<rasterizer_desc, uint32, desc_hash, desc_equal> m_rasterizer_ids;
+            std::unordered_map<depth_stencil_desc, uint32, desc_hash, desc_equal> m_depth_stencil_ids;
+            std::unordered_map<blend_desc, uint32, desc_hash, desc_equal> m_blend_ids;
+
+            // Objets Direct3D possédés par le cache, nuls sans périphérique.
+            std::vector<ID3D11RasterizerState *> m_rasterizer_states;
+            std::vector<ID3D11DepthStencilState *> m_depth_stencil_states;
+            std::vector<ID3D11BlendState *> m_blend_states;
+
+            std::atomic<uint32> m_frame_lookups;
+            std::atomic<uint32> m_frame_hits;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,176 @@
+#include "D3D/render_queue.hpp"
+
+#include <DeepLib/memory/memory.hpp>
+
+#include <cstring>
+
+namespace deep
+{
+    namespace D3D
+    {
+        render_queue::render_queue(const ref<ctx> &context) noexcept
+                : object(context),
+                  m_packets(nullptr),
+                  m_scratch(nullptr),
+                  m_count(0),
+                  m_capacity(0)
+        {
+        }
+
+        render_queue::~render_queue() noexcept
+        {
+            if (m_packets != nullptr)
+            {
+                mem::dealloc(get_context_ptr(), m_packets);
+            }
+
+            if (m_scratch != nullptr)
+            {
+                mem::dealloc(get_context_ptr(), m_scratch);
+            }
+        }
+
+        uint64 render_queue::make_key(render_pass pass, resource_id vertex_shader, resource_id pixel_shader, resource_id texture, float depth) noexcept
+        {
+            // Pour un flottant positif, l'ordre des bits suit l'ordre des valeurs.
+            uint32 depth_bits = 0;
+
+            if (depth > 0.0f)
+            {
+                std::memcpy(&depth_bits, &depth, sizeof(depth_bits));
+            }
+
+            // | passe : 2 | vertex shader : 10 | pixel shader : 10 | texture : 16 | profondeur : 24 | libre : 2 |
+            return (static_cast<uint64>(pass) & 0x3) << 62 |
+                   (static_cast<uint64>(vertex_shader) & 0x3FF) << 52 |
+                   (static_cast<uint64>(pixel_shader) & 0x3FF) << 42 |
+                   (static_cast<uint64>(texture) & 0xFFFF) << 26 |
+                   (static_cast<uint64>(depth_bits >> 8) & 0xFFFFFF) << 2;
+        }
+
+        void render_queue::clear() noexcept
+        {
+            m_count = 0;
+        }
+
+        bool render_queue::add(uint64 key, drawable *item) noexcept
+        {
+            if (m_count == m_capacity && !reserve(m_capacity == 0 ? 64 : m_capacity * 2))
+            {
+                return false;
+            }
+
+            m_packets[m_count].key  = key;
+            m_packets[m_count].item = item;
+            m_count++;
+
+            return true;
+        }
+
+        void render_queue::sort() noexcept
+        {
+            if (m_count < 2)
+            {
+                return;
+            }
+
+            usize histograms[8][256] = {};
+            usize index;
+            uint32 pass;
+
+            // Un seul parcours calcule les histogrammes des 8 octets de la clé.
+            for (index = 0; index < m_count; ++index)
+            {
+                uint64 key = m_packets[index].key;
+
+                for (pass = 0; pass < 8; ++pass)
+                {
+                    histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+                }
+            }
+
+            for (pass = 0; pass < 8; ++pass)
+            {
+                usize *histogram = histograms[pass];
+                uint32 shift     = pass * 8;
+
+                // Octet identique pour tous les paquets : la passe ne changerait rien.
+                if (histogram[(m_packets[0].key >> shift) & 0xFF] == m_count)
+                {
+                    continue;
+                }
+
+                usize offset = 0;
+                uint32 bucket;
+
+                for (bucket = 0; bucket < 256; ++bucket)
+                {
+                    usize bucket_count = histogram[bucket];
+                    histogram[bucket]  = offset;
+                    offset += bucket_count;
+                }
+
+                for (index = 0; index < m_count; ++index)
+                {
+                    const draw_packet &packet = m_packets[index];
+
+                    m_scratch[histogram[(packet.key >> shift) & 0xFF]++] = packet;
+                }
+
+                draw_packet *swap = m_packets;
+                m_packets         = m_scratch;
+                m_scratch         = swap;
+            }
+        }
+
+        usize render_queue::count() const noexcept
+        {
+            return m_count;
+        }
+
+        const draw_packet &render_queue::operator[](usize index) const noexcept
+        {
+            return m_packets[index];
+        }
+
+        bool render_queue::reserve(usize capacity) noexcept
+        {
+            if (capacity <= m_capacity)
+            {
+                return true;
+            }
+
+            draw_packet *packets = mem::alloc<draw_packet>(get_context_ptr(), capacity * sizeof(draw_packet));
+            draw_packet *scratch = mem::alloc<draw_packet>(get_context_ptr(), capacity * sizeof(draw_packet));
+
+            if (packets == nullptr || scratch == nullptr)
+            {
+                if (packets != nullptr)
+                {
+                    mem::dealloc(get_context_ptr(), packets);
+                }
+
+                if (scratch != nullptr)
+                {
+                    mem::dealloc(get_context_ptr(), scratch);
+                }
+
+                return false;
+            }
+
+            if (m_packets != nullptr)
+            {
+                std::memcpy(packets, m_packets, m_count * sizeof(draw_packet));
+
+                mem::dealloc(get_context_ptr(), m_packets);
+                mem::dealloc(get_context_ptr(), m_scratch);
+            }
+
+            m_packets  = packets;
+            m_scratch  = scratch;
+            m_capacity = capacity;
+
+            return true;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,77 @@
+#ifndef DEEP_ENGINE_D3D_RENDER_QUEUE_HPP
+#define DEEP_ENGINE_D3D_RENDER_QUEUE_HPP
+
+#include "deep_d3d_export.h"
+#include <DeepCore/types.hpp>
+#include <DeepLib/object.hpp>
+
+#include "D3D/resource_id.hpp"
+
+namespace deep
+{
+    namespace D3D
+    {
+        class drawable;
+
+        enum class render_pass : uint8
+        {
+            Opaque      = 0,
+            Transparent = 1
+        };
+
+        /**
+         * @brief Appel de dessin en attente, ordonné par sa clé.
+         */
+        struct draw_packet
+        {
+            uint64 key;
+            drawable *item;
+        };
+
+        /**
+         * @brief File des appels de dessin d'une image, triée par clé avant la soumission.
+         *
+         * La clé (bits de poids fort en premier) contient la passe, le couple de shaders,
+         * la texture puis la profondeur, ce qui regroupe les objets partageant le même état
+         * et dessine les objets opaques de l'avant vers l'arrière.
+         */
+        class DEEP_D3D_API render_queue : public object
+        {
+          public:
+            render_queue()                                = delete;
+            render_queue(const render_queue &)            = delete;
+            render_queue &operator=(const render_queue &) = delete;
+
+            render_queue(const ref<ctx> &context) noexcept;
+            ~render_queue() noexcept;
+
+            /**
+             * @brief Construit la clé de tri d'un appel de dessin.
+             * @param depth La distance à la caméra, les valeurs négatives sont ramenées à 0.
+             */
+            static uint64 make_key(render_pass pass, resource_id vertex_shader, resource_id pixel_shader, resource_id texture, float depth) noexcept;
+
+            void clear() noexcept;
+            bool add(uint64 key, drawable *item) noexcept;
+
+            /**
+             * @brief Trie les paquets par clé croissante (tri par base stable, 8 bits par passe).
+             */
+            void sort() noexcept;
+
+            usize count() const noexcept;
+            const draw_packet &operator[](usize index) const noexcept;
+
+          private:
+            bool reserve(usize capacity) noexcept;
+
+          private:
+            draw_packet *m_packets;
+            draw_packet *m_scratch;
+            usize m_count;
+            usize m_capacity;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
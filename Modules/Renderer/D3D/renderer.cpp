@@ -0,0 +1,482 @@
+#include "D3D/renderer.hpp"
+#include "D3D/transform.hpp"
+#include "D3D/resource_factory.hpp"
+#include "D3D/culling/frustum_culler.hpp"
+#include "D3D/culling/bvh.hpp"
+#include "D3D/culling/occlusion_culler.hpp"
+#include "D3D/command_recorder.hpp"
+#include "D3D/pipeline_state_cache.hpp"
+#include "D3D/shader/shader_cache.hpp"
+
+#include <DeepLib/memory/memory.hpp>
+
+namespace deep
+{
+    namespace D3D
+    {
+        renderer::renderer(const ref<ctx> &context) noexcept
+                : object(context),
+                  m_background_color(),
+                  m_drawables(context),
+                  m_render_queue(context),
+                  m_frustum_culler(mem::alloc_type<frustum_culler>(context.get())),
+                  m_bvh(mem::alloc_type<bvh>(context.get())),
+                  m_frustum_culling(true),
+                  m_culled_count(0),
+                  m_occlusion_culler(mem::alloc_type<occlusion_culler>(context.get())),
+                  m_occlusion_culling(true),
+                  m_occluded_count(0),
+                  m_dropped_count(0),
+                  m_command_recorder(mem::alloc_type<command_recorder>(context.get())),
+                  m_command_list_count(0),
+                  m_pipeline_cache(nullptr),
+                  m_shader_cache(mem::alloc_type<shader_cache>(context.get())),
+                  m_last_frame_stats(),
+                  m_frame_count(0),
+                  m_sync_interval(1)
+        {
+        }
+
+        renderer::~renderer()
+        {
+            if (m_frustum_culler != nullptr)
+            {
+                mem::dealloc_type(m_context.get_memory_manager(), m_frustum_culler);
+            }
+
+            if (m_bvh != nullptr)
+            {
+                mem::dealloc_type(m_context.get_memory_manager(), m_bvh);
+            }
+
+            if (m_occlusion_culler != nullptr)
+            {
+                mem::dealloc_type(m_context.get_memory_manager(), m_occlusion_culler);
+            }
+
+            if (m_command_recorder != nullptr)
+            {
+                mem::dealloc_type(m_context.get_memory_manager(), m_command_recorder);
+            }
+
+            if (m_pipeline_cache != nullptr)
+            {
+                m_device_context.m_pipeline_cache = nullptr;
+                mem::dealloc_type(m_context.get_memory_manager(), m_pipeline_cache);
+            }
+
+            if (m_shader_cache != nullptr)
+            {
+                mem::dealloc_type(m_context.get_memory_manager(), m_shader_cache);
+            }
+        }
+
+        device_handle renderer::get_device() noexcept
+        {
+            return device_handle();
+        }
+
+        void renderer::add_drawable(const ref<drawable> &dr) noexcept
+        {
+            m_drawables.add(dr);
+        }
+
+        usize renderer::get_drawable_count() const noexcept
+        {
+            return m_drawables.count();
+        }
+
+        ref<drawable> renderer::get_drawable(usize index) const noexcept
+        {
+            if (index >= m_drawables.count())
+            {
+                return ref<drawable>();
+            }
+
+            return m_drawables[index];
+        }
+
+        fvec4 renderer::get_background_color() const noexcept
+        {
+            return m_background_color;
+        }
+
+        void renderer::set_background_color(const fvec4 &color) noexcept
+        {
+            m_background_color = color;
+        }
+
+        device_context &renderer::get_device_context() noexcept
+        {
+            return m_device_context;
+        }
+
+        const device_context &renderer::get_device_context() const noexcept
+        {
+            return m_device_context;
+        }
+
+        const frame_stats &renderer::get_last_frame_stats() const noexcept
+        {
+            return m_last_frame_stats;
+        }
+
+        ref<constant_ring_buffer> renderer::get_constant_ring() const noexcept
+        {
+            return m_constant_ring;
+        }
+
+        bool renderer::init_constant_ring(device_handle device, uint32 capacity) noexcept
+        {
+            m_constant_ring = resource_factory::create_constant_ring_buffer(get_context(), capacity, device);
+
+            if (!m_constant_ring.is_valid())
+            {
+                return false;
+            }
+
+            m_device_context.set_constant_ring(m_constant_ring);
+
+            return true;
+        }
+
+        pipeline_state_id renderer::get_pipeline_state(const pipeline_state_desc &desc) noexcept
+        {
+            if (m_pipeline_cache == nullptr)
+            {
+                return invalid_pipeline_state;
+            }
+
+            return m_pipeline_cache->get_or_create(desc);
+        }
+
+        uint32 renderer::get_pipeline_state_count() const noexcept
+        {
+            return m_pipeline_cache != nullptr ? m_pipeline_cache->get_state_count() : 0;
+        }
+
+        shader_cache *renderer::get_shader_cache() noexcept
+        {
+            return m_shader_cache;
+        }
+
+        bool renderer::init_pipeline_states(device_handle device) noexcept
+        {
+            m_pipeline_cache = mem::alloc_type<pipeline_state_cache>(get_context_ptr(), device);
+
+            if (m_pipeline_cache == nullptr)
+            {
+                return false;
+            }
+
+            const pipeline_state_id id = m_pipeline_cache->get_or_create(default_pipeline_state_desc());
+
+            if (id == invalid_pipeline_state)
+            {
+                return false;
+            }
+
+            m_device_context.m_pipeline_cache = m_pipeline_cache;
+            m_device_context.set_pipeline_state(id);
+
+            return true;
+        }
+
+        void renderer::set_frustum_culling(bool enabled) noexcept
+        {
+            m_frustum_culling = enabled;
+        }
+
+        bool renderer::is_frustum_culling_enabled() const noexcept
+        {
+            return m_frustum_culling;
+        }
+
+        void renderer::set_occlusion_culling(bool enabled) noexcept
+        {
+            m_occlusion_culling = enabled;
+        }
+
+        bool renderer::is_occlusion_culling_enabled() const noexcept
+        {
+            return m_occlusion_culling;
+        }
+
+        void renderer::set_recording_thread_count(uint32 thread_count) noexcept
+        {
+            if (m_command_recorder != nullptr)
+            {
+                mem::dealloc_type(m_context.get_memory_manager(), m_command_recorder);
+                m_command_recorder = nullptr;
+            }
+
+            // Même sur un seul thread, les commandes passent par une liste pour grouper l'écriture des constantes.
+            m_command_recorder = mem::alloc_type<command_recorder>(get_context_ptr(), thread_count);
+        }
+
+        uint32 renderer::get_recording_thread_count() const noexcept
+        {
+            return m_command_recorder != nullptr ? m_command_recorder->get_thread_count() : 1;
+        }
+
+        ref<drawable> renderer::pick_drawable(const fvec3 &origin, const fvec3 &direction, float max_distance, float &distance) const noexcept
+        {
+            uint32 key;
+
+            if (m_bvh == nullptr || !m_bvh->ray_cast(origin, direction, max_distance, key, distance) || key >= m_drawables.count())
+            {
+                return ref<drawable>();
+            }
+
+            return m_drawables[key];
+        }
+
+        usize renderer::query_drawables(const fvec3 &center, const fvec3 &extents, array_list<ref<drawable>> &out) const noexcept
+        {
+            if (m_bvh == nullptr)
+            {
+                return 0;
+            }
+
+            std::vector<uint32> keys;
+            m_bvh->query_bounds(center, extents, keys);
+
+            usize added = 0;
+
+            for (uint32 key : keys)
+            {
+                if (key < m_drawables.count())
+                {
+                    out.add(m_drawables[key]);
+                    added++;
+                }
+            }
+
+            return added;
+        }
+
+        uint64 renderer::get_frame_count() const noexcept
+        {
+            return m_frame_count;
+        }
+
+        void renderer::set_sync_interval(uint32 interval) noexcept
+        {
+            m_sync_interval = interval > 4 ? 4 : interval;
+        }
+
+        uint32 renderer::get_sync_interval() const noexcept
+        {
+            return m_sync_interval;
+        }
+
+        void renderer::submit_drawables(const fmat4 &view_projection) noexcept
+        {
+            usize count = m_drawables.count();
+            usize index;
+
+            m_render_queue.clear();
+            m_culled_count       = 0;
+            m_occluded_count     = 0;
+            m_dropped_count      = 0;
+            m_command_list_count = 0;
+
+            if (m_constant_ring.is_valid())
+            {
+                m_constant_ring->begin_frame();
+            }
+
+            const bool tracking  = m_frustum_culler != nullptr && m_bvh != nullptr;
+            const bool culling   = m_frustum_culling && tracking;
+            const bool occlusion = culling && m_occlusion_culling && m_occlusion_culler != nullptr;
+
+            if (tracking)
+            {
+                const uint32 tracked_count = static_cast<uint32>(count);
+
+                if (m_frustum_culler->get_count() != tracked_count)
+                {
+                    m_frustum_culler->resize(tracked_count);
+                }
+
+                // Seules les boîtes des objets déplacés depuis l'image précédente sont recalculées.
+                for (index = 0; index < count; ++index)
+                {
+                    const ref<drawable> &dr = m_drawables[index];
+                    const uint32 slot       = static_cast<uint32>(index);
+                    const uint64 version    = dr.is_valid() ? dr->get_transform_version() : 0;
+
+                    if (m_frustum_culler->get_version(slot) == version)
+                    {
+                        continue;
+                    }
+
+                    fvec3 center;
+                    fvec3 extents;
+
+                    if (dr.is_valid() && dr->get_world_bounds(center, extents))
+                    {
+                        m_frustum_culler->set_bounds(slot, center, extents, version);
+                        m_bvh->update(slot, center, extents);
+                    }
+                    else
+                    {
+                        m_frustum_culler->set_unbounded(slot, version);
+                        m_bvh->remove(slot);
+                    }
+                }
+
+                m_bvh->optimize();
+            }
+
+            if (culling)
+            {
+                const frustum view_frustum = frustum::from_view_projection(view_projection);
+                const uint32 visible_count = count >= hierarchical_culling_threshold ? m_frustum_culler->cull(view_frustum, *m_bvh)
+                                                                                     : m_frustum_culler->cull(view_frustum);
+
+                m_culled_count = static_cast<uint32>(count) - visible_count;
+
+                if (occlusion)
+                {
+                    m_occluded_count = cull_occluded(view_projection);
+                }
+            }
+
+            for (index = 0; index < count; ++index)
+            {
+                const ref<drawable> &dr = m_drawables[index];
+
+                if (!dr.is_valid())
+                {
+                    continue;
+                }
+
+                if (culling && !m_frustum_culler->is_visible(static_cast<uint32>(index)))
+                {
+                    continue;
+                }
+
+                if (occlusion && m_occlusion_culler->is_occluded(static_cast<uint32>(index)))
+                {
+                    continue;
+                }
+
+                ref<vertex_shader> vs = dr->get_vertex_shader();
+                ref<pixel_shader> ps  = dr->get_pixel_shader();
+                ref<texture> tex      = dr->get_texture();
+
+                // La composante w de la position projetée est la profondeur vue depuis la caméra.
+                const float depth = transform_point(view_projection, dr->get_location()).w;
+
+                const uint64 key = render_queue::make_key(render_pass::Opaque,
+                                                          vs.is_valid() ? vs->get_id() : 0,
+                                                          ps.is_valid() ? ps->get_id() : 0,
+                                                          tex.is_valid() ? tex->get_id() : 0,
+                                                          depth);
+
+                // Plus de mémoire pour la file : l'objet n'est pas dessiné plutôt que de l'être hors de l'ordre des listes.
+                if (!m_render_queue.add(key, dr.get()))
+                {
+                    m_dropped_count++;
+                }
+            }
+
+            m_render_queue.sort();
+
+            count = m_render_queue.count();
+
+            // Les commandes passent toujours par une liste : les constantes de tous les objets sont écrites en un seul map.
+            if (m_command_recorder != nullptr)
+            {
+                m_command_list_count = m_command_recorder->record(static_cast<uint32>(count), m_device_context, [&](uint32 item, device_context &dc) {
+                    m_render_queue[item].item->draw(dc, view_projection);
+                }, count >= parallel_recording_threshold);
+
+                return;
+            }
+
+            for (index = 0; index < count; ++index)
+            {
+                m_render_queue[index].item->draw(m_device_context, view_projection);
+            }
+        }
+
+        uint32 renderer::cull_occluded(const fmat4 &view_projection) noexcept
+        {
+            const usize count = m_drawables.count();
+            usize index;
+
+            float vp[16];
+            load_matrix(view_projection, vp);
+
+            m_occlusion_culler->begin_frame();
+
+            for (index = 0; index < count; ++index)
+            {
+                const ref<drawable> &dr = m_drawables[index];
+
+                fvec3 center;
+                fvec3 extents;
+
+                if (!dr.is_valid() || !dr->is_occluder() || !m_frustum_culler->is_visible(static_cast<uint32>(index)) || !dr->get_local_bounds(center, extents))
+                {
+                    continue;
+                }
+
+                float world[16];
+                float world_view_proj[16];
+
+                load_matrix(dr->get_world(), world);
+                combine_matrices(vp, world, world_view_proj);
+
+                m_occlusion_culler->add_occluder(world_view_proj, center, extents);
+            }
+
+            if (m_occlusion_culler->get_occluder_count() == 0)
+            {
+                return 0;
+            }
+
+            // Les occultants ne sont pas testés : leur profondeur est déjà dans le tampon.
+            for (index = 0; index < count; ++index)
+            {
+                const ref<drawable> &dr = m_drawables[index];
+                const uint32 slot       = static_cast<uint32>(index);
+
+                fvec3 center;
+                fvec3 extents;
+
+                if (!dr.is_valid() || dr->is_occluder() || !m_frustum_culler->is_visible(slot) || !m_frustum_culler->get_bounds(slot, center, extents))
+                {
+                    continue;
+                }
+
+                m_occlusion_culler->add_occludee(slot, center, extents);
+            }
+
+            return m_occlusion_culler->cull(view_projection);
+        }
+
+        void renderer::finish_frame() noexcept
+        {
+            m_last_frame_stats                    = m_device_context.get_frame_stats();
+            m_last_frame_stats.culled_drawables   = m_culled_count;
+            m_last_frame_stats.occluded_drawables = m_occluded_count;
+            m_last_frame_stats.dropped_drawables  = m_dropped_count;
+            m_last_frame_stats.command_lists      = m_command_list_count;
+            m_last_frame_stats.ring_maps          = m_constant_ring.is_valid() ? m_constant_ring->get_frame_maps() : 0;
+
+            if (m_pipeline_cache != nullptr)
+            {
+                m_last_frame_stats.pipeline_lookups    = m_pipeline_cache->get_frame_lookups();
+                m_last_frame_stats.pipeline_cache_hits = m_pipeline_cache->get_frame_hits();
+                m_pipeline_cache->begin_frame();
+            }
+
+            m_device_context.reset_frame_stats();
+
+            m_frame_count++;
+        }
+    } // namespace D3D
+} // namespace deep
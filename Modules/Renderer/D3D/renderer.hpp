@@ -0,0 +1,238 @@
+#ifndef DEEP_ENGINE_D3D_RENDERER_HPP
+#define DEEP_ENGINE_D3D_RENDERER_HPP
+
+#include "deep_d3d_export.h"
+#include <DeepCore/types.hpp>
+#include <DeepLib/object.hpp>
+#include <DeepLib/memory/ref_counted.hpp>
+#include <DeepLib/collection/array_list.hpp>
+#include <DeepLib/maths/vec.hpp>
+#include <DeepLib/maths/mat.hpp>
+
+#include "D3D/device_context.hpp"
+#include "D3D/device_handle.hpp"
+#include "D3D/drawable/drawable.hpp"
+#include "D3D/render_queue.hpp"
+#include "D3D/culling/frustum.hpp"
+
+namespace deep
+{
+    namespace D3D
+    {
+        template class DEEP_D3D_API array_list<ref<drawable>>;
+
+        enum class renderer_backend
+        {
+            Direct3D11,
+            Software,
+            Null
+        };
+
+        class frustum_culler;
+        class bvh;
+        class occlusion_culler;
+        class command_recorder;
+        class pipeline_state_cache;
+        class shader_cache;
+
+        /**
+         * @brief Interface commune à tous les backends de rendu.
+         *
+         * La boucle de jeu ne connaît que cette interface, ce qui permet d'exécuter une scène
+         * sans GPU ni fenêtre avec le backend nul.
+         *
+         * Le périphérique n'est exposé qu'à travers une poignée opaque : l'interface, comme les backends nul et
+         * logiciel, se compile sans le SDK Windows. Seul graphics donne accès aux objets Direct3D 11.
+         */
+        class DEEP_D3D_API renderer : public object
+        {
+          public:
+            renderer()                            = delete;
+            renderer(const renderer &)            = delete;
+            renderer &operator=(const renderer &) = delete;
+
+            virtual ~renderer();
+
+            virtual renderer_backend get_backend() const noexcept = 0;
+
+            virtual void clear_buffer() noexcept                                       = 0;
+            virtual void draw_all(const fmat4 &projection, const fmat4 &view) noexcept = 0;
+            virtual void end_frame() noexcept                                          = 0;
+
+            /**
+             * @brief Récupère le périphérique utilisé pour créer les ressources.
+             * @return Une poignée nulle si le backend ne possède pas de périphérique.
+             */
+            virtual device_handle get_device() noexcept;
+
+            void add_drawable(const ref<drawable> &dr) noexcept;
+            usize get_drawable_count() const noexcept;
+            ref<drawable> get_drawable(usize index) const noexcept;
+
+            fvec4 get_background_color() const noexcept;
+            void set_background_color(const fvec4 &color) noexcept;
+
+            device_context &get_device_context() noexcept;
+            const device_context &get_device_context() const noexcept;
+
+            /**
+             * @brief Récupère les compteurs de la dernière image terminée.
+             */
+            const frame_stats &get_last_frame_stats() const noexcept;
+            ref<constant_ring_buffer> get_constant_ring() const noexcept;
+
+            /**
+             * @brief Récupère l'identifiant de l'état de pipeline décrit, en le créant au premier appel.
+             *
+             * Peut être appelée depuis plusieurs threads. Les descriptions identiques octet par octet partagent
+             * le même identifiant et les mêmes objets Direct3D.
+             * @return invalid_pipeline_state si l'état n'a pas pu être créé.
+             */
+            pipeline_state_id get_pipeline_state(const pipeline_state_desc &desc) noexcept;
+            uint32 get_pipeline_state_count() const noexcept;
+
+            /**
+             * @brief Cache des shaders à passer à shader_factory, pour partager les shaders de même bytecode.
+             */
+            shader_cache *get_shader_cache() noexcept;
+
+            /**
+             * @brief Active l'élimination des objets hors du volume de vue, activée par défaut.
+             */
+            void set_frustum_culling(bool enabled) noexcept;
+            bool is_frustum_culling_enabled() const noexcept;
+
+            /**
+             * @brief Active l'élimination des objets cachés par les occultants, activée par défaut.
+             *
+             * Le test n'est effectué qu'avec l'élimination par volume de vue et lorsqu'au moins un objet visible est occultant.
+             */
+            void set_occlusion_culling(bool enabled) noexcept;
+            bool is_occlusion_culling_enabled() const noexcept;
+
+            /**
+             * @brief Définit le nombre de threads qui enregistrent les commandes de dessin.
+             *
+             * Chaque thread enregistre une partie de la file de dessin dans sa propre liste de commandes,
+             * puis les listes sont rejouées dans l'ordre sur le contexte. Avec 1, une seule liste est enregistrée
+             * sur le thread appelant.
+             * @param thread_count 0 pour utiliser tous les cœurs.
+             */
+            void set_recording_thread_count(uint32 thread_count) noexcept;
+            uint32 get_recording_thread_count() const noexcept;
+
+            /**
+             * @brief Recherche l'objet le plus proche touché par un rayon.
+             *
+             * Les requêtes spatiales utilisent les boîtes englobantes de la dernière image soumise.
+             * @param distance La distance au point d'entrée dans la boîte, en multiples de la longueur de 'direction'.
+             * @return Une référence invalide si aucun objet n'est touché.
+             */
+            ref<drawable> pick_drawable(const fvec3 &origin, const fvec3 &direction, float max_distance, float &distance) const noexcept;
+
+            /**
+             * @brief Ajoute à 'out' les objets dont la boîte englobante touche la boîte donnée.
+             * @return Le nombre d'objets ajoutés.
+             */
+            usize query_drawables(const fvec3 &center, const fvec3 &extents, array_list<ref<drawable>> &out) const noexcept;
+
+            uint64 get_frame_count() const noexcept;
+
+            /**
+             * @brief Définit le nombre de synchronisations verticales attendues avant d'afficher une image, 1 par défaut.
+             *
+             * Avec 0, l'image est affichée sans attendre l'écran : le rythme est alors donné par la boucle de jeu.
+             * Les backends sans écran ignorent la valeur.
+             * @param interval Entre 0 et 4.
+             */
+            void set_sync_interval(uint32 interval) noexcept;
+            uint32 get_sync_interval() const noexcept;
+
+          protected:
+            // En dessous, tester toutes les boîtes d'un bloc SIMD est plus rapide que de parcourir la hiérarchie.
+            static constexpr usize hierarchical_culling_threshold = 1024;
+
+            // En dessous, répartir l'enregistrement entre plusieurs threads coûte plus qu'il ne rapporte.
+            static constexpr usize parallel_recording_threshold = 256;
+
+          protected:
+            renderer(const ref<ctx> &context) noexcept;
+
+            /**
+             * @brief Crée l'anneau de constantes partagé par les objets de la scène.
+             * @param device Le périphérique, nul pour conserver l'anneau côté CPU.
+             */
+            bool init_constant_ring(device_handle device, uint32 capacity = constant_ring_buffer::default_capacity) noexcept;
+
+            /**
+             * @brief Crée le cache des états de pipeline et applique l'état par défaut.
+             * @param device Le périphérique, nul pour ne conserver que les descriptions.
+             */
+            bool init_pipeline_states(device_handle device) noexcept;
+
+            /**
+             * @brief Soumet tous les objets visibles de la scène au contexte, triés par clé de dessin.
+             *
+             * Les objets hors du volume de vue ou cachés par les occultants sont ignorés. Les objets partageant les mêmes shaders
+             * et la même texture sont soumis ensemble, du plus proche au plus éloigné de la caméra.
+             */
+            void submit_drawables(const fmat4 &view_projection) noexcept;
+
+            /**
+             * @brief Rastérise les occultants visibles puis teste les autres objets visibles.
+             * @return Le nombre d'objets cachés.
+             */
+            uint32 cull_occluded(const fmat4 &view_projection) noexcept;
+
+            /**
+             * @brief Archive les compteurs de l'image courante et les remet à zéro.
+             */
+            void finish_frame() noexcept;
+
+          protected:
+            DEEP_FVEC4(m_background_color)
+
+            // La 'device context' permet l'utilisation des ressources créées avec le 'device'.
+            device_context m_device_context;
+
+            array_list<ref<drawable>> m_drawables;
+            render_queue m_render_queue;
+
+            // Boîtes englobantes des objets, à l'indice qu'ils occupent dans m_drawables.
+            frustum_culler *m_frustum_culler;
+
+            // Hiérarchie des mêmes boîtes, indexée par l'indice des objets, pour les requêtes spatiales.
+            bvh *m_bvh;
+
+            bool m_frustum_culling;
+            uint32 m_culled_count;
+
+            // Tampon de profondeur des occultants, rempli sur le CPU.
+            occlusion_culler *m_occlusion_culler;
+            bool m_occlusion_culling;
+            uint32 m_occluded_count;
+
+            // Objets qui n'ont pas pu être ajoutés à la file de dessin durant l'image.
+            uint32 m_dropped_count;
+
+            // Threads et listes de commandes de la soumission parallèle, nul pour soumettre depuis le thread appelant.
+            command_recorder *m_command_recorder;
+            uint32 m_command_list_count;
+
+            DEEP_REF(constant_ring_buffer, m_constant_ring)
+
+            // États de pipeline dédupliqués, partagés par le contexte immédiat.
+            pipeline_state_cache *m_pipeline_cache;
+
+            // Shaders déjà créés, indexés par le haché de leur bytecode et de leur input layout.
+            shader_cache *m_shader_cache;
+
+            frame_stats m_last_frame_stats;
+            uint64 m_frame_count;
+
+            uint32 m_sync_interval;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -1,13 +1,100 @@
 #include "resource_factory.hpp"
-#include "error.hpp"
+#include "D3D/mipmap.hpp"
+#include "D3D/block_compression.hpp"
 
 #include <DeepLib/context.hpp>
+#include <DeepLib/memory/memory.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#ifdef DEEP_D3D11
+#    include "D3D/error.hpp"
+#    include "D3D/native_d3d11.hpp"
+#endif
 
 namespace deep
 {
     namespace D3D
     {
-        ref<vertex_buffer> resource_factory::create_vertex_buffer(const ref<ctx> &context, const void *data, uint32 bytes_size, uint32 stride, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        namespace
+        {
+            /**
+             * @brief Vérifie l'en-tête et la table des niveaux d'une texture préparée.
+             * @return nullptr si les données sont invalides ou tronquées.
+             */
+            const cooked_texture_header *read_cooked_header(const uint8 *data, usize bytes_size) noexcept
+            {
+                if (bytes_size < sizeof(cooked_texture_header))
+                {
+                    return nullptr;
+                }
+
+                const cooked_texture_header *header = reinterpret_cast<const cooked_texture_header *>(data);
+
+                if (header->magic != texture_cooker::magic || header->version != texture_cooker::version ||
+                    header->format > static_cast<uint16>(texture_format::BC7) || header->width == 0 || header->height == 0 ||
+                    header->level_count == 0 || header->level_count > mip_chain::get_level_count(header->width, header->height))
+                {
+                    return nullptr;
+                }
+
+                if (bytes_size < sizeof(cooked_texture_header) + sizeof(cooked_texture_level) * header->level_count)
+                {
+                    return nullptr;
+                }
+
+                const texture_format format        = static_cast<texture_format>(header->format);
+                const cooked_texture_level *levels = reinterpret_cast<const cooked_texture_level *>(header + 1);
+                uint32 width                       = header->width;
+                uint32 height                      = header->height;
+                uint32 level;
+
+                for (level = 0; level < header->level_count; ++level)
+                {
+                    const uint32 row_pitch = block_compression::get_row_pitch(format, width);
+
+                    if (levels[level].row_pitch != row_pitch || levels[level].size != row_pitch * block_compression::get_row_count(format, height) ||
+                        static_cast<usize>(levels[level].offset) + levels[level].size > bytes_size)
+                    {
+                        return nullptr;
+                    }
+
+                    width  = std::max(1u, width / 2);
+                    height = std::max(1u, height / 2);
+                }
+
+                return header;
+            }
+
+            /**
+             * @brief Ordre des canaux d'une image 8 bits à 4 canaux.
+             * @return false si l'espace colorimétrique de l'image n'est pas pris en charge.
+             */
+            bool get_channel_order(const image &img, bool &bgra) noexcept
+            {
+                switch (img.get_color_space())
+                {
+                    default:
+                        return false;
+                    case image::color_space::RGBA:
+                    {
+                        bgra = false;
+                    }
+                    break;
+                    case image::color_space::BGRA:
+                    {
+                        bgra = true;
+                    }
+                    break;
+                }
+
+                return true;
+            }
+        } // namespace
+
+        ref<vertex_buffer> resource_factory::create_vertex_buffer(const ref<ctx> &context, const void *data, uint32 bytes_size, uint32 stride, device_handle device) noexcept
         {
             vertex_buffer *vb = mem::alloc_type<vertex_buffer>(context.get(), context);
 
@@ -16,8 +103,29 @@ namespace deep
                 return ref<vertex_buffer>();
             }
 
-            vb->m_offset = 0;
-            vb->m_stride = stride;
+            vb->m_offset     = 0;
+            vb->m_stride     = stride;
+            vb->m_bytes_size = bytes_size;
+
+            // Backend sans GPU : les sommets sont conservés côté CPU.
+            if (!device)
+            {
+                vb->m_data = mem::alloc<uint8>(context.get(), bytes_size);
+
+                if (vb->m_data == nullptr)
+                {
+                    mem::dealloc_type(context.get_memory_manager(), vb);
+
+                    return ref<vertex_buffer>();
+                }
+
+                std::memcpy(vb->m_data, data, bytes_size);
+
+                return ref<vertex_buffer>(context, vb);
+            }
+
+#ifdef DEEP_D3D11
+            ID3D11Device *d3d_device = get_d3d11_device(device);
 
             D3D11_BUFFER_DESC bd   = {};
             bd.BindFlags           = D3D11_BIND_VERTEX_BUFFER;
@@ -30,12 +138,75 @@ namespace deep
             D3D11_SUBRESOURCE_DATA sd = {};
             sd.pSysMem                = data;
 
-            DEEP_DX_CHECK(device->CreateBuffer(&bd, &sd, &vb->m_buffer), context, device)
+            DEEP_DX_CHECK(d3d_device->CreateBuffer(&bd, &sd, &vb->m_buffer), context, d3d_device)
+#endif
+
+            return ref<vertex_buffer>(context, vb);
+        }
+
+        ref<vertex_buffer> resource_factory::create_vertex_buffer(const ref<ctx> &context, const void *data, uint32 vertex_count, const vertex_format &format, device_handle device) noexcept
+        {
+            const uint32 stride = vertex_quantizer::get_stride(format);
+
+            ref<vertex_buffer> vb = create_vertex_buffer(context, data, vertex_count * stride, stride, device);
+
+            if (vb.is_valid())
+            {
+                vb->m_compression = format.compression;
+            }
+
+            return vb;
+        }
+
+        ref<vertex_buffer> resource_factory::create_dynamic_vertex_buffer(const ref<ctx> &context, uint32 bytes_size, uint32 stride, device_handle device) noexcept
+        {
+            vertex_buffer *vb = mem::alloc_type<vertex_buffer>(context.get(), context);
+
+            if (vb == nullptr)
+            {
+                return ref<vertex_buffer>();
+            }
+
+            vb->m_offset     = 0;
+            vb->m_stride     = stride;
+            vb->m_bytes_size = bytes_size;
+            vb->m_dynamic    = true;
+
+            // Backend sans GPU : le contenu est conservé côté CPU.
+            if (!device)
+            {
+                vb->m_data = mem::alloc<uint8>(context.get(), bytes_size);
+
+                if (vb->m_data == nullptr)
+                {
+                    mem::dealloc_type(context.get_memory_manager(), vb);
+
+                    return ref<vertex_buffer>();
+                }
+
+                std::memset(vb->m_data, 0, bytes_size);
+
+                return ref<vertex_buffer>(context, vb);
+            }
+
+#ifdef DEEP_D3D11
+            ID3D11Device *d3d_device = get_d3d11_device(device);
+
+            D3D11_BUFFER_DESC bd   = {};
+            bd.BindFlags           = D3D11_BIND_VERTEX_BUFFER;
+            bd.Usage               = D3D11_USAGE_DYNAMIC;
+            bd.CPUAccessFlags      = D3D11_CPU_ACCESS_WRITE;
+            bd.MiscFlags           = 0;
+            bd.ByteWidth           = bytes_size;
+            bd.StructureByteStride = stride;
+
+            DEEP_DX_CHECK(d3d_device->CreateBuffer(&bd, nullptr, &vb->m_buffer), context, d3d_device)
+#endif
 
             return ref<vertex_buffer>(context, vb);
         }
 
-        ref<constant_buffer> resource_factory::create_constant_buffer(const ref<ctx> &context, const void *data, uint32 bytes_size, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<constant_buffer> resource_factory::create_constant_buffer(const ref<ctx> &context, const void *data, uint32 bytes_size, device_handle device) noexcept
         {
             constant_buffer *cb = mem::alloc_type<constant_buffer>(context.get(), context);
 
@@ -46,6 +217,33 @@ namespace deep
 
             cb->m_bytes_size = bytes_size;
 
+            // Backend sans GPU : le contenu est conservé côté CPU.
+            if (!device)
+            {
+                cb->m_data = mem::alloc<uint8>(context.get(), bytes_size);
+
+                if (cb->m_data == nullptr)
+                {
+                    mem::dealloc_type(context.get_memory_manager(), cb);
+
+                    return ref<constant_buffer>();
+                }
+
+                if (data != nullptr)
+                {
+                    std::memcpy(cb->m_data, data, bytes_size);
+                }
+                else
+                {
+                    std::memset(cb->m_data, 0, bytes_size);
+                }
+
+                return ref<constant_buffer>(context, cb);
+            }
+
+#ifdef DEEP_D3D11
+            ID3D11Device *d3d_device = get_d3d11_device(device);
+
             D3D11_BUFFER_DESC bd   = {};
             bd.BindFlags           = D3D11_BIND_CONSTANT_BUFFER;
             bd.Usage               = D3D11_USAGE_DEFAULT;
@@ -57,12 +255,66 @@ namespace deep
             D3D11_SUBRESOURCE_DATA sd = {};
             sd.pSysMem                = data;
 
-            DEEP_DX_CHECK(device->CreateBuffer(&bd, &sd, &cb->m_buffer), context, device)
+            DEEP_DX_CHECK(d3d_device->CreateBuffer(&bd, &sd, &cb->m_buffer), context, d3d_device)
+#endif
 
             return ref<constant_buffer>(context, cb);
         }
 
-        ref<index_buffer> resource_factory::create_index_buffer(const ref<ctx> &context, const uint16 *indices, uint16 count, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<constant_ring_buffer> resource_factory::create_constant_ring_buffer(const ref<ctx> &context, uint32 capacity, device_handle device) noexcept
+        {
+            // La capacité doit contenir au moins une allocation et rester alignée.
+            capacity = (capacity + constant_ring_buffer::alignment - 1) & ~(constant_ring_buffer::alignment - 1);
+
+            if (capacity == 0)
+            {
+                return ref<constant_ring_buffer>();
+            }
+
+            constant_ring_buffer *ring = mem::alloc_type<constant_ring_buffer>(context.get(), context);
+
+            if (ring == nullptr)
+            {
+                return ref<constant_ring_buffer>();
+            }
+
+            ring->m_capacity = capacity;
+
+            // Backend sans GPU : le contenu est conservé côté CPU.
+            if (!device)
+            {
+                ring->m_data = mem::alloc<uint8>(context.get(), capacity);
+
+                if (ring->m_data == nullptr)
+                {
+                    mem::dealloc_type(context.get_memory_manager(), ring);
+
+                    return ref<constant_ring_buffer>();
+                }
+
+                std::memset(ring->m_data, 0, capacity);
+
+                return ref<constant_ring_buffer>(context, ring);
+            }
+
+#ifdef DEEP_D3D11
+            ID3D11Device *d3d_device = get_d3d11_device(device);
+
+            D3D11_BUFFER_DESC bd   = {};
+            bd.BindFlags           = D3D11_BIND_CONSTANT_BUFFER;
+            bd.Usage               = D3D11_USAGE_DYNAMIC;
+            bd.CPUAccessFlags      = D3D11_CPU_ACCESS_WRITE;
+            bd.MiscFlags           = 0;
+            bd.ByteWidth           = capacity;
+            bd.StructureByteStride = 0;
+
+            DEEP_DX_CHECK(d3d_device->CreateBuffer(&bd, nullptr, &ring->m_buffer), context, d3d_device)
+#endif
+
+            return ref<constant_ring_buffer>(context, ring);
+        }
+
+        ref<index_buffer> resource_factory::create_index_buffer(const ref<ctx> &context, const uint16 *indices, uint16 count, device_handle device) noexcept
         {
             index_buffer *ib = mem::alloc_type<index_buffer>(context.get(), context);
 
@@ -73,6 +325,26 @@ namespace deep
 
             ib->m_count = count;
 
+            // Backend sans GPU : les indices sont conservés côté CPU.
+            if (!device)
+            {
+                ib->m_data = mem::alloc<uint16>(context.get(), count * sizeof(*indices));
+
+                if (ib->m_data == nullptr)
+                {
+                    mem::dealloc_type(context.get_memory_manager(), ib);
+
+                    return ref<index_buffer>();
+                }
+
+                std::memcpy(ib->m_data, indices, count * sizeof(*indices));
+
+                return ref<index_buffer>(context, ib);
+            }
+
+#ifdef DEEP_D3D11
+            ID3D11Device *d3d_device = get_d3d11_device(device);
+
             D3D11_BUFFER_DESC bd   = {};
             bd.BindFlags           = D3D11_BIND_INDEX_BUFFER;
             bd.Usage               = D3D11_USAGE_DEFAULT;
@@ -84,29 +356,216 @@ namespace deep
             D3D11_SUBRESOURCE_DATA sd = {};
             sd.pSysMem                = indices;
 
-            DEEP_DX_CHECK(device->CreateBuffer(&bd, &sd, &ib->m_buffer), context, device)
+            DEEP_DX_CHECK(d3d_device->CreateBuffer(&bd, &sd, &ib->m_buffer), context, d3d_device)
+#endif
 
             return ref<index_buffer>(context, ib);
         }
 
-        ref<texture> resource_factory::create_texture(const ref<ctx> &context, const image &img, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<texture> resource_factory::create_texture(const ref<ctx> &context, const image &img, device_handle device, thread_pool *pool) noexcept
         {
-            DXGI_FORMAT format;
-            switch (img.get_color_space())
+            bool bgra;
+
+            if (!get_channel_order(img, bgra))
             {
-                default:
-                    return ref<texture>();
-                case image::color_space::RGBA:
+                return ref<texture>();
+            }
+
+            // Sans GPU, les niveaux réduits ne sont pas utilisés.
+            mip_chain mips;
+
+            if (device)
+            {
+                mips.build(*img, img.get_width(), img.get_height(), img.get_row_bytes(), true, pool);
+            }
+
+            return create_texture(context, img, &mips, device);
+        }
+
+        ref<texture> resource_factory::create_texture(const ref<ctx> &context, const image &img, const mip_chain *mips, device_handle device) noexcept
+        {
+            bool bgra;
+
+            if (!get_channel_order(img, bgra))
+            {
+                return ref<texture>();
+            }
+
+            texture *tex = mem::alloc_type<texture>(context.get(), context);
+
+            if (tex == nullptr)
+            {
+                return ref<texture>();
+            }
+
+            // Backend sans GPU : les pixels sont conservés côté CPU au format RGBA.
+            if (!device)
+            {
+                uint32 width  = img.get_width();
+                uint32 height = img.get_height();
+
+                tex->m_pixels = mem::alloc<uint32>(context.get(), static_cast<usize>(width) * height * sizeof(uint32));
+
+                if (tex->m_pixels == nullptr)
                 {
-                    format = DXGI_FORMAT_R8G8B8A8_UNORM;
+                    mem::dealloc_type(context.get_memory_manager(), tex);
+
+                    return ref<texture>();
                 }
-                break;
-                case image::color_space::BGRA:
+
+                tex->m_width  = width;
+                tex->m_height = height;
+
+                const uint8 *source = *img;
+                uint8 *destination  = reinterpret_cast<uint8 *>(tex->m_pixels);
+                uint32 y;
+                uint32 x;
+
+                for (y = 0; y < height; ++y)
                 {
-                    format = DXGI_FORMAT_B8G8R8A8_UNORM;
+                    const uint8 *row = source + y * img.get_row_bytes();
+
+                    for (x = 0; x < width; ++x)
+                    {
+                        const uint8 *texel = row + x * 4;
+                        uint8 *out         = destination + (static_cast<usize>(y) * width + x) * 4;
+
+                        if (bgra)
+                        {
+                            out[0] = texel[2];
+                            out[1] = texel[1];
+                            out[2] = texel[0];
+                        }
+                        else
+                        {
+                            out[0] = texel[0];
+                            out[1] = texel[1];
+                            out[2] = texel[2];
+                        }
+
+                        out[3] = texel[3];
+                    }
                 }
-                break;
+
+                return ref<texture>(context, tex);
             }
+#ifdef DEEP_D3D11
+            ID3D11Device *d3d_device = get_d3d11_device(device);
+
+
+            const uint32 width  = img.get_width();
+            const uint32 height = img.get_height();
+
+            // Chaîne de mipmaps envoyée avec le niveau 0 en un seul appel.
+            const uint32 level_count = mips != nullptr ? mips->get_count() + 1 : 1;
+
+            D3D11_TEXTURE2D_DESC texture_desc = {};
+            texture_desc.Width                = width;
+            texture_desc.Height               = height;
+            texture_desc.MipLevels            = level_count;
+            texture_desc.ArraySize            = 1;
+            texture_desc.Format               = bgra ? DXGI_FORMAT_B8G8R8A8_UNORM : DXGI_FORMAT_R8G8B8A8_UNORM;
+            texture_desc.SampleDesc.Count     = 1;
+            texture_desc.SampleDesc.Quality   = 0;
+            texture_desc.Usage                = D3D11_USAGE_DEFAULT;
+            texture_desc.BindFlags            = D3D11_BIND_SHADER_RESOURCE;
+            texture_desc.CPUAccessFlags       = 0;
+            texture_desc.MiscFlags            = 0;
+
+            std::vector<D3D11_SUBRESOURCE_DATA> subresources(level_count);
+            subresources[0].pSysMem     = *img;
+            subresources[0].SysMemPitch = static_cast<UINT>(img.get_row_bytes());
+
+            uint32 level;
+
+            for (level = 1; level < level_count; ++level)
+            {
+                subresources[level].pSysMem     = mips->get_pixels(level - 1);
+                subresources[level].SysMemPitch = mips->get_level(level - 1).width * 4;
+            }
+
+            // La texture sera ensuite liée à une 'Shader Resource View'.
+            Microsoft::WRL::ComPtr<ID3D11Texture2D> d3d_texture;
+
+            DEEP_DX_CHECK(d3d_device->CreateTexture2D(&texture_desc, subresources.data(), &d3d_texture), context, d3d_device)
+
+            D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc = {};
+            srv_desc.Format                          = texture_desc.Format;
+            srv_desc.ViewDimension                   = D3D11_SRV_DIMENSION_TEXTURE2D;
+            srv_desc.Texture2D.MostDetailedMip       = 0;
+            srv_desc.Texture2D.MipLevels             = level_count;
+
+            DEEP_DX_CHECK(d3d_device->CreateShaderResourceView(d3d_texture.Get(), &srv_desc, &tex->m_texture_view), context, d3d_device)
+#endif
+
+            return ref<texture>(context, tex);
+        }
+
+        mip_chain *resource_factory::build_mips(const ref<ctx> &context, const image &img, thread_pool *pool) noexcept
+        {
+            bool bgra;
+
+            if (!get_channel_order(img, bgra))
+            {
+                return nullptr;
+            }
+
+            mip_chain *mips = mem::alloc_type<mip_chain>(context.get());
+
+            if (mips != nullptr)
+            {
+                mips->build(*img, img.get_width(), img.get_height(), img.get_row_bytes(), true, pool);
+            }
+
+            return mips;
+        }
+
+        void resource_factory::release_mips(const ref<ctx> &context, mip_chain *mips) noexcept
+        {
+            if (mips != nullptr)
+            {
+                mem::dealloc_type(context.get_memory_manager(), mips);
+            }
+        }
+
+        ref<texture> resource_factory::create_texture(const ref<ctx> &context, stream *cooked, device_handle device) noexcept
+        {
+            usize bytes_size = cooked->get_length();
+            usize bytes_read;
+
+            uint8 *buff = mem::alloc<uint8>(context.get(), bytes_size);
+
+            if (buff == nullptr)
+            {
+                return ref<texture>();
+            }
+
+            if (!cooked->read(buff, bytes_size, &bytes_read))
+            {
+                mem::dealloc(context.get(), buff);
+
+                return ref<texture>();
+            }
+
+            ref<texture> tex = create_texture(context, buff, bytes_read, device);
+
+            mem::dealloc(context.get(), buff);
+
+            return tex;
+        }
+
+        ref<texture> resource_factory::create_texture(const ref<ctx> &context, const void *cooked, usize bytes_size, device_handle device) noexcept
+        {
+            const uint8 *data                   = static_cast<const uint8 *>(cooked);
+            const cooked_texture_header *header = read_cooked_header(data, bytes_size);
+
+            if (header == nullptr)
+            {
+                return ref<texture>();
+            }
+
+            const texture_format format        = static_cast<texture_format>(header->format);
+            const cooked_texture_level *levels = reinterpret_cast<const cooked_texture_level *>(header + 1);
 
             texture *tex = mem::alloc_type<texture>(context.get(), context);
 
@@ -115,12 +574,58 @@ namespace deep
                 return ref<texture>();
             }
 
+            // Backend sans GPU : seul le niveau 0 est conservé, décompressé en RGBA.
+            if (!device)
+            {
+                tex->m_pixels = mem::alloc<uint32>(context.get(), static_cast<usize>(header->width) * header->height * sizeof(uint32));
+
+                if (tex->m_pixels == nullptr || !block_compression::decompress(format, data + levels[0].offset, header->width, header->height, reinterpret_cast<uint8 *>(tex->m_pixels)))
+                {
+                    mem::dealloc_type(context.get_memory_manager(), tex);
+
+                    return ref<texture>();
+                }
+
+                tex->m_width  = header->width;
+                tex->m_height = header->height;
+
+                return ref<texture>(context, tex);
+            }
+
+#ifdef DEEP_D3D11
+            ID3D11Device *d3d_device = get_d3d11_device(device);
+
+            DXGI_FORMAT dxgi_format;
+            switch (format)
+            {
+                default:
+                {
+                    dxgi_format = DXGI_FORMAT_R8G8B8A8_UNORM;
+                }
+                break;
+                case texture_format::BC1:
+                {
+                    dxgi_format = DXGI_FORMAT_BC1_UNORM;
+                }
+                break;
+                case texture_format::BC3:
+                {
+                    dxgi_format = DXGI_FORMAT_BC3_UNORM;
+                }
+                break;
+                case texture_format::BC7:
+                {
+                    dxgi_format = DXGI_FORMAT_BC7_UNORM;
+                }
+                break;
+            }
+
             D3D11_TEXTURE2D_DESC texture_desc = {};
-            texture_desc.Width                = img.get_width();
-            texture_desc.Height               = img.get_height();
-            texture_desc.MipLevels            = 1;
+            texture_desc.Width                = header->width;
+            texture_desc.Height               = header->height;
+            texture_desc.MipLevels            = header->level_count;
             texture_desc.ArraySize            = 1;
-            texture_desc.Format               = format;
+            texture_desc.Format               = dxgi_format;
             texture_desc.SampleDesc.Count     = 1;
             texture_desc.SampleDesc.Quality   = 0;
             texture_desc.Usage                = D3D11_USAGE_DEFAULT;
@@ -128,27 +633,33 @@ namespace deep
             texture_desc.CPUAccessFlags       = 0;
             texture_desc.MiscFlags            = 0;
 
-            D3D11_SUBRESOURCE_DATA sd = { 0 };
-            sd.pSysMem                = *img;
-            sd.SysMemPitch            = static_cast<UINT>(img.get_row_bytes());
+            // Les niveaux pointent directement dans le fichier : aucune copie intermédiaire.
+            std::vector<D3D11_SUBRESOURCE_DATA> subresources(header->level_count);
+            uint32 level;
+
+            for (level = 0; level < header->level_count; ++level)
+            {
+                subresources[level].pSysMem     = data + levels[level].offset;
+                subresources[level].SysMemPitch = levels[level].row_pitch;
+            }
 
-            // La texture sera ensuite liée à une 'Shader Resource View'.
             Microsoft::WRL::ComPtr<ID3D11Texture2D> d3d_texture;
 
-            DEEP_DX_CHECK(device->CreateTexture2D(&texture_desc, &sd, &d3d_texture), context, device)
+            DEEP_DX_CHECK(d3d_device->CreateTexture2D(&texture_desc, subresources.data(), &d3d_texture), context, d3d_device)
 
             D3D11_SHADER_RESOURCE_VIEW_DESC srv_desc = {};
             srv_desc.Format                          = texture_desc.Format;
             srv_desc.ViewDimension                   = D3D11_SRV_DIMENSION_TEXTURE2D;
             srv_desc.Texture2D.MostDetailedMip       = 0;
-            srv_desc.Texture2D.MipLevels             = 1;
+            srv_desc.Texture2D.MipLevels             = header->level_count;
 
-            DEEP_DX_CHECK(device->CreateShaderResourceView(d3d_texture.Get(), &srv_desc, &tex->m_texture_view), context, device)
+            DEEP_DX_CHECK(d3d_device->CreateShaderResourceView(d3d_texture.Get(), &srv_desc, &tex->m_texture_view), context, d3d_device)
+#endif
 
             return ref<texture>(context, tex);
         }
 
-        ref<sampler> resource_factory::create_sampler(const ref<ctx> &context, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<sampler> resource_factory::create_sampler(const ref<ctx> &context, device_handle device) noexcept
         {
             sampler *s = mem::alloc_type<sampler>(context.get(), context);
 
@@ -157,13 +668,23 @@ namespace deep
                 return ref<sampler>();
             }
 
+            // Backend nul : la ressource n'a pas d'équivalent côté GPU.
+            if (!device)
+            {
+                return ref<sampler>(context, s);
+            }
+
+#ifdef DEEP_D3D11
+            ID3D11Device *d3d_device = get_d3d11_device(device);
+
             D3D11_SAMPLER_DESC sampler_desc = {};
             sampler_desc.Filter             = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
             sampler_desc.AddressU           = D3D11_TEXTURE_ADDRESS_WRAP;
             sampler_desc.AddressV           = D3D11_TEXTURE_ADDRESS_WRAP;
             sampler_desc.AddressW           = D3D11_TEXTURE_ADDRESS_WRAP;
 
-            DEEP_DX_CHECK(device->CreateSamplerState(&sampler_desc, &s->m_sampler_state), context, device)
+            DEEP_DX_CHECK(d3d_device->CreateSamplerState(&sampler_desc, &s->m_sampler_state), context, d3d_device)
+#endif
 
             return ref<sampler>(context, s);
         }
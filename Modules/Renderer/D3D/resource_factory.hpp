@@ -6,28 +6,72 @@
 #include "D3D/buffer/vertex_buffer.hpp"
 #include "D3D/buffer/constant_buffer.hpp"
 #include "D3D/buffer/index_buffer.hpp"
+#include "D3D/buffer/constant_ring_buffer.hpp"
 #include "D3D/texture.hpp"
+#include "D3D/cooked_texture.hpp"
 #include "D3D/sampler.hpp"
+#include "D3D/device_handle.hpp"
 
 #include <DeepLib/memory/memory.hpp>
 #include <DeepLib/memory/ref_counted.hpp>
 #include <DeepLib/image/image.hpp>
-
-#include <d3d11.h>
-#include <wrl.h>
+#include <DeepLib/stream/stream.hpp>
 
 namespace deep
 {
     namespace D3D
     {
+        class thread_pool;
+        class mip_chain;
+
         class DEEP_D3D_API resource_factory
         {
           public:
-            static ref<vertex_buffer> create_vertex_buffer(const ref<ctx> &context, const void *data, uint32 bytes_size, uint32 stride, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
-            static ref<constant_buffer> create_constant_buffer(const ref<ctx> &context, const void *data, uint32 bytes_size, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
-            static ref<index_buffer> create_index_buffer(const ref<ctx> &context, const uint16 *indices, uint16 count, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
-            static ref<texture> create_texture(const ref<ctx> &context, const image &img, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
-            static ref<sampler> create_sampler(const ref<ctx> &context, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
+            static ref<vertex_buffer> create_vertex_buffer(const ref<ctx> &context, const void *data, uint32 bytes_size, uint32 stride, device_handle device) noexcept;
+
+            /**
+             * @brief Crée un buffer de sommets déjà rangés dans le format donné, par exemple par vertex_quantizer::quantize.
+             */
+            static ref<vertex_buffer> create_vertex_buffer(const ref<ctx> &context, const void *data, uint32 vertex_count, const vertex_format &format, device_handle device) noexcept;
+
+            /**
+             * @brief Crée un buffer de sommets modifiable à chaque image, par exemple pour les données d'instances.
+             */
+            static ref<vertex_buffer> create_dynamic_vertex_buffer(const ref<ctx> &context, uint32 bytes_size, uint32 stride, device_handle device) noexcept;
+            static ref<constant_buffer> create_constant_buffer(const ref<ctx> &context, const void *data, uint32 bytes_size, device_handle device) noexcept;
+            static ref<constant_ring_buffer> create_constant_ring_buffer(const ref<ctx> &context, uint32 capacity, device_handle device) noexcept;
+            static ref<index_buffer> create_index_buffer(const ref<ctx> &context, const uint16 *indices, uint16 count, device_handle device) noexcept;
+
+            /**
+             * @brief Crée une texture et sa chaîne complète de mipmaps, calculée sur le CPU.
+             * @param pool Threads de l'appelant utilisés pour les grands niveaux, nul pour tout calculer sur le thread appelant.
+             */
+            static ref<texture> create_texture(const ref<ctx> &context, const image &img, device_handle device, thread_pool *pool = nullptr) noexcept;
+
+            /**
+             * @brief Crée une texture dont les mipmaps ont déjà été calculés par build_mips : seul l'envoi au GPU
+             * reste à faire sur le thread appelant.
+             */
+            static ref<texture> create_texture(const ref<ctx> &context, const image &img, const mip_chain *mips, device_handle device) noexcept;
+
+            /**
+             * @brief Calcule sur le CPU la chaîne de mipmaps d'une image, par exemple sur un thread de chargement.
+             * @return La chaîne à libérer avec release_mips, nullptr si l'image n'est pas prise en charge.
+             */
+            static mip_chain *build_mips(const ref<ctx> &context, const image &img, thread_pool *pool = nullptr) noexcept;
+            static void release_mips(const ref<ctx> &context, mip_chain *mips) noexcept;
+
+            /**
+             * @brief Crée une texture depuis un fichier préparé par texture_cooker : tous ses niveaux sont envoyés
+             * tels quels au GPU, sans décodage ni calcul de mipmaps.
+             */
+            static ref<texture> create_texture(const ref<ctx> &context, stream *cooked, device_handle device) noexcept;
+
+            /**
+             * @brief Crée une texture depuis le contenu d'un fichier préparé, déjà en mémoire.
+             */
+            static ref<texture> create_texture(const ref<ctx> &context, const void *cooked, usize bytes_size, device_handle device) noexcept;
+            static ref<sampler> create_sampler(const ref<ctx> &context, device_handle device) noexcept;
         };
     } // namespace D3D
 } // namespace deep
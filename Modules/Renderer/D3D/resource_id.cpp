@@ -0,0 +1,16 @@
+#include "D3D/resource_id.hpp"
+
+#include <atomic>
+
+namespace deep
+{
+    namespace D3D
+    {
+        resource_id generate_resource_id() noexcept
+        {
+            static std::atomic<resource_id> next_id(1);
+
+            return next_id.fetch_add(1, std::memory_order_relaxed);
+        }
+    } // namespace D3D
+} // namespace deep
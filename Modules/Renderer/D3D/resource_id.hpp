@@ -0,0 +1,22 @@
+#ifndef DEEP_ENGINE_D3D_RESOURCE_ID_HPP
+#define DEEP_ENGINE_D3D_RESOURCE_ID_HPP
+
+#include "deep_d3d_export.h"
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Identifiant unique et compact d'une ressource, utilisé pour trier les appels de dessin.
+         *
+         * La valeur 0 est réservée à l'absence de ressource.
+         */
+        using resource_id = uint32;
+
+        DEEP_D3D_API resource_id generate_resource_id() noexcept;
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -1,9 +1,18 @@
 #include "D3D/sampler.hpp"
 
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
+
 namespace deep
 {
     namespace D3D
     {
-
-    }
+        sampler::~sampler() noexcept
+        {
+#ifdef DEEP_D3D11
+            release_native(m_sampler_state);
+#endif
+        }
+    } // namespace D3D
 } // namespace deep
@@ -3,20 +3,20 @@
 
 #include "deep_d3d_export.h"
 #include <DeepLib/object.hpp>
-#include <d3d11.h>
-#include <wrl.h>
+
+struct ID3D11SamplerState;
 
 namespace deep
 {
     namespace D3D
     {
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11SamplerState>;
-
         class DEEP_D3D_API sampler : public object
         {
           public:
+            ~sampler() noexcept;
+
           protected:
-            Microsoft::WRL::ComPtr<ID3D11SamplerState> m_sampler_state;
+            ID3D11SamplerState *m_sampler_state = nullptr;
 
           protected:
             using object::object;
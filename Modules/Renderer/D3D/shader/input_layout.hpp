@@ -0,0 +1,47 @@
+#ifndef DEEP_ENGINE_D3D_INPUT_LAYOUT_HPP
+#define DEEP_ENGINE_D3D_INPUT_LAYOUT_HPP
+
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Type et nombre de composantes d'un attribut de sommet.
+         */
+        enum class element_format : uint8
+        {
+            Float2,
+            Float3,
+            Float4,
+            Half2,
+            Unorm16x4,
+            Snorm16x2
+        };
+
+        enum class input_rate : uint8
+        {
+            PerVertex,
+            PerInstance
+        };
+
+        /**
+         * @brief Description d'un attribut lu par un vertex shader, indépendante du backend.
+         *
+         * Les champs suivent l'ordre de D3D11_INPUT_ELEMENT_DESC, vers lequel le backend Direct3D 11 la convertit.
+         */
+        struct input_element_desc
+        {
+            const char *semantic_name;
+            uint32 semantic_index;
+            element_format format;
+            uint32 input_slot;
+            uint32 aligned_byte_offset;
+            input_rate rate;
+            uint32 instance_step_rate;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
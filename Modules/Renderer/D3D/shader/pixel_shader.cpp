@@ -1,13 +1,29 @@
 #include "pixel_shader.hpp"
 #include "D3D/device_context.hpp"
 
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
+
 namespace deep
 {
     namespace D3D
     {
+        pixel_shader::~pixel_shader() noexcept
+        {
+#ifdef DEEP_D3D11
+            release_native(m_shader);
+#endif
+        }
+
         ID3D11PixelShader *pixel_shader::get() const noexcept
         {
-            return m_shader.Get();
+            return m_shader;
+        }
+
+        resource_id pixel_shader::get_id() const noexcept
+        {
+            return m_id;
         }
     } // namespace D3D
 } // namespace deep
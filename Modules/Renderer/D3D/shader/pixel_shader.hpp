@@ -4,26 +4,30 @@
 #include "deep_d3d_export.h"
 #include <DeepLib/object.hpp>
 
-#include <d3d11.h>
-#include <wrl.h>
+#include "D3D/resource_id.hpp"
+
+struct ID3D11PixelShader;
 
 namespace deep
 {
     namespace D3D
     {
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11PixelShader>;
-
         class DEEP_D3D_API pixel_shader : public object
         {
           public:
             pixel_shader()                                = delete;
             pixel_shader(const pixel_shader &)            = delete;
             pixel_shader &operator=(const pixel_shader &) = delete;
+            ~pixel_shader() noexcept;
 
             ID3D11PixelShader *get() const noexcept;
 
+            resource_id get_id() const noexcept;
+
           private:
-            Microsoft::WRL::ComPtr<ID3D11PixelShader> m_shader;
+            ID3D11PixelShader *m_shader = nullptr;
+
+            resource_id m_id = generate_resource_id();
 
           protected:
             using object::object;
@@ -4,9 +4,6 @@
 #include "deep_d3d_export.h"
 #include <DeepLib/object.hpp>
 
-#include <d3d11.h>
-#include <wrl.h>
-
 namespace deep
 {
     namespace D3D
@@ -0,0 +1,249 @@
+#include "shader_cache.hpp"
+#include "D3D/shader/shader_factory.hpp"
+
+#include <cstring>
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace
+        {
+            constexpr uint64 hash_prime1 = 0x9E3779B185EBCA87ull;
+            constexpr uint64 hash_prime2 = 0xC2B2AE3D27D4EB4Full;
+
+            inline uint64 rotate_left(uint64 value, uint32 bits) noexcept
+            {
+                return (value << bits) | (value >> (64 - bits));
+            }
+
+            inline uint64 mix(uint64 hash, uint64 word) noexcept
+            {
+                hash ^= rotate_left(word * hash_prime2, 31) * hash_prime1;
+
+                return rotate_left(hash, 27) * hash_prime1 + hash_prime2;
+            }
+        } // namespace
+
+        ref<vertex_shader> shader_cache::get_vertex_shader(const ref<ctx> &context, stream *input, const input_element_desc *ied, uint32 ied_count, device_handle device)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!read_bytecode(input))
+            {
+                return ref<vertex_shader>();
+            }
+
+            return find_vertex_shader(context, m_bytecode.data(), m_bytecode.size(), ied, ied_count, device);
+        }
+
+        ref<pixel_shader> shader_cache::get_pixel_shader(const ref<ctx> &context, stream *input, device_handle device)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!read_bytecode(input))
+            {
+                return ref<pixel_shader>();
+            }
+
+            return find_pixel_shader(context, m_bytecode.data(), m_bytecode.size(), device);
+        }
+
+        ref<vertex_shader> shader_cache::get_vertex_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, const input_element_desc *ied, uint32 ied_count, device_handle device)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return find_vertex_shader(context, bytecode, bytes_size, ied, ied_count, device);
+        }
+
+        ref<pixel_shader> shader_cache::get_pixel_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, device_handle device)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return find_pixel_shader(context, bytecode, bytes_size, device);
+        }
+
+        void shader_cache::clear() noexcept
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_vertex_shaders.clear();
+            m_pixel_shaders.clear();
+        }
+
+        uint32 shader_cache::get_shader_count() const noexcept
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return static_cast<uint32>(m_vertex_shaders.size() + m_pixel_shaders.size());
+        }
+
+        uint32 shader_cache::get_hit_count() const noexcept
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_hit_count;
+        }
+
+        uint64 shader_cache::hash_bytes(const void *data, usize bytes_size, uint64 seed) noexcept
+        {
+            const uint8 *bytes = static_cast<const uint8 *>(data);
+            uint64 hash        = seed + hash_prime2 + static_cast<uint64>(bytes_size);
+            usize offset       = 0;
+
+            for (; offset + sizeof(uint64) <= bytes_size; offset += sizeof(uint64))
+            {
+                uint64 word;
+                std::memcpy(&word, bytes + offset, sizeof(word));
+
+                hash = mix(hash, word);
+            }
+
+            // Derniers octets, complétés par des zéros.
+            if (offset < bytes_size)
+            {
+                uint64 word = 0;
+                std::memcpy(&word, bytes + offset, bytes_size - offset);
+
+                hash = mix(hash, word);
+            }
+
+            // Avalanche finale : chaque bit d'entrée influence tous les bits du haché.
+            hash ^= hash >> 33;
+            hash *= hash_prime2;
+            hash ^= hash >> 29;
+            hash *= hash_prime1;
+            hash ^= hash >> 32;
+
+            return hash;
+        }
+
+        uint64 shader_cache::hash_input_layout(const input_element_desc *ied, uint32 ied_count, uint64 seed) noexcept
+        {
+            uint64 hash = hash_bytes(&ied_count, sizeof(ied_count), seed);
+            uint32 index;
+
+            for (index = 0; index < ied_count; ++index)
+            {
+                const input_element_desc &element = ied[index];
+
+                // Le nom de la sémantique est haché par son contenu : son adresse change d'un appel à l'autre.
+                const uint32 fields[6] = {
+                    element.semantic_index,
+                    static_cast<uint32>(element.format),
+                    element.input_slot,
+                    element.aligned_byte_offset,
+                    static_cast<uint32>(element.rate),
+                    element.instance_step_rate
+                };
+
+                hash = hash_bytes(element.semantic_name, std::strlen(element.semantic_name), hash);
+                hash = hash_bytes(fields, sizeof(fields), hash);
+            }
+
+            return hash;
+        }
+
+        bool shader_cache::read_bytecode(stream *input)
+        {
+            const usize bytes_size = input->get_length();
+            usize bytes_read;
+
+            m_bytecode.resize(bytes_size);
+
+            if (!input->read(m_bytecode.data(), bytes_size, &bytes_read))
+            {
+                return false;
+            }
+
+            m_bytecode.resize(bytes_read);
+
+            return true;
+        }
+
+        void shader_cache::make_identity(const void *bytecode, usize bytes_size, const input_element_desc *ied, uint32 ied_count)
+        {
+            const uint8 *bytes = static_cast<const uint8 *>(bytecode);
+            uint32 index;
+
+            m_identity.assign(bytes, bytes + bytes_size);
+
+            for (index = 0; index < ied_count; ++index)
+            {
+                const input_element_desc &element = ied[index];
+
+                const uint32 fields[6] = {
+                    element.semantic_index,
+                    static_cast<uint32>(element.format),
+                    element.input_slot,
+                    element.aligned_byte_offset,
+                    static_cast<uint32>(element.rate),
+                    element.instance_step_rate
+                };
+
+                // Le zéro final sépare le nom des champs suivants.
+                const uint8 *name = reinterpret_cast<const uint8 *>(element.semantic_name);
+                const uint8 *data = reinterpret_cast<const uint8 *>(fields);
+
+                m_identity.insert(m_identity.end(), name, name + std::strlen(element.semantic_name) + 1);
+                m_identity.insert(m_identity.end(), data, data + sizeof(fields));
+            }
+        }
+
+        ref<vertex_shader> shader_cache::find_vertex_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, const input_element_desc *ied, uint32 ied_count, device_handle device)
+        {
+            const uint64 key = hash_input_layout(ied, ied_count, hash_bytes(bytecode, bytes_size));
+
+            make_identity(bytecode, bytes_size, ied, ied_count);
+
+            auto range = m_vertex_shaders.equal_range(key);
+
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second.identity == m_identity)
+                {
+                    m_hit_count++;
+
+                    return it->second.shader;
+                }
+            }
+
+            ref<vertex_shader> vs = shader_factory::create_vertex_shader(context, bytecode, bytes_size, ied, ied_count, device);
+
+            if (vs.is_valid())
+            {
+                m_vertex_shaders.emplace(key, entry<vertex_shader> { vs, m_identity });
+            }
+
+            return vs;
+        }
+
+        ref<pixel_shader> shader_cache::find_pixel_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, device_handle device)
+        {
+            const uint64 key = hash_bytes(bytecode, bytes_size);
+
+            make_identity(bytecode, bytes_size, nullptr, 0);
+
+            auto range = m_pixel_shaders.equal_range(key);
+
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second.identity == m_identity)
+                {
+                    m_hit_count++;
+
+                    return it->second.shader;
+                }
+            }
+
+            ref<pixel_shader> ps = shader_factory::create_pixel_shader(context, bytecode, bytes_size, device);
+
+            if (ps.is_valid())
+            {
+                m_pixel_shaders.emplace(key, entry<pixel_shader> { ps, m_identity });
+            }
+
+            return ps;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,109 @@
+#ifndef DEEP_ENGINE_D3D_SHADER_CACHE_HPP
+#define DEEP_ENGINE_D3D_SHADER_CACHE_HPP
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/memory/ref_counted.hpp>
+#include <DeepLib/stream/stream.hpp>
+
+#include "D3D/shader/vertex_shader.hpp"
+#include "D3D/shader/pixel_shader.hpp"
+#include "D3D/shader/input_layout.hpp"
+#include "D3D/device_handle.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Cache des shaders, indexé par le haché de leur bytecode.
+         *
+         * Un vertex shader est identifié par son bytecode et par la description de son input layout : deux appels
+         * avec le même fichier et les mêmes éléments récupèrent le même shader, sans recréer d'objet Direct3D.
+         * Le haché ne sert qu'à trouver les candidats : chaque entrée garde une copie de son bytecode et de son
+         * input layout, comparée octet par octet avant de renvoyer le shader. Deux shaders différents de même haché
+         * sont conservés côte à côte. Le bytecode est lu dans un tampon réutilisé d'un appel à l'autre.
+         *
+         * Les méthodes peuvent être appelées depuis plusieurs threads.
+         *
+         * Classe interne à DeepD3D, appartenant au renderer et utilisée par shader_factory.
+         */
+        class shader_cache
+        {
+          public:
+            shader_cache() = default;
+
+            shader_cache(const shader_cache &)            = delete;
+            shader_cache &operator=(const shader_cache &) = delete;
+
+            ref<vertex_shader> get_vertex_shader(const ref<ctx> &context, stream *input, const input_element_desc *ied, uint32 ied_count, device_handle device);
+            ref<pixel_shader> get_pixel_shader(const ref<ctx> &context, stream *input, device_handle device);
+
+            /**
+             * @brief Variantes utilisées lorsque le bytecode a déjà été lu, par exemple sur un thread de chargement.
+             */
+            ref<vertex_shader> get_vertex_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, const input_element_desc *ied, uint32 ied_count, device_handle device);
+            ref<pixel_shader> get_pixel_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, device_handle device);
+
+            /**
+             * @brief Libère les shaders qui ne sont plus utilisés que par le cache.
+             */
+            void clear() noexcept;
+
+            uint32 get_shader_count() const noexcept;
+
+            /**
+             * @return Le nombre de demandes servies sans créer de shader.
+             */
+            uint32 get_hit_count() const noexcept;
+
+            /**
+             * @brief Haché 64 bits d'une suite d'octets, lue par mots de 8 octets.
+             */
+            static uint64 hash_bytes(const void *data, usize bytes_size, uint64 seed = 0) noexcept;
+
+            /**
+             * @brief Combine au haché la description d'un input layout, noms de sémantique compris.
+             */
+            static uint64 hash_input_layout(const input_element_desc *ied, uint32 ied_count, uint64 seed) noexcept;
+
+          private:
+            template<typename T>
+            struct entry
+            {
+                ref<T> shader;
+
+                // Bytecode suivi, pour un vertex shader, de la description de son input layout.
+                std::vector<uint8> identity;
+            };
+
+          private:
+            bool read_bytecode(stream *input);
+
+            /**
+             * @brief Copie dans m_identity le bytecode puis la description de l'input layout, noms de sémantique compris.
+             */
+            void make_identity(const void *bytecode, usize bytes_size, const input_element_desc *ied, uint32 ied_count);
+
+            // Appelées avec le mutex verrouillé.
+            ref<vertex_shader> find_vertex_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, const input_element_desc *ied, uint32 ied_count, device_handle device);
+            ref<pixel_shader> find_pixel_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, device_handle device);
+
+          private:
+            mutable std::mutex m_mutex;
+
+            std::vector<uint8> m_bytecode;
+            std::vector<uint8> m_identity;
+
+            std::unordered_multimap<uint64, entry<vertex_shader>> m_vertex_shaders;
+            std::unordered_multimap<uint64, entry<pixel_shader>> m_pixel_shaders;
+
+            uint32 m_hit_count = 0;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -1,18 +1,23 @@
 #include "shader_factory.hpp"
-#include "D3D/error.hpp"
+#include "D3D/shader/shader_cache.hpp"
 #include <DeepLib/memory/memory.hpp>
 
+#ifdef DEEP_D3D11
+#    include "D3D/error.hpp"
+#    include "D3D/native_d3d11.hpp"
+
+#    include <vector>
+#endif
+
 namespace deep
 {
     namespace D3D
     {
-        ref<vertex_shader> shader_factory::create_vertex_shader(const ref<ctx> &context, stream *input, const D3D11_INPUT_ELEMENT_DESC *ied, uint32 ied_count, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<vertex_shader> shader_factory::create_vertex_shader(const ref<ctx> &context, stream *input, const input_element_desc *ied, uint32 ied_count, device_handle device, shader_cache *cache) noexcept
         {
-            vertex_shader *vs = mem::alloc_type<vertex_shader>(context.get(), context);
-
-            if (vs == nullptr)
+            if (cache != nullptr)
             {
-                return ref<vertex_shader>();
+                return cache->get_vertex_shader(context, input, ied, ied_count, device);
             }
 
             usize bytes_size = input->get_length();
@@ -22,34 +27,67 @@ namespace deep
 
             if (buff == nullptr)
             {
-                mem::dealloc_type(context.get_memory_manager(), vs);
-
                 return ref<vertex_shader>();
             }
 
             if (!input->read(buff, bytes_size, &bytes_read))
             {
                 mem::dealloc(context.get(), buff);
-                mem::dealloc_type(context.get_memory_manager(), vs);
 
                 return ref<vertex_shader>();
             }
 
-            DEEP_DX_CHECK(device->CreateVertexShader(buff, bytes_read, nullptr, &vs->m_shader), context, device)
-            DEEP_DX_CHECK(device->CreateInputLayout(ied, ied_count, buff, bytes_read, &vs->m_input_layout), context, device)
+            ref<vertex_shader> vs = create_vertex_shader(context, buff, bytes_read, ied, ied_count, device);
 
             mem::dealloc(context.get(), buff);
 
-            return ref<vertex_shader>(context.get(), vs);
+            return vs;
         }
 
-        ref<pixel_shader> shader_factory::create_pixel_shader(const ref<ctx> &context, stream *input, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept
+        ref<vertex_shader> shader_factory::create_vertex_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, const input_element_desc *ied, uint32 ied_count, device_handle device) noexcept
         {
-            pixel_shader *ps = mem::alloc_type<pixel_shader>(context.get(), context);
+            vertex_shader *vs = mem::alloc_type<vertex_shader>(context.get(), context);
 
-            if (ps == nullptr)
+            if (vs == nullptr)
             {
-                return ref<pixel_shader>();
+                return ref<vertex_shader>();
+            }
+
+#ifdef DEEP_D3D11
+            // Backend nul : aucun shader n'est créé.
+            if (device)
+            {
+                ID3D11Device *d3d_device = get_d3d11_device(device);
+
+                std::vector<D3D11_INPUT_ELEMENT_DESC> d3d_ied(ied_count);
+                uint32 index;
+
+                for (index = 0; index < ied_count; ++index)
+                {
+                    d3d_ied[index] = {
+                        ied[index].semantic_name,
+                        ied[index].semantic_index,
+                        to_d3d(ied[index].format),
+                        ied[index].input_slot,
+                        ied[index].aligned_byte_offset,
+                        ied[index].rate == input_rate::PerInstance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA,
+                        ied[index].instance_step_rate
+                    };
+                }
+
+                DEEP_DX_CHECK(d3d_device->CreateVertexShader(bytecode, bytes_size, nullptr, &vs->m_shader), context, d3d_device)
+                DEEP_DX_CHECK(d3d_device->CreateInputLayout(d3d_ied.data(), ied_count, bytecode, bytes_size, &vs->m_input_layout), context, d3d_device)
+            }
+#endif
+
+            return ref<vertex_shader>(context.get(), vs);
+        }
+
+        ref<pixel_shader> shader_factory::create_pixel_shader(const ref<ctx> &context, stream *input, device_handle device, shader_cache *cache) noexcept
+        {
+            if (cache != nullptr)
+            {
+                return cache->get_pixel_shader(context, input, device);
             }
 
             usize bytes_size = input->get_length();
@@ -59,23 +97,41 @@ namespace deep
 
             if (buff == nullptr)
             {
-                mem::dealloc_type(context.get_memory_manager(), ps);
-
                 return ref<pixel_shader>();
             }
 
             if (!input->read(buff, bytes_size, &bytes_read))
             {
                 mem::dealloc(context.get(), buff);
-                mem::dealloc_type(context.get_memory_manager(), ps);
 
                 return ref<pixel_shader>();
             }
 
-            DEEP_DX_CHECK(device->CreatePixelShader(buff, bytes_read, nullptr, &ps->m_shader), context, device)
+            ref<pixel_shader> ps = create_pixel_shader(context, buff, bytes_read, device);
 
             mem::dealloc(context.get(), buff);
 
+            return ps;
+        }
+
+        ref<pixel_shader> shader_factory::create_pixel_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, device_handle device) noexcept
+        {
+            pixel_shader *ps = mem::alloc_type<pixel_shader>(context.get(), context);
+
+            if (ps == nullptr)
+            {
+                return ref<pixel_shader>();
+            }
+
+#ifdef DEEP_D3D11
+            if (device)
+            {
+                ID3D11Device *d3d_device = get_d3d11_device(device);
+
+                DEEP_DX_CHECK(d3d_device->CreatePixelShader(bytecode, bytes_size, nullptr, &ps->m_shader), context, d3d_device)
+            }
+#endif
+
             return ref<pixel_shader>(context.get(), ps);
         }
     } // namespace D3D
@@ -4,22 +4,34 @@
 #include "deep_d3d_export.h"
 #include "D3D/shader/vertex_shader.hpp"
 #include "D3D/shader/pixel_shader.hpp"
+#include "D3D/shader/input_layout.hpp"
+#include "D3D/device_handle.hpp"
 
 #include <DeepLib/memory/ref_counted.hpp>
 #include <DeepLib/stream/stream.hpp>
 
-#include <d3d11.h>
-#include <wrl.h>
-
 namespace deep
 {
     namespace D3D
     {
+        class shader_cache;
+
         class DEEP_D3D_API shader_factory
         {
           public:
-            static ref<vertex_shader> create_vertex_shader(const ref<ctx> &context, stream *input, const D3D11_INPUT_ELEMENT_DESC *ied, uint32 ied_count, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
-            static ref<pixel_shader> create_pixel_shader(const ref<ctx> &context, stream *input, Microsoft::WRL::ComPtr<ID3D11Device> device) noexcept;
+            /**
+             * @brief Crée un vertex shader à partir du bytecode lu dans 'input'.
+             * @param cache Si non nul, un shader de même bytecode et de même input layout déjà créé est réutilisé.
+             */
+            static ref<vertex_shader> create_vertex_shader(const ref<ctx> &context, stream *input, const input_element_desc *ied, uint32 ied_count, device_handle device, shader_cache *cache = nullptr) noexcept;
+            static ref<vertex_shader> create_vertex_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, const input_element_desc *ied, uint32 ied_count, device_handle device) noexcept;
+
+            /**
+             * @brief Crée un pixel shader à partir du bytecode lu dans 'input'.
+             * @param cache Si non nul, un shader de même bytecode déjà créé est réutilisé.
+             */
+            static ref<pixel_shader> create_pixel_shader(const ref<ctx> &context, stream *input, device_handle device, shader_cache *cache = nullptr) noexcept;
+            static ref<pixel_shader> create_pixel_shader(const ref<ctx> &context, const void *bytecode, usize bytes_size, device_handle device) noexcept;
         };
     } // namespace D3D
 } // namespace deep
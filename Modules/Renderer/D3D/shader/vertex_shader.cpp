@@ -1,20 +1,35 @@
 #include "vertex_shader.hpp"
 #include "D3D/device_context.hpp"
 
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
+
 namespace deep
 {
     namespace D3D
     {
+        vertex_shader::~vertex_shader() noexcept
+        {
+#ifdef DEEP_D3D11
+            release_native(m_input_layout);
+            release_native(m_shader);
+#endif
+        }
 
         ID3D11VertexShader *vertex_shader::get() const noexcept
         {
-            return m_shader.Get();
+            return m_shader;
         }
 
         ID3D11InputLayout *vertex_shader::get_input_layout() const noexcept
         {
-            return m_input_layout.Get();
+            return m_input_layout;
         }
 
+        resource_id vertex_shader::get_id() const noexcept
+        {
+            return m_id;
+        }
     } // namespace D3D
 } // namespace deep
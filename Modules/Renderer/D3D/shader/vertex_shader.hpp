@@ -4,29 +4,33 @@
 #include "deep_d3d_export.h"
 #include <DeepLib/object.hpp>
 
-#include <d3d11.h>
-#include <wrl.h>
+#include "D3D/resource_id.hpp"
+
+struct ID3D11VertexShader;
+struct ID3D11InputLayout;
 
 namespace deep
 {
     namespace D3D
     {
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11VertexShader>;
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11InputLayout>;
-
         class DEEP_D3D_API vertex_shader : public object
         {
           public:
             vertex_shader()                                 = delete;
             vertex_shader(const vertex_shader &)            = delete;
             vertex_shader &operator=(const vertex_shader &) = delete;
+            ~vertex_shader() noexcept;
 
             ID3D11VertexShader *get() const noexcept;
             ID3D11InputLayout *get_input_layout() const noexcept;
 
+            resource_id get_id() const noexcept;
+
           private:
-            Microsoft::WRL::ComPtr<ID3D11VertexShader> m_shader;
-            Microsoft::WRL::ComPtr<ID3D11InputLayout> m_input_layout;
+            ID3D11VertexShader *m_shader      = nullptr;
+            ID3D11InputLayout *m_input_layout = nullptr;
+
+            resource_id m_id = generate_resource_id();
 
           protected:
             using object::object;
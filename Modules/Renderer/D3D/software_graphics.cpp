@@ -0,0 +1,389 @@
+#include "D3D/software_graphics.hpp"
+#include "D3D/software_rasterizer.hpp"
+#include "D3D/transform.hpp"
+
+#include <DeepLib/context.hpp>
+
+#include <cstring>
+
+namespace deep
+{
+    namespace D3D
+    {
+        software_graphics::software_graphics(const ref<ctx> &context, software_rasterizer *rasterizer) noexcept
+                : renderer(context),
+                  m_rasterizer(rasterizer)
+        {
+        }
+
+        software_graphics::~software_graphics()
+        {
+            if (m_rasterizer != nullptr)
+            {
+                mem::dealloc_type(m_context.get_memory_manager(), m_rasterizer);
+            }
+        }
+
+        ref<software_graphics> software_graphics::create(const ref<ctx> &context, uint32 width, uint32 height, const fvec4 &background_color, uint32 thread_count) noexcept
+        {
+            context->out() << "Software renderer initialization...";
+
+            software_rasterizer *rasterizer = mem::alloc_type<software_rasterizer>(context.get(), width, height, thread_count);
+
+            if (rasterizer == nullptr)
+            {
+                return ref<software_graphics>();
+            }
+
+            software_graphics *graph = mem::alloc_type<software_graphics>(context.get(), context, rasterizer);
+
+            if (graph == nullptr)
+            {
+                mem::dealloc_type(context.get_memory_manager(), rasterizer);
+
+                return ref<software_graphics>();
+            }
+
+            graph->m_background_color = background_color;
+
+            if (!graph->init_constant_ring(nullptr) || !graph->init_pipeline_states(nullptr))
+            {
+                mem::dealloc_type(context.get_memory_manager(), graph);
+
+                return ref<software_graphics>();
+            }
+
+            graph->m_device_context.set_draw_callback(on_draw, graph);
+
+            context->out() << " OK (" << rasterizer->get_thread_count() << " threads)\r\n";
+
+            return ref<software_graphics>(context, graph);
+        }
+
+        renderer_backend software_graphics::get_backend() const noexcept
+        {
+            return renderer_backend::Software;
+        }
+
+        void software_graphics::clear_buffer() noexcept
+        {
+            const float color[] = {
+                m_background_color.x,
+                m_background_color.y,
+                m_background_color.z,
+                m_background_color.w
+            };
+
+            uint32 packed = 0;
+            uint32 index;
+
+            for (index = 0; index < 4; ++index)
+            {
+                float value = color[index] < 0.0f ? 0.0f : (color[index] > 1.0f ? 1.0f : color[index]);
+
+                packed |= static_cast<uint32>(value * 255.0f + 0.5f) << (index * 8);
+            }
+
+            m_rasterizer->clear(packed);
+        }
+
+        void software_graphics::draw_all(const fmat4 &projection, const fmat4 &view) noexcept
+        {
+            m_rasterizer->begin_frame();
+
+            submit_drawables(projection * view);
+
+            m_rasterizer->render();
+        }
+
+        void software_graphics::end_frame() noexcept
+        {
+            finish_frame();
+        }
+
+        void software_graphics::on_draw(const device_context &dc, const draw_call &call, void *data)
+        {
+            software_graphics *graph = static_cast<software_graphics *>(data);
+
+            if (graph == nullptr || dc.get_primitive_topology() != primitive_topology::TriangleList)
+            {
+                return;
+            }
+
+            ref<vertex_buffer> vb   = dc.get_binded_vertex_buffer();
+            uint32 per_object_size  = 0;
+            const uint8 *per_object = dc.get_vs_constant_data(1, &per_object_size);
+
+            const bool quantized = vb.is_valid() && vb->get_compression() == vertex_compression::Quantized;
+
+            if (!vb.is_valid() || vb->get_data() == nullptr || vb->get_stride() < (quantized ? sizeof(uint16) * 4 : sizeof(float) * 3) ||
+                per_object == nullptr || per_object_size < sizeof(float) * 16)
+            {
+                return;
+            }
+
+            raster_draw draw = {};
+
+            draw.vertices      = vb->get_data();
+            draw.vertex_stride = vb->get_stride();
+            draw.vertex_count  = vb->get_bytes_size() / vb->get_stride();
+            draw.quantized     = quantized;
+            draw.call          = call;
+
+            std::memcpy(draw.world_view_proj, per_object, sizeof(draw.world_view_proj));
+
+            if (call.indexed)
+            {
+                ref<index_buffer> ib = dc.get_binded_index_buffer();
+
+                if (!ib.is_valid() || ib->get_data() == nullptr)
+                {
+                    return;
+                }
+
+                draw.indices     = ib->get_data();
+                draw.index_count = ib->count();
+            }
+
+            ref<constant_buffer> colors = dc.get_binded_ps_constant_buffer(0);
+
+            if (colors.is_valid() && colors->get_data() != nullptr)
+            {
+                draw.color_count = colors->get_bytes_size() / static_cast<uint32>(sizeof(float) * 4);
+
+                if (draw.color_count > raster_draw::max_colors)
+                {
+                    draw.color_count = raster_draw::max_colors;
+                }
+
+                std::memcpy(draw.colors, colors->get_data(), draw.color_count * sizeof(float) * 4);
+            }
+
+            ref<texture> tex = dc.get_binded_texture();
+
+            if (tex.is_valid() && tex->get_pixels() != nullptr)
+            {
+                draw.texels         = tex->get_pixels();
+                draw.texture_width  = tex->get_width();
+                draw.texture_height = tex->get_height();
+            }
+
+            rasterizer_state state = dc.get_rasterizer_state();
+            draw.cull_front        = state == rasterizer_state::CullFrontSolid || state == rasterizer_state::CullFrontWireframe;
+
+            if (!call.instanced)
+            {
+                graph->m_rasterizer->add_draw(draw);
+
+                return;
+            }
+
+            // Le buffer par objet contient la vue-projection, chaque instance y ajoute sa matrice monde.
+            ref<vertex_buffer> instances = dc.get_binded_instance_buffer();
+
+            if (!instances.is_valid() || instances->get_data() == nullptr || instances->get_stride() < sizeof(float) * 16)
+            {
+                return;
+            }
+
+            const uint32 available = instances->get_bytes_size() / instances->get_stride();
+            uint32 last            = call.start_instance + call.instance_count;
+            uint32 index;
+
+            if (last > available)
+            {
+                last = available;
+            }
+
+            float view_projection[16];
+            std::memcpy(view_projection, draw.world_view_proj, sizeof(view_projection));
+
+            for (index = call.start_instance; index < last; ++index)
+            {
+                float world[16];
+                std::memcpy(world, instances->get_data() + index * instances->get_stride(), sizeof(world));
+
+                combine_matrices(view_projection, world, draw.world_view_proj);
+
+                graph->m_rasterizer->add_draw(draw);
+            }
+        }
+
+        uint32 software_graphics::get_width() const noexcept
+        {
+            return m_rasterizer->get_width();
+        }
+
+        uint32 software_graphics::get_height() const noexcept
+        {
+            return m_rasterizer->get_height();
+        }
+
+        uint32 software_graphics::get_thread_count() const noexcept
+        {
+            return m_rasterizer->get_thread_count();
+        }
+
+        const uint32 *software_graphics::get_pixels() const noexcept
+        {
+            return m_rasterizer->get_color_buffer();
+        }
+
+        uint32 software_graphics::get_row_pitch() const noexcept
+        {
+            return m_rasterizer->get_row_pitch();
+        }
+
+        bool software_graphics::write_tga(stream *output) const noexcept
+        {
+            if (output == nullptr)
+            {
+                return false;
+            }
+
+            uint32 width  = get_width();
+            uint32 height = get_height();
+
+            uint8 header[18] = { 0 };
+            header[2]        = 2; // Image en couleurs vraies, non compressée.
+            header[12]       = static_cast<uint8>(width & 0xFF);
+            header[13]       = static_cast<uint8>((width >> 8) & 0xFF);
+            header[14]       = static_cast<uint8>(height & 0xFF);
+            header[15]       = static_cast<uint8>((height >> 8) & 0xFF);
+            header[16]       = 32;
+            header[17]       = 0x28; // 8 bits d'alpha, origine en haut à gauche.
+
+            usize bytes_written;
+
+            if (!output->write(header, sizeof(header), &bytes_written))
+            {
+                return false;
+            }
+
+            const uint32 *pixels = get_pixels();
+            uint32 pitch         = get_row_pitch();
+            uint8 *row           = mem::alloc<uint8>(get_context_ptr(), static_cast<usize>(width) * 4);
+
+            if (row == nullptr)
+            {
+                return false;
+            }
+
+            bool result = true;
+            uint32 x;
+            uint32 y;
+
+            for (y = 0; y < height && result; ++y)
+            {
+                const uint32 *source = pixels + static_cast<usize>(y) * pitch;
+
+                // Le format TGA stocke les composantes dans l'ordre BGRA.
+                for (x = 0; x < width; ++x)
+                {
+                    uint32 pixel = source[x];
+
+                    row[x * 4 + 0] = static_cast<uint8>((pixel >> 16) & 0xFF);
+                    row[x * 4 + 1] = static_cast<uint8>((pixel >> 8) & 0xFF);
+                    row[x * 4 + 2] = static_cast<uint8>(pixel & 0xFF);
+                    row[x * 4 + 3] = static_cast<uint8>((pixel >> 24) & 0xFF);
+                }
+
+                result = output->write(row, static_cast<usize>(width) * 4, &bytes_written);
+            }
+
+            mem::dealloc(get_context_ptr(), row);
+
+            return result;
+        }
+
+        bool software_graphics::compare_tga(stream *golden, uint32 tolerance, image_comparison &result) const noexcept
+        {
+            result = {};
+
+            if (golden == nullptr)
+            {
+                return false;
+            }
+
+            uint8 header[18];
+            usize bytes_read;
+
+            if (!golden->read(header, sizeof(header), &bytes_read) || bytes_read != sizeof(header))
+            {
+                return false;
+            }
+
+            const uint32 width  = static_cast<uint32>(header[12]) | (static_cast<uint32>(header[13]) << 8);
+            const uint32 height = static_cast<uint32>(header[14]) | (static_cast<uint32>(header[15]) << 8);
+            const uint32 bpp    = header[16] / 8;
+
+            // Seules les images en couleurs vraies non compressées et sans palette sont prises en charge.
+            if (header[1] != 0 || header[2] != 2 || (bpp != 3 && bpp != 4) || width != get_width() || height != get_height())
+            {
+                return false;
+            }
+
+            const usize row_size = static_cast<usize>(width) * bpp;
+            uint8 *row           = mem::alloc<uint8>(get_context_ptr(), row_size > header[0] ? row_size : header[0]);
+
+            if (row == nullptr)
+            {
+                return false;
+            }
+
+            // Le champ d'identification précède les pixels.
+            bool readable = header[0] == 0 || (golden->read(row, header[0], &bytes_read) && bytes_read == header[0]);
+
+            // Sans le bit 5 du descripteur, la première ligne stockée est celle du bas.
+            const bool top_down  = (header[17] & 0x20) != 0;
+            const uint32 *pixels = get_pixels();
+            const uint32 pitch   = get_row_pitch();
+            uint32 x;
+            uint32 y;
+
+            for (y = 0; y < height && readable; ++y)
+            {
+                readable = golden->read(row, row_size, &bytes_read) && bytes_read == row_size;
+
+                if (!readable)
+                {
+                    break;
+                }
+
+                const uint32 *source = pixels + static_cast<usize>(top_down ? y : height - 1 - y) * pitch;
+
+                for (x = 0; x < width; ++x)
+                {
+                    const uint32 pixel    = source[x];
+                    const uint8 *expected = row + static_cast<usize>(x) * bpp;
+
+                    // Le format TGA stocke les composantes dans l'ordre BGRA.
+                    const uint32 actual[4] = { (pixel >> 16) & 0xFF, (pixel >> 8) & 0xFF, pixel & 0xFF, (pixel >> 24) & 0xFF };
+                    uint32 difference      = 0;
+                    uint32 channel;
+
+                    for (channel = 0; channel < bpp; ++channel)
+                    {
+                        const uint32 delta = actual[channel] > expected[channel] ? actual[channel] - expected[channel] : expected[channel] - actual[channel];
+
+                        difference = delta > difference ? delta : difference;
+                    }
+
+                    if (difference > tolerance)
+                    {
+                        result.differing_pixels++;
+                    }
+
+                    if (difference > result.max_difference)
+                    {
+                        result.max_difference = difference;
+                    }
+                }
+            }
+
+            mem::dealloc(get_context_ptr(), row);
+
+            return readable;
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,96 @@
+#ifndef DEEP_ENGINE_D3D_SOFTWARE_GRAPHICS_HPP
+#define DEEP_ENGINE_D3D_SOFTWARE_GRAPHICS_HPP
+
+#include "deep_d3d_export.h"
+#include <DeepCore/types.hpp>
+#include <DeepLib/memory/memory.hpp>
+#include <DeepLib/maths/vec.hpp>
+#include <DeepLib/stream/stream.hpp>
+
+#include "D3D/renderer.hpp"
+
+namespace deep
+{
+    namespace D3D
+    {
+        class software_rasterizer;
+
+        /**
+         * @brief Écart entre la dernière image et une image de référence.
+         */
+        struct image_comparison
+        {
+            // Pixels dont une composante s'écarte de la référence de plus que la tolérance.
+            uint32 differing_pixels;
+
+            // Plus grand écart d'une composante sur toute l'image, entre 0 et 255.
+            uint32 max_difference;
+        };
+
+        /**
+         * @brief Backend de rendu exécuté entièrement sur le CPU.
+         *
+         * Les appels de dessin transmis au contexte sont rastérisés par tuiles sur tous les cœurs,
+         * en émulant les shaders du moteur. L'image produite peut être lue ou enregistrée,
+         * ce qui permet de générer des images de référence sur une machine sans GPU.
+         */
+        class DEEP_D3D_API software_graphics : public renderer
+        {
+          public:
+            software_graphics()                                     = delete;
+            software_graphics(const software_graphics &)            = delete;
+            software_graphics &operator=(const software_graphics &) = delete;
+            ~software_graphics();
+
+            /**
+             * @param thread_count Le nombre de threads de rastérisation, 0 pour utiliser tous les cœurs.
+             */
+            static ref<software_graphics> create(const ref<ctx> &context, uint32 width, uint32 height, const fvec4 &background_color, uint32 thread_count = 0) noexcept;
+
+            virtual renderer_backend get_backend() const noexcept override;
+
+            virtual void clear_buffer() noexcept override;
+
+            virtual void draw_all(const fmat4 &projection, const fmat4 &view) noexcept override;
+
+            virtual void end_frame() noexcept override;
+
+            uint32 get_width() const noexcept;
+            uint32 get_height() const noexcept;
+            uint32 get_thread_count() const noexcept;
+
+            /**
+             * @brief Récupère les pixels de la dernière image, au format RGBA 8 bits.
+             *
+             * Chaque ligne contient get_row_pitch() pixels, dont seuls les get_width() premiers sont visibles.
+             */
+            const uint32 *get_pixels() const noexcept;
+            uint32 get_row_pitch() const noexcept;
+
+            /**
+             * @brief Enregistre la dernière image au format TGA 32 bits non compressé.
+             */
+            bool write_tga(stream *output) const noexcept;
+
+            /**
+             * @brief Compare la dernière image à une image de référence TGA 24 ou 32 bits non compressée.
+             * @param tolerance L'écart accepté sur chaque composante, entre 0 et 255.
+             * @return false si la référence ne peut pas être lue ou n'a pas la taille de l'image.
+             */
+            bool compare_tga(stream *golden, uint32 tolerance, image_comparison &result) const noexcept;
+
+          protected:
+            software_graphics(const ref<ctx> &context, software_rasterizer *rasterizer) noexcept;
+
+            static void on_draw(const device_context &dc, const draw_call &call, void *data);
+
+          private:
+            software_rasterizer *m_rasterizer;
+
+          public:
+            friend memory_manager;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,704 @@
+#include "D3D/software_rasterizer.hpp"
+#include "D3D/vertex_quantization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <emmintrin.h>
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace
+        {
+            // Précision sous-pixel des sommets (1/16 de pixel).
+            constexpr float subpixel_scale = 16.0f;
+
+            uint8 to_unorm8(float value) noexcept
+            {
+                if (!(value > 0.0f))
+                {
+                    return 0;
+                }
+
+                if (value >= 1.0f)
+                {
+                    return 255;
+                }
+
+                return static_cast<uint8>(value * 255.0f + 0.5f);
+            }
+
+            uint32 pack_color(const float *color) noexcept
+            {
+                return static_cast<uint32>(to_unorm8(color[0])) |
+                       (static_cast<uint32>(to_unorm8(color[1])) << 8) |
+                       (static_cast<uint32>(to_unorm8(color[2])) << 16) |
+                       (static_cast<uint32>(to_unorm8(color[3])) << 24);
+            }
+
+            bool is_textured(const raster_draw &draw) noexcept
+            {
+                const uint32 textured_stride = draw.quantized ? sizeof(uint16) * 6 : sizeof(float) * 5;
+
+                return draw.texels != nullptr && draw.vertex_stride >= textured_stride;
+            }
+
+            /**
+             * @brief Lit la position puis, si demandé, les coordonnées de texture d'un sommet.
+             *
+             * Une position quantifiée est lue entre 0 et 1 : la déquantification fait partie de la matrice de l'objet.
+             */
+            void read_vertex(const raster_draw &draw, const uint8 *source, bool textured, float *attributes) noexcept
+            {
+                if (!draw.quantized)
+                {
+                    std::memcpy(attributes, source, sizeof(float) * (textured ? 5 : 3));
+
+                    return;
+                }
+
+                uint16 packed[6];
+                std::memcpy(packed, source, sizeof(uint16) * (textured ? 6 : 4));
+
+                attributes[0] = static_cast<float>(packed[0]) / 65535.0f;
+                attributes[1] = static_cast<float>(packed[1]) / 65535.0f;
+                attributes[2] = static_cast<float>(packed[2]) / 65535.0f;
+
+                if (textured)
+                {
+                    attributes[3] = vertex_quantizer::half_to_float(packed[4]);
+                    attributes[4] = vertex_quantizer::half_to_float(packed[5]);
+                }
+            }
+
+            int32 clamp_to_int(float value, int32 low, int32 high) noexcept
+            {
+                if (!(value > static_cast<float>(low)))
+                {
+                    return low;
+                }
+
+                if (value >= static_cast<float>(high))
+                {
+                    return high;
+                }
+
+                return static_cast<int32>(value);
+            }
+
+            /**
+             * @brief Teste l'appartenance de 4 pixels à un côté en appliquant la règle haut-gauche.
+             */
+            __m128 edge_inside(__m128 edge, __m128 top_left) noexcept
+            {
+                const __m128 zero = _mm_setzero_ps();
+
+                return _mm_or_ps(_mm_cmpgt_ps(edge, zero), _mm_and_ps(_mm_cmpeq_ps(edge, zero), top_left));
+            }
+        } // namespace
+
+        software_rasterizer::software_rasterizer(uint32 width, uint32 height, uint32 thread_count)
+                : m_width(width),
+                  m_height(height),
+                  m_row_pitch((width + 3) & ~3u),
+                  m_tiles_x((width + tile_size - 1) / tile_size),
+                  m_tiles_y((height + tile_size - 1) / tile_size),
+                  m_color_buffer(static_cast<usize>(m_row_pitch) * height, 0),
+                  m_depth_buffer(static_cast<usize>(m_row_pitch) * height, 1.0f),
+                  m_clear_pending(false),
+                  m_clear_color(0),
+                  m_batch_count(0),
+                  m_thread_pool(thread_count)
+        {
+        }
+
+        void software_rasterizer::begin_frame() noexcept
+        {
+            m_draws.clear();
+        }
+
+        void software_rasterizer::clear(uint32 color) noexcept
+        {
+            m_clear_pending = true;
+            m_clear_color   = color;
+        }
+
+        void software_rasterizer::add_draw(const raster_draw &draw)
+        {
+            m_draws.push_back(draw);
+        }
+
+        void software_rasterizer::render()
+        {
+            uint32 draw_count = static_cast<uint32>(m_draws.size());
+            uint32 tile_count = m_tiles_x * m_tiles_y;
+            uint32 index;
+
+            // Plusieurs lots par thread pour équilibrer la charge entre des objets de tailles différentes.
+            m_batch_count = std::min(draw_count, m_thread_pool.get_thread_count() * 4);
+
+            if (m_batches.size() < m_batch_count)
+            {
+                m_batches.resize(m_batch_count);
+            }
+
+            for (index = 0; index < m_batch_count; ++index)
+            {
+                batch &b = m_batches[index];
+
+                b.first_draw = static_cast<uint32>(static_cast<uint64>(draw_count) * index / m_batch_count);
+                b.last_draw  = static_cast<uint32>(static_cast<uint64>(draw_count) * (index + 1) / m_batch_count);
+
+                b.bins.resize(tile_count);
+            }
+
+            m_thread_pool.parallel_for(m_batch_count, [this](uint32 batch_index, uint32 /*worker*/) {
+                process_batch(m_batches[batch_index]);
+            });
+
+            m_thread_pool.parallel_for(tile_count, [this](uint32 tile_index, uint32 /*worker*/) {
+                raster_tile(tile_index);
+            });
+
+            m_clear_pending = false;
+        }
+
+        void software_rasterizer::process_batch(batch &b)
+        {
+            b.triangles.clear();
+
+            for (std::vector<uint32> &bin : b.bins)
+            {
+                bin.clear();
+            }
+
+            uint32 draw_index;
+
+            for (draw_index = b.first_draw; draw_index < b.last_draw; ++draw_index)
+            {
+                const raster_draw &draw = m_draws[draw_index];
+                const float *m          = draw.world_view_proj;
+                const bool textured     = is_textured(draw);
+                const uint32 prim_count = draw.call.count / 3;
+                uint32 prim;
+
+                for (prim = 0; prim < prim_count; ++prim)
+                {
+                    clip_vertex v[3];
+                    bool valid = true;
+                    uint32 k;
+
+                    for (k = 0; k < 3; ++k)
+                    {
+                        uint32 element = draw.call.start + prim * 3 + k;
+                        int64 vertex_index;
+
+                        if (draw.call.indexed)
+                        {
+                            if (draw.indices == nullptr || element >= draw.index_count)
+                            {
+                                valid = false;
+                                break;
+                            }
+
+                            vertex_index = static_cast<int64>(draw.indices[element]) + draw.call.base_vertex;
+                        }
+                        else
+                        {
+                            vertex_index = element;
+                        }
+
+                        if (vertex_index < 0 || vertex_index >= draw.vertex_count)
+                        {
+                            valid = false;
+                            break;
+                        }
+
+                        const uint8 *source = draw.vertices + static_cast<usize>(vertex_index) * draw.vertex_stride;
+                        float attributes[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+                        // Position au début du sommet, coordonnées de texture juste après.
+                        read_vertex(draw, source, textured, attributes);
+
+                        // Équivalent de mul(float4(position, 1.0f), world_view_proj) côté HLSL.
+                        v[k].x = m[0] * attributes[0] + m[1] * attributes[1] + m[2] * attributes[2] + m[3];
+                        v[k].y = m[4] * attributes[0] + m[5] * attributes[1] + m[6] * attributes[2] + m[7];
+                        v[k].z = m[8] * attributes[0] + m[9] * attributes[1] + m[10] * attributes[2] + m[11];
+                        v[k].w = m[12] * attributes[0] + m[13] * attributes[1] + m[14] * attributes[2] + m[15];
+                        v[k].u = attributes[3];
+                        v[k].v = attributes[4];
+                    }
+
+                    if (!valid)
+                    {
+                        continue;
+                    }
+
+                    // Rejet des triangles entièrement en dehors d'un plan du volume de vue.
+                    if ((v[0].x < -v[0].w && v[1].x < -v[1].w && v[2].x < -v[2].w) ||
+                        (v[0].x > v[0].w && v[1].x > v[1].w && v[2].x > v[2].w) ||
+                        (v[0].y < -v[0].w && v[1].y < -v[1].w && v[2].y < -v[2].w) ||
+                        (v[0].y > v[0].w && v[1].y > v[1].w && v[2].y > v[2].w) ||
+                        (v[0].z < 0.0f && v[1].z < 0.0f && v[2].z < 0.0f) ||
+                        (v[0].z > v[0].w && v[1].z > v[1].w && v[2].z > v[2].w))
+                    {
+                        continue;
+                    }
+
+                    uint32 color = 0xFFFFFFFF;
+
+                    if (!textured && draw.color_count > 0)
+                    {
+                        // Le pixel shader des cubes indexe ses couleurs avec SV_PrimitiveID / 2.
+                        uint32 color_index = std::min(prim / 2, draw.color_count - 1);
+
+                        color = pack_color(draw.colors[color_index]);
+                    }
+
+                    if (v[0].z >= 0.0f && v[1].z >= 0.0f && v[2].z >= 0.0f)
+                    {
+                        setup_triangle(b, v[0], v[1], v[2], color, draw_index, draw.cull_front);
+
+                        continue;
+                    }
+
+                    // Découpe contre le plan proche (z >= 0).
+                    clip_vertex polygon[4];
+                    uint32 polygon_count = 0;
+
+                    for (k = 0; k < 3; ++k)
+                    {
+                        const clip_vertex &a = v[k];
+                        const clip_vertex &c = v[(k + 1) % 3];
+
+                        if (a.z >= 0.0f)
+                        {
+                            polygon[polygon_count++] = a;
+                        }
+
+                        if ((a.z >= 0.0f) != (c.z >= 0.0f))
+                        {
+                            float t = a.z / (a.z - c.z);
+
+                            clip_vertex &out = polygon[polygon_count++];
+                            out.x            = a.x + (c.x - a.x) * t;
+                            out.y            = a.y + (c.y - a.y) * t;
+                            out.z            = 0.0f;
+                            out.w            = a.w + (c.w - a.w) * t;
+                            out.u            = a.u + (c.u - a.u) * t;
+                            out.v            = a.v + (c.v - a.v) * t;
+                        }
+                    }
+
+                    for (k = 2; k < polygon_count; ++k)
+                    {
+                        setup_triangle(b, polygon[0], polygon[k - 1], polygon[k], color, draw_index, draw.cull_front);
+                    }
+                }
+            }
+        }
+
+        void software_rasterizer::setup_triangle(batch &b, const clip_vertex &v0, const clip_vertex &v1, const clip_vertex &v2, uint32 color, uint32 draw_index, bool cull_front)
+        {
+            const clip_vertex *source[3] = { &v0, &v1, &v2 };
+
+            float sx[3];
+            float sy[3];
+            float sz[3];
+            float inv_w[3];
+            float u[3];
+            float v[3];
+            uint32 k;
+
+            for (k = 0; k < 3; ++k)
+            {
+                const clip_vertex &cv = *source[k];
+
+                if (!(cv.w > 0.0f))
+                {
+                    return;
+                }
+
+                inv_w[k] = 1.0f / cv.w;
+
+                float x = (cv.x * inv_w[k] * 0.5f + 0.5f) * static_cast<float>(m_width);
+                float y = (0.5f - cv.y * inv_w[k] * 0.5f) * static_cast<float>(m_height);
+
+                sx[k] = std::floor(x * subpixel_scale + 0.5f) / subpixel_scale;
+                sy[k] = std::floor(y * subpixel_scale + 0.5f) / subpixel_scale;
+                sz[k] = cv.z * inv_w[k];
+                u[k]  = cv.u * inv_w[k];
+                v[k]  = cv.v * inv_w[k];
+            }
+
+            double area = (static_cast<double>(sy[0]) - sy[1]) * sx[2] +
+                          (static_cast<double>(sx[1]) - sx[0]) * sy[2] +
+                          (static_cast<double>(sx[0]) * sy[1] - static_cast<double>(sy[0]) * sx[1]);
+
+            if (area == 0.0 || std::isnan(area))
+            {
+                return;
+            }
+
+            // FrontCounterClockwise = false : une aire positive (sens horaire à l'écran) désigne une face avant.
+            bool front = area > 0.0;
+
+            if (front == cull_front)
+            {
+                return;
+            }
+
+            if (area < 0.0)
+            {
+                std::swap(sx[1], sx[2]);
+                std::swap(sy[1], sy[2]);
+                std::swap(sz[1], sz[2]);
+                std::swap(inv_w[1], inv_w[2]);
+                std::swap(u[1], u[2]);
+                std::swap(v[1], v[2]);
+
+                area = -area;
+            }
+
+            triangle tri;
+
+            tri.min_x = clamp_to_int(std::floor(std::min({ sx[0], sx[1], sx[2] })), 0, static_cast<int32>(m_width));
+            tri.min_y = clamp_to_int(std::floor(std::min({ sy[0], sy[1], sy[2] })), 0, static_cast<int32>(m_height));
+            tri.max_x = clamp_to_int(std::ceil(std::max({ sx[0], sx[1], sx[2] })), 0, static_cast<int32>(m_width));
+            tri.max_y = clamp_to_int(std::ceil(std::max({ sy[0], sy[1], sy[2] })), 0, static_cast<int32>(m_height));
+
+            if (tri.min_x >= tri.max_x || tri.min_y >= tri.max_y)
+            {
+                return;
+            }
+
+            // Le côté i est opposé au sommet i, sa fonction vaut l'aire du sous-triangle.
+            const double inv_area = 1.0 / area;
+            double plane_c[3];
+
+            for (k = 0; k < 3; ++k)
+            {
+                uint32 a = (k + 1) % 3;
+                uint32 c = (k + 2) % 3;
+
+                tri.edge_a[k] = sy[a] - sy[c];
+                tri.edge_b[k] = sx[c] - sx[a];
+                tri.edge_c[k] = static_cast<double>(sx[a]) * sy[c] - static_cast<double>(sy[a]) * sx[c];
+
+                tri.top_left[k] = tri.edge_a[k] > 0.0f || (tri.edge_a[k] == 0.0f && tri.edge_b[k] > 0.0f);
+
+                plane_c[k] = tri.edge_c[k] * inv_area;
+            }
+
+            float *planes[4]       = { tri.z, tri.inv_w, tri.u_w, tri.v_w };
+            const float *values[4] = { sz, inv_w, u, v };
+            uint32 plane;
+
+            for (plane = 0; plane < 4; ++plane)
+            {
+                const float *f = values[plane];
+
+                planes[plane][0] = static_cast<float>((f[0] * tri.edge_a[0] + f[1] * tri.edge_a[1] + f[2] * tri.edge_a[2]) * inv_area);
+                planes[plane][1] = static_cast<float>((f[0] * tri.edge_b[0] + f[1] * tri.edge_b[1] + f[2] * tri.edge_b[2]) * inv_area);
+                planes[plane][2] = static_cast<float>(f[0] * plane_c[0] + f[1] * plane_c[1] + f[2] * plane_c[2]);
+            }
+
+            tri.color = color;
+            tri.draw  = draw_index;
+
+            uint32 triangle_index = static_cast<uint32>(b.triangles.size());
+            b.triangles.push_back(tri);
+
+            // Répartition dans les tuiles couvertes, en écartant celles situées hors d'un côté.
+            int32 tile_x0 = tri.min_x / static_cast<int32>(tile_size);
+            int32 tile_y0 = tri.min_y / static_cast<int32>(tile_size);
+            int32 tile_x1 = (tri.max_x - 1) / static_cast<int32>(tile_size);
+            int32 tile_y1 = (tri.max_y - 1) / static_cast<int32>(tile_size);
+            int32 tx;
+            int32 ty;
+
+            for (ty = tile_y0; ty <= tile_y1; ++ty)
+            {
+                for (tx = tile_x0; tx <= tile_x1; ++tx)
+                {
+                    double left   = tx * static_cast<double>(tile_size) + 0.5;
+                    double top    = ty * static_cast<double>(tile_size) + 0.5;
+                    double right  = left + tile_size - 1.0;
+                    double bottom = top + tile_size - 1.0;
+                    bool outside  = false;
+
+                    for (k = 0; k < 3 && !outside; ++k)
+                    {
+                        double x = tri.edge_a[k] > 0.0f ? right : left;
+                        double y = tri.edge_b[k] > 0.0f ? bottom : top;
+
+                        outside = tri.edge_a[k] * x + tri.edge_b[k] * y + tri.edge_c[k] < 0.0;
+                    }
+
+                    if (!outside)
+                    {
+                        b.bins[static_cast<usize>(ty) * m_tiles_x + tx].push_back(triangle_index);
+                    }
+                }
+            }
+        }
+
+        void software_rasterizer::raster_tile(uint32 tile_index)
+        {
+            int32 x0 = static_cast<int32>((tile_index % m_tiles_x) * tile_size);
+            int32 y0 = static_cast<int32>((tile_index / m_tiles_x) * tile_size);
+            int32 x1 = std::min(x0 + static_cast<int32>(tile_size), static_cast<int32>(m_width));
+            int32 y1 = std::min(y0 + static_cast<int32>(tile_size), static_cast<int32>(m_height));
+
+            if (m_clear_pending)
+            {
+                // La dernière colonne de tuiles efface aussi le remplissage de fin de ligne.
+                int32 clear_x1 = x1 == static_cast<int32>(m_width) ? static_cast<int32>(m_row_pitch) : x1;
+                int32 y;
+
+                for (y = y0; y < y1; ++y)
+                {
+                    usize row = static_cast<usize>(y) * m_row_pitch;
+
+                    std::fill(m_color_buffer.begin() + row + x0, m_color_buffer.begin() + row + clear_x1, m_clear_color);
+                    std::fill(m_depth_buffer.begin() + row + x0, m_depth_buffer.begin() + row + clear_x1, 1.0f);
+                }
+            }
+
+            uint32 batch_index;
+
+            for (batch_index = 0; batch_index < m_batch_count; ++batch_index)
+            {
+                const batch &b = m_batches[batch_index];
+
+                for (uint32 triangle_index : b.bins[tile_index])
+                {
+                    const triangle &tri = b.triangles[triangle_index];
+
+                    raster_triangle(tri,
+                                    std::max(x0, tri.min_x),
+                                    std::max(y0, tri.min_y),
+                                    std::min(x1, tri.max_x),
+                                    std::min(y1, tri.max_y));
+                }
+            }
+        }
+
+        void software_rasterizer::raster_triangle(const triangle &tri, int32 x0, int32 y0, int32 x1, int32 y1)
+        {
+            if (x0 >= x1 || y0 >= y1)
+            {
+                return;
+            }
+
+            // Les tuiles et le pas des lignes sont des multiples de 4 : un groupe ne déborde jamais sur une autre tuile.
+            const int32 start_x  = x0 & ~3;
+            const float start_cx = static_cast<float>(start_x) + 0.5f;
+
+            const raster_draw &draw = m_draws[tri.draw];
+            const bool textured     = is_textured(draw);
+
+            const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            const __m128 one   = _mm_set1_ps(1.0f);
+            const __m128 zero  = _mm_setzero_ps();
+            const __m128i flat = _mm_set1_epi32(static_cast<int>(tri.color));
+
+            __m128 edge_step[3];
+            __m128 edge_offset[3];
+            __m128 top_left[3];
+            uint32 k;
+
+            for (k = 0; k < 3; ++k)
+            {
+                edge_step[k]   = _mm_set1_ps(tri.edge_a[k] * 4.0f);
+                edge_offset[k] = _mm_mul_ps(_mm_set1_ps(tri.edge_a[k]), lanes);
+                top_left[k]    = _mm_castsi128_ps(_mm_set1_epi32(tri.top_left[k] ? -1 : 0));
+            }
+
+            const __m128 z_step   = _mm_set1_ps(tri.z[0] * 4.0f);
+            const __m128 z_offset = _mm_mul_ps(_mm_set1_ps(tri.z[0]), lanes);
+
+            int32 y;
+
+            for (y = y0; y < y1; ++y)
+            {
+                const float cy = static_cast<float>(y) + 0.5f;
+
+                __m128 edge[3];
+
+                for (k = 0; k < 3; ++k)
+                {
+                    // Évaluation en double au début de la ligne pour garder des valeurs précises sur tout l'écran.
+                    double row_value = static_cast<double>(tri.edge_a[k]) * start_cx + static_cast<double>(tri.edge_b[k]) * cy + tri.edge_c[k];
+
+                    edge[k] = _mm_add_ps(_mm_set1_ps(static_cast<float>(row_value)), edge_offset[k]);
+                }
+
+                __m128 z = _mm_add_ps(_mm_set1_ps(tri.z[0] * start_cx + tri.z[1] * cy + tri.z[2]), z_offset);
+
+                uint32 *color_row = m_color_buffer.data() + static_cast<usize>(y) * m_row_pitch;
+                float *depth_row  = m_depth_buffer.data() + static_cast<usize>(y) * m_row_pitch;
+                int32 x;
+
+                for (x = start_x; x < x1; x += 4)
+                {
+                    __m128 mask = _mm_and_ps(_mm_and_ps(edge_inside(edge[0], top_left[0]),
+                                                        edge_inside(edge[1], top_left[1])),
+                                             edge_inside(edge[2], top_left[2]));
+
+                    if (_mm_movemask_ps(mask) != 0)
+                    {
+                        __m128 depth = _mm_loadu_ps(depth_row + x);
+
+                        mask = _mm_and_ps(mask, _mm_cmplt_ps(z, depth));
+                        mask = _mm_and_ps(mask, _mm_cmpge_ps(z, zero));
+                        mask = _mm_and_ps(mask, _mm_cmple_ps(z, one));
+
+                        int32 bits = _mm_movemask_ps(mask);
+
+                        if (bits != 0)
+                        {
+                            _mm_storeu_ps(depth_row + x, _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, depth)));
+
+                            if (!textured)
+                            {
+                                __m128i mask_i = _mm_castps_si128(mask);
+                                __m128i old    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(color_row + x));
+
+                                _mm_storeu_si128(reinterpret_cast<__m128i *>(color_row + x), _mm_or_si128(_mm_and_si128(mask_i, flat), _mm_andnot_si128(mask_i, old)));
+                            }
+                            else
+                            {
+                                const float cx = static_cast<float>(x) + 0.5f;
+                                int32 lane;
+
+                                for (lane = 0; lane < 4; ++lane)
+                                {
+                                    if ((bits & (1 << lane)) == 0)
+                                    {
+                                        continue;
+                                    }
+
+                                    const float px = cx + static_cast<float>(lane);
+                                    const float iw = tri.inv_w[0] * px + tri.inv_w[1] * cy + tri.inv_w[2];
+                                    const float uw = tri.u_w[0] * px + tri.u_w[1] * cy + tri.u_w[2];
+                                    const float vw = tri.v_w[0] * px + tri.v_w[1] * cy + tri.v_w[2];
+
+                                    color_row[x + lane] = sample(draw, uw / iw, vw / iw);
+                                }
+                            }
+                        }
+                    }
+
+                    for (k = 0; k < 3; ++k)
+                    {
+                        edge[k] = _mm_add_ps(edge[k], edge_step[k]);
+                    }
+
+                    z = _mm_add_ps(z, z_step);
+                }
+            }
+        }
+
+        uint32 software_rasterizer::sample(const raster_draw &draw, float u, float v) noexcept
+        {
+            // Filtrage bilinéaire avec répétition, comme le sampler créé par resource_factory.
+            const int32 width  = static_cast<int32>(draw.texture_width);
+            const int32 height = static_cast<int32>(draw.texture_height);
+
+            if (width == 0 || height == 0 || !std::isfinite(u) || !std::isfinite(v))
+            {
+                return 0;
+            }
+
+            float fx = (u - std::floor(u)) * width - 0.5f;
+            float fy = (v - std::floor(v)) * height - 0.5f;
+
+            float floor_x = std::floor(fx);
+            float floor_y = std::floor(fy);
+
+            uint32 weight_x = static_cast<uint32>((fx - floor_x) * 256.0f);
+            uint32 weight_y = static_cast<uint32>((fy - floor_y) * 256.0f);
+
+            int32 tx0 = static_cast<int32>(floor_x);
+            int32 ty0 = static_cast<int32>(floor_y);
+            int32 tx1 = tx0 + 1;
+            int32 ty1 = ty0 + 1;
+
+            tx0 = (tx0 % width + width) % width;
+            ty0 = (ty0 % height + height) % height;
+            tx1 = tx1 % width;
+            ty1 = ty1 % height;
+
+            const uint32 c00 = draw.texels[ty0 * width + tx0];
+            const uint32 c10 = draw.texels[ty0 * width + tx1];
+            const uint32 c01 = draw.texels[ty1 * width + tx0];
+            const uint32 c11 = draw.texels[ty1 * width + tx1];
+
+            uint32 result = 0;
+            uint32 shift;
+
+            for (shift = 0; shift < 32; shift += 8)
+            {
+                uint32 a = (c00 >> shift) & 0xFF;
+                uint32 b = (c10 >> shift) & 0xFF;
+                uint32 c = (c01 >> shift) & 0xFF;
+                uint32 d = (c11 >> shift) & 0xFF;
+
+                uint32 top    = a * (256 - weight_x) + b * weight_x;
+                uint32 bottom = c * (256 - weight_x) + d * weight_x;
+                uint32 value  = (top * (256 - weight_y) + bottom * weight_y + (1 << 15)) >> 16;
+
+                result |= std::min(value, 255u) << shift;
+            }
+
+            return result;
+        }
+
+        uint32 software_rasterizer::get_width() const noexcept
+        {
+            return m_width;
+        }
+
+        uint32 software_rasterizer::get_height() const noexcept
+        {
+            return m_height;
+        }
+
+        uint32 software_rasterizer::get_row_pitch() const noexcept
+        {
+            return m_row_pitch;
+        }
+
+        uint32 software_rasterizer::get_thread_count() const noexcept
+        {
+            return m_thread_pool.get_thread_count();
+        }
+
+        uint32 software_rasterizer::get_triangle_count() const noexcept
+        {
+            usize count = 0;
+            uint32 index;
+
+            for (index = 0; index < m_batch_count; ++index)
+            {
+                count += m_batches[index].triangles.size();
+            }
+
+            return static_cast<uint32>(count);
+        }
+
+        const uint32 *software_rasterizer::get_color_buffer() const noexcept
+        {
+            return m_color_buffer.data();
+        }
+
+        const float *software_rasterizer::get_depth_buffer() const noexcept
+        {
+            return m_depth_buffer.data();
+        }
+    } // namespace D3D
+} // namespace deep
@@ -0,0 +1,150 @@
+#ifndef DEEP_ENGINE_D3D_SOFTWARE_RASTERIZER_HPP
+#define DEEP_ENGINE_D3D_SOFTWARE_RASTERIZER_HPP
+
+#include <DeepCore/types.hpp>
+
+#include "D3D/device_context.hpp"
+#include "D3D/thread_pool.hpp"
+
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief État capturé lors d'un appel de dessin, suffisant pour émuler les shaders du moteur.
+         */
+        struct raster_draw
+        {
+            static constexpr uint32 max_colors = 8;
+
+            const uint8 *vertices;
+            uint32 vertex_stride;
+            uint32 vertex_count;
+
+            // Positions et coordonnées de texture compressées par vertex_quantizer.
+            bool quantized;
+
+            const uint16 *indices;
+            uint32 index_count;
+
+            draw_call call;
+
+            float world_view_proj[16];
+
+            float colors[max_colors][4];
+            uint32 color_count;
+
+            const uint32 *texels;
+            uint32 texture_width;
+            uint32 texture_height;
+
+            bool cull_front;
+        };
+
+        /**
+         * @brief Rastériseur logiciel par tuiles.
+         *
+         * Les appels de dessin sont découpés en lots transformés en parallèle, chaque lot répartit
+         * ses triangles dans les tuiles de l'écran. Les tuiles sont ensuite rastérisées en parallèle,
+         * en parcourant les lots dans l'ordre de soumission afin que l'image soit déterministe.
+         *
+         * Classe interne à DeepD3D, utilisée par software_graphics.
+         */
+        class software_rasterizer
+        {
+          public:
+            static constexpr uint32 tile_size = 64;
+
+          public:
+            software_rasterizer(uint32 width, uint32 height, uint32 thread_count);
+
+            software_rasterizer(const software_rasterizer &)            = delete;
+            software_rasterizer &operator=(const software_rasterizer &) = delete;
+
+            void begin_frame() noexcept;
+            void clear(uint32 color) noexcept;
+            void add_draw(const raster_draw &draw);
+            void render();
+
+            uint32 get_width() const noexcept;
+            uint32 get_height() const noexcept;
+            uint32 get_row_pitch() const noexcept;
+            uint32 get_thread_count() const noexcept;
+            uint32 get_triangle_count() const noexcept;
+
+            const uint32 *get_color_buffer() const noexcept;
+            const float *get_depth_buffer() const noexcept;
+
+          private:
+            struct triangle
+            {
+                float edge_a[3];
+                float edge_b[3];
+                double edge_c[3];
+                bool top_left[3];
+
+                float z[3];
+                float inv_w[3];
+                float u_w[3];
+                float v_w[3];
+
+                int32 min_x;
+                int32 min_y;
+                int32 max_x;
+                int32 max_y;
+
+                uint32 color;
+                uint32 draw;
+            };
+
+            struct batch
+            {
+                uint32 first_draw;
+                uint32 last_draw;
+                std::vector<triangle> triangles;
+                std::vector<std::vector<uint32>> bins;
+            };
+
+            struct clip_vertex
+            {
+                float x;
+                float y;
+                float z;
+                float w;
+                float u;
+                float v;
+            };
+
+          private:
+            void process_batch(batch &b);
+            void setup_triangle(batch &b, const clip_vertex &v0, const clip_vertex &v1, const clip_vertex &v2, uint32 color, uint32 draw_index, bool cull_front);
+            void raster_tile(uint32 tile_index);
+            void raster_triangle(const triangle &tri, int32 x0, int32 y0, int32 x1, int32 y1);
+
+            static uint32 sample(const raster_draw &draw, float u, float v) noexcept;
+
+          private:
+            uint32 m_width;
+            uint32 m_height;
+            uint32 m_row_pitch;
+            uint32 m_tiles_x;
+            uint32 m_tiles_y;
+
+            std::vector<uint32> m_color_buffer;
+            std::vector<float> m_depth_buffer;
+
+            bool m_clear_pending;
+            uint32 m_clear_color;
+
+            std::vector<raster_draw> m_draws;
+            std::vector<batch> m_batches;
+            uint32 m_batch_count;
+
+            thread_pool m_thread_pool;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
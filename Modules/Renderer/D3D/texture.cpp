@@ -1,12 +1,50 @@
 #include "D3D/texture.hpp"
 
+#include <DeepLib/memory/memory.hpp>
+
+#ifdef DEEP_D3D11
+#    include "D3D/native_d3d11.hpp"
+#endif
+
 namespace deep
 {
     namespace D3D
     {
+        texture::~texture() noexcept
+        {
+#ifdef DEEP_D3D11
+            release_native(m_texture_view);
+#endif
+
+            if (m_pixels != nullptr)
+            {
+                mem::dealloc(get_context_ptr(), m_pixels);
+            }
+        }
+
         ID3D11ShaderResourceView *texture::get() const
         {
-            return m_texture_view.Get();
+            return m_texture_view;
+        }
+
+        resource_id texture::get_id() const noexcept
+        {
+            return m_id;
+        }
+
+        const uint32 *texture::get_pixels() const noexcept
+        {
+            return m_pixels;
+        }
+
+        uint32 texture::get_width() const noexcept
+        {
+            return m_width;
+        }
+
+        uint32 texture::get_height() const noexcept
+        {
+            return m_height;
         }
     } // namespace D3D
 } // namespace deep
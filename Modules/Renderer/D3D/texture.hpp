@@ -3,25 +3,41 @@
 
 #include "deep_d3d_export.h"
 #include <DeepLib/object.hpp>
-#include <d3d11.h>
-#include <wrl.h>
+
+#include "D3D/resource_id.hpp"
+
+struct ID3D11ShaderResourceView;
 
 namespace deep
 {
     namespace D3D
     {
-        template class DEEP_D3D_API Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>;
-
         class DEEP_D3D_API texture : public object
         {
           public:
+            ~texture() noexcept;
+
             ID3D11ShaderResourceView *get() const;
 
+            resource_id get_id() const noexcept;
+
+            /**
+             * @brief Récupère la copie des pixels (RGBA 8 bits) conservée côté CPU.
+             * @return nullptr si la texture a été créée sur un périphérique Direct3D.
+             */
+            const uint32 *get_pixels() const noexcept;
+            uint32 get_width() const noexcept;
+            uint32 get_height() const noexcept;
+
           protected:
             using object::object;
 
           protected:
-            Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_texture_view;
+            ID3D11ShaderResourceView *m_texture_view = nullptr;
+            uint32 m_width   = 0;
+            uint32 m_height  = 0;
+            uint32 *m_pixels = nullptr;
+            resource_id m_id = generate_resource_id();
 
           public:
             friend class resource_factory;
@@ -0,0 +1,199 @@
+#ifndef DEEP_ENGINE_D3D_THREAD_POOL_HPP
+#define DEEP_ENGINE_D3D_THREAD_POOL_HPP
+
+#include <DeepCore/types.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace deep
+{
+    namespace D3D
+    {
+        /**
+         * @brief Groupe de threads de travail partagé par les traitements parallèles du moteur.
+         *
+         * La classe n'est pas exportée et n'est utilisée que de manière interne, à travers un pointeur.
+         */
+        class thread_pool
+        {
+          public:
+            using task = std::function<void(uint32 index, uint32 worker)>;
+
+          public:
+            thread_pool(const thread_pool &)            = delete;
+            thread_pool &operator=(const thread_pool &) = delete;
+
+            /**
+             * @param thread_count Le nombre total de threads, thread appelant compris. 0 pour utiliser tous les cœurs.
+             */
+            explicit thread_pool(uint32 thread_count = 0)
+                    : m_generation(0),
+                      m_stopping(false),
+                      m_count(0),
+                      m_next(0),
+                      m_pending(0)
+            {
+                if (thread_count == 0)
+                {
+                    thread_count = static_cast<uint32>(std::thread::hardware_concurrency());
+
+                    if (thread_count == 0)
+                    {
+                        thread_count = 1;
+                    }
+                }
+
+                uint32 index;
+
+                // Le thread appelant participe aux traitements et porte l'indice 0.
+                for (index = 1; index < thread_count; ++index)
+                {
+                    m_workers.emplace_back(&thread_pool::worker_main, this, index);
+                }
+            }
+
+            ~thread_pool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stopping = true;
+                }
+
+                m_wake.notify_all();
+
+                for (std::thread &worker : m_workers)
+                {
+                    worker.join();
+                }
+            }
+
+            /**
+             * @brief Nombre de threads pouvant exécuter une tâche, thread appelant compris.
+             */
+            uint32 get_thread_count() const noexcept
+            {
+                return static_cast<uint32>(m_workers.size()) + 1;
+            }
+
+            /**
+             * @brief Exécute fn(index, worker) pour chaque index de [0, count) et attend la fin de tous les appels.
+             *
+             * Les index sont distribués dynamiquement, worker est compris dans [0, get_thread_count()).
+             * Un groupe ne traite qu'un appel à la fois : il ne doit pas être partagé entre threads appelants.
+             */
+            void parallel_for(uint32 count, const task &fn)
+            {
+                if (count == 0)
+                {
+                    return;
+                }
+
+                if (m_workers.empty() || count == 1)
+                {
+                    uint32 index;
+
+                    for (index = 0; index < count; ++index)
+                    {
+                        fn(index, 0);
+                    }
+
+                    return;
+                }
+
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+
+                    // Un thread peut encore sortir de la boucle du traitement précédent.
+                    m_done.wait(lock, [this]() { return m_active == 0; });
+
+                    m_task  = &fn;
+                    m_count = count;
+                    m_next.store(0, std::memory_order_relaxed);
+                    m_pending.store(count, std::memory_order_relaxed);
+                    m_generation++;
+                }
+
+                m_wake.notify_all();
+
+                run_tasks(0);
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_done.wait(lock, [this]() { return m_pending.load(std::memory_order_acquire) == 0 && m_active == 0; });
+
+                m_task  = nullptr;
+                m_count = 0;
+            }
+
+          private:
+            void worker_main(uint32 worker)
+            {
+                uint64 seen_generation = 0;
+
+                for (;;)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_wake.wait(lock, [&]() { return m_stopping || m_generation != seen_generation; });
+
+                        if (m_stopping)
+                        {
+                            return;
+                        }
+
+                        seen_generation = m_generation;
+                        m_active++;
+                    }
+
+                    run_tasks(worker);
+
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+
+                        if (--m_active == 0)
+                        {
+                            m_done.notify_all();
+                        }
+                    }
+                }
+            }
+
+            void run_tasks(uint32 worker)
+            {
+                const task *fn = m_task;
+                uint32 index;
+
+                while ((index = m_next.fetch_add(1, std::memory_order_relaxed)) < m_count)
+                {
+                    (*fn)(index, worker);
+
+                    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_done.notify_all();
+                    }
+                }
+            }
+
+          private:
+            std::vector<std::thread> m_workers;
+            std::mutex m_mutex;
+            std::condition_variable m_wake;
+            std::condition_variable m_done;
+            uint64 m_generation;
+            bool m_stopping;
+            uint32 m_active = 0;
+
+            const task *m_task = nullptr;
+            uint32 m_count;
+            std::atomic<uint32> m_next;
+            std::atomic<uint32> m_pending;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef DEEP_ENGINE_D3D_TRANSFORM_HPP
+#define DEEP_ENGINE_D3D_TRANSFORM_HPP
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/maths/vec.hpp>
+#include <DeepLib/maths/mat.hpp>
+
+#include <cmath>
+#include <cstring>
+
+namespace deep
+{
+    namespace D3D
+    {
+        static_assert(sizeof(fmat4) == sizeof(float) * 16, "fmat4 must be copied as-is into constant buffers.");
+
+        /**
+         * @brief Copie les éléments d'une matrice dans l'ordre où les reçoivent les shaders.
+         */
+        inline void load_matrix(const fmat4 &m, float *out) noexcept
+        {
+            std::memcpy(out, &m, sizeof(float) * 16);
+        }
+
+        /**
+         * @brief Compose deux matrices chargées avec load_matrix : appliquer out revient à appliquer b puis a.
+         */
+        inline void combine_matrices(const float *a, const float *b, float *out) noexcept
+        {
+            uint32 row;
+            uint32 column;
+
+            for (row = 0; row < 4; ++row)
+            {
+                for (column = 0; column < 4; ++column)
+                {
+                    out[row * 4 + column] = a[row * 4 + 0] * b[0 * 4 + column] +
+                                            a[row * 4 + 1] * b[1 * 4 + column] +
+                                            a[row * 4 + 2] * b[2 * 4 + column] +
+                                            a[row * 4 + 3] * b[3 * 4 + column];
+                }
+            }
+        }
+
+        /**
+         * @brief Transforme un point comme le fait mul(float4(p, 1.0f), m) dans les shaders du moteur.
+         */
+        inline fvec4 transform_point(const fmat4 &m, const fvec3 &p) noexcept
+        {
+            float e[16];
+            load_matrix(m, e);
+
+            return fvec4(e[0] * p.x + e[1] * p.y + e[2] * p.z + e[3],
+                         e[4] * p.x + e[5] * p.y + e[6] * p.z + e[7],
+                         e[8] * p.x + e[9] * p.y + e[10] * p.z + e[11],
+                         e[12] * p.x + e[13] * p.y + e[14] * p.z + e[15]);
+        }
+
+        /**
+         * @brief Calcule la boîte alignée sur les axes qui contient une boîte transformée par une matrice.
+         */
+        inline void transform_bounds(const fmat4 &m, const fvec3 &center, const fvec3 &extents, fvec3 &out_center, fvec3 &out_extents) noexcept
+        {
+            float e[16];
+            load_matrix(m, e);
+
+            out_center = fvec3(e[0] * center.x + e[1] * center.y + e[2] * center.z + e[3],
+                               e[4] * center.x + e[5] * center.y + e[6] * center.z + e[7],
+                               e[8] * center.x + e[9] * center.y + e[10] * center.z + e[11]);
+
+            out_extents = fvec3(std::fabs(e[0]) * extents.x + std::fabs(e[1]) * extents.y + std::fabs(e[2]) * extents.z,
+                                std::fabs(e[4]) * extents.x + std::fabs(e[5]) * extents.y + std::fabs(e[6]) * extents.z,
+                                std::fabs(e[8]) * extents.x + std::fabs(e[9]) * extents.y + std::fabs(e[10]) * extents.z);
+        }
+    } // namespace D3D
+} // namespace deep
+
+#endif
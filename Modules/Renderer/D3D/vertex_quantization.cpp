@@ -0,0 +1,310 @@
+#include "vertex_quantization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace deep
+{
+    namespace D3D
+    {
+        namespace
+        {
+            uint16 quantize_unorm16(float value, float offset, float scale) noexcept
+            {
+                if (scale <= 0.0f)
+                {
+                    return 0;
+                }
+
+                const float normalized = std::min(std::max((value - offset) / scale, 0.0f), 1.0f);
+
+                return static_cast<uint16>(normalized * 65535.0f + 0.5f);
+            }
+
+            int16 quantize_snorm16(float value) noexcept
+            {
+                const float clamped = std::min(std::max(value, -1.0f), 1.0f);
+
+                return static_cast<int16>(std::lround(clamped * 32767.0f));
+            }
+
+            float sign_not_zero(float value) noexcept
+            {
+                return value >= 0.0f ? 1.0f : -1.0f;
+            }
+        } // namespace
+
+        uint32 vertex_quantizer::get_stride(const vertex_format &format) noexcept
+        {
+            if (format.compression == vertex_compression::Quantized)
+            {
+                return sizeof(uint16) * 4 + (format.has_texcoord ? sizeof(uint16) * 2 : 0) + (format.has_normal ? sizeof(int16) * 2 : 0);
+            }
+
+            return sizeof(float) * 3 + (format.has_texcoord ? sizeof(float) * 2 : 0) + (format.has_normal ? sizeof(float) * 3 : 0);
+        }
+
+        uint32 vertex_quantizer::get_input_layout(const vertex_format &format, input_element_desc *out) noexcept
+        {
+            const bool quantized = format.compression == vertex_compression::Quantized;
+            uint32 count         = 0;
+            uint32 offset        = 0;
+
+            // La quatrième composante de la position quantifiée n'est pas lue par les shaders, qui attendent un 'float3'.
+            out[count++] = { "Position", 0, quantized ? element_format::Unorm16x4 : element_format::Float3, 0, offset, input_rate::PerVertex, 0 };
+            offset += quantized ? sizeof(uint16) * 4 : sizeof(float) * 3;
+
+            if (format.has_texcoord)
+            {
+                out[count++] = { "TexCoord", 0, quantized ? element_format::Half2 : element_format::Float2, 0, offset, input_rate::PerVertex, 0 };
+                offset += quantized ? sizeof(uint16) * 2 : sizeof(float) * 2;
+            }
+
+            // Une normale quantifiée arrive en 'float2' et doit être décodée par le shader (decode_octahedral).
+            if (format.has_normal)
+            {
+                out[count++] = { "Normal", 0, quantized ? element_format::Snorm16x2 : element_format::Float3, 0, offset, input_rate::PerVertex, 0 };
+            }
+
+            return count;
+        }
+
+        void vertex_quantizer::compute_bounds(const vertex_format &format, const void *vertices, uint32 vertex_count, fvec3 &min, fvec3 &max) noexcept
+        {
+            vertex_format source = format;
+            source.compression   = vertex_compression::None;
+
+            const uint32 stride = get_stride(source);
+            const uint8 *bytes  = static_cast<const uint8 *>(vertices);
+            uint32 index;
+
+            min = fvec3();
+            max = fvec3();
+
+            for (index = 0; index < vertex_count; ++index)
+            {
+                float position[3];
+                std::memcpy(position, bytes + static_cast<usize>(index) * stride, sizeof(position));
+
+                if (index == 0)
+                {
+                    min = fvec3(position[0], position[1], position[2]);
+                    max = min;
+
+                    continue;
+                }
+
+                min = fvec3(std::min(min.x, position[0]), std::min(min.y, position[1]), std::min(min.z, position[2]));
+                max = fvec3(std::max(max.x, position[0]), std::max(max.y, position[1]), std::max(max.z, position[2]));
+            }
+        }
+
+        vertex_dequantization vertex_quantizer::get_dequantization(const fvec3 &min, const fvec3 &max) noexcept
+        {
+            vertex_dequantization dequantization;
+            dequantization.offset = min;
+            dequantization.scale  = fvec3(max.x - min.x, max.y - min.y, max.z - min.z);
+
+            return dequantization;
+        }
+
+        void vertex_quantizer::quantize(const vertex_format &format,
+                                        const void *vertices,
+                                        uint32 vertex_count,
+                                        const fvec3 &min,
+                                        const fvec3 &max,
+                                        void *out) noexcept
+        {
+            vertex_format source = format;
+            source.compression   = vertex_compression::None;
+
+            const uint32 source_stride = get_stride(source);
+            const uint32 stride        = get_stride(format);
+
+            if (format.compression == vertex_compression::None)
+            {
+                std::memcpy(out, vertices, static_cast<usize>(vertex_count) * stride);
+
+                return;
+            }
+
+            const vertex_dequantization dequantization = get_dequantization(min, max);
+
+            const uint8 *input = static_cast<const uint8 *>(vertices);
+            uint8 *output      = static_cast<uint8 *>(out);
+            uint32 index;
+
+            for (index = 0; index < vertex_count; ++index)
+            {
+                // Au plus une position, des coordonnées de texture et une normale.
+                float attributes[8];
+                std::memcpy(attributes, input + static_cast<usize>(index) * source_stride, source_stride);
+
+                uint8 *destination = output + static_cast<usize>(index) * stride;
+                const float *next  = attributes + 3;
+
+                const uint16 position[4] = {
+                    quantize_unorm16(attributes[0], dequantization.offset.x, dequantization.scale.x),
+                    quantize_unorm16(attributes[1], dequantization.offset.y, dequantization.scale.y),
+                    quantize_unorm16(attributes[2], dequantization.offset.z, dequantization.scale.z),
+                    0
+                };
+
+                std::memcpy(destination, position, sizeof(position));
+                destination += sizeof(position);
+
+                if (format.has_texcoord)
+                {
+                    const uint16 texcoord[2] = { float_to_half(next[0]), float_to_half(next[1]) };
+
+                    std::memcpy(destination, texcoord, sizeof(texcoord));
+                    destination += sizeof(texcoord);
+                    next += 2;
+                }
+
+                if (format.has_normal)
+                {
+                    int16 normal[2];
+                    encode_octahedral(next, normal);
+
+                    std::memcpy(destination, normal, sizeof(normal));
+                }
+            }
+        }
+
+        uint16 vertex_quantizer::float_to_half(float value) noexcept
+        {
+            uint32 bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            const uint32 sign    = (bits >> 16) & 0x8000;
+            const int32 exponent = static_cast<int32>((bits >> 23) & 0xFF) - 127 + 15;
+            uint32 mantissa      = bits & 0x7FFFFF;
+
+            // Infini et NaN, dont un bit de mantisse est conservé.
+            if ((bits & 0x7FFFFFFF) >= 0x7F800000)
+            {
+                return static_cast<uint16>(sign | 0x7C00 | (mantissa != 0 ? 0x200 : 0));
+            }
+
+            if (exponent >= 31)
+            {
+                return static_cast<uint16>(sign | 0x7C00);
+            }
+
+            // Valeurs dénormalisées en demi-précision, ou trop petites pour être représentées.
+            if (exponent <= 0)
+            {
+                if (exponent < -10)
+                {
+                    return static_cast<uint16>(sign);
+                }
+
+                mantissa |= 0x800000;
+
+                const uint32 shift = static_cast<uint32>(14 - exponent);
+                uint32 half        = mantissa >> shift;
+
+                if ((mantissa >> (shift - 1)) & 1)
+                {
+                    half++;
+                }
+
+                return static_cast<uint16>(sign | half);
+            }
+
+            uint32 half = (static_cast<uint32>(exponent) << 10) | (mantissa >> 13);
+
+            // Arrondi au plus proche : une retenue passe naturellement dans l'exposant.
+            if (mantissa & 0x1000)
+            {
+                half++;
+            }
+
+            return static_cast<uint16>(sign | half);
+        }
+
+        float vertex_quantizer::half_to_float(uint16 value) noexcept
+        {
+            const uint32 sign     = static_cast<uint32>(value & 0x8000) << 16;
+            const uint32 exponent = (value >> 10) & 0x1F;
+            const uint32 mantissa = value & 0x3FF;
+
+            if (exponent == 0)
+            {
+                const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+
+                return sign != 0 ? -magnitude : magnitude;
+            }
+
+            uint32 bits;
+
+            if (exponent == 31)
+            {
+                bits = sign | 0x7F800000 | (mantissa << 13);
+            }
+            else
+            {
+                bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+            }
+
+            float result;
+            std::memcpy(&result, &bits, sizeof(result));
+
+            return result;
+        }
+
+        void vertex_quantizer::encode_octahedral(const float *normal, int16 *out) noexcept
+        {
+            const float length = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+
+            if (length <= 0.0f)
+            {
+                out[0] = 0;
+                out[1] = 0;
+
+                return;
+            }
+
+            float x = normal[0] / length;
+            float y = normal[1] / length;
+
+            // L'hémisphère inférieur est replié sur les coins du carré.
+            if (normal[2] < 0.0f)
+            {
+                const float folded_x = (1.0f - std::fabs(y)) * sign_not_zero(x);
+                const float folded_y = (1.0f - std::fabs(x)) * sign_not_zero(y);
+
+                x = folded_x;
+                y = folded_y;
+            }
+
+            out[0] = quantize_snorm16(x);
+            out[1] = quantize_snorm16(y);
+        }
+
+        void vertex_quantizer::decode_octahedral(const int16 *encoded, float *normal) noexcept
+        {
+            float x = std::max(static_cast<float>(encoded[0]) / 32767.0f, -1.0f);
+            float y = std::max(static_cast<float>(encoded[1]) / 32767.0f, -1.0f);
+
+            const float z = 1.0f - std::fabs(x) - std::fabs(y);
+
+            if (z < 0.0f)
+            {
+                const float unfolded_x = (1.0f - std::fabs(y)) * sign_not_zero(x);
+                const float unfolded_y = (1.0f - std::fabs(x)) * sign_not_zero(y);
+
+                x = unfolded_x;
+                y = unfolded_y;
+            }
+
+            const float length = std::sqrt(x * x + y * y + z * z);
+
+            normal[0] = x / length;
+            normal[1] = y / length;
+            normal[2] = z / length;
+        }
+    } // namespace D3D
+} // namespace deep
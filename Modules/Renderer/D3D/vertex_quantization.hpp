@@ -0,0 +1,99 @@
+#ifndef DEEP_ENGINE_D3D_VERTEX_QUANTIZATION_HPP
+#define DEEP_ENGINE_D3D_VERTEX_QUANTIZATION_HPP
+
+#include "deep_d3d_export.h"
+#include "D3D/shader/input_layout.hpp"
+
+#include <DeepCore/types.hpp>
+#include <DeepLib/maths/vec.hpp>
+
+namespace deep
+{
+    namespace D3D
+    {
+        enum class vertex_compression : uint8
+        {
+            // Positions en 'float3', coordonnées de texture en 'float2' et normales en 'float3'.
+            None = 0,
+
+            // Positions sur 16 bits normalisés dans la boîte englobante, coordonnées de texture en demi-flottants
+            // et normales en projection octaédrique sur 2 x 16 bits.
+            Quantized = 1
+        };
+
+        /**
+         * @brief Attributs d'un sommet, rangés dans l'ordre position, coordonnées de texture puis normale.
+         */
+        struct vertex_format
+        {
+            bool has_texcoord;
+            bool has_normal;
+            vertex_compression compression;
+        };
+
+        /**
+         * @brief Constantes qui ramènent une position quantifiée dans l'espace de l'objet : offset + q * scale.
+         *
+         * Elles sont intégrées à la matrice monde de l'objet (drawable::set_vertex_dequantization) : les
+         * vertex shaders n'ont pas à être modifiés.
+         */
+        struct vertex_dequantization
+        {
+            fvec3 offset;
+            fvec3 scale;
+        };
+
+        /**
+         * @brief Compresse les sommets et génère les input layouts correspondants.
+         *
+         * Un sommet avec position et coordonnées de texture passe de 20 à 12 octets, et de 32 à 16 octets
+         * avec une normale.
+         */
+        class DEEP_D3D_API vertex_quantizer
+        {
+          public:
+            static constexpr uint32 max_layout_elements = 3;
+
+          public:
+            static uint32 get_stride(const vertex_format &format) noexcept;
+
+            /**
+             * @brief Écrit l'input layout du format, avec les sémantiques 'Position', 'TexCoord' et 'Normal' sur le slot 0.
+             * @param out Au moins max_layout_elements entrées.
+             * @return Le nombre d'éléments écrits.
+             */
+            static uint32 get_input_layout(const vertex_format &format, input_element_desc *out) noexcept;
+
+            /**
+             * @brief Calcule la boîte englobante de sommets non compressés.
+             */
+            static void compute_bounds(const vertex_format &format, const void *vertices, uint32 vertex_count, fvec3 &min, fvec3 &max) noexcept;
+
+            static vertex_dequantization get_dequantization(const fvec3 &min, const fvec3 &max) noexcept;
+
+            /**
+             * @brief Convertit des sommets non compressés vers le format demandé.
+             * @param vertices Sommets rangés comme le format sans compression.
+             * @param min Boîte englobante des positions, utilisée par la quantification.
+             * @param out Au moins vertex_count * get_stride(format) octets.
+             */
+            static void quantize(const vertex_format &format,
+                                 const void *vertices,
+                                 uint32 vertex_count,
+                                 const fvec3 &min,
+                                 const fvec3 &max,
+                                 void *out) noexcept;
+
+            static uint16 float_to_half(float value) noexcept;
+            static float half_to_float(uint16 value) noexcept;
+
+            /**
+             * @brief Projette une normale unitaire sur un octaèdre déplié en carré, sur 2 x 16 bits signés.
+             */
+            static void encode_octahedral(const float *normal, int16 *out) noexcept;
+            static void decode_octahedral(const int16 *encoded, float *normal) noexcept;
+        };
+    } // namespace D3D
+} // namespace deep
+
+#endif
@@ -0,0 +1,151 @@
+#include "asset_tools.hpp"
+
+#include "D3D/thread_pool.hpp"
+#include "Assimp/loader.hpp"
+#include "DeepEngine/Assets/pack_file.hpp"
+
+#include <DeepLib/lib.hpp>
+#include <DeepLib/stream/file_stream.hpp>
+#include <DeepLib/image/png.hpp>
+
+#include <filesystem>
+
+namespace deep
+{
+    namespace tools
+    {
+        int cook_texture(const char *input, const char *output, D3D::texture_format format)
+        {
+            ref<ctx> context = lib::create_ctx();
+
+            if (!context.is_valid())
+            {
+                return 1;
+            }
+
+            file_stream source = file_stream(context,
+                                             std::filesystem::path(input).c_str(),
+                                             core_fs::file_mode::Open,
+                                             core_fs::file_access::Read,
+                                             core_fs::file_share::Read);
+
+            if (!source.open())
+            {
+                context->err() << "[ERROR] Cannot open '" << input << "'.\r\n";
+
+                return 1;
+            }
+
+            png png_source = png::load(context, &source);
+
+            if (!png_source.is_valid() || !png_source.check() || !png_source.read_info())
+            {
+                source.close();
+                context->err() << "[ERROR] Cannot load '" << input << "'.\r\n";
+
+                return 1;
+            }
+
+            image img = png_source.read_image(image::color_space::RGBA);
+
+            source.close();
+
+            if (!img.is_valid())
+            {
+                context->err() << "[ERROR] Cannot read image data from '" << input << "'.\r\n";
+
+                return 1;
+            }
+
+            file_stream destination = file_stream(context,
+                                                  std::filesystem::path(output).c_str(),
+                                                  core_fs::file_mode::Create,
+                                                  core_fs::file_access::Write,
+                                                  core_fs::file_share::Read);
+
+            // La préparation est faite hors ligne : tous les cœurs sont utilisés.
+            D3D::thread_pool pool;
+
+            const bool written = destination.open() && D3D::texture_cooker::cook(img, format, &destination, &pool);
+
+            destination.close();
+
+            if (!written)
+            {
+                context->err() << "[ERROR] Cannot write '" << output << "'.\r\n";
+
+                return 1;
+            }
+
+            context->out() << "Texture written to '" << output << "'.\r\n";
+
+            return 0;
+        }
+
+        int cook_mesh(const char *input, const char *output, D3D::vertex_compression compression)
+        {
+            ref<ctx> context = lib::create_ctx();
+
+            if (!context.is_valid())
+            {
+                return 1;
+            }
+
+            file_stream destination = file_stream(context,
+                                                  std::filesystem::path(output).c_str(),
+                                                  core_fs::file_mode::Create,
+                                                  core_fs::file_access::Write,
+                                                  core_fs::file_share::Read);
+
+            model::cook_statistics statistics;
+
+            const bool written = destination.open() && model::loader::cook(context, input, &destination, compression, &statistics);
+
+            destination.close();
+
+            if (!written)
+            {
+                context->err() << "[ERROR] Cannot cook '" << input << "' into '" << output << "'.\r\n";
+
+                return 1;
+            }
+
+            model::loader::print_statistics(context, input, statistics);
+
+            context->out() << "Mesh written to '" << output << "'.\r\n";
+
+            return 0;
+        }
+
+        int pack_folder(const char *input, const char *output)
+        {
+            ref<ctx> context = lib::create_ctx();
+
+            if (!context.is_valid())
+            {
+                return 1;
+            }
+
+            file_stream destination = file_stream(context,
+                                                  std::filesystem::path(output).c_str(),
+                                                  core_fs::file_mode::Create,
+                                                  core_fs::file_access::Write,
+                                                  core_fs::file_share::Read);
+
+            const bool written = destination.open() && pack_builder::build(context, std::filesystem::path(input), &destination);
+
+            destination.close();
+
+            if (!written)
+            {
+                context->err() << "[ERROR] Cannot pack '" << input << "' into '" << output << "'.\r\n";
+
+                return 1;
+            }
+
+            context->out() << "Pack written to '" << output << "'.\r\n";
+
+            return 0;
+        }
+    } // namespace tools
+} // namespace deep
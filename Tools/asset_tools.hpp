@@ -0,0 +1,28 @@
+#ifndef DEEP_ENGINE_TOOLS_ASSET_TOOLS_HPP
+#define DEEP_ENGINE_TOOLS_ASSET_TOOLS_HPP
+
+#include "D3D/cooked_texture.hpp"
+#include "D3D/vertex_quantization.hpp"
+
+namespace deep
+{
+    namespace tools
+    {
+        /**
+         * @brief Prépare une image PNG pour qu'elle soit chargée sans décodage, compressée par blocs avec tous les cœurs.
+         */
+        int cook_texture(const char *input, const char *output, D3D::texture_format format);
+
+        /**
+         * @brief Importe un modèle et écrit le maillage préparé, chargé ensuite sans Assimp ni simplification.
+         */
+        int cook_mesh(const char *input, const char *output, D3D::vertex_compression compression);
+
+        /**
+         * @brief Regroupe les fichiers d'un dossier dans une archive, montée par le moteur au lancement.
+         */
+        int pack_folder(const char *input, const char *output);
+    } // namespace tools
+} // namespace deep
+
+#endif
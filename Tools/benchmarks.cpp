@@ -0,0 +1,317 @@
+#include "benchmarks.hpp"
+
+#include "D3D/null_graphics.hpp"
+#include "D3D/culling/bvh_benchmark.hpp"
+#include "DeepEngine/frame_limiter.hpp"
+
+#include <DeepLib/lib.hpp>
+
+#ifdef _WIN32
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace deep
+{
+    namespace tools
+    {
+        namespace
+        {
+            // Durée de la mesure de --pacing-bench : la première période sert de mise en route du limiteur.
+            constexpr uint32 pacing_bench_seconds = 3;
+
+            /**
+             * @brief Temps processeur consommé par le processus, en mode utilisateur et noyau, en microsecondes.
+             */
+            uint64 get_process_cpu_micros() noexcept
+            {
+#ifdef _WIN32
+                FILETIME creation_time;
+                FILETIME exit_time;
+                FILETIME kernel;
+                FILETIME user;
+
+                if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel, &user))
+                {
+                    return 0;
+                }
+
+                // Les durées sont exprimées en intervalles de 100 ns.
+                const uint64 kernel_ticks = (static_cast<uint64>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+                const uint64 user_ticks   = (static_cast<uint64>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+
+                return (kernel_ticks + user_ticks) / 10;
+#else
+                rusage usage;
+
+                if (getrusage(RUSAGE_SELF, &usage) != 0)
+                {
+                    return 0;
+                }
+
+                return static_cast<uint64>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 +
+                       static_cast<uint64>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+#endif
+            }
+        } // namespace
+
+        int bench_pacing(double fps)
+        {
+            ref<ctx> context = lib::create_ctx();
+
+            if (!context.is_valid())
+            {
+                return 1;
+            }
+
+            frame_limiter limiter;
+            limiter.set_target_fps(fps);
+
+            const uint64 frame_count = static_cast<uint64>(fps * pacing_bench_seconds);
+
+            // Le temps processeur est mesuré sur la même dernière seconde que la régularité.
+            const uint64 measured_frames = static_cast<uint64>(fps) < frame_count ? static_cast<uint64>(fps) : frame_count;
+            const uint64 first_measured  = frame_count - measured_frames;
+            uint64 cpu_start_micros      = 0;
+            uint64 work_micros           = 0;
+
+            // Générateur congruentiel : la même suite de durées de travail à chaque exécution.
+            uint32 seed = 0x2545F491;
+            uint64 frame;
+
+            for (frame = 0; frame < frame_count; ++frame)
+            {
+                if (frame == first_measured)
+                {
+                    cpu_start_micros = get_process_cpu_micros();
+                }
+
+                seed = seed * 1664525u + 1013904223u;
+
+                const auto work = std::chrono::microseconds(3000 + (seed >> 8) % 3001);
+                const auto end  = std::chrono::steady_clock::now() + work;
+
+                if (frame >= first_measured)
+                {
+                    work_micros += static_cast<uint64>(work.count());
+                }
+
+                // Attente active : le travail occupe le processeur comme une vraie image.
+                while (std::chrono::steady_clock::now() < end)
+                {
+                }
+
+                limiter.wait();
+            }
+
+            const uint64 cpu_micros         = get_process_cpu_micros() - cpu_start_micros;
+            const frame_pacing_stats &stats = limiter.get_stats();
+
+            char line[160];
+            std::snprintf(line,
+                          sizeof(line),
+                          "    mean %.3f ms, jitter %.3f ms, max deviation %.3f ms, %u late of %u frames\r\n",
+                          stats.mean_millis,
+                          stats.jitter_millis,
+                          stats.max_deviation_millis,
+                          stats.late_frames,
+                          stats.frame_count);
+
+            context->out() << "Frame pacing at " << static_cast<uint32>(fps) << " FPS, last second:\r\n" << line;
+
+            // Au-delà du travail simulé, le temps processeur est celui de l'attente : l'attente active l'augmente, le sommeil non.
+            if (measured_frames != 0)
+            {
+                const double cpu_per_frame  = static_cast<double>(cpu_micros) / 1000.0 / static_cast<double>(measured_frames);
+                const double work_per_frame = static_cast<double>(work_micros) / 1000.0 / static_cast<double>(measured_frames);
+
+                std::snprintf(line,
+                              sizeof(line),
+                              "    process CPU %.3f ms per frame: %.3f ms of work, %.3f ms waiting\r\n",
+                              cpu_per_frame,
+                              work_per_frame,
+                              cpu_per_frame - work_per_frame);
+
+                context->out() << line;
+            }
+
+            return 0;
+        }
+
+        int bench_bvh(uint32 box_count)
+        {
+            ref<ctx> context = lib::create_ctx();
+
+            if (!context.is_valid())
+            {
+                return 1;
+            }
+
+            const D3D::bvh_benchmark_results results = D3D::bvh_benchmark::run(box_count);
+
+            char line[160];
+
+            context->out() << "BVH benchmark, " << results.box_count << " boxes, " << results.query_count << " queries:\r\n";
+
+            std::snprintf(line, sizeof(line), "    insert:        %10.1f ns\r\n", results.insert_nanos);
+            context->out() << line;
+
+            std::snprintf(line, sizeof(line), "    update:        %10.1f ns (%u of %u changed the tree)\r\n", results.update_nanos, results.tree_updates, results.box_count);
+            context->out() << line;
+
+            std::snprintf(line, sizeof(line), "    query_frustum: %10.1f ns (%.1f boxes found)\r\n", results.query_frustum_nanos, results.frustum_hits);
+            context->out() << line;
+
+            std::snprintf(line, sizeof(line), "    query_bounds:  %10.1f ns (%.1f boxes found)\r\n", results.query_bounds_nanos, results.bounds_hits);
+            context->out() << line;
+
+            std::snprintf(line, sizeof(line), "    ray_cast:      %10.1f ns (%u of %u rays hit)\r\n", results.ray_cast_nanos, results.ray_hits, results.query_count);
+            context->out() << line;
+
+            std::snprintf(line, sizeof(line), "    tree height %u, SAH cost %.2f\r\n", results.height, static_cast<double>(results.cost));
+            context->out() << line;
+
+            return 0;
+        }
+
+        int check_constant_ring()
+        {
+            ref<ctx> context = lib::create_ctx();
+
+            if (!context.is_valid())
+            {
+                return 1;
+            }
+
+            const auto fail = [&context](const char *reason) {
+                context->err() << "[ERROR] Constant ring check failed: " << reason << ".\r\n";
+
+                return 1;
+            };
+
+            // L'anneau vérifié est celui que le renderer crée et que son contexte utilise pour chaque objet.
+            ref<D3D::null_graphics> rend = D3D::null_graphics::create(context, 1, 1, fvec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+            if (!rend.is_valid())
+            {
+                return fail("cannot create the null renderer");
+            }
+
+            const uint32 alignment              = D3D::constant_ring_buffer::alignment;
+            D3D::device_context &dc             = rend->get_device_context();
+            ref<D3D::constant_ring_buffer> ring = rend->get_constant_ring();
+
+            if (!ring.is_valid() || ring->get_data() == nullptr || dc.get_constant_ring().get() != ring.get())
+            {
+                return fail("the renderer has no constant ring");
+            }
+
+            const uint32 capacity = ring->get_capacity();
+            const uint32 head     = ring->get_head();
+
+            if (capacity % alignment != 0 || head % alignment != 0 || head + alignment * 4 > capacity)
+            {
+                return fail("capacity");
+            }
+
+            uint8 constants[alignment + 44];
+            uint32 index;
+
+            for (index = 0; index < sizeof(constants); ++index)
+            {
+                constants[index] = static_cast<uint8>(index * 7 + 1);
+            }
+
+            // Les tailles sont arrondies à l'alignement et les données copiées à leur position.
+            D3D::constant_allocation first;
+            D3D::constant_allocation second;
+
+            if (!ring->push(constants, 64, dc, &first) || !ring->push(constants, sizeof(constants), dc, &second))
+            {
+                return fail("push");
+            }
+
+            if (first.offset != head || first.bytes_size != alignment || second.offset != head + alignment || second.bytes_size != alignment * 2 ||
+                std::memcmp(ring->get_data() + second.offset, constants, sizeof(constants)) != 0)
+            {
+                return fail("alignment");
+            }
+
+            if (ring->fits(capacity + 1) || ring->push(constants, capacity + 1, dc, &first))
+            {
+                return fail("oversized allocation");
+            }
+
+            // Le contexte du renderer écrit les constantes d'un objet dans l'anneau et lie leur portion au slot.
+            const uint32 ring_head = ring->get_head();
+            uint32 bound_size      = 0;
+
+            if (!dc.push_vs_constants(1, constants, 64))
+            {
+                return fail("push through the device context");
+            }
+
+            const uint8 *bound = dc.get_vs_constant_data(1, &bound_size);
+
+            if (bound != ring->get_data() + ring_head || bound_size != alignment || std::memcmp(bound, constants, 64) != 0)
+            {
+                return fail("binding through the device context");
+            }
+
+            // Une série d'écritures n'utilise qu'un map et s'arrête, sans rien écrire, quand l'anneau est plein.
+            const uint32 expected_writes = (capacity - ring->get_head()) / alignment;
+            const uint64 wraps           = ring->get_wrap_count();
+
+            ring->begin_frame();
+
+            D3D::constant_allocation batch;
+            uint32 written = 0;
+
+            if (!ring->map(dc))
+            {
+                return fail("map");
+            }
+
+            while (ring->write(constants, 16, &batch))
+            {
+                written++;
+            }
+
+            ring->unmap(dc);
+
+            if (written != expected_writes || batch.offset != capacity - alignment || ring->get_frame_maps() != 1 ||
+                ring->get_wrap_count() != wraps + 1 || ring->is_mapped())
+            {
+                return fail("batched writes");
+            }
+
+            // Le map suivant repart du début de l'anneau.
+            if (!ring->map(dc) || !ring->write(constants, 16, &batch))
+            {
+                return fail("map after wrap");
+            }
+
+            ring->unmap(dc);
+
+            if (!batch.wrapped || batch.offset != 0 || std::memcmp(ring->get_data(), constants, 16) != 0 || ring->get_frame_maps() != 2)
+            {
+                return fail("wrap-around");
+            }
+
+            context->out() << "Constant ring check passed (" << capacity << " bytes).\r\n";
+
+            return 0;
+        }
+    } // namespace tools
+} // namespace deep
@@ -0,0 +1,29 @@
+#ifndef DEEP_ENGINE_TOOLS_BENCHMARKS_HPP
+#define DEEP_ENGINE_TOOLS_BENCHMARKS_HPP
+
+#include <DeepCore/types.hpp>
+
+namespace deep
+{
+    namespace tools
+    {
+        /**
+         * @brief Mesure la régularité du limiteur d'images, chaque image simulant entre 3 et 6 ms de travail.
+         */
+        int bench_pacing(double fps);
+
+        /**
+         * @brief Mesure les opérations de la hiérarchie de boîtes du renderer sur N boîtes, sans GPU ni fenêtre.
+         */
+        int bench_bvh(uint32 box_count);
+
+        /**
+         * @brief Vérifie l'anneau de constantes créé par le renderer nul : alignement, contenu écrit, écriture groupée
+         * en un seul map et retour au début lorsque l'anneau est plein.
+         * @return 0 si toutes les vérifications passent, 1 sinon.
+         */
+        int check_constant_ring();
+    } // namespace tools
+} // namespace deep
+
+#endif
@@ -0,0 +1,286 @@
+#include "headless_run.hpp"
+
+#include "DeepEngine/engine.hpp"
+#include "D3D/drawable/drawable_factory.hpp"
+#include "D3D/software_graphics.hpp"
+#include "Assimp/loader.hpp"
+
+#include <DeepLib/stream/file_stream.hpp>
+
+#include <filesystem>
+
+namespace deep
+{
+    namespace tools
+    {
+        namespace
+        {
+            // Copies d'un maillage chargé par --load-mesh, de plus en plus loin devant la caméra.
+            constexpr uint32 mesh_copy_count = 6;
+
+            /**
+             * @brief Remplit la scène d'une grille de cubes afin de mesurer le coût d'une image sans GPU.
+             */
+            void populate_scene(ref<engine> &eng, uint32 cube_count, bool instancing, bool occluder)
+            {
+                ref<D3D::renderer> rend                     = eng->get_renderer();
+                ref<D3D::cube> basic_cube                   = eng->get_basic_shapes().cube;
+                ref<D3D::instanced_drawable> cube_instances = eng->get_basic_shapes().cube_instances;
+
+                if (!rend.is_valid() || !basic_cube.is_valid())
+                {
+                    return;
+                }
+
+                if (occluder)
+                {
+                    // Un mur plein entre la caméra et la grille, qui cache les cubes situés derrière lui.
+                    ref<D3D::cube> wall = D3D::drawable_factory::from(eng->get_context(),
+                                                                      basic_cube,
+                                                                      basic_cube->get_vertex_shader(),
+                                                                      basic_cube->get_pixel_shader(),
+                                                                      fvec3(0.0f, 0.0f, 25.0f),
+                                                                      fvec3(),
+                                                                      fvec3(20.0f, 20.0f, 0.5f),
+                                                                      rend->get_device());
+
+                    if (wall.is_valid())
+                    {
+                        wall->set_occluder(true);
+                        rend->add_drawable(ref_cast<D3D::drawable>(wall));
+                    }
+                }
+
+                uint32 side = 1;
+
+                while (side * side < cube_count)
+                {
+                    side++;
+                }
+
+                uint32 index;
+
+                for (index = 0; index < cube_count; ++index)
+                {
+                    const float x = (static_cast<float>(index % side) - static_cast<float>(side) * 0.5f) * 3.0f;
+                    const float y = (static_cast<float>(index / side) - static_cast<float>(side) * 0.5f) * 3.0f;
+
+                    if (instancing)
+                    {
+                        if (cube_instances.is_valid())
+                        {
+                            cube_instances->add_instance(fvec3(x, y, 50.0f), fvec3(), fvec3(1.0f, 1.0f, 1.0f), rend->get_device());
+                        }
+
+                        continue;
+                    }
+
+                    ref<D3D::cube> add_cube = D3D::drawable_factory::from(eng->get_context(),
+                                                                          basic_cube,
+                                                                          basic_cube->get_vertex_shader(),
+                                                                          basic_cube->get_pixel_shader(),
+                                                                          fvec3(x, y, 50.0f),
+                                                                          fvec3(),
+                                                                          fvec3(1.0f, 1.0f, 1.0f),
+                                                                          rend->get_device());
+
+                    if (add_cube.is_valid())
+                    {
+                        rend->add_drawable(ref_cast<D3D::drawable>(add_cube));
+                    }
+                }
+            }
+
+            /**
+             * @brief Charge un maillage préparé par --cook-mesh et l'ajoute à la scène, dessiné avec les shaders du cube.
+             *
+             * Le maillage doit avoir été préparé avec le même choix de --quantize-vertices que le moteur : ses sommets
+             * suivent alors l'input layout du vertex shader du cube.
+             */
+            ref<D3D::mesh> load_cooked_mesh(ref<engine> &eng, const char *path, const fvec3 &location)
+            {
+                ref<D3D::renderer> rend   = eng->get_renderer();
+                ref<D3D::cube> basic_cube = eng->get_basic_shapes().cube;
+
+                if (!rend.is_valid() || !basic_cube.is_valid())
+                {
+                    return ref<D3D::mesh>();
+                }
+
+                ref<D3D::mesh> loaded = model::loader::load_cooked(eng->get_context(),
+                                                                   path,
+                                                                   basic_cube->get_vertex_shader(),
+                                                                   basic_cube->get_pixel_shader(),
+                                                                   location,
+                                                                   fvec3(),
+                                                                   fvec3(1.0f, 1.0f, 1.0f),
+                                                                   rend->get_device());
+
+                if (loaded.is_valid())
+                {
+                    rend->add_drawable(ref_cast<D3D::drawable>(loaded));
+                }
+
+                return loaded;
+            }
+
+            /**
+             * @brief Affiche le niveau de détail choisi au dernier dessin de chaque copie du maillage.
+             */
+            void print_mesh_lods(ref<engine> &eng, const ref<D3D::mesh> *copies)
+            {
+                uint32 index;
+
+                for (index = 0; index < mesh_copy_count; ++index)
+                {
+                    const ref<D3D::mesh> &copy = copies[index];
+
+                    eng->get_context()->out() << "    distance " << static_cast<uint32>(copy->get_location().z) << ": level "
+                                              << copy->get_last_lod() << " of " << copy->get_lod_count() << "\r\n";
+                }
+            }
+
+            /**
+             * @brief Enregistre la dernière image du rendu logiciel dans 'frame.tga'.
+             */
+            void capture_frame(ref<engine> &eng)
+            {
+                ref<D3D::renderer> rend = eng->get_renderer();
+
+                if (!rend.is_valid() || rend->get_backend() != D3D::renderer_backend::Software)
+                {
+                    eng->get_context()->err() << "[ERROR] --capture requires --software-renderer.\r\n";
+
+                    return;
+                }
+
+                ref<D3D::software_graphics> soft = ref_cast<D3D::software_graphics>(rend);
+                file_stream output               = file_stream(eng->get_context(),
+                                                               DEEP_TEXT_NATIVE("frame.tga"),
+                                                               core_fs::file_mode::Create,
+                                                               core_fs::file_access::Write,
+                                                               core_fs::file_share::Read);
+
+                if (output.open() && soft->write_tga(&output))
+                {
+                    eng->get_context()->out() << "Frame written to 'frame.tga'.\r\n";
+                }
+                else
+                {
+                    eng->get_context()->err() << "[ERROR] Cannot write 'frame.tga'.\r\n";
+                }
+
+                output.close();
+            }
+
+            /**
+             * @brief Compare la dernière image du rendu logiciel à une image de référence.
+             * @return false si les images diffèrent ou si la comparaison est impossible.
+             */
+            bool compare_frame(ref<engine> &eng, const char *golden_path, uint32 tolerance)
+            {
+                ref<ctx> context        = eng->get_context();
+                ref<D3D::renderer> rend = eng->get_renderer();
+
+                if (!rend.is_valid() || rend->get_backend() != D3D::renderer_backend::Software)
+                {
+                    context->err() << "[ERROR] --compare requires --software-renderer.\r\n";
+
+                    return false;
+                }
+
+                ref<D3D::software_graphics> soft = ref_cast<D3D::software_graphics>(rend);
+                file_stream golden               = file_stream(context,
+                                                               std::filesystem::path(golden_path).c_str(),
+                                                               core_fs::file_mode::Open,
+                                                               core_fs::file_access::Read,
+                                                               core_fs::file_share::Read);
+
+                D3D::image_comparison comparison;
+
+                const bool compared = golden.open() && soft->compare_tga(&golden, tolerance, comparison);
+
+                golden.close();
+
+                if (!compared)
+                {
+                    context->err() << "[ERROR] Cannot compare the frame with '" << golden_path << "'.\r\n";
+
+                    return false;
+                }
+
+                if (comparison.differing_pixels != 0)
+                {
+                    context->err() << "[ERROR] Frame differs from '" << golden_path << "': " << comparison.differing_pixels
+                                   << " pixels above the tolerance of " << tolerance << ", max difference " << comparison.max_difference << ".\r\n";
+
+                    return false;
+                }
+
+                context->out() << "Frame matches '" << golden_path << "' (max difference " << comparison.max_difference << ").\r\n";
+
+                return true;
+            }
+        } // namespace
+
+        int run_headless(const headless_options &options)
+        {
+            ref<engine> eng = engine::create(options.backend, options.vertex_compression);
+
+            if (!eng.is_valid())
+            {
+                return 1;
+            }
+
+            populate_scene(eng, options.cube_count, options.instancing, options.occluder);
+
+            ref<D3D::mesh> mesh_copies[mesh_copy_count];
+
+            if (options.load_mesh_path != nullptr)
+            {
+                // La distance double d'une copie à l'autre : chaque niveau de détail finit par être choisi par mesh::draw.
+                float distance = 10.0f;
+
+                for (ref<D3D::mesh> &copy : mesh_copies)
+                {
+                    copy = load_cooked_mesh(eng, options.load_mesh_path, fvec3(0.0f, 0.0f, distance));
+
+                    if (!copy.is_valid())
+                    {
+                        return 1;
+                    }
+
+                    distance *= 2.0f;
+                }
+            }
+
+            if (options.recording_threads != 0 && eng->get_renderer().is_valid())
+            {
+                eng->get_renderer()->set_recording_thread_count(options.recording_threads);
+            }
+
+            eng->set_max_frames(options.max_frames != 0 ? options.max_frames : 1000);
+
+            eng->run();
+
+            if (options.load_mesh_path != nullptr)
+            {
+                eng->get_context()->out() << "'" << options.load_mesh_path << "' levels of detail:\r\n";
+
+                print_mesh_lods(eng, mesh_copies);
+            }
+
+            if (options.capture)
+            {
+                capture_frame(eng);
+            }
+
+            if (options.golden_path != nullptr && !compare_frame(eng, options.golden_path, options.compare_tolerance))
+            {
+                return 1;
+            }
+
+            return 0;
+        }
+    } // namespace tools
+} // namespace deep
@@ -0,0 +1,42 @@
+#ifndef DEEP_ENGINE_TOOLS_HEADLESS_RUN_HPP
+#define DEEP_ENGINE_TOOLS_HEADLESS_RUN_HPP
+
+#include "D3D/renderer.hpp"
+#include "D3D/vertex_quantization.hpp"
+
+namespace deep
+{
+    namespace tools
+    {
+        /**
+         * @brief Paramètres d'une exécution du moteur sans fenêtre.
+         */
+        struct headless_options
+        {
+            D3D::renderer_backend backend              = D3D::renderer_backend::Null;
+            D3D::vertex_compression vertex_compression = D3D::vertex_compression::None;
+            // 1000 images si 0 : sans fenêtre, rien d'autre ne permet de quitter la boucle.
+            uint64 max_frames                          = 0;
+            uint32 cube_count                          = 256;
+            // 0 pour conserver le nombre de threads par défaut du renderer.
+            uint32 recording_threads                   = 0;
+            bool instancing                            = false;
+            bool occluder                              = false;
+            // Enregistre la dernière image du rendu logiciel dans 'frame.tga'.
+            bool capture                               = false;
+            // Maillage préparé dont des copies sont ajoutées de plus en plus loin, nul si aucun.
+            const char *load_mesh_path                 = nullptr;
+            // Image TGA comparée à la dernière image du rendu logiciel, nulle si aucune.
+            const char *golden_path                    = nullptr;
+            uint32 compare_tolerance                   = 2;
+        };
+
+        /**
+         * @brief Exécute la boucle de jeu sans GPU ni fenêtre sur une grille de cubes, pour mesurer ou vérifier le rendu.
+         * @return 0 si l'exécution et la comparaison éventuelle réussissent, 1 sinon.
+         */
+        int run_headless(const headless_options &options);
+    } // namespace tools
+} // namespace deep
+
+#endif
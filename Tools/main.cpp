@@ -0,0 +1,178 @@
+#include "asset_tools.hpp"
+#include "benchmarks.hpp"
+#include "headless_run.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+int main(int argc, const char *argv[])
+{
+    deep::tools::headless_options headless;
+    bool run_engine                       = false;
+    bool check_ring                       = false;
+    bool quantize_vertices                = false;
+    deep::uint32 bvh_bench_count          = 0;
+    double pacing_bench_fps               = 0.0;
+    const char *cook_input                = nullptr;
+    const char *cook_output               = nullptr;
+    deep::D3D::texture_format cook_format = deep::D3D::texture_format::BC7;
+    const char *mesh_input                = nullptr;
+    const char *mesh_output               = nullptr;
+    const char *pack_input                = nullptr;
+    const char *pack_output               = nullptr;
+    int index;
+
+    // Outils hors ligne, qui quittent une fois leur travail terminé :
+    // --cook-texture IN OUT [rgba8|bc1|bc3|bc7]
+    //                     : prépare l'image PNG IN dans la texture OUT ('.dtex', BC7 par défaut).
+    // --cook-mesh IN OUT  : prépare le modèle IN dans le maillage OUT ('.dmsh').
+    // --pack IN OUT       : regroupe les fichiers du dossier IN dans l'archive OUT ('resources.dpak').
+    // --quantize-vertices : compresse les sommets des maillages préparés et des formes de base.
+    // --check-ring        : vérifie les allocations de l'anneau de constantes du renderer nul.
+    // --bvh-bench N       : mesure insert, update, query_frustum, query_bounds et ray_cast sur N boîtes.
+    // --pacing-bench N    : mesure la régularité du limiteur à N images par seconde.
+    //
+    // Exécution du moteur sans GPU ni fenêtre :
+    // --null-renderer     : exécute la boucle de jeu sans rendu.
+    // --software-renderer : rastérise la scène sur le CPU.
+    // --frames N          : quitte après N images, 1000 par défaut.
+    // --cubes N           : nombre de cubes dans la scène.
+    // --instancing        : dessine les cubes en un seul appel.
+    // --occluder          : place un mur occultant devant les cubes.
+    // --threads N         : nombre de threads qui enregistrent les commandes de dessin, 0 pour tous les cœurs.
+    // --capture           : enregistre la dernière image du rendu logiciel dans 'frame.tga'.
+    // --compare IN        : compare la dernière image du rendu logiciel à l'image TGA IN, code de retour 1 si elles diffèrent.
+    // --tolerance N       : écart accepté par composante lors de la comparaison, 2 par défaut.
+    // --load-mesh IN      : ajoute à la scène des copies du maillage préparé IN ('.dmsh') de plus en plus lointaines,
+    //                       puis affiche le niveau de détail dessiné pour chacune.
+    for (index = 1; index < argc; ++index)
+    {
+        if (std::strcmp(argv[index], "--null-renderer") == 0)
+        {
+            headless.backend = deep::D3D::renderer_backend::Null;
+            run_engine       = true;
+        }
+        else if (std::strcmp(argv[index], "--software-renderer") == 0)
+        {
+            headless.backend = deep::D3D::renderer_backend::Software;
+            run_engine       = true;
+        }
+        else if (std::strcmp(argv[index], "--capture") == 0)
+        {
+            headless.capture = true;
+        }
+        else if (std::strcmp(argv[index], "--instancing") == 0)
+        {
+            headless.instancing = true;
+        }
+        else if (std::strcmp(argv[index], "--occluder") == 0)
+        {
+            headless.occluder = true;
+        }
+        else if (std::strcmp(argv[index], "--quantize-vertices") == 0)
+        {
+            quantize_vertices = true;
+        }
+        else if (std::strcmp(argv[index], "--check-ring") == 0)
+        {
+            check_ring = true;
+        }
+        else if (std::strcmp(argv[index], "--frames") == 0 && index + 1 < argc)
+        {
+            headless.max_frames = static_cast<deep::uint64>(std::strtoull(argv[++index], nullptr, 10));
+        }
+        else if (std::strcmp(argv[index], "--cubes") == 0 && index + 1 < argc)
+        {
+            headless.cube_count = static_cast<deep::uint32>(std::strtoul(argv[++index], nullptr, 10));
+        }
+        else if (std::strcmp(argv[index], "--threads") == 0 && index + 1 < argc)
+        {
+            headless.recording_threads = static_cast<deep::uint32>(std::strtoul(argv[++index], nullptr, 10));
+        }
+        else if (std::strcmp(argv[index], "--pacing-bench") == 0 && index + 1 < argc)
+        {
+            pacing_bench_fps = std::strtod(argv[++index], nullptr);
+        }
+        else if (std::strcmp(argv[index], "--bvh-bench") == 0 && index + 1 < argc)
+        {
+            bvh_bench_count = static_cast<deep::uint32>(std::strtoul(argv[++index], nullptr, 10));
+        }
+        else if (std::strcmp(argv[index], "--cook-texture") == 0 && index + 2 < argc)
+        {
+            cook_input  = argv[++index];
+            cook_output = argv[++index];
+
+            if (index + 1 < argc && deep::D3D::texture_cooker::parse_format(argv[index + 1], cook_format))
+            {
+                index++;
+            }
+        }
+        else if (std::strcmp(argv[index], "--cook-mesh") == 0 && index + 2 < argc)
+        {
+            mesh_input  = argv[++index];
+            mesh_output = argv[++index];
+        }
+        else if (std::strcmp(argv[index], "--compare") == 0 && index + 1 < argc)
+        {
+            headless.golden_path = argv[++index];
+            run_engine           = true;
+        }
+        else if (std::strcmp(argv[index], "--tolerance") == 0 && index + 1 < argc)
+        {
+            headless.compare_tolerance = static_cast<deep::uint32>(std::strtoul(argv[++index], nullptr, 10));
+        }
+        else if (std::strcmp(argv[index], "--load-mesh") == 0 && index + 1 < argc)
+        {
+            headless.load_mesh_path = argv[++index];
+            run_engine              = true;
+        }
+        else if (std::strcmp(argv[index], "--pack") == 0 && index + 2 < argc)
+        {
+            pack_input  = argv[++index];
+            pack_output = argv[++index];
+        }
+    }
+
+    headless.vertex_compression = quantize_vertices ? deep::D3D::vertex_compression::Quantized : deep::D3D::vertex_compression::None;
+
+    if (pacing_bench_fps > 0.0)
+    {
+        return deep::tools::bench_pacing(pacing_bench_fps);
+    }
+
+    if (bvh_bench_count != 0)
+    {
+        return deep::tools::bench_bvh(bvh_bench_count);
+    }
+
+    if (check_ring)
+    {
+        return deep::tools::check_constant_ring();
+    }
+
+    if (cook_input != nullptr)
+    {
+        return deep::tools::cook_texture(cook_input, cook_output, cook_format);
+    }
+
+    if (mesh_input != nullptr)
+    {
+        return deep::tools::cook_mesh(mesh_input, mesh_output, headless.vertex_compression);
+    }
+
+    if (pack_input != nullptr)
+    {
+        return deep::tools::pack_folder(pack_input, pack_output);
+    }
+
+    if (run_engine)
+    {
+        return deep::tools::run_headless(headless);
+    }
+
+    std::fprintf(stderr, "Usage: DeepEngineTools [--cook-texture IN OUT [FORMAT] | --cook-mesh IN OUT | --pack IN OUT | --check-ring |\n"
+                         "                        --bvh-bench N | --pacing-bench N | --null-renderer | --software-renderer] [options]\n");
+
+    return 1;
+}